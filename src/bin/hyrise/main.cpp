@@ -16,9 +16,14 @@
 #include <boost/program_options.hpp>
 
 #include "helper/HwlocHelper.h"
+#include "helper/Settings.h"
 #include "net/AsyncConnection.h"
+#include "io/Checkpoint.h"
+#include "io/RedoLog.h"
 #include "io/StorageManager.h"
+#include "io/TransactionManager.h"
 #include "taskscheduler/SharedScheduler.h"
+#include "access/system/PlanCache.h"
 
 namespace po = boost::program_options;
 using namespace hyrise;
@@ -129,6 +134,10 @@ int main(int argc, char *argv[]) {
   std::string logPropertyFile;
   std::string scheduler_name;
   size_t maxTaskSize;
+  size_t planCacheSize;
+  std::string redoLogFile;
+  size_t groupCommitWindow;
+  std::string checkpointDir;
 
   // Program Options
   po::options_description desc("Allowed Parameters");
@@ -136,6 +145,11 @@ int main(int argc, char *argv[]) {
   ("port,p", po::value<size_t>(&port)->default_value(DEFAULT_PORT), "Server Port")
   ("logdef,l", po::value<std::string>(&logPropertyFile)->default_value("build/log.properties"), "Log4CXX Log Properties File")
   ("maxTaskSize,m", po::value<size_t>(&maxTaskSize)->default_value(DEFAULT_MTS), "Maximum task size used in dynamic parallelization scheduler. Use 0 for unbounded task run time.")
+  ("planCacheSize", po::value<size_t>(&planCacheSize)->default_value(access::PlanCache::DEFAULT_CAPACITY), "Number of query plans kept parsed in the plan cache. Use 0 to disable the cache.")
+  ("redoLog", po::value<std::string>(&redoLogFile)->default_value(""), "File of the redo log that makes commits durable. Commits are not logged if empty.")
+  ("groupCommitWindow", po::value<size_t>(&groupCommitWindow)->default_value(tx::RedoLog::DEFAULT_GROUP_COMMIT_WINDOW.count()), "Time in microseconds a commit waits for others to share its write of the redo log")
+  ("checkpointDir", po::value<std::string>(&checkpointDir)->default_value(Settings::getInstance()->getCheckpointPath()), "Directory of the checkpoints written through /checkpoint/")
+  ("recover", "Recover the tables from the latest checkpoint and the redo log on startup")
   ("scheduler,s", po::value<std::string>(&scheduler_name)->default_value("CentralScheduler"), "Name of the scheduler to use")
     // set default number of worker threads to #cores-1, as main thread with event loop is bound to core 0 
   ("threads,t", po::value<int>(&worker_threads)->default_value(getNumberOfCoresOnSystem()-1), "Number of worker threads for scheduler (only relevant for scheduler with fixed number of threads)");
@@ -156,7 +170,7 @@ int main(int argc, char *argv[]) {
 
 
   //Bind the program to the first NUMA node for schedulers that have core bound threads
-  if((scheduler_name == "CoreBoundQueuesScheduler") || (scheduler_name == "CoreBoundQueuesScheduler") ||  (scheduler_name == "WSCoreBoundQueuesScheduler") || (scheduler_name == "WSCoreBoundPriorityQueuesScheduler"))
+  if((scheduler_name == "CoreBoundQueuesScheduler") || (scheduler_name == "CoreBoundQueuesScheduler") ||  (scheduler_name == "WSCoreBoundQueuesScheduler") || (scheduler_name == "WSCoreBoundPriorityQueuesScheduler") || (scheduler_name == "LockFreeWSCoreBoundQueuesScheduler"))
     bindToNode(0);
 
   // Log File Configuration
@@ -167,6 +181,19 @@ int main(int argc, char *argv[]) {
 #endif
 
   taskscheduler::SharedScheduler::getInstance().init(scheduler_name, worker_threads, maxTaskSize);
+  access::PlanCache::getInstance().setCapacity(planCacheSize);
+
+  Settings::getInstance()->setCheckpointPath(checkpointDir);
+  if (vm.count("recover")) {
+    auto cid = tx::Checkpoint::recover(checkpointDir, redoLogFile);
+    LOG4CXX_INFO(logger, "Recovered up to commit " << cid);
+  }
+
+  if (!redoLogFile.empty()) {
+    auto& txmgr = tx::TransactionManager::getInstance();
+    txmgr.setRedoLog(std::make_shared<tx::RedoLog>(redoLogFile, txmgr.getLastCommitId(),
+                                                   std::chrono::microseconds(groupCommitWindow)));
+  }
 
   // Main Server Loop
   struct ev_loop *loop = ev_default_loop(0);
@@ -0,0 +1,93 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "helper/Arena.h"
+#include "helper/parallel_sort.hpp"
+
+namespace hyrise {
+
+TEST(ArenaTests, allocations_are_aligned_and_disjoint) {
+  Arena arena;
+  char *a = static_cast<char *>(arena.allocate(3, 1));
+  char *b = static_cast<char *>(arena.allocate(8, 8));
+  char *c = static_cast<char *>(arena.allocate(16, 16));
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(b) % 8);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(c) % 16);
+  EXPECT_LE(a + 3, b);
+  EXPECT_LE(b + 8, c);
+  EXPECT_EQ(Arena::MIN_BLOCK_SIZE, arena.reservedBytes());
+}
+
+TEST(ArenaTests, blocks_grow_and_large_allocations_get_their_own) {
+  Arena arena;
+  arena.allocate(Arena::MIN_BLOCK_SIZE / 4, 8);
+  arena.allocate(Arena::MIN_BLOCK_SIZE / 4, 8);
+  arena.allocate(Arena::MIN_BLOCK_SIZE / 4, 8);
+  arena.allocate(Arena::MIN_BLOCK_SIZE / 4, 8);
+  EXPECT_EQ(Arena::MIN_BLOCK_SIZE, arena.reservedBytes());
+  arena.allocate(8, 8);
+  EXPECT_EQ(3 * Arena::MIN_BLOCK_SIZE, arena.reservedBytes());
+
+  arena.allocate(Arena::MAX_BLOCK_SIZE, 8);
+  EXPECT_EQ(3 * Arena::MIN_BLOCK_SIZE + Arena::MAX_BLOCK_SIZE, arena.reservedBytes());
+  // the current block is still used
+  arena.allocate(8, 8);
+  EXPECT_EQ(3 * Arena::MIN_BLOCK_SIZE + Arena::MAX_BLOCK_SIZE, arena.reservedBytes());
+}
+
+TEST(ArenaTests, containers_share_the_arena) {
+  std::vector<size_t, ArenaAllocator<size_t> > copy;
+  {
+    auto arena = std::make_shared<Arena>();
+    std::vector<size_t, ArenaAllocator<size_t> > positions((ArenaAllocator<size_t>(arena)));
+    for (size_t i = 0; i < 100; ++i)
+      positions.push_back(i);
+    EXPECT_EQ(Arena::MIN_BLOCK_SIZE, arena->reservedBytes());
+
+    copy = positions;
+    EXPECT_EQ(arena, copy.get_allocator().arena());
+  }
+  // the copy keeps the arena alive
+  ASSERT_EQ(100u, copy.size());
+  EXPECT_EQ(99u, copy.back());
+  EXPECT_EQ(2, copy.get_allocator().arena().use_count());
+}
+
+TEST(ArenaTests, large_containers_use_the_heap) {
+  auto arena = std::make_shared<Arena>();
+  std::vector<size_t, ArenaAllocator<size_t> > positions((ArenaAllocator<size_t>(arena)));
+  positions.resize(Arena::MAX_ALLOCATION / sizeof(size_t) + 1);
+  EXPECT_EQ(0u, arena->reservedBytes());
+
+  std::vector<size_t, ArenaAllocator<size_t> > heap;
+  heap.resize(10);
+  EXPECT_FALSE(heap.get_allocator().arena());
+}
+
+TEST(ArenaTests, concurrent_allocations_are_disjoint) {
+  Arena arena;
+  const size_t threads = 4, allocations = 20000;
+  std::vector<std::vector<size_t *> > memory(threads);
+  run_threads(threads, [&] (size_t thread) {
+    for (size_t i = 0; i < allocations; ++i) {
+      size_t *value = static_cast<size_t *>(arena.allocate(sizeof(size_t), alignof(size_t)));
+      *value = thread * allocations + i;
+      memory[thread].push_back(value);
+    }
+  });
+
+  std::vector<size_t *> all;
+  for (size_t thread = 0; thread < threads; ++thread) {
+    for (size_t i = 0; i < allocations; ++i)
+      EXPECT_EQ(thread * allocations + i, *memory[thread][i]);
+    all.insert(all.end(), memory[thread].begin(), memory[thread].end());
+  }
+  std::sort(all.begin(), all.end());
+  EXPECT_TRUE(std::adjacent_find(all.begin(), all.end()) == all.end());
+}
+
+} // namespace hyrise
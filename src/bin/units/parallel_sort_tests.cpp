@@ -0,0 +1,25 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <stdexcept>
+
+#include "helper/parallel_sort.hpp"
+
+TEST(RunThreadsTests, exceptions_are_rethrown_after_joining_all_threads) {
+  for (size_t throwing = 0; throwing < 4; ++throwing) {
+    std::atomic<size_t> finished(0);
+    EXPECT_THROW(run_threads(4, [&] (size_t thread) {
+      if (thread == throwing)
+        throw std::runtime_error("failed");
+      ++finished;
+    }), std::runtime_error);
+    EXPECT_EQ(3u, finished.load());
+  }
+}
+
+TEST(RunThreadsTests, every_thread_runs_once) {
+  std::vector<size_t> runs(5, 0);
+  run_threads(5, [&] (size_t thread) { ++runs[thread]; });
+  EXPECT_EQ(std::vector<size_t>(5, 1), runs);
+}
@@ -0,0 +1,257 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/ArrowStreamWriter.h"
+
+#include <cstring>
+
+#include "io/shortcuts.h"
+#include "storage/AbstractTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class ArrowStreamWriterTests : public AccessTest {};
+
+namespace {
+
+class StreamConnection : public net::AbstractConnection {
+ public:
+  std::string response;
+  std::string contentType;
+
+  virtual void respond(const std::string &message, size_t status, const std::string &type) {
+    response = message;
+    contentType = type;
+  }
+  std::string getBody() const { return ""; }
+  std::string getPath() const { return ""; }
+  bool hasBody() const { return false; }
+};
+
+template <typename T>
+T read(const char *at) {
+  T value;
+  std::memcpy(&value, at, sizeof(T));
+  return value;
+}
+
+// Reads a table of a flatbuffer
+struct FlatTable {
+  const char *start;
+
+  const char *field(size_t slot) const {
+    const char *vtable = start - read<int32_t>(start);
+    if (sizeof(uint16_t) * (2 + slot) >= read<uint16_t>(vtable))
+      return nullptr;
+    const uint16_t offset = read<uint16_t>(vtable + sizeof(uint16_t) * (2 + slot));
+    return offset == 0 ? nullptr : start + offset;
+  }
+
+  template <typename T>
+  T scalar(size_t slot) const {
+    const char *at = field(slot);
+    return at ? read<T>(at) : T();
+  }
+
+  // target of the offset in slot
+  const char *target(size_t slot) const {
+    const char *at = field(slot);
+    return at + read<uint32_t>(at);
+  }
+
+  FlatTable table(size_t slot) const { return {target(slot)}; }
+
+  std::string string(size_t slot) const {
+    const char *at = target(slot);
+    return std::string(at + sizeof(uint32_t), read<uint32_t>(at));
+  }
+
+  size_t vectorSize(size_t slot) const { return read<uint32_t>(target(slot)); }
+
+  FlatTable tableAt(size_t slot, size_t i) const {
+    const char *element = target(slot) + sizeof(uint32_t) * (1 + i);
+    return {element + read<uint32_t>(element)};
+  }
+
+  // i-th int64 of a vector of structs of int64 fields
+  int64_t longAt(size_t slot, size_t i) const {
+    return read<int64_t>(target(slot) + sizeof(uint32_t) + sizeof(int64_t) * i);
+  }
+};
+
+// Message of a stream, points into the stream
+struct Message {
+  uint8_t type;
+  FlatTable header;
+  const char *body;
+};
+
+std::vector<Message> readMessages(const std::string &stream) {
+  std::vector<Message> messages;
+  size_t pos = 0;
+  while (true) {
+    EXPECT_EQ(0xFFFFFFFFu, read<uint32_t>(&stream[pos]));
+    const uint32_t length = read<uint32_t>(&stream[pos + 4]);
+    if (length == 0) {
+      EXPECT_EQ(stream.size(), pos + 8);
+      return messages;
+    }
+    EXPECT_EQ(0u, length % 8);
+    const char *metadata = &stream[pos + 8];
+    FlatTable message = {metadata + read<uint32_t>(metadata)};
+    EXPECT_EQ(4, message.scalar<int16_t>(0));
+    messages.push_back({message.scalar<uint8_t>(1), message.table(2), metadata + length});
+    pos += 8 + length + message.scalar<int64_t>(3);
+  }
+}
+
+// Rows of the record batches, every value formatted as text
+std::vector<std::vector<std::string>> decodeRows(const std::vector<Message> &messages, size_t columns) {
+  std::map<int64_t, std::vector<std::string>> dictionaries;
+  std::vector<std::vector<std::string>> rows;
+  for (const auto &message : messages) {
+    if (message.type == 2) {
+      const auto batch = message.header.table(1);
+      std::vector<std::string> values;
+      const char *offsets = message.body + batch.longAt(2, 2);
+      const char *data = message.body + batch.longAt(2, 4);
+      for (int64_t i = 0; i < batch.scalar<int64_t>(0); ++i) {
+        const int32_t first = read<int32_t>(offsets + 4 * i);
+        values.push_back(std::string(data + first, read<int32_t>(offsets + 4 * (i + 1)) - first));
+      }
+      dictionaries[message.header.scalar<int64_t>(0)] = values;
+    } else if (message.type == 3) {
+      const auto &batch = message.header;
+      const int64_t length = batch.scalar<int64_t>(0);
+      EXPECT_EQ(columns, batch.vectorSize(1));
+      for (int64_t row = 0; row < length; ++row) {
+        std::vector<std::string> values;
+        for (size_t column = 0; column < columns; ++column) {
+          const char *data = message.body + batch.longAt(2, 2 * (2 * column + 1));
+          if (dictionaries.count(column))
+            values.push_back(dictionaries[column].at(read<int32_t>(data + 4 * row)));
+          else if (batch.longAt(2, 2 * (2 * column + 1) + 1) == 8 * length)
+            values.push_back(std::to_string(read<int64_t>(data + 8 * row)));
+          else
+            values.push_back(std::to_string(read<float>(data + 4 * row)));
+        }
+        rows.push_back(values);
+      }
+    }
+  }
+  return rows;
+}
+
+std::vector<std::vector<std::string>> tableRows(const storage::c_atable_ptr_t &table, size_t first, size_t last) {
+  std::vector<std::vector<std::string>> rows;
+  for (size_t row = first; row < last; ++row) {
+    rows.push_back({std::to_string(table->getValue<hyrise_int_t>(0, row)),
+                    table->getValue<hyrise_string_t>(1, row),
+                    std::to_string(table->getValue<hyrise_float_t>(2, row))});
+  }
+  return rows;
+}
+
+std::string stream(const storage::c_atable_ptr_t &table, size_t limit, size_t offset, size_t batchRows) {
+  StreamConnection connection;
+  connection.beginStream(200, ARROW_STREAM_CONTENT_TYPE);
+  writeArrowStream(&connection, table, limit, offset, "{\"real_size\":1}", batchRows);
+  connection.endStream();
+  EXPECT_EQ(ARROW_STREAM_CONTENT_TYPE, connection.contentType);
+  return connection.response;
+}
+
+}  // namespace
+
+TEST_F(ArrowStreamWriterTests, schema_dictionaries_and_batches) {
+  auto t = io::Loader::shortcuts::load("test/tables/hash_join_construction.tbl");
+  const auto response = stream(t, 0, 0, 16);
+  const auto messages = readMessages(response);
+
+  // schema, the dictionary of the string column and three batches
+  ASSERT_EQ(5u, messages.size());
+  ASSERT_EQ(1, messages[0].type);
+  EXPECT_EQ(2, messages[1].type);
+  EXPECT_EQ(3, messages[2].type);
+
+  const auto &schema = messages[0].header;
+  ASSERT_EQ(3u, schema.vectorSize(1));
+  for (size_t column = 0; column < 3; ++column)
+    EXPECT_EQ(t->nameOfColumn(column), schema.tableAt(1, column).string(0));
+  EXPECT_EQ(2, schema.tableAt(1, 0).scalar<uint8_t>(2));
+  EXPECT_EQ(64, schema.tableAt(1, 0).table(3).scalar<int32_t>(0));
+  EXPECT_EQ(5, schema.tableAt(1, 1).scalar<uint8_t>(2));
+  EXPECT_EQ(1, schema.tableAt(1, 1).table(4).scalar<int64_t>(0));
+  EXPECT_EQ(3, schema.tableAt(1, 2).scalar<uint8_t>(2));
+  EXPECT_EQ("hyrise", schema.tableAt(2, 0).string(0));
+  EXPECT_EQ("{\"real_size\":1}", schema.tableAt(2, 0).string(1));
+
+  EXPECT_EQ(tableRows(t, 0, t->size()), decodeRows(messages, 3));
+}
+
+TEST_F(ArrowStreamWriterTests, limit_and_offset) {
+  auto t = io::Loader::shortcuts::load("test/tables/hash_join_construction.tbl");
+  EXPECT_EQ(tableRows(t, 3, 13), decodeRows(readMessages(stream(t, 10, 3, 4)), 3));
+  EXPECT_EQ(tableRows(t, 5, t->size()), decodeRows(readMessages(stream(t, 0, 5, 1024)), 3));
+  EXPECT_TRUE(decodeRows(readMessages(stream(t, 0, t->size() + 1, 4)), 3).empty());
+}
+
+TEST_F(ArrowStreamWriterTests, main_table_sends_its_ordered_dictionary) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/hash_join_construction.tbl"));
+  const storage::c_atable_ptr_t main = store->getMainTable();
+  const auto response = stream(main, 0, 0, 16);
+  const auto messages = readMessages(response);
+
+  const auto dictionary = main->dictionaryAt(1);
+  EXPECT_EQ(1, messages[0].header.tableAt(1, 1).table(4).scalar<uint8_t>(2));
+  EXPECT_EQ(static_cast<int64_t>(dictionary->size()), messages[1].header.table(1).scalar<int64_t>(0));
+  EXPECT_EQ(tableRows(main, 0, main->size()), decodeRows(messages, 3));
+}
+
+TEST_F(ArrowStreamWriterTests, unordered_dictionaries_are_rebuilt) {
+  auto t = io::Loader::shortcuts::load("test/tables/hash_join_construction.tbl");
+  auto delta = t->copy_structure_modifiable();
+  delta->resize(t->size());
+  for (size_t row = 0; row < t->size(); ++row) {
+    const size_t from = t->size() - 1 - row;
+    delta->setValue<hyrise_int_t>(0, row, t->getValue<hyrise_int_t>(0, from));
+    delta->setValue<hyrise_string_t>(1, row, t->getValue<hyrise_string_t>(1, from));
+    delta->setValue<hyrise_float_t>(2, row, t->getValue<hyrise_float_t>(2, from));
+  }
+  const auto response = stream(delta, 0, 0, 16);
+  const auto messages = readMessages(response);
+
+  EXPECT_EQ(0, messages[0].header.tableAt(1, 1).table(4).scalar<uint8_t>(2));
+  EXPECT_EQ(tableRows(delta, 0, delta->size()), decodeRows(messages, 3));
+}
+
+TEST_F(ArrowStreamWriterTests, store_rows_of_main_and_delta) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/hash_join_construction.tbl"));
+  const size_t mainSize = store->size();
+  store->appendRowsToDelta(store, tx::START_TID + 1);
+  ASSERT_EQ(2 * mainSize, store->size());
+
+  // batches spanning the end of the main are read from main and delta
+  EXPECT_EQ(tableRows(store, 0, store->size()), decodeRows(readMessages(stream(store, 0, 0, 7)), 3));
+  EXPECT_EQ(tableRows(store, 5, mainSize + 6), decodeRows(readMessages(stream(store, mainSize + 1, 5, 4)), 3));
+
+  // rows of the main share its dictionary, in any order
+  pos_list_t positions;
+  for (size_t row = 0; row < mainSize; ++row)
+    positions.push_back(mainSize - 1 - row);
+  const auto pointers = std::make_shared<storage::PointerCalculator>(store, new pos_list_t(positions));
+  auto messages = readMessages(stream(pointers, 0, 0, 16));
+  EXPECT_EQ(1, messages[0].header.tableAt(1, 1).table(4).scalar<uint8_t>(2));
+  EXPECT_EQ(tableRows(pointers, 0, mainSize), decodeRows(messages, 3));
+
+  // rows of main and delta do not
+  positions.push_back(mainSize);
+  const auto mixed = std::make_shared<storage::PointerCalculator>(store, new pos_list_t(positions));
+  messages = readMessages(stream(mixed, 0, 0, 16));
+  EXPECT_EQ(0, messages[0].header.tableAt(1, 1).table(4).scalar<uint8_t>(2));
+  EXPECT_EQ(tableRows(mixed, 0, mixed->size()), decodeRows(messages, 3));
+}
+
+} } // namespace hyrise::access
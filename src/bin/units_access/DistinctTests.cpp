@@ -1,6 +1,10 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/DenseDomain.h"
 #include "access/Distinct.h"
 #include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "taskscheduler/SharedScheduler.h"
 #include "testing/test.h"
 #include "testing/TableEqualityTest.h"
 
@@ -36,5 +40,44 @@ TEST_F(DistinctTests, distinct_on_distinct_column_test) {
   EXPECT_RELATION_EQ(result, t);
 }
 
+TEST_F(DistinctTests, dense_distinct_keeps_first_occurrences) {
+  auto t = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  const size_t domain = denseDomainSize(t, 1);
+  ASSERT_LT(0u, domain);
+
+  pos_list_t expected;
+  std::set<hyrise_int_t> seen;
+  for (pos_t row = 0; row < t->size(); ++row) {
+    if (seen.insert(t->getValue<hyrise_int_t>(1, row)).second)
+      expected.push_back(row);
+  }
+
+  for (size_t threads : {1, 2, 5})
+    EXPECT_EQ(expected, firstOccurrences(t, 1, domain, threads));
+}
+
+TEST_F(DistinctTests, dense_passes_run_on_scheduler_workers) {
+  auto t = io::Loader::shortcuts::load("test/tables/employees.tbl");
+  const size_t domain = denseDomainSize(t, 1);
+  const auto expected = firstOccurrences(t, 1, domain, 1);
+
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 2);
+  EXPECT_EQ(2u, denseThreads(size_t(1) << 20, domain));
+  EXPECT_EQ(expected, firstOccurrences(t, 1, domain, 5));
+}
+
+TEST_F(DistinctTests, dense_domain_requires_a_single_dictionary) {
+  auto t = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  ASSERT_TRUE(t != nullptr);
+  const pos_t last = t->size() - 1;
+  EXPECT_LT(0u, denseDomainSize(storage::PointerCalculator::create(t, new pos_list_t({0, last})), 1));
+
+  // the middle row lives in the delta, which has a dictionary of its own
+  t->appendToDelta(1);
+  EXPECT_EQ(0u, denseDomainSize(storage::PointerCalculator::create(t, new pos_list_t({0, last + 1, last})), 1));
+  EXPECT_EQ(0u, denseDomainSize(t, 1));
+  EXPECT_LT(0u, denseDomainSize(storage::PointerCalculator::create(t, new pos_list_t({last, 0})), 1));
+}
+
 }
 }
@@ -1,7 +1,10 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/DenseDomain.h"
 #include "access/GroupByScan.h"
 #include "access/HashBuild.h"
+#include "access/UnionAll.h"
 #include "io/shortcuts.h"
+#include "taskscheduler/SharedScheduler.h"
 #include "testing/TableEqualityTest.h"
 #include "testing/test.h"
 
@@ -57,6 +60,74 @@ TEST_F(GroupByScanTests, group_by_with_multiple_fields) {
   EXPECT_RELATION_EQ(reference, result);
 }
 
+// Two instances share the groups of the hash table, which itself is
+// built from morsels
+TEST_F(GroupByScanTests, group_by_with_morsels) {
+  auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+
+  HashBuild hb;
+  hb.addInput(t);
+  hb.addField(0);
+  hb.addField(1);
+  hb.setKey("groupby");
+  hb.setMorselCursor(std::make_shared<MorselCursor>(7));
+  hb.execute();
+
+  const auto &hash = hb.getResultHashTable();
+  auto cursor = std::make_shared<MorselCursor>(2);
+
+  GroupByScan gs1;
+  gs1.addInput(t);
+  gs1.addInput(hash);
+  gs1.addField(0);
+  gs1.addField(1);
+  gs1.setMorselCursor(cursor);
+
+  GroupByScan gs2;
+  gs2.addInput(t);
+  gs2.addInput(hash);
+  gs2.addField(0);
+  gs2.addField(1);
+  gs2.setMorselCursor(cursor);
+
+  gs1.execute();
+  gs2.execute();
+
+  UnionAll ua;
+  ua.addInput(gs1.getResultTable());
+  ua.addInput(gs2.getResultTable());
+  ua.execute();
+
+  auto reference = io::Loader::shortcuts::load("test/10_30_group_multi_result.tbl");
+  EXPECT_RELATION_EQ(reference, ua.getResultTable());
+}
+
+// A single operator starts morsel workers on the scheduler when it
+// executes, each writes the groups of its buckets into its own table
+TEST_F(GroupByScanTests, group_by_with_morsel_workers) {
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+
+  HashBuild hb;
+  hb.addInput(t);
+  hb.addField(0);
+  hb.addField(1);
+  hb.setKey("groupby");
+  hb.setMorselCursor(std::make_shared<MorselCursor>(3));
+  hb.execute();
+
+  GroupByScan gs;
+  gs.addInput(t);
+  gs.addInput(hb.getResultHashTable());
+  gs.addField(0);
+  gs.addField(1);
+  gs.setMorselCursor(std::make_shared<MorselCursor>(1));
+  gs.execute();
+
+  auto reference = io::Loader::shortcuts::load("test/10_30_group_multi_result.tbl");
+  EXPECT_RELATION_EQ(reference, gs.getResultTable());
+}
+
 TEST_F(GroupByScanTests, group_by_with_aggregate_function) {
   auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
   auto reference = io::Loader::shortcuts::load("test/10_30_group_count_result.tbl");
@@ -82,5 +153,73 @@ TEST_F(GroupByScanTests, group_by_with_aggregate_function) {
   EXPECT_RELATION_EQ(reference, result);
 }
 
+TEST_F(GroupByScanTests, dense_group_by_aggregates_per_value_id) {
+  auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+
+  GroupByScan gs;
+  gs.addInput(t);
+  gs.addField(1);
+  gs.addFunction(new SumAggregateFun(0));
+  gs.addFunction(new CountAggregateFun(0));
+  gs.addFunction(new MinAggregateFun(2));
+  gs.addFunction(new MaxAggregateFun(3));
+  gs.addFunction(new AverageAggregateFun(4));
+  gs.execute();
+  const auto &result = gs.getResultTable();
+
+  std::map<hyrise_int_t, std::vector<pos_t> > groups;
+  for (pos_t row = 0; row < t->size(); ++row)
+    groups[t->getValue<hyrise_int_t>(1, row)].push_back(row);
+  ASSERT_EQ(groups.size(), result->size());
+
+  for (pos_t row = 0; row < result->size(); ++row) {
+    const auto &rows = groups.at(result->getValue<hyrise_int_t>(0, row));
+    hyrise_int_t sum = 0, min = t->getValue<hyrise_int_t>(2, rows[0]), max = t->getValue<hyrise_int_t>(3, rows[0]), avg = 0;
+    for (const auto &r : rows) {
+      sum += t->getValue<hyrise_int_t>(0, r);
+      min = std::min(min, t->getValue<hyrise_int_t>(2, r));
+      max = std::max(max, t->getValue<hyrise_int_t>(3, r));
+      avg += t->getValue<hyrise_int_t>(4, r);
+    }
+    EXPECT_EQ(sum, result->getValue<hyrise_int_t>(1, row));
+    EXPECT_EQ(static_cast<hyrise_int_t>(rows.size()), result->getValue<hyrise_int_t>(2, row));
+    EXPECT_EQ(min, result->getValue<hyrise_int_t>(3, row));
+    EXPECT_EQ(max, result->getValue<hyrise_int_t>(4, row));
+    EXPECT_FLOAT_EQ((float)avg / rows.size(), result->getValue<hyrise_float_t>(5, row));
+  }
+}
+
+TEST_F(GroupByScanTests, dense_groups_merge_accumulators_of_threads) {
+  auto t = io::Loader::shortcuts::load("test/10_30_group.tbl");
+  const size_t domain = denseDomainSize(t, 1);
+  ASSERT_LT(0u, domain);
+
+  std::vector<value_id_t> valueIds;
+  const auto firsts = firstOccurrences(t, 1, domain, 3, &valueIds);
+  ASSERT_EQ(firsts, firstOccurrences(t, 1, domain, 1));
+  pos_list_t targetRows(domain, 0);
+  for (size_t row = 0; row < firsts.size(); ++row)
+    targetRows[valueIds[firsts[row]]] = row;
+
+  GroupByScan gs;
+  gs.addInput(t);
+  gs.addField(1);
+  std::vector<AggregateFun *> functions {new SumAggregateFun(0), new MinAggregateFun(2), new AverageAggregateFun(4)};
+  for (const auto &fun : functions) {
+    fun->walk(*t);
+    gs.addFunction(fun);
+  }
+
+  auto single = gs.createResultTableLayout();
+  auto parallel = gs.createResultTableLayout();
+  single->resize(firsts.size());
+  parallel->resize(firsts.size());
+  for (const auto &fun : functions) {
+    fun->processDenseGroups(t, valueIds, targetRows, single, 1);
+    fun->processDenseGroups(t, valueIds, targetRows, parallel, 3);
+  }
+  EXPECT_RELATION_EQ(single, parallel);
+}
+
 }
 }
@@ -0,0 +1,139 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/JsonStreamWriter.h"
+
+#include <limits>
+
+#include "json.h"
+
+#include "io/shortcuts.h"
+#include "storage/AbstractTable.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class JsonStreamWriterTests : public AccessTest {};
+
+namespace {
+
+class RecordingConnection : public net::AbstractConnection {
+ public:
+  std::vector<std::string> parts;
+  std::string response;
+
+  virtual void writeStream(const char *data, size_t length) {
+    parts.push_back(std::string(data, length));
+    net::AbstractConnection::writeStream(data, length);
+  }
+  virtual void respond(const std::string &message, size_t status, const std::string &contentType) {
+    response = message;
+  }
+  std::string getBody() const { return ""; }
+  std::string getPath() const { return ""; }
+  bool hasBody() const { return false; }
+};
+
+std::string fastWriterRows(const storage::c_atable_ptr_t &table, size_t limit, size_t offset) {
+  Json::Value rows(Json::arrayValue);
+  for (size_t row = offset; row < table->size() && (limit == 0 || row < offset + limit); ++row) {
+    Json::Value jsonRow(Json::arrayValue);
+    for (size_t col = 0; col < table->columnCount(); ++col) {
+      switch (table->typeOfColumn(col)) {
+        case IntegerType:
+          jsonRow.append(Json::Value(table->getValue<hyrise_int_t>(col, row)));
+          break;
+        case FloatType:
+          jsonRow.append(Json::Value(table->getValue<hyrise_float_t>(col, row)));
+          break;
+        default:
+          jsonRow.append(Json::Value(table->getValue<hyrise_string_t>(col, row)));
+      }
+    }
+    rows.append(jsonRow);
+  }
+  std::string text = Json::FastWriter().write(rows);
+  return text.substr(0, text.size() - 1);
+}
+
+std::string streamed(const std::function<void(JsonStreamWriter&)> &write, size_t chunkSize = 64 * 1024) {
+  RecordingConnection connection;
+  connection.beginStream();
+  JsonStreamWriter writer(&connection, chunkSize);
+  write(writer);
+  writer.flush();
+  connection.endStream();
+  return connection.response;
+}
+
+}  // namespace
+
+TEST_F(JsonStreamWriterTests, rows_match_fast_writer) {
+  auto t = io::Loader::shortcuts::load("test/tables/hash_join_construction.tbl");
+  ASSERT_LT(0u, t->size());
+
+  for (size_t offset : {0, 3}) {
+    for (size_t limit : {0, 5}) {
+      EXPECT_EQ(fastWriterRows(t, limit, offset),
+                streamed([&] (JsonStreamWriter &w) { writeRowsJson(w, t, limit, offset); }));
+    }
+  }
+  EXPECT_EQ("[]", streamed([&] (JsonStreamWriter &w) { writeRowsJson(w, t, 0, t->size() + 1); }));
+}
+
+TEST_F(JsonStreamWriterTests, strings_of_main_and_delta_match_fast_writer) {
+  auto t = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  ASSERT_TRUE(t != nullptr);
+  // strings of front coded mains are decoded into a buffer
+  t->setFrontCoding(true);
+  t->merge();
+  const size_t main = t->size();
+  t->appendToDelta(2);
+  for (size_t row = main; row < main + 2; ++row) {
+    t->setValue<hyrise_int_t>(0, row, row);
+    t->setValue<hyrise_int_t>(1, row, 4);
+  }
+  t->setValue<hyrise_string_t>(2, main, "Larry \"Ellison\"");
+  t->setValue<hyrise_string_t>(2, main + 1, "Steve Jobs");
+
+  EXPECT_EQ(fastWriterRows(t, 0, 0), streamed([&] (JsonStreamWriter &w) { writeRowsJson(w, t, 0, 0); }));
+  EXPECT_EQ(fastWriterRows(t, 3, main - 1), streamed([&] (JsonStreamWriter &w) { writeRowsJson(w, t, 3, main - 1); }));
+}
+
+TEST_F(JsonStreamWriterTests, numbers_and_strings_match_fast_writer) {
+  const std::vector<int64_t> ints = {0, 7, -7, 10, 99, 100, -12345678901234ll,
+                                     std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()};
+  const std::vector<double> doubles = {0.0, -0.0, 1.5, -2.0, 1e15, 1e16, 123456789.0, 0.1f, 3.25e-7, -1e300};
+  const std::vector<std::string> strings = {"", "plain", "quote\"backslash\\", "tab\tnewline\nreturn\r",
+                                            std::string("\x01\x1f/\b\f"), "umlaut \xc3\xa4"};
+
+  for (auto v : ints)
+    EXPECT_EQ(Json::FastWriter().write(Json::Value(static_cast<Json::Int64>(v))),
+              streamed([&] (JsonStreamWriter &w) { w.value(v); }) + "\n");
+  for (auto v : doubles)
+    EXPECT_EQ(Json::FastWriter().write(Json::Value(v)), streamed([&] (JsonStreamWriter &w) { w.value(v); }) + "\n");
+  for (const auto &v : strings)
+    EXPECT_EQ(Json::FastWriter().write(Json::Value(v)), streamed([&] (JsonStreamWriter &w) { w.value(v); }) + "\n");
+}
+
+TEST_F(JsonStreamWriterTests, output_is_handed_over_in_chunks) {
+  auto t = io::Loader::shortcuts::load("test/tables/hash_join_construction.tbl");
+
+  RecordingConnection connection;
+  connection.beginStream();
+  JsonStreamWriter writer(&connection, 16);
+  writeRowsJson(writer, t, 0, 0);
+  writer.flush();
+  connection.endStream();
+
+  ASSERT_LT(1u, connection.parts.size());
+  std::string joined;
+  for (const auto &part : connection.parts) {
+    EXPECT_GE(16u, part.size());
+    joined += part;
+  }
+  EXPECT_EQ(fastWriterRows(t, 0, 0), joined);
+  EXPECT_EQ(joined, connection.response);
+}
+
+} } // namespace hyrise::access
@@ -0,0 +1,114 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/PlanCache.h"
+#include "helper.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class PlanCacheTests : public AccessTest {};
+
+PlanCache::plan_t plan(const std::string& name) {
+  auto result = std::make_shared<Json::Value>();
+  (*result)["name"] = name;
+  return result;
+}
+
+TEST_F(PlanCacheTests, evicts_least_recently_used) {
+  PlanCache cache(2);
+  cache.put("a", plan("a"));
+  cache.put("b", plan("b"));
+
+  // makes b the least recently used plan
+  ASSERT_NE(nullptr, cache.get("a"));
+  cache.put("c", plan("c"));
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(nullptr, cache.get("b"));
+  EXPECT_EQ("a", (*cache.get("a"))["name"].asString());
+  EXPECT_EQ("c", (*cache.get("c"))["name"].asString());
+
+  EXPECT_EQ(3u, cache.getHits());
+  EXPECT_EQ(1u, cache.getMisses());
+  EXPECT_EQ(1u, cache.getEvictions());
+}
+
+TEST_F(PlanCacheTests, zero_capacity_disables_cache) {
+  PlanCache cache(1);
+  cache.put("a", plan("a"));
+  cache.setCapacity(0);
+  cache.put("b", plan("b"));
+
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(1u, cache.getEvictions());
+  EXPECT_EQ(nullptr, cache.get("b"));
+}
+
+TEST_F(PlanCacheTests, bind_parameters) {
+  Json::Value parameters;
+  parameters.append(2009);
+  parameters.append("x");
+
+  Json::Value slot;
+  slot["$param"] = 1;
+  Json::Value query;
+  query["a"]["value"] = slot;
+  query["b"].append(slot);
+  query["b"].append(5);
+
+  ASSERT_TRUE(hasParameters(query));
+  bindParameters(query, parameters);
+
+  EXPECT_FALSE(hasParameters(query));
+  EXPECT_EQ("x", query["a"]["value"].asString());
+  EXPECT_EQ("x", query["b"][0u].asString());
+  EXPECT_EQ(5, query["b"][1u].asInt());
+
+  slot["$param"] = 2;
+  EXPECT_THROW(bindParameters(slot, parameters), std::runtime_error);
+}
+
+TEST_F(PlanCacheTests, cached_plan_with_parameters) {
+  const std::string query =
+      "{\"operators\": {"
+      "  \"load\": {\"type\": \"LoadFile\", \"filename\": \"tables/revenue.tbl\"},"
+      "  \"scan\": {\"type\": \"SimpleTableScan\", \"predicates\": ["
+      "    {\"type\": \"EQ\", \"in\": 0, \"f\": \"year\", \"vtype\": 0, \"value\": {\"$param\": 0}}]}"
+      "}, \"edges\": [[\"load\", \"scan\"]]}";
+
+  auto& cache = PlanCache::getInstance();
+  const auto hits = cache.getHits();
+
+  const auto& result2009 = executeAndWait(query + "&parameters=[2009]");
+  const auto& result2010 = executeAndWait(query + "&parameters=[2010]");
+  const auto& result1999 = executeAndWait(query + "&parameters=[1999]");
+
+  EXPECT_EQ(hits + 2, cache.getHits());
+  EXPECT_LT(0u, result2009->size());
+  EXPECT_LT(0u, result2010->size());
+  EXPECT_EQ(0u, result1999->size());
+  EXPECT_EQ(2009, result2009->getValue<hyrise_int_t>(0, 0));
+  EXPECT_EQ(2010, result2010->getValue<hyrise_int_t>(0, 0));
+}
+
+TEST_F(PlanCacheTests, plans_are_cached_per_number_of_workers) {
+  const std::string query =
+      "{\"operators\": {"
+      "  \"load\": {\"type\": \"LoadFile\", \"filename\": \"tables/revenue.tbl\"},"
+      "  \"scan\": {\"type\": \"TableScan\", \"morselSize\": 2, \"expression\": \"hyrise::example\", \"column\": 0, \"value\": 2009}"
+      "}, \"edges\": [[\"load\", \"scan\"]]}";
+
+  auto& cache = PlanCache::getInstance();
+  executeAndWait(query, 1);
+  const auto hits = cache.getHits();
+  const auto misses = cache.getMisses();
+
+  const auto& result = executeAndWait(query, 2);
+  EXPECT_EQ(hits, cache.getHits());
+  EXPECT_EQ(misses + 1, cache.getMisses());
+  executeAndWait(query, 2);
+  EXPECT_EQ(hits + 1, cache.getHits());
+  EXPECT_LT(0u, result->size());
+}
+
+} } // namespace hyrise::access
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/ProjectionScan.h"
+#include "access/system/ResponseTask.h"
 #include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
 #include "testing/test.h"
 
 namespace hyrise {
@@ -22,5 +24,24 @@ TEST_F(ProjectionScanTests, basic_projection_scan_test) {
   ASSERT_TRUE(result->contentEquals(reference));
 }
 
+TEST_F(ProjectionScanTests, limited_positions_are_allocated_in_the_arena_of_the_query) {
+  auto t = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+  auto responseTask = std::make_shared<ResponseTask>(nullptr);
+
+  ProjectionScan ps;
+  ps.setResponseTask(responseTask);
+  ps.addInput(t);
+  ps.addField(0);
+  ps.setLimit(10);
+  ps.execute();
+
+  const auto result = std::dynamic_pointer_cast<const storage::PointerCalculator>(ps.getResultTable());
+  ASSERT_NE(nullptr, result.get());
+  const auto positions = result->getPositions();
+  ASSERT_EQ(10u, positions->size());
+  for (pos_t row = 0; row < 10; ++row)
+    EXPECT_EQ(row, positions->at(row));
+  EXPECT_EQ(responseTask->getArena(), positions->get_allocator().arena());
+}
 
 }}
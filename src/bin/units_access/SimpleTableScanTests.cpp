@@ -3,8 +3,11 @@
 #include "access/expressions/predicates.h"
 #include "access/UnionAll.h"
 #include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
 #include "testing/test.h"
 
+#include <functional>
+
 namespace hyrise {
 namespace access {
 
@@ -57,5 +60,157 @@ TEST_F(SimpleTableScanTests, parallelized_simple_table_scan) {
   ASSERT_EQ(100, result->getValue<storage::hyrise_int_t>(0, 0));
 }
 
+// Same as above, but both instances claim morsels from a shared cursor
+TEST_F(SimpleTableScanTests, morsel_simple_table_scan) {
+  storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+  auto cursor = std::make_shared<MorselCursor>(7);
+
+  SimpleTableScan sts1;
+  sts1.addInput(t);
+  sts1.setPredicate(new LessThanExpression<storage::hyrise_int_t>(0, 0, 150));
+  sts1.setMorselCursor(cursor);
+
+  SimpleTableScan sts2;
+  sts2.addInput(t);
+  sts2.setPredicate(new LessThanExpression<storage::hyrise_int_t>(0, 0, 150));
+  sts2.setMorselCursor(cursor);
+
+  sts1.execute();
+  sts2.execute();
+
+  UnionAll ua;
+  ua.addInput(sts1.getResultTable());
+  ua.addInput(sts2.getResultTable());
+  ua.execute();
+
+  SimpleTableScan reference;
+  reference.addInput(t);
+  reference.setPredicate(new LessThanExpression<storage::hyrise_int_t>(0, 0, 150));
+  reference.execute();
+
+  ASSERT_LT(0u, reference.getResultTable()->size());
+  ASSERT_EQ(reference.getResultTable()->size(), ua.getResultTable()->size());
+}
+
+// Scans on bit-compressed main partitions take the bulk unpacking path
+TEST_F(SimpleTableScanTests, bit_compressed_simple_table_scan) {
+  storage::c_atable_ptr_t t = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+  io::Loader::params p;
+  p.setCompressed(true);
+  storage::c_atable_ptr_t c = io::Loader::shortcuts::load("test/lin_xxs.tbl", p);
+
+  std::vector<std::function<SimpleExpression *()>> predicates {
+    [] { return new EqualsExpression<storage::hyrise_int_t>(0, 0, 100); },
+    [] { return new LessThanExpression<storage::hyrise_int_t>(0, 0, 150); },
+    [] { return new GreaterThanExpression<storage::hyrise_int_t>(0, 1, 42); },
+    [] { return new BetweenExpression<storage::hyrise_int_t>(0, 0, 50, 250); },
+    [] { return new CompoundExpression(new EqualsExpression<storage::hyrise_int_t>(0, 0, 100), nullptr, NOT); }
+  };
+
+  for (const auto& predicate : predicates) {
+    SimpleTableScan plain;
+    plain.addInput(t);
+    plain.setPredicate(predicate());
+    plain.execute();
+
+    SimpleTableScan compressed;
+    compressed.addInput(c);
+    compressed.setPredicate(predicate());
+    compressed.execute();
+
+    ASSERT_TABLE_EQUAL(plain.getResultTable(), compressed.getResultTable());
+  }
+}
+
+// Conjunctions and IN lists are compiled for uncompressed and compressed main partitions
+TEST_F(SimpleTableScanTests, compiled_conjunction_simple_table_scan) {
+  io::Loader::params p;
+  p.setCompressed(true);
+  std::vector<storage::c_atable_ptr_t> tables {
+    io::Loader::shortcuts::load("test/lin_xxs.tbl"),
+    io::Loader::shortcuts::load("test/lin_xxs.tbl", p)
+  };
+
+  Json::Value in_list;
+  for (auto value : {7, 100, 120, 250, 1000})
+    in_list.append(value);
+
+  std::vector<std::function<SimpleExpression *()>> predicates {
+    [&] { return new InExpression<storage::hyrise_int_t>(0, 0, in_list); },
+    [] { return new CompoundExpression(new LessThanExpression<storage::hyrise_int_t>(0, 0, 200),
+                                       new GreaterThanExpression<storage::hyrise_int_t>(0, 1, 42), AND); },
+    [&] { return new CompoundExpression(new CompoundExpression(new BetweenExpression<storage::hyrise_int_t>(0, 2, 10, 290),
+                                                               new InExpression<storage::hyrise_int_t>(0, 0, in_list), AND),
+                                        new CompoundExpression(new EqualsExpression<storage::hyrise_int_t>(0, 3, 100), nullptr, NOT), AND); }
+  };
+
+  for (const auto& t : tables) {
+    for (const auto& predicate : predicates) {
+      std::unique_ptr<SimpleExpression> reference(predicate());
+      reference->walk({t});
+      pos_list_t expected;
+      for (size_t row = 0; row < t->size(); ++row)
+        if ((*reference)(row))
+          expected.push_back(row);
+
+      auto compiled = compilePredicate(*reference, t);
+      ASSERT_TRUE(compiled != nullptr);
+      ASSERT_EQ(t->size(), compiled->rows());
+
+      SimpleTableScan sts;
+      sts.addInput(t);
+      sts.setPredicate(predicate());
+      sts.setProducesPositions(true);
+      sts.execute();
+
+      const auto& result = std::dynamic_pointer_cast<const storage::PointerCalculator>(sts.getResultTable());
+      ASSERT_EQ(expected, *result->getPositions());
+    }
+  }
+}
+
+// Compiled predicates mark their matches in bitmaps starting at any row
+TEST_F(SimpleTableScanTests, compiled_predicates_scan_into_bitmaps) {
+  io::Loader::params p;
+  p.setCompressed(true);
+  std::vector<storage::c_atable_ptr_t> tables {
+    io::Loader::shortcuts::load("test/lin_xxs.tbl"),
+    io::Loader::shortcuts::load("test/lin_xxs.tbl", p)
+  };
+
+  std::vector<std::function<SimpleExpression *()>> predicates {
+    [] { return new BetweenExpression<storage::hyrise_int_t>(0, 0, 50, 750); },
+    [] { return new CompoundExpression(new LessThanExpression<storage::hyrise_int_t>(0, 0, 800),
+                                       new GreaterThanExpression<storage::hyrise_int_t>(0, 1, 42), AND); }
+  };
+
+  for (const auto& t : tables) {
+    for (const auto& predicate : predicates) {
+      std::unique_ptr<SimpleExpression> expression(predicate());
+      expression->walk({t});
+      auto compiled = compilePredicate(*expression, t);
+      ASSERT_TRUE(compiled != nullptr);
+
+      for (size_t start : {0, 5, 63, 64, 70}) {
+        std::vector<uint64_t> words((t->size() + 63) / 64, 0);
+        compiled->scanBitmap(start, t->size(), 0, words.data());
+        for (size_t row = 0; row < t->size(); ++row)
+          ASSERT_EQ(row >= start && (*expression)(row), (words[row / 64] >> (row % 64)) & 1) << start << " " << row;
+      }
+
+      // morsels of a positional scan share one bitmap
+      SimpleTableScan sts;
+      sts.addInput(t);
+      sts.setPredicate(predicate());
+      sts.setMorselCursor(std::make_shared<MorselCursor>(7));
+      sts.execute();
+      const auto& result = std::dynamic_pointer_cast<const storage::PointerCalculator>(sts.getResultTable());
+      EXPECT_NE(storage::PositionSet::LIST, result->getPositionSet().kind());
+      for (size_t row = 0; row < result->size(); ++row)
+        EXPECT_TRUE((*expression)(result->getTableRowForRow(row)));
+    }
+  }
+}
+
 }
 }
@@ -1,6 +1,9 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/SortScan.h"
 #include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "taskscheduler/SharedScheduler.h"
 #include "testing/test.h"
 
 namespace hyrise {
@@ -22,5 +25,125 @@ TEST_F(SortScanTests, basic_sort_scan_test) {
   ASSERT_TRUE(result->contentEquals(reference));
 }
 
+namespace {
+// Table of the rows of employees.tbl repeated, using the main table
+// and thereby the ordered dictionaries of the loaded store
+storage::atable_ptr_t employeesRepeated(size_t rows) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  auto main = store->getMainTable();
+  auto table = main->copy_structure(nullptr, true);
+  table->resize(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t column = 0; column < main->columnCount(); ++column)
+      table->setValueId(column, row, main->getValueId(column, (row * 7) % main->size()));
+  }
+  return table;
+}
+
+// first rows of table with the unordered dictionaries of a modifiable table
+storage::atable_ptr_t modifiableCopy(const storage::c_atable_ptr_t &table, size_t rows) {
+  auto result = io::Loader::shortcuts::load("test/tables/employees.tbl")->copy_structure_modifiable();
+  result->resize(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    result->setValue<hyrise_int_t>(0, row, table->getValue<hyrise_int_t>(0, row));
+    result->setValue<hyrise_int_t>(1, row, table->getValue<hyrise_int_t>(1, row));
+    result->setValue<hyrise_string_t>(2, row, table->getValue<hyrise_string_t>(2, row));
+  }
+  return result;
+}
+
+// positions of a sort by company descending and name ascending
+storage::pos_list_t sortByCompanyAndName(const storage::c_atable_ptr_t &table, size_t limit, size_t threads) {
+  SortScan ss;
+  ss.addInput(table);
+  ss.addSortField(1, false);
+  ss.addSortField(2);
+  ss.setLimit(limit);
+  ss.setThreads(threads);
+  ss.execute();
+  auto result = std::dynamic_pointer_cast<const storage::PointerCalculator>(ss.getResultTable());
+  return *result->getPositions();
+}
+
+void checkOrder(const storage::c_atable_ptr_t &table, const storage::pos_list_t &positions) {
+  for (size_t i = 1; i < positions.size(); ++i) {
+    const auto previous = positions[i - 1], current = positions[i];
+    const auto previousCompany = table->getValue<hyrise_int_t>(1, previous);
+    const auto company = table->getValue<hyrise_int_t>(1, current);
+    ASSERT_GE(previousCompany, company);
+    if (previousCompany == company) {
+      const auto previousName = table->getValue<hyrise_string_t>(2, previous);
+      const auto name = table->getValue<hyrise_string_t>(2, current);
+      ASSERT_LE(previousName, name);
+      if (previousName == name) {
+        ASSERT_LT(previous, current);
+      }
+    }
+  }
+}
+}
+
+TEST_F(SortScanTests, multi_field_sort_on_value_ids_and_values) {
+  auto table = employeesRepeated(1000);
+  auto modifiable = modifiableCopy(table, table->size());
+
+  const auto byValueIds = sortByCompanyAndName(table, 0, 1);
+  ASSERT_EQ(table->size(), byValueIds.size());
+  checkOrder(table, byValueIds);
+  ASSERT_EQ(byValueIds, sortByCompanyAndName(modifiable, 0, 1));
+}
+
+TEST_F(SortScanTests, parallel_sort_matches_single_thread) {
+  auto table = employeesRepeated(100000);
+  auto modifiable = modifiableCopy(table, 20000);
+
+  const auto expected = sortByCompanyAndName(table, 0, 1);
+  checkOrder(table, expected);
+  ASSERT_EQ(expected, sortByCompanyAndName(table, 0, 4));
+  ASSERT_EQ(sortByCompanyAndName(modifiable, 0, 1), sortByCompanyAndName(modifiable, 0, 3));
+}
+
+// The parts of the sort run as tasks on the workers of the scheduler
+TEST_F(SortScanTests, parallel_sort_on_scheduler_workers) {
+  auto table = employeesRepeated(200000);
+  auto modifiable = modifiableCopy(table, 20000);
+  const auto expected = sortByCompanyAndName(table, 0, 1);
+  const auto expectedModifiable = sortByCompanyAndName(modifiable, 0, 1);
+
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  ASSERT_EQ(expected, sortByCompanyAndName(table, 0, 0));
+  ASSERT_EQ(expectedModifiable, sortByCompanyAndName(modifiable, 0, 4));
+  ASSERT_EQ(storage::pos_list_t(expected.begin(), expected.begin() + 17), sortByCompanyAndName(table, 17, 4));
+}
+
+TEST_F(SortScanTests, top_n_is_prefix_of_sort) {
+  auto table = employeesRepeated(5000);
+  auto modifiable = modifiableCopy(table, table->size());
+
+  for (const auto& input : {table, modifiable}) {
+    const auto sorted = sortByCompanyAndName(input, 0, 1);
+    for (size_t threads : {1, 4}) {
+      const auto top = sortByCompanyAndName(input, 17, threads);
+      ASSERT_EQ(storage::pos_list_t(sorted.begin(), sorted.begin() + 17), top);
+    }
+  }
+}
+
+TEST_F(SortScanTests, parse_fields_and_directions) {
+  auto table = employeesRepeated(300);
+  Json::Value data;
+  data["fields"].append(1);
+  data["fields"].append(2);
+  data["asc"].append(false);
+  data["asc"].append(true);
+  data["limit"] = 10;
+
+  auto ss = SortScan::parse(data);
+  ss->addInput(table);
+  ss->execute();
+  auto result = std::dynamic_pointer_cast<const storage::PointerCalculator>(ss->getResultTable());
+  ASSERT_EQ(sortByCompanyAndName(table, 10, 1), *result->getPositions());
+}
+
 }
 }
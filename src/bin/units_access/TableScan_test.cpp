@@ -3,9 +3,13 @@
 #include "access/TableScan.h"
 #include "access/expressions/pred_EqualsExpression.h"
 #include "access/expressions/pred_CompoundExpression.h"
+#include "access/expressions/pred_LessThanExpression.h"
+#include "access/system/MorselCursor.h"
 #include "io/shortcuts.h"
 #include "access/Barrier.h"
 #include "helper/make_unique.h"
+#include "storage/TableRangeView.h"
+#include "taskscheduler/SharedScheduler.h"
 
 namespace hyrise { namespace access {
 
@@ -26,6 +30,44 @@ TEST(TableScan, test2) {
   ASSERT_EQ(1u, result->size());
 }
 
+TEST(TableScan, morsels_of_a_range_view_match_the_rows_of_the_view) {
+  auto tbl = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+  auto view = storage::TableRangeView::create(tbl, 20, 80);
+
+  TableScan reference(make_unique<LessThanExpression<hyrise_int_t>>(0, 0, 500));
+  reference.addInput(view);
+  const auto& expected = reference.execute()->getResultTable();
+
+  TableScan ts(make_unique<LessThanExpression<hyrise_int_t>>(0, 0, 500));
+  ts.addInput(view);
+  ts.setMorselCursor(std::make_shared<MorselCursor>(7));
+  const auto& result = ts.execute()->getResultTable();
+
+  ASSERT_LT(0u, expected->size());
+  ASSERT_EQ(expected->size(), result->size());
+  for (size_t row = 0; row < result->size(); ++row)
+    EXPECT_EQ(expected->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int_t>(0, row));
+}
+
+TEST(TableScan, morsel_workers_keep_the_order_of_the_rows) {
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  auto tbl = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  TableScan reference(make_unique<LessThanExpression<hyrise_int_t>>(0, 0, 500));
+  reference.addInput(tbl);
+  const auto& expected = reference.execute()->getResultTable();
+
+  TableScan ts(make_unique<LessThanExpression<hyrise_int_t>>(0, 0, 500));
+  ts.addInput(tbl);
+  ts.setMorselCursor(std::make_shared<MorselCursor>(3));
+  const auto& result = ts.execute()->getResultTable();
+
+  ASSERT_LT(0u, expected->size());
+  ASSERT_EQ(expected->size(), result->size());
+  for (size_t row = 0; row < result->size(); ++row)
+    EXPECT_EQ(expected->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int_t>(0, row));
+}
+
 TEST(TableScan, testDynamicParallelization) {
   auto MTS = 20;
 
@@ -61,13 +61,13 @@ TEST_F(UnionAllTests, many_pointer_calc_input) {
 }
 
 TEST_F(UnionAllTests, vertical_nested_pointer_calculators) {
-  auto pc1_l = std::make_shared<storage::PointerCalculator>(t, new std::vector<size_t> {1}, new std::vector<size_t> {0, 1});
-  auto pc1_r = std::make_shared<storage::PointerCalculator>(t, new std::vector<size_t> {5}, new std::vector<size_t> {2, 3, 4});
+  auto pc1_l = std::make_shared<storage::PointerCalculator>(t, new pos_list_t {1}, new std::vector<size_t> {0, 1});
+  auto pc1_r = std::make_shared<storage::PointerCalculator>(t, new pos_list_t {5}, new std::vector<size_t> {2, 3, 4});
   std::vector<storage::atable_ptr_t> pc1 {pc1_l , pc1_r};
   auto mtv1  = std::make_shared<storage::MutableVerticalTable>(pc1);
   
-  auto pc2_l = std::make_shared<storage::PointerCalculator>(t, new std::vector<size_t> {2, 3}, new std::vector<size_t> {0, 1});
-  auto pc2_r = std::make_shared<storage::PointerCalculator>(t, new std::vector<size_t> {2, 6}, new std::vector<size_t> {2, 3, 4});
+  auto pc2_l = std::make_shared<storage::PointerCalculator>(t, new pos_list_t {2, 3}, new std::vector<size_t> {0, 1});
+  auto pc2_r = std::make_shared<storage::PointerCalculator>(t, new pos_list_t {2, 6}, new std::vector<size_t> {2, 3, 4});
   std::vector<storage::atable_ptr_t> pc2 {pc2_l , pc2_r};
   auto mtv2  = std::make_shared<storage::MutableVerticalTable>(pc2);
 
@@ -3,6 +3,8 @@
 #include "access/NoOp.h"
 #include "testing/test.h"
 #include "testing/TableEqualityTest.h"
+#include "storage/HorizontalTable.h"
+#include "storage/TableBuilder.h"
 
 namespace hyrise {
 namespace access {
@@ -58,4 +60,31 @@ INSTANTIATE_TEST_CASE_P(DistributeCoveringTests,
                         ::testing::Combine(::testing::Values(1u, 2u, 3u, 11u, 14u),
                                            ::testing::Values(0u, 1u, 10u, 13u, 1000u, 1001u, 1002u, 3333u)));
 
+TEST(DistributePlacedTest, parts_stay_within_partitions) {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("a");
+  std::vector<storage::c_atable_ptr_t> parts;
+  for (size_t rows : {10, 0, 7, 1000}) {
+    auto part = storage::TableBuilder::build(list);
+    part->resize(rows);
+    parts.push_back(part);
+  }
+  storage::HorizontalTable table(parts, {0, 1, 2, 3});
+  ASSERT_TRUE(table.isPlaced());
+
+  for (size_t count : {1, 2, 3, 4, 5, 9, 16}) {
+    std::uint64_t previous_last = 0;
+    for (size_t part = 0; part < count; ++part) {
+      auto result = ParallelizablePlanOperation::distribute(table, part, count);
+      EXPECT_EQ(previous_last, result.first) << count;
+      // with at least as many parts as partitions no part spans two partitions
+      if (count >= table.partCount() && result.first < result.second) {
+        EXPECT_EQ(table.partForRow(result.first), table.partForRow(result.second - 1)) << "part " << part << " of " << count << " spans two partitions";
+      }
+      previous_last = result.second;
+    }
+    EXPECT_EQ(table.size(), previous_last) << count;
+  }
+}
+
 }}
@@ -5,12 +5,15 @@
 #include "access/radixjoin/RadixCluster.h"
 #include "helper.h"
 #include "io/shortcuts.h"
+#include "access/radixjoin/KeyDomain.h"
 #include "access/radixjoin/NestedLoopEquiJoin.h"
+#include "access/radixjoin/PartitionedHashJoin.h"
 #include "testing/TableEqualityTest.h"
 #include <storage/TableBuilder.h>
 #include "access/RadixJoin.h"
 #include "access/storage/TableLoad.h"
 #include "access/Barrier.h"
+#include "storage/Store.h"
 #include "taskscheduler/ThreadPerTaskScheduler.h"
 
 namespace hyrise {
@@ -798,6 +801,159 @@ TEST_F(RadixJoinTest, determine_dynamic_count) {
   ASSERT_GT(dynamicCount2, dynamicCount1);
 }
 
+TEST_F(RadixJoinTest, self_scheduling_join) {
+  auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto employees = io::Loader::shortcuts::load("test/tables/employees.tbl");
+
+  for (size_t threads : {1, 4}) {
+    RadixJoin radix;
+    radix.addInput(companies);
+    radix.addInput(employees);
+    radix.addField(0);
+    radix.addField(1);
+    radix.setThreads(threads);
+    radix.execute();
+
+    auto reference = io::Loader::shortcuts::load("test/tables/companies_employees_joined.tbl");
+    ASSERT_TRUE(reference->contentEquals(radix.getResultTable()));
+  }
+}
+
+TEST_F(RadixJoinTest, self_scheduling_join_without_bits_is_not_split) {
+  auto radix = std::make_shared<RadixJoin>();
+  radix->addField(0);
+  radix->addField(1);
+
+  auto tasks = radix->applyDynamicParallelization(4);
+  ASSERT_EQ(1u, tasks.size());
+  ASSERT_EQ(radix, tasks.front());
+}
+
+TEST_F(RadixJoinTest, partition_bits_grow_with_build_side) {
+  EXPECT_EQ(0u, radixjoin::choosePartitionBits(100, 8));
+  const auto large = radixjoin::choosePartitionBits(10000000, 8);
+  EXPECT_GE(large, 5u);
+  EXPECT_LE(large, radixjoin::MAX_PARTITION_BITS);
+  EXPECT_LE(radixjoin::choosePartitionBits(100000, 8), large);
+}
+
+TEST_F(RadixJoinTest, partitions_are_clustered_and_stable) {
+  std::vector<storage::hyrise_int_t> keys;
+  for (storage::hyrise_int_t i = 0; i < 10000; ++i)
+    keys.push_back(i % 777);
+
+  const uint32_t bits = 6;
+  auto partitions = radixjoin::partition(radixjoin::buildTuples(keys, 3), bits, 3);
+  ASSERT_EQ((1u << bits) + 1, partitions.offsets.size());
+  ASSERT_EQ(keys.size(), partitions.offsets.back());
+
+  for (size_t p = 0; p < (1u << bits); ++p) {
+    for (size_t t = partitions.offsets[p]; t < partitions.offsets[p + 1]; ++t) {
+      EXPECT_EQ(p, partitions.tuples[t].hash >> (64 - bits));
+      if (t > partitions.offsets[p]) {
+        EXPECT_LT(partitions.tuples[t - 1].row, partitions.tuples[t].row);
+      }
+    }
+  }
+}
+
+TEST_F(RadixJoinTest, partitioned_hash_join_does_not_depend_on_threads) {
+  std::vector<storage::hyrise_int_t> probe, build;
+  for (storage::hyrise_int_t i = 0; i < 50000; ++i)
+    probe.push_back(i % 3001);
+  for (storage::hyrise_int_t i = 0; i < 4000; ++i)
+    build.push_back(i * 7 % 4001);
+
+  size_t expected = 0;
+  std::vector<size_t> buildCounts(4001, 0);
+  for (const auto& key : build)
+    ++buildCounts[key];
+  for (const auto& key : probe)
+    expected += buildCounts[key];
+
+  storage::pos_list_t probeRows1, buildRows1, probeRows4, buildRows4;
+  radixjoin::partitionedHashJoin(probe, build, 5, 1, probeRows1, buildRows1);
+  radixjoin::partitionedHashJoin(probe, build, 5, 4, probeRows4, buildRows4);
+
+  ASSERT_EQ(expected, probeRows1.size());
+  ASSERT_EQ(probeRows1, probeRows4);
+  ASSERT_EQ(buildRows1, buildRows4);
+  for (size_t i = 0; i < probeRows1.size(); ++i)
+    ASSERT_EQ(probe[probeRows1[i]], build[buildRows1[i]]);
+}
+
+TEST_F(RadixJoinTest, partitioned_hash_join_strings) {
+  std::vector<storage::hyrise_string_t> probe {"apple", "pear", "plum", "apple", "fig"};
+  std::vector<storage::hyrise_string_t> build {"fig", "apple", "kiwi"};
+
+  storage::pos_list_t probeRows, buildRows;
+  radixjoin::partitionedHashJoin(probe, build, 2, 2, probeRows, buildRows);
+
+  ASSERT_EQ(3u, probeRows.size());
+  for (size_t i = 0; i < probeRows.size(); ++i)
+    EXPECT_EQ(probe[probeRows[i]], build[buildRows[i]]);
+}
+
+TEST_F(RadixJoinTest, key_domain_keeps_value_ids_and_translates_other_dictionaries) {
+  auto employees = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  ASSERT_TRUE(employees != nullptr);
+  const size_t main = employees->size();
+  employees->appendToDelta(2);
+  employees->setValue<storage::hyrise_string_t>(2, main, "Larry Ellison");
+  employees->setValue<storage::hyrise_string_t>(2, main + 1, "Steve Jobs");
+
+  radixjoin::KeyDomain<storage::hyrise_string_t> domain;
+  const auto keys = domain.keys(employees, 2, 3);
+  ASSERT_EQ(employees->size(), keys.size());
+  for (size_t row = 0; row < main; ++row)
+    EXPECT_EQ(employees->getValueId(2, row).valueId, keys[row]);
+
+  size_t pairs = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    for (size_t j = 0; j < keys.size(); ++j) {
+      const bool equal = employees->getValue<storage::hyrise_string_t>(2, i) == employees->getValue<storage::hyrise_string_t>(2, j);
+      EXPECT_EQ(equal, keys[i] == keys[j]);
+      pairs += equal;
+    }
+  }
+
+  RadixJoin radix;
+  radix.addInput(employees);
+  radix.addInput(employees);
+  radix.addField(2);
+  radix.addField(2);
+  radix.setThreads(2);
+  radix.execute();
+  EXPECT_EQ(pairs, radix.getResultTable()->size());
+}
+
+TEST_F(RadixJoinTest, key_domain_translates_values_added_to_a_dictionary) {
+  auto employees = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  ASSERT_TRUE(employees != nullptr);
+  const size_t main = employees->size();
+  employees->appendToDelta(1);
+  employees->setValue<storage::hyrise_string_t>(2, main, "Larry Ellison");
+
+  radixjoin::KeyDomain<storage::hyrise_string_t> domain;
+  const auto before = domain.keys(employees, 2, 2);
+
+  // the delta dictionary grows after the domain translated it
+  employees->appendToDelta(2);
+  employees->setValue<storage::hyrise_string_t>(2, main + 1, "Steve Jobs");
+  employees->setValue<storage::hyrise_string_t>(2, main + 2, employees->getValue<storage::hyrise_string_t>(2, 0));
+  const auto after = domain.keys(employees, 2, 2);
+  ASSERT_EQ(employees->size(), after.size());
+  EXPECT_EQ(after[0], after[main + 2]);
+
+  for (size_t i = 0; i < before.size(); ++i) {
+    EXPECT_EQ(before[i], after[i]);
+    for (size_t j = 0; j < after.size(); ++j) {
+      const bool equal = employees->getValue<storage::hyrise_string_t>(2, i) == employees->getValue<storage::hyrise_string_t>(2, j);
+      EXPECT_EQ(equal, before[i] == after[j]);
+    }
+  }
+}
+
 class RadixDynamicCountTest : public AccessTest, public ::testing::WithParamInterface<int> {
   protected:
     virtual void SetUp() {
@@ -6,6 +6,9 @@
 #include "helper.h"
 
 #include <algorithm>
+#include <cstdio>
+
+#include <boost/filesystem.hpp>
 
 #include "access/Delete.h"
 #include "access/InsertScan.h"
@@ -16,11 +19,15 @@
 #include "access/tx/Commit.h"
 #include "access/tx/ValidatePositions.h"
 #include "io/shortcuts.h"
+#include "storage/BitCompressedVector.h"
 #include "storage/Store.h"
 #include "storage/PointerCalculator.h"
 #include "storage/TableBuilder.h"
 #include "helper/types.h"
 #include "io/TransactionManager.h"
+#include "io/Checkpoint.h"
+#include "io/RedoLog.h"
+#include "io/StorageManager.h"
 
 #include <testing/TableEqualityTest.h>
 
@@ -702,4 +709,260 @@ TEST_F(TransactionTests, delete_rollback) {
   ASSERT_EQ(tx::START_TID, linxxxs->tid(0));
 }
 
+TEST_F(TransactionTests, redo_log_records_committed_changes) {
+  const std::string logFile = "test/redo_log_test.log";
+  std::remove(logFile.c_str());
+  io::StorageManager::getInstance()->loadTable("linxxxs_logged", linxxxs);
+  auto& txmgr = tx::TransactionManager::getInstance();
+  txmgr.setRedoLog(std::make_shared<tx::RedoLog>(logFile, txmgr.getLastCommitId()));
+
+  auto writeCtx = tx::TransactionManager::beginTransaction();
+  InsertScan is;
+  is.setTXContext(writeCtx);
+  is.addInput(linxxxs);
+  is.setInputData(one_row);
+  is.execute();
+
+  DeleteOp del;
+  del.setTXContext(writeCtx);
+  del.addInput(storage::PointerCalculator::create(linxxxs, new pos_list_t({1})));
+  del.execute();
+
+  // read-only transactions take no commit id and are not logged
+  auto readCtx = tx::TransactionManager::beginTransaction();
+  EXPECT_EQ(readCtx.lastCid, tx::TransactionManager::commitTransaction(readCtx));
+  auto cid = tx::TransactionManager::commitTransaction(writeCtx);
+  EXPECT_EQ(readCtx.lastCid + 1, cid);
+  EXPECT_EQ(cid, txmgr.getRedoLog()->getDurableCommitId());
+
+  txmgr.setRedoLog(nullptr);
+  io::StorageManager::getInstance()->removeTable("linxxxs_logged");
+
+  const auto& records = tx::RedoLog::read(logFile);
+  std::remove(logFile.c_str());
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ(cid, records[0].cid);
+  EXPECT_EQ(writeCtx.tid, records[0].tid);
+  ASSERT_EQ(1u, records[0].changes.size());
+
+  const auto& changes = records[0].changes[0];
+  EXPECT_EQ("linxxxs_logged", changes.table);
+  EXPECT_EQ(pos_list_t({linxxxs->size() - 1}), changes.inserted);
+  EXPECT_EQ(pos_list_t({1}), changes.deleted);
+
+  auto rows = linxxxs->copy_structure_modifiable();
+  rows->resize(1);
+  changes.copyInsertedRowsTo(rows, 0);
+  EXPECT_EQ(99, rows->getValue<hyrise_int_t>(0, 0));
+  EXPECT_EQ(999, rows->getValue<hyrise_int_t>(1, 0));
+}
+
+TEST_F(TransactionTests, recover_from_checkpoint_and_redo_log) {
+  const std::string checkpointDir = "test/checkpoint_test";
+  const std::string logFile = "test/checkpoint_test.log";
+  boost::filesystem::remove_all(checkpointDir);
+  std::remove(logFile.c_str());
+  io::StorageManager::getInstance()->loadTable("linxxxs_checkpointed", linxxxs);
+  auto& txmgr = tx::TransactionManager::getInstance();
+
+  auto insertRow = [this] (const storage::atable_ptr_t &row) {
+    auto ctx = tx::TransactionManager::beginTransaction();
+    InsertScan is;
+    is.setTXContext(ctx);
+    is.addInput(linxxxs);
+    is.setInputData(row);
+    is.execute();
+    return tx::TransactionManager::commitTransaction(ctx);
+  };
+  auto deleteRow = [this] (pos_t pos) {
+    auto ctx = tx::TransactionManager::beginTransaction();
+    DeleteOp del;
+    del.setTXContext(ctx);
+    del.addInput(storage::PointerCalculator::create(linxxxs, new pos_list_t({pos})));
+    del.execute();
+    return tx::TransactionManager::commitTransaction(ctx);
+  };
+
+  // part of the checkpoint
+  insertRow(one_row);
+  deleteRow(1);
+  // reserved but never committed, stays invisible
+  linxxxs->appendToDelta(1);
+  EXPECT_EQ(2, tx::Checkpoint::create(checkpointDir));
+
+  // part of the log tail
+  txmgr.setRedoLog(std::make_shared<tx::RedoLog>(logFile, txmgr.getLastCommitId()));
+  insertRow(second_row);
+  auto lastCid = deleteRow(2);
+  txmgr.setRedoLog(nullptr);
+
+  const auto expectedPositions = linxxxs->buildValidPositions(lastCid, tx::MERGE_TID);
+  io::StorageManager::getInstance()->removeTable("linxxxs_checkpointed");
+  txmgr.reset();
+
+  EXPECT_EQ(lastCid, tx::Checkpoint::recover(checkpointDir, logFile));
+  EXPECT_EQ(lastCid, txmgr.getLastCommitId());
+  auto recovered = std::dynamic_pointer_cast<storage::Store>(
+      io::StorageManager::getInstance()->getTable("linxxxs_checkpointed"));
+  io::StorageManager::getInstance()->removeTable("linxxxs_checkpointed");
+  boost::filesystem::remove_all(checkpointDir);
+  // the log only holds the replayed commits
+  EXPECT_EQ(2u, tx::RedoLog::read(logFile).size());
+  std::remove(logFile.c_str());
+
+  ASSERT_TRUE(recovered != nullptr);
+  ASSERT_EQ(linxxxs->size(), recovered->size());
+  const auto positions = recovered->buildValidPositions(lastCid, tx::MERGE_TID);
+  ASSERT_EQ(expectedPositions, positions);
+  EXPECT_RELATION_EQ(storage::PointerCalculator::create(linxxxs, new pos_list_t(expectedPositions)),
+                     storage::PointerCalculator::create(recovered, new pos_list_t(positions)));
+  // the recovered main is bit compressed like a merged one
+  for (size_t column = 0; column < recovered->columnCount(); ++column) {
+    const auto vectors = recovered->getMainTable()->getAttributeVectors(column);
+    EXPECT_TRUE(std::dynamic_pointer_cast<storage::BitCompressedVector<value_id_t> >(vectors.front().attribute_vector) != nullptr);
+  }
+}
+
+TEST_F(TransactionTests, recover_rows_merged_online_as_delta_rows) {
+  const std::string checkpointDir = "test/checkpoint_online_test";
+  const std::string logFile = "test/checkpoint_online_test.log";
+  boost::filesystem::remove_all(checkpointDir);
+  std::remove(logFile.c_str());
+  io::StorageManager::getInstance()->loadTable("linxxxs_online", linxxxs);
+  auto& txmgr = tx::TransactionManager::getInstance();
+
+  auto insertRow = [this] (const storage::atable_ptr_t &row, bool commit) {
+    auto ctx = tx::TransactionManager::beginTransaction();
+    InsertScan is;
+    is.setTXContext(ctx);
+    is.addInput(linxxxs);
+    is.setInputData(row);
+    is.execute();
+    if (commit)
+      return tx::TransactionManager::commitTransaction(ctx);
+    tx::TransactionManager::rollbackTransaction(ctx);
+    return ctx.lastCid;
+  };
+
+  insertRow(one_row, true);
+  // the aborted row does not stop the online merge
+  insertRow(second_row, false);
+  insertRow(second_row, true);
+  linxxxs->mergeOnline();
+  ASSERT_EQ(linxxxs->size(), linxxxs->getMainTable()->size());
+  tx::Checkpoint::create(checkpointDir);
+
+  txmgr.setRedoLog(std::make_shared<tx::RedoLog>(logFile, txmgr.getLastCommitId()));
+  auto lastCid = insertRow(one_row, true);
+  txmgr.setRedoLog(nullptr);
+
+  const auto expectedPositions = linxxxs->buildValidPositions(lastCid, tx::MERGE_TID);
+  io::StorageManager::getInstance()->removeTable("linxxxs_online");
+  txmgr.reset();
+
+  EXPECT_EQ(lastCid, tx::Checkpoint::recover(checkpointDir, logFile));
+  auto recovered = std::dynamic_pointer_cast<storage::Store>(
+      io::StorageManager::getInstance()->getTable("linxxxs_online"));
+  io::StorageManager::getInstance()->removeTable("linxxxs_online");
+  boost::filesystem::remove_all(checkpointDir);
+  std::remove(logFile.c_str());
+
+  // the main of the checkpoint ends at the delta of the store
+  ASSERT_TRUE(recovered != nullptr);
+  EXPECT_EQ(linxxxs->deltaOffset(), recovered->deltaOffset());
+  ASSERT_EQ(linxxxs->size(), recovered->size());
+  const auto positions = recovered->buildValidPositions(lastCid, tx::MERGE_TID);
+  ASSERT_EQ(expectedPositions, positions);
+  EXPECT_RELATION_EQ(storage::PointerCalculator::create(linxxxs, new pos_list_t(expectedPositions)),
+                     storage::PointerCalculator::create(recovered, new pos_list_t(positions)));
+}
+
+TEST_F(TransactionTests, recover_merges_logged_after_the_checkpoint) {
+  const std::string checkpointDir = "test/checkpoint_merge_test";
+  const std::string logFile = "test/checkpoint_merge_test.log";
+  boost::filesystem::remove_all(checkpointDir);
+  std::remove(logFile.c_str());
+  io::StorageManager::getInstance()->loadTable("linxxxs_merged", linxxxs);
+  auto& txmgr = tx::TransactionManager::getInstance();
+
+  auto insertRow = [this] (const storage::atable_ptr_t &row) {
+    auto ctx = tx::TransactionManager::beginTransaction();
+    InsertScan is;
+    is.setTXContext(ctx);
+    is.addInput(linxxxs);
+    is.setInputData(row);
+    is.execute();
+    return tx::TransactionManager::commitTransaction(ctx);
+  };
+  auto deleteRow = [this] (pos_t pos) {
+    auto ctx = tx::TransactionManager::beginTransaction();
+    DeleteOp del;
+    del.setTXContext(ctx);
+    del.addInput(storage::PointerCalculator::create(linxxxs, new pos_list_t({pos})));
+    del.execute();
+    return tx::TransactionManager::commitTransaction(ctx);
+  };
+
+  insertRow(one_row);
+  tx::Checkpoint::create(checkpointDir);
+
+  // the merge renumbers the rows between the logged commits
+  txmgr.setRedoLog(std::make_shared<tx::RedoLog>(logFile, txmgr.getLastCommitId()));
+  deleteRow(1);
+  const auto generation = linxxxs->generation();
+  tx::TransactionManager::mergeStore(linxxxs);
+  EXPECT_EQ(generation + 1, linxxxs->generation());
+  insertRow(second_row);
+  auto lastCid = deleteRow(0);
+  txmgr.setRedoLog(nullptr);
+
+  const auto expectedPositions = linxxxs->buildValidPositions(lastCid, tx::MERGE_TID);
+  io::StorageManager::getInstance()->removeTable("linxxxs_merged");
+  txmgr.reset();
+
+  EXPECT_EQ(lastCid, tx::Checkpoint::recover(checkpointDir, logFile));
+  auto recovered = std::dynamic_pointer_cast<storage::Store>(
+      io::StorageManager::getInstance()->getTable("linxxxs_merged"));
+  io::StorageManager::getInstance()->removeTable("linxxxs_merged");
+  boost::filesystem::remove_all(checkpointDir);
+  std::remove(logFile.c_str());
+
+  ASSERT_TRUE(recovered != nullptr);
+  EXPECT_EQ(linxxxs->generation(), recovered->generation());
+  EXPECT_EQ(linxxxs->deltaOffset(), recovered->deltaOffset());
+  ASSERT_EQ(linxxxs->size(), recovered->size());
+  const auto positions = recovered->buildValidPositions(lastCid, tx::MERGE_TID);
+  ASSERT_EQ(expectedPositions, positions);
+  EXPECT_RELATION_EQ(storage::PointerCalculator::create(linxxxs, new pos_list_t(expectedPositions)),
+                     storage::PointerCalculator::create(recovered, new pos_list_t(positions)));
+}
+
+TEST_F(TransactionTests, recover_refuses_changes_after_an_unlogged_merge) {
+  const std::string checkpointDir = "test/checkpoint_unlogged_test";
+  const std::string logFile = "test/checkpoint_unlogged_test.log";
+  boost::filesystem::remove_all(checkpointDir);
+  std::remove(logFile.c_str());
+  io::StorageManager::getInstance()->loadTable("linxxxs_unlogged", linxxxs);
+  auto& txmgr = tx::TransactionManager::getInstance();
+  tx::Checkpoint::create(checkpointDir);
+
+  txmgr.setRedoLog(std::make_shared<tx::RedoLog>(logFile, txmgr.getLastCommitId()));
+  linxxxs->merge();
+  auto ctx = tx::TransactionManager::beginTransaction();
+  InsertScan is;
+  is.setTXContext(ctx);
+  is.addInput(linxxxs);
+  is.setInputData(one_row);
+  is.execute();
+  tx::TransactionManager::commitTransaction(ctx);
+  txmgr.setRedoLog(nullptr);
+
+  io::StorageManager::getInstance()->removeTable("linxxxs_unlogged");
+  txmgr.reset();
+  EXPECT_THROW(tx::Checkpoint::recover(checkpointDir, logFile), std::runtime_error);
+  io::StorageManager::getInstance()->removeTable("linxxxs_unlogged");
+  boost::filesystem::remove_all(checkpointDir);
+  std::remove(logFile.c_str());
+}
+
 }}
@@ -158,5 +158,47 @@ TEST_F(DumpTests, simple_dump_should_not_dump_delta) {
   ASSERT_TABLE_EQUAL(t, simpleTable);
 }
 
+TEST_F(DumpTests, mapped_dump_load_all) {
+  auto dumper = hyrise::storage::MappedTableDump("./test/dump");
+  ASSERT_TRUE(dumper.dump("simple", simpleTable));
+
+  MappedTableDumpLoader input("./test/dump", "simple");
+  CSVHeader header("test/dump/simple/header.dat", CSVHeader::params().setCSVParams(csv::HYRISE_FORMAT));
+  auto t = Loader::load(Loader::params().setInput(input).setHeader(header));
+  ASSERT_EQ(100u, t->size());
+  ASSERT_TABLE_EQUAL(t, simpleTable);
+}
+
+TEST_F(DumpTests, mapped_dump_load_strings_and_floats) {
+  simpleTable = Loader::shortcuts::load("test/tables/hash_table_test_ref.tbl");
+  auto dumper = hyrise::storage::MappedTableDump("./test/dump");
+  ASSERT_TRUE(dumper.dump("mixed", simpleTable));
+
+  MappedTableDumpLoader input("./test/dump", "mixed");
+  CSVHeader header("test/dump/mixed/header.dat", CSVHeader::params().setCSVParams(csv::HYRISE_FORMAT));
+  auto t = Loader::load(Loader::params().setInput(input).setHeader(header));
+  ASSERT_TABLE_EQUAL(t, simpleTable);
+}
+
+TEST_F(DumpTests, mapped_dump_is_not_modified_by_loaded_table) {
+  auto dumper = hyrise::storage::MappedTableDump("./test/dump");
+  ASSERT_TRUE(dumper.dump("simple", simpleTable));
+
+  MappedTableDumpLoader input("./test/dump", "simple");
+  CSVHeader header("test/dump/simple/header.dat", CSVHeader::params().setCSVParams(csv::HYRISE_FORMAT));
+  auto t = std::dynamic_pointer_cast<hyrise::storage::Store>(Loader::load(Loader::params().setInput(input).setHeader(header)));
+  auto main = t->getMainTable();
+  main->setValueId(0, 0, main->getValueId(0, 1));
+  ASSERT_EQ(main->getValueId(0, 1).valueId, main->getValueId(0, 0).valueId);
+
+  // growing copies the mapped data
+  main->resize(1000);
+  ASSERT_EQ(main->getValueId(0, 1).valueId, main->getValueId(0, 0).valueId);
+  ASSERT_EQ(simpleTable->getValueId(9, 99).valueId, main->getValueId(9, 99).valueId);
+
+  auto reloaded = Loader::load(Loader::params().setInput(input).setHeader(header));
+  ASSERT_TABLE_EQUAL(reloaded, simpleTable);
+}
+
 } } // namespace hyrise::io
 
@@ -4,10 +4,13 @@
 #include <io/CSVLoader.h>
 #include <io/EmptyLoader.h>
 #include <io/Loader.h>
+#include <io/ParallelCSVLoader.h>
 #include <io/StringLoader.h>
+#include <io/shortcuts.h>
 
 #include <storage/MutableVerticalTable.h>
 #include <storage/Store.h>
+#include <taskscheduler/SharedScheduler.h>
 
 namespace hyrise {
 namespace io {
@@ -63,6 +66,77 @@ TEST_F(LoaderTests, load_string_header) {
   ASSERT_EQ(4u, t->partitionCount());
 }
 
+TEST_F(LoaderTests, parallel_load_splits_lines_like_libcsv) {
+  const std::string file = "test/tables/parallel_load.tbl";
+  for (size_t threads = 1; threads <= 4; ++threads) {
+    auto t = Loader::load(Loader::params().setHeader(CSVHeader(file)).setReturnsMutableVerticalTable(true));
+    ASSERT_TRUE(parallelLoadCSV(file, csv::params().setLineStart(5), false, t, threads, 1));
+
+    ASSERT_EQ(5u, t->size());
+    const std::vector<hyrise_int_t> ids = {3, 1, 2, -4, 5};
+    const std::vector<hyrise_string_t> names = {"Potsdam", "Berlin", "Potsdam", "", "Berlin"};
+    const std::vector<hyrise_float_t> prices = {1.5f, 2.25f, 0.5f, 3.0f, 1.5f};
+    const std::vector<hyrise_int_t> codes = {-7, 12, 7, 0, 12};
+    for (size_t row = 0; row < t->size(); ++row) {
+      EXPECT_EQ(ids[row], t->getValue<hyrise_int_t>(0, row));
+      EXPECT_EQ(names[row], t->getValue<hyrise_string_t>(1, row));
+      EXPECT_FLOAT_EQ(prices[row], t->getValue<hyrise_float_t>(2, row));
+      EXPECT_EQ(codes[row], t->getValue<hyrise_int_t>(3, row));
+    }
+    EXPECT_TRUE(t->dictionaryAt(1)->isOrdered());
+    EXPECT_EQ(3u, t->dictionaryAt(1)->size());
+    EXPECT_EQ(2u, t->getValueId(1, 0).valueId);
+  }
+}
+
+TEST_F(LoaderTests, parallel_load_on_scheduler_workers) {
+  const std::string file = "test/tables/parallel_load.tbl";
+  auto expected = Loader::load(Loader::params().setHeader(CSVHeader(file)).setReturnsMutableVerticalTable(true));
+  ASSERT_TRUE(parallelLoadCSV(file, csv::params().setLineStart(5), false, expected, 1, 1));
+
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  auto t = Loader::load(Loader::params().setHeader(CSVHeader(file)).setReturnsMutableVerticalTable(true));
+  ASSERT_TRUE(parallelLoadCSV(file, csv::params().setLineStart(5), false, t, 4, 1));
+  ASSERT_TRUE(expected->contentEquals(t));
+}
+
+TEST_F(LoaderTests, parallel_load_leaves_quoted_fields_to_libcsv) {
+  const std::string file = "test/tables/quoted_load.tbl";
+  auto t = Loader::load(Loader::params().setHeader(CSVHeader(file)).setReturnsMutableVerticalTable(true));
+  EXPECT_FALSE(parallelLoadCSV(file, csv::params().setLineStart(5), false, t, 2, 1));
+  EXPECT_EQ(0u, t->size());
+
+  auto loaded = Loader::shortcuts::load(file);
+  ASSERT_EQ(2u, loaded->size());
+  EXPECT_EQ("Hasso|Plattner", loaded->getValue<hyrise_string_t>(0, 0));
+  EXPECT_EQ(2, loaded->getValue<hyrise_int_t>(1, 1));
+}
+
+TEST_F(LoaderTests, only_parallel_loads_leave_a_main) {
+  const std::string file = "test/tables/parallel_load.tbl";
+  CSVInput input(file);
+  auto t = Loader::load(Loader::params().setHeader(CSVHeader(file)).setReturnsMutableVerticalTable(true));
+  input.load(t, nullptr, Loader::params());
+  EXPECT_TRUE(input.loaded_main());
+
+  const std::string quotedFile = "test/tables/quoted_load.tbl";
+  CSVInput quoted(quotedFile);
+  auto q = Loader::load(Loader::params().setHeader(CSVHeader(quotedFile)).setReturnsMutableVerticalTable(true));
+  quoted.load(q, nullptr, Loader::params());
+  EXPECT_FALSE(quoted.loaded_main());
+  EXPECT_EQ(2u, q->size());
+}
+
+TEST_F(LoaderTests, parallel_load_rejects_short_lines) {
+  const std::string file = "test/tables/parallel_load.tbl";
+  StringHeader header("a|b|c|d|e\nINTEGER|STRING|FLOAT|INTEGER|INTEGER\n0_C|0_C|0_C|0_C|0_C");
+  auto t = Loader::load(Loader::params().setHeader(header).setReturnsMutableVerticalTable(true));
+  EXPECT_THROW(parallelLoadCSV(file, csv::params().setLineStart(5), false, t, 2, 1), CSVLoaderError);
+  EXPECT_TRUE(parallelLoadCSV(file, csv::params().setLineStart(5), true, t, 2, 1));
+  EXPECT_EQ(5u, t->size());
+  EXPECT_EQ(0, t->getValue<hyrise_int_t>(4, 0));
+}
+
 hyrise::storage::atable_ptr_t  loadTable() {
   CSVInput input("test/lin_xxs.tbl");
   CSVHeader header("test/lin_xxs.tbl");
@@ -4,7 +4,10 @@
 #include "storage/MutableVerticalTable.h"
 #include "storage/Table.h"
 #include "storage/HorizontalTable.h"
+#include "storage/NumaPlacement.h"
+#include "io/shortcuts.h"
 
+#include "storage/BitCompressedVector.h"
 #include "storage/TableBuilder.h"
 #include "storage/storage_types.h"
 
@@ -43,4 +46,22 @@ TEST(HorizontalTableTests, test_nesting) {
   EXPECT_EQ(3u, nested_ht->getValueId(0, 4).table);
 }
 
+TEST(HorizontalTableTests, place_on_nodes) {
+  auto t = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto placed = placeOnNodes(t, {0, 0, 0});
+  ASSERT_EQ(3u, placed->partCount());
+  EXPECT_EQ(t->size(), placed->size());
+  for (size_t part = 0; part < placed->partCount(); ++part) {
+    EXPECT_TRUE(placed->partNode(part) == 0 || placed->partNode(part) == HorizontalTable::NO_NODE);
+    // every partition has a dictionary of its own
+    EXPECT_NE(t->dictionaryAt(1), placed->part(part)->dictionaryAt(1));
+    const auto vectors = placed->part(part)->getAttributeVectors(0);
+    EXPECT_TRUE(std::dynamic_pointer_cast<BitCompressedVector<value_id_t>>(vectors.front().attribute_vector) != nullptr);
+  }
+  for (size_t row = 0; row < t->size(); ++row) {
+    EXPECT_EQ(t->getValue<hyrise_int_t>(0, row), placed->getValue<hyrise_int_t>(0, row));
+    EXPECT_EQ(t->getValue<hyrise_string_t>(1, row), placed->getValue<hyrise_string_t>(1, row));
+  }
+}
+
 }}
@@ -37,6 +37,38 @@ TEST(BitCompressedTests, empty_size_does_not_change_with_reserve) {
   ASSERT_EQ(128u, tuples.capacity());
 }
 
+TEST(BitCompressedTests, bulk_scan_matches_get) {
+  std::vector<uint64_t> bits {3, 17, 1, 32};
+  size_t rows = 333;
+  BitCompressedVector<value_id_t> tuples(bits.size(), rows, bits);
+  tuples.resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    for (size_t col = 0; col < bits.size(); ++col)
+      tuples.set(col, row, (row * 2654435761u + col) & maxValueForBits<value_id_t>(bits[col]));
+
+  for (size_t col = 0; col < bits.size(); ++col) {
+    auto range = bitunpacking::ValueIdRange::between(1, maxValueForBits<value_id_t>(bits[col]) / 2);
+    for (const auto& r : {range, range.negate(), bitunpacking::ValueIdRange::equals(1)}) {
+      pos_list_t positions, expected;
+      tuples.scan(col, 5, rows, r, positions);
+      for (size_t row = 5; row < rows; ++row)
+        if (r.matches(tuples.get(col, row)))
+          expected.push_back(row);
+      ASSERT_EQ(expected, positions) << "column " << col;
+
+      std::vector<uint64_t> bitmap;
+      tuples.scanBitmap(col, 5, rows, r, bitmap);
+      for (size_t i = 0; i < expected.size(); ++i)
+        ASSERT_TRUE((bitmap[(expected[i] - 5) / 64] >> ((expected[i] - 5) % 64)) & 1);
+    }
+
+    std::vector<value_id_t> decoded(rows - 7);
+    tuples.decode(col, 7, rows, decoded.data());
+    for (size_t row = 7; row < rows; ++row)
+      ASSERT_EQ(tuples.get(col, row), decoded[row - 7]);
+  }
+}
+
 TEST(FixedLengthVectorTest, increment_test) {
   size_t cols = 1;
   size_t rows = 3;
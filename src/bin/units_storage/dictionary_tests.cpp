@@ -1,6 +1,10 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "testing/test.h"
 
+#include <thread>
+
+#include "storage/ConcurrentUnorderedDictionary.h"
+#include "storage/FrontCodedDictionary.h"
 #include "storage/OrderIndifferentDictionary.h"
 #include "storage/OrderPreservingDictionary.h"
 #include "storage/PassThroughDictionary.h"
@@ -158,5 +162,108 @@ TEST_F(DictionaryTest, order_preserving_string_exists) {
 
 }
 
+TEST_F(DictionaryTest, front_coded_strings) {
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 1000; ++i)
+    values.push_back("customer_" + std::to_string(100000 + 2 * i));
+  values.push_back(std::string(300, 'z'));
+
+  FrontCodedDictionary dict;
+  for (const auto &value : values)
+    dict.addValue(value);
+  ASSERT_EQ(values.size(), dict.size());
+  // shared prefixes are stored once per block
+  EXPECT_LT(dict.encodedSize(), 1000u * 6);
+
+  std::string decoded;
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], dict.getValueForValueId(i));
+    dict.decodeValue(i, decoded);
+    EXPECT_EQ(values[i], decoded);
+    EXPECT_EQ(i, dict.getValueIdForValue(values[i]));
+    EXPECT_TRUE(dict.valueExists(values[i]));
+  }
+
+  size_t index = 0;
+  for (auto it = dict.begin(); it != dict.end(); ++it, ++index) {
+    EXPECT_EQ(values[index], *it);
+    EXPECT_EQ(index, it.getValueId());
+  }
+  EXPECT_EQ(values.size(), index);
+
+  // values between and around the stored ones
+  for (size_t i = 0; i < 1000; ++i) {
+    const std::string between = "customer_" + std::to_string(100000 + 2 * i + 1);
+    EXPECT_FALSE(dict.valueExists(between));
+    EXPECT_EQ(i + 1, dict.getValueIdForValue(between));
+    EXPECT_EQ(i, dict.getValueIdForValueSmaller(between));
+    EXPECT_EQ(i + 1, dict.getValueIdForValueGreater(between));
+  }
+  EXPECT_EQ(0u, dict.getValueIdForValue("a"));
+  EXPECT_FALSE(dict.valueExists("a"));
+  EXPECT_EQ(values.size(), dict.getValueIdForValue("zzzzzzzzzzzzzz" + std::string(300, 'z')));
+  EXPECT_EQ(16u, dict.getValueIdForValueGreater(values[15]));
+  EXPECT_EQ(values.front(), dict.getSmallestValue());
+  EXPECT_EQ(values.back(), dict.getGreatestValue());
+
+  auto copy = std::dynamic_pointer_cast<FrontCodedDictionary>(dict.copy());
+  EXPECT_EQ(values[500], copy->getValueForValueId(500));
+
+  // front coding a sorted dictionary keeps the value ids
+  OrderPreservingDictionary<std::string> sorted;
+  for (const auto &value : values)
+    sorted.addValue(value);
+  auto encoded = FrontCodedDictionary::encode(sorted);
+  ASSERT_EQ(values.size(), encoded->size());
+  EXPECT_EQ(values[500], encoded->getValueForValueId(500));
+  EXPECT_EQ(dict.encodedSize(), encoded->encodedSize());
+}
+
+TEST_F(DictionaryTest, front_coded_strings_decode_into_a_reused_value) {
+  // prefixes that grow and shrink within a block
+  const std::vector<std::string> values {"", "a", "abcdef", "abcx", "abd", "b", "babble", "babel", "bz",
+                                         "c", "ca", "cab", "cabin", "d", "dd", "ddd", "dddd", "e"};
+  FrontCodedDictionary dict;
+  for (const auto &value : values)
+    dict.addValue(value);
+
+  std::string decoded = "a previous value longer than the others";
+  for (size_t i = values.size(); i-- > 0; ) {
+    dict.decodeValue(i, decoded);
+    EXPECT_EQ(values[i], decoded);
+  }
+}
+
+TEST_F(DictionaryTest, concurrent_repeated_values_are_not_appended) {
+  ConcurrentUnorderedDictionary<std::string> dict;
+  const std::vector<std::string> codes {"DE", "FR", "US", "JP", "BR"};
+  for (const auto &code : codes)
+    dict.addValue(code);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&dict, &codes] () {
+      for (size_t i = 0; i < 1000; ++i)
+        dict.addValue(codes[i % codes.size()]);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(codes.size(), dict.size());
+  for (size_t i = 0; i < codes.size(); ++i)
+    EXPECT_EQ(i, dict.getValueIdForValue(codes[i]));
+
+  // sorted extraction yields every value once
+  std::vector<std::string> sorted(codes);
+  std::sort(sorted.begin(), sorted.end());
+  size_t index = 0;
+  for (auto it = dict.begin(); it != dict.end(); ++it, ++index) {
+    EXPECT_EQ(sorted[index], *it);
+    EXPECT_EQ(dict.getValueIdForValue(*it), it.getValueId());
+  }
+  EXPECT_EQ(codes.size(), index);
+}
+
 } } // namepsace hyrise::storage
 
@@ -200,5 +200,55 @@ TYPED_TEST(HashTableViewTest, partial_range) {
   }
 }
 
+TEST(CompositeKeyTest, inline_and_heap_keys) {
+  aggregate_key_t small {1, 2, 3};
+  aggregate_key_t large {1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(3u, small.size());
+  EXPECT_EQ(6u, large.size());
+  EXPECT_EQ(6u, large[5]);
+
+  aggregate_key_t copy = large;
+  EXPECT_TRUE(copy == large);
+  copy = small;
+  EXPECT_TRUE(copy == small);
+  EXPECT_FALSE(copy == large);
+  EXPECT_TRUE(small < large);
+}
+
+TEST(FlatHashMultimapTest, groups_positions_by_key) {
+  aggregate_hash_map_t map;
+  const size_t keys = 1000;
+  for (pos_t pos = 0; pos < 3 * keys; ++pos)
+    map.insert(aggregate_key_t {static_cast<value_id_t>(pos % keys), 7}, pos);
+
+  EXPECT_EQ(3 * keys, map.size());
+  EXPECT_EQ(keys, map.key_count());
+  EXPECT_LE(map.load_factor(), map.max_load_factor());
+
+  pos_list_t positions;
+  EXPECT_EQ(3u, map.copy_positions(aggregate_key_t {42, 7}, positions));
+  EXPECT_EQ((pos_list_t {42 + 2 * keys, 42 + keys, 42}), positions);
+  EXPECT_EQ(0u, map.copy_positions(aggregate_key_t {42, 8}, positions));
+
+  auto range = map.equal_range(aggregate_key_t {42, 7});
+  EXPECT_EQ(3, std::distance(range.first, range.second));
+  range = map.equal_range(aggregate_key_t {static_cast<value_id_t>(keys), 7});
+  EXPECT_TRUE(range.first == map.end() && range.second == map.end());
+
+  // all positions of a key are adjacent
+  size_t groups = 0;
+  for (auto it1 = map.begin(), it2 = it1; it1 != map.end(); it1 = it2, ++groups) {
+    for (; it2 != map.end() && it1->first == it2->first; ++it2) {
+      EXPECT_EQ(it1->first[0], it2->second % keys);
+    }
+  }
+  EXPECT_EQ(keys, groups);
+
+  size_t positionsInBuckets = 0;
+  for (size_t bucket = 0; bucket < map.bucket_count(); ++bucket)
+    positionsInBuckets += std::distance(map.begin(bucket), map.end(bucket));
+  EXPECT_EQ(map.size(), positionsInBuckets);
+}
+
 } } // namespace hyrise::storage
 
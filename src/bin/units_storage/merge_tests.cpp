@@ -9,9 +9,12 @@
 #include "io/shortcuts.h"
 
 #include "storage/AbstractTable.h"
+#include "storage/ParallelHeapMerger.h"
 #include "storage/Store.h"
 #include "storage/TableGenerator.h"
 
+#include "taskscheduler/SharedScheduler.h"
+
 #include "helper/types.h"
 #include "helper/vector_helpers.h"
 
@@ -198,7 +201,7 @@ TEST_F(MergeTests, sequential_heap_merger_delta_test) {
 
 }
 
-TEST_F(MergeTests, DISABLED_parallel_heap_merger_delta_test) {
+TEST_F(MergeTests, parallel_heap_merger_delta_test) {
   TableGenerator g(true);
   hyrise::storage::atable_ptr_t main1 = g.int_random(1000, 1);
   hyrise::storage::atable_ptr_t main2 = g.int_random(1000, 1);
@@ -225,7 +228,7 @@ TEST_F(MergeTests, DISABLED_parallel_heap_merger_delta_test) {
   TableMerger merger1(new DefaultMergeStrategy(), new SequentialHeapMerger());
   const auto& result_1 = merger1.merge(tables1);
 
-  TableMerger merger2(new DefaultMergeStrategy(), new SequentialHeapMerger());
+  TableMerger merger2(new DefaultMergeStrategy(), new ParallelHeapMerger(4));
   const auto& result_2 = merger2.merge(tables2);
 
   ASSERT_TRUE(result_1[0]->contentEquals(result_2[0]));
@@ -248,13 +251,13 @@ TEST_F(MergeTests, simple_logarithmic_merger_test) {
 
 }
 
-TEST_F(MergeTests, DISABLED_parallel_value_merger_test) {
+TEST_F(MergeTests, parallel_value_merger_test) {
   auto m = io::Loader::shortcuts::loadMainDelta("test/merge1_main.tbl", "test/merge1_delta.tbl", io::Loader::params().setCompressed(false));
   std::vector<hyrise::storage::c_atable_ptr_t > tables;
   tables.push_back(m->getMainTable());
   tables.push_back(m->getDeltaTable());
 
-  TableMerger merger(new DefaultMergeStrategy(), new SequentialHeapMerger());
+  TableMerger merger(new DefaultMergeStrategy(), new ParallelHeapMerger(4));
 
   const auto& result = merger.merge(tables);
 
@@ -266,6 +269,39 @@ TEST_F(MergeTests, DISABLED_parallel_value_merger_test) {
 
 }
 
+TEST_F(MergeTests, parallel_heap_merger_row_ranges_test) {
+  // more rows than fit into one range, merged into bit compressed tables
+  TableGenerator g(true);
+  std::vector<hyrise::storage::c_atable_ptr_t> tables {g.int_random(150000, 3), g.int_random(100000, 3)};
+  std::vector<bool> valid(250000);
+  for (size_t i = 0; i < valid.size(); ++i)
+    valid[i] = i % 3 != 0;
+
+  TableMerger sequential(new DefaultMergeStrategy(), new SequentialHeapMerger());
+  TableMerger parallel(new DefaultMergeStrategy(), new ParallelHeapMerger(4));
+  const auto& expected = sequential.merge(tables, true, valid);
+  const auto& result = parallel.merge(tables, true, valid);
+
+  ASSERT_EQ(expected[0]->size(), result[0]->size());
+  ASSERT_TRUE(expected[0]->contentEquals(result[0]));
+}
+
+// Without a number of parts the merger splits the work by the workers
+// of the shared scheduler and runs it in their tasks
+TEST_F(MergeTests, parallel_heap_merger_on_scheduler_workers) {
+  taskscheduler::SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  TableGenerator g(true);
+  std::vector<hyrise::storage::c_atable_ptr_t> tables {g.int_random(150000, 3), g.int_random(100000, 3)};
+
+  TableMerger sequential(new DefaultMergeStrategy(), new SequentialHeapMerger());
+  TableMerger parallel(new DefaultMergeStrategy(), new ParallelHeapMerger());
+  const auto& expected = sequential.merge(tables);
+  const auto& result = parallel.merge(tables);
+
+  ASSERT_EQ(expected[0]->size(), result[0]->size());
+  ASSERT_TRUE(expected[0]->contentEquals(result[0]));
+}
+
 TEST_F(MergeTests, merge_with_different_layout) {
   auto main = io::Loader::shortcuts::load("test/merge1_main.tbl");
   auto delta = io::Loader::shortcuts::load("test/merge1_delta.tbl"); //, io::Loader::params().set_modifiable(true));
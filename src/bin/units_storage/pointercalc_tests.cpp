@@ -100,5 +100,27 @@ TEST_F(PointerCalcTests, pc_on_selected_columns) {
   ASSERT_TRUE(pc->metadataAt(3).matches(t->metadataAt(7)));
 }
 
+TEST_F(PointerCalcTests, pc_with_compressed_positions) {
+  atable_ptr_t t = io::Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  auto range = PointerCalculator::create(t, PositionSet::range(10, 60));
+  auto even = PointerCalculator::create(t, PositionSet::fromSorted({0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20}));
+  ASSERT_EQ(50u, range->size());
+  ASSERT_EQ(11u, even->size());
+  EXPECT_EQ(t->getValueId(1, 12).valueId, range->getValueId(1, 2).valueId);
+  EXPECT_EQ(t->getValueId(1, 18).valueId, even->getValueId(1, 9).valueId);
+
+  auto both = range->intersect(even);
+  EXPECT_EQ(PositionSet::BITMAP, both->getPositionSet().kind());
+  pos_list_t visited;
+  both->forEachPosition([&visited] (pos_t pos) { visited.push_back(pos); });
+  EXPECT_EQ((pos_list_t {10, 12, 14, 16, 18, 20}), visited);
+  EXPECT_EQ(visited, *both->getPositions());
+
+  auto all = range->unite(even);
+  EXPECT_EQ(PositionSet::BITMAP, all->getPositionSet().kind());
+  EXPECT_EQ(55u, all->size());
+}
+
 } } // namespace hyrise::storage
 
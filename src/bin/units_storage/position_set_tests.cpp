@@ -0,0 +1,85 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "storage/PositionSet.h"
+
+namespace hyrise {
+namespace storage {
+
+pos_list_t every(size_t step, pos_t first, pos_t last) {
+  pos_list_t result;
+  for (pos_t pos = first; pos < last; pos += step)
+    result.push_back(pos);
+  return result;
+}
+
+TEST(PositionSetTests, representation_follows_density) {
+  EXPECT_EQ(PositionSet::RANGE, PositionSet::fromSorted(every(1, 10, 1000)).kind());
+  EXPECT_EQ(PositionSet::BITMAP, PositionSet::fromSorted(every(2, 10, 1000)).kind());
+  EXPECT_EQ(PositionSet::BITMAP, PositionSet::fromSorted(every(64, 10, 100000)).kind());
+  EXPECT_EQ(PositionSet::LIST, PositionSet::fromSorted(every(65, 10, 100000)).kind());
+
+  auto dense = PositionSet::fromSorted(every(2, 0, 1 << 20));
+  EXPECT_EQ(1u << 19, dense.size());
+  // the bitmap and a count of set bits for every 8 of its words
+  EXPECT_EQ((1u << 20) / 8 + (1u << 20) / 512 * sizeof(size_t), dense.memorySize());
+  EXPECT_EQ(every(2, 0, 1 << 20), dense.materialize());
+  EXPECT_TRUE(dense.contains(1000));
+  EXPECT_FALSE(dense.contains(1001));
+}
+
+TEST(PositionSetTests, intersect_matches_lists) {
+  const std::vector<pos_list_t> lists {
+    every(1, 100, 5000), every(2, 0, 6000), every(3, 7, 4000), every(100, 50, 10000), {}
+  };
+  for (const auto& left : lists) {
+    for (const auto& right : lists) {
+      pos_list_t expected;
+      std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+      auto result = PositionSet::fromSorted(left).intersect(PositionSet::fromSorted(right));
+      EXPECT_EQ(expected.size(), result.size());
+      EXPECT_EQ(expected, result.materialize());
+    }
+  }
+}
+
+TEST(PositionSetTests, unite_matches_lists) {
+  const std::vector<pos_list_t> lists {
+    every(1, 100, 5000), every(1, 4000, 8000), every(2, 1, 6000), every(3, 7, 4000), every(100, 50, 10000), {}
+  };
+  for (const auto& left : lists) {
+    for (const auto& right : lists) {
+      pos_list_t expected;
+      std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+      auto result = PositionSet::fromSorted(left).unite(PositionSet::fromSorted(right));
+      EXPECT_EQ(expected.size(), result.size());
+      EXPECT_EQ(expected, result.materialize());
+    }
+  }
+}
+
+TEST(PositionSetTests, sparse_results_become_lists) {
+  auto odd = PositionSet::fromSorted(every(2, 1, 100000));
+  auto fewEven = PositionSet::fromSorted(every(1000, 0, 100000));
+  auto both = odd.unite(fewEven).intersect(PositionSet::fromSorted(every(2, 0, 100000)));
+  EXPECT_EQ(PositionSet::LIST, both.kind());
+  EXPECT_EQ(every(1000, 0, 100000), both.materialize());
+}
+
+TEST(PositionSetTests, at_finds_positions_without_materializing) {
+  for (const auto& positions : {every(1, 10, 1000), every(3, 7, 40000), every(64, 10, 100000), every(65, 10, 100000)}) {
+    auto set = PositionSet::fromSorted(positions);
+    for (size_t i = 0; i < positions.size(); ++i)
+      ASSERT_EQ(positions[i], set.at(i)) << i;
+  }
+}
+
+TEST(PositionSetTests, bitmaps_need_an_aligned_base) {
+  EXPECT_THROW(PositionSet::fromBitmap(10, {0x5}), std::runtime_error);
+  EXPECT_EQ(pos_list_t({128, 130}), PositionSet::fromBitmap(128, {0x5}).materialize());
+}
+
+} } // namespace hyrise::storage
@@ -1,6 +1,13 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "testing/test.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "helper/Epochs.h"
+#include "io/shortcuts.h"
+#include "storage/ConcurrentFixedLengthVector.h"
 #include "storage/Store.h"
 #include "storage/TableGenerator.h"
 
@@ -35,5 +42,188 @@ TEST_F(StoreTests, test_write_through_fail) {
 #endif
 }
 
+TEST_F(StoreTests, merge_online_merges_committed_rows_and_keeps_positions) {
+  auto s = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/lin_xxxs.tbl"));
+  const size_t mainSize = s->getMainTable()->size();
+
+  auto area = s->appendToDelta(3);
+  for (size_t i = area.first; i < area.second; ++i) {
+    s->copyRowToDelta(s, 0, i, tx::START_TID + 1);
+    s->setValue<hyrise_int_t>(1, s->deltaOffset() + i, 100 + i);
+  }
+  // the third row is not committed yet
+  s->commitPositions({mainSize, mainSize + 1}, tx::UNKNOWN_CID, true);
+
+  s->mergeOnline();
+  ASSERT_EQ(mainSize + 2, s->getMainTable()->size());
+  ASSERT_EQ(mainSize + 3, s->size());
+  ASSERT_EQ(mainSize, s->deltaOffset());
+  ASSERT_EQ(1u, s->getUnmergedDelta()->size());
+  for (size_t i = 0; i < 3; ++i)
+    ASSERT_EQ(100 + i, s->getValue<hyrise_int_t>(1, mainSize + i));
+
+  s->commitPositions({mainSize + 2}, tx::UNKNOWN_CID, true);
+  const auto generation = s->generation();
+  s->mergeOnline();
+  ASSERT_EQ(mainSize + 3, s->getMainTable()->size());
+  ASSERT_EQ(0u, s->getUnmergedDelta()->size());
+  EXPECT_EQ(generation, s->generation());
+
+  // a regular merge compacts the delta and renumbers the rows
+  s->merge();
+  EXPECT_EQ(generation + 1, s->generation());
+  ASSERT_EQ(mainSize + 3, s->size());
+  ASSERT_EQ(mainSize + 3, s->deltaOffset());
+  ASSERT_EQ(0u, s->getDeltaTable()->size());
+  ASSERT_EQ(102, s->getValue<hyrise_int_t>(1, mainSize + 2));
+}
+
+TEST_F(StoreTests, merge_online_passes_over_dead_rows) {
+  auto s = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/lin_xxxs.tbl"));
+  const size_t mainSize = s->getMainTable()->size();
+
+  auto area = s->appendToDelta(4);
+  for (size_t i = area.first; i < area.second; ++i)
+    s->copyRowToDelta(s, 0, i, tx::START_TID + 1);
+  s->commitPositions({mainSize, mainSize + 2}, tx::UNKNOWN_CID, true);
+  // the second row was inserted by an aborted transaction, the fourth
+  // row is still held by a running one
+  s->abortPositions({mainSize + 1});
+  EXPECT_FALSE(s->isVisibleForTransaction(mainSize + 1, tx::UNKNOWN_CID, tx::START_TID + 1));
+
+  s->mergeOnline();
+  ASSERT_EQ(mainSize + 3, s->getMainTable()->size());
+  ASSERT_EQ(1u, s->getUnmergedDelta()->size());
+  const auto valid = s->buildValidPositions(tx::UNKNOWN_CID, tx::MERGE_TID);
+  EXPECT_TRUE(std::find(valid.begin(), valid.end(), mainSize + 1) == valid.end());
+  EXPECT_TRUE(std::find(valid.begin(), valid.end(), mainSize + 2) != valid.end());
+
+  // the regular merge drops the dead row
+  s->abortUncommitted();
+  s->merge();
+  ASSERT_EQ(mainSize + 2, s->size());
+}
+
+TEST_F(StoreTests, pinned_epochs_keep_reading_their_main) {
+  auto s = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/lin_xxxs.tbl"));
+  const size_t mainSize = s->size();
+  auto insertAndMerge = [&] () {
+    auto area = s->appendToDelta(1);
+    s->copyRowToDelta(s, 0, area.first, tx::START_TID + 1);
+    s->commitPositions({mainSize + area.first}, tx::UNKNOWN_CID, true);
+    s->mergeOnline();
+  };
+
+  std::weak_ptr<AbstractTable> first;
+  {
+    EpochGuard pin;
+    first = s->getMainTable();
+    const auto& dictionary = s->dictionaryAt(1, 0);
+    const auto firstId = s->getValueId(1, 0).valueId;
+    for (size_t i = 0; i < 2; ++i)
+      insertAndMerge();
+
+    // the pinned epoch reads the first main and the rows merged into the
+    // newer ones from the delta
+    EXPECT_EQ(first.lock(), s->getMainTable());
+    EXPECT_EQ(firstId, s->getValueId(1, 0).valueId);
+    EXPECT_EQ(s->getValue<hyrise_int_t>(1, 0), std::static_pointer_cast<BaseDictionary<hyrise_int_t> >(dictionary)->getValueForValueId(firstId));
+    EXPECT_EQ(s->getValue<hyrise_int_t>(1, 0), s->getValue<hyrise_int_t>(1, mainSize + 1));
+    EXPECT_EQ(1u, s->getValueId(1, mainSize).table);
+  }
+
+  ASSERT_EQ(mainSize + 2, s->getMainTable()->size());
+  EXPECT_EQ(0u, s->getValueId(1, mainSize).table);
+  // the next merge frees the mains no epoch reads any more
+  insertAndMerge();
+  EXPECT_TRUE(first.expired());
+  ASSERT_EQ(mainSize + 3, s->getMainTable()->size());
+}
+
+TEST_F(StoreTests, merge_online_releases_merged_delta_rows) {
+  auto s = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/lin_xxxs.tbl"));
+  const size_t mainSize = s->size();
+  const size_t rows = 3 * ConcurrentFixedLengthVector<value_id_t>::CHUNK_ROWS;
+  auto area = s->appendToDelta(rows);
+  pos_list_t positions;
+  for (size_t row = area.first; row < area.second; ++row) {
+    s->copyRowToDelta(s, 0, row, tx::START_TID + 1);
+    s->setValue<hyrise_int_t>(1, mainSize + row, row);
+    positions.push_back(mainSize + row);
+  }
+  s->commitPositions(positions, tx::UNKNOWN_CID, true);
+
+  {
+    EpochGuard pin;
+    s->mergeOnline();
+    // the merged rows are read from the delta until the epoch ends
+    for (size_t row = 0; row < rows; ++row)
+      ASSERT_EQ(static_cast<hyrise_int_t>(row), s->getValue<hyrise_int_t>(1, mainSize + row));
+  }
+
+  area = s->appendToDelta(1);
+  s->copyRowToDelta(s, 0, area.first, tx::START_TID + 1);
+  s->commitPositions({mainSize + area.first}, tx::UNKNOWN_CID, true);
+  s->mergeOnline();
+  ASSERT_EQ(mainSize + rows + 1, s->getMainTable()->size());
+  for (size_t row = 0; row < rows; ++row)
+    ASSERT_EQ(static_cast<hyrise_int_t>(row), s->getValue<hyrise_int_t>(1, mainSize + row));
+}
+
+TEST_F(StoreTests, merge_online_during_inserts) {
+  auto s = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/lin_xxxs.tbl"));
+  const size_t mainSize = s->size();
+  const size_t rows = 2000;
+
+  std::atomic<bool> done(false);
+  std::thread writer([&] () {
+      for (size_t i = 0; i < rows; ++i) {
+        // each insert reads one main, as an operation would
+        EpochGuard pin;
+        auto area = s->appendToDelta(1);
+        s->copyRowToDelta(s, 0, area.first, tx::START_TID + 1);
+        s->setValue<hyrise_int_t>(1, s->deltaOffset() + area.first, i);
+        s->commitPositions({s->deltaOffset() + area.first}, tx::UNKNOWN_CID, true);
+      }
+      done = true;
+    });
+  while (!done)
+    s->mergeOnline();
+  writer.join();
+  s->mergeOnline();
+
+  ASSERT_EQ(mainSize + rows, s->getMainTable()->size());
+  for (size_t i = 0; i < rows; ++i)
+    ASSERT_EQ(static_cast<hyrise_int_t>(i), s->getValue<hyrise_int_t>(1, mainSize + i));
+}
+
+TEST_F(StoreTests, append_rows_to_delta_encodes_batches) {
+  auto s = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/tables/companies.tbl"));
+  const size_t mainSize = s->size();
+  const size_t rows = 100;
+  auto batch = s->copy_structure_modifiable();
+  batch->resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    batch->copyRowFrom(s, row % 3, row, true);
+
+  auto area = s->appendRowsToDelta(batch, tx::START_TID + 1);
+  ASSERT_EQ(0u, area.first);
+  ASSERT_EQ(rows, area.second);
+  ASSERT_EQ(mainSize + rows, s->size());
+  // every distinct value is added to the delta dictionary once
+  EXPECT_EQ(3u, s->getDeltaTable()->dictionaryAt(1)->size());
+  for (size_t row = 0; row < rows; ++row) {
+    EXPECT_EQ(s->getValue<hyrise_int_t>(0, row % 3), s->getValue<hyrise_int_t>(0, mainSize + row));
+    EXPECT_EQ(s->getValue<hyrise_string_t>(1, row % 3), s->getValue<hyrise_string_t>(1, mainSize + row));
+    EXPECT_EQ(tx::START_TID + 1, s->tid(mainSize + row));
+  }
+
+  // rows of a store are copied one by one
+  area = s->appendRowsToDelta(s, tx::START_TID + 2);
+  ASSERT_EQ(mainSize + rows, area.second - area.first);
+  for (size_t row = 0; row < mainSize + rows; ++row)
+    EXPECT_EQ(s->getValue<hyrise_string_t>(1, row), s->getValue<hyrise_string_t>(1, mainSize + area.first + row));
+}
+
 }
 }
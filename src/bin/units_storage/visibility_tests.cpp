@@ -3,6 +3,7 @@
 #include "helper.h"
 
 #include <algorithm>
+#include <numeric>
 
 #include <io/shortcuts.h>
 #include <storage/Store.h>
@@ -10,6 +11,7 @@
 #include <storage/TableBuilder.h>
 #include <helper/types.h>
 #include <io/TransactionManager.h>
+#include <helper/parallel_sort.hpp>
 
 #include <testing/TableEqualityTest.h>
 
@@ -174,4 +176,138 @@ TEST_F (VisibilityTests, read_writes_after_commit_old_cid) {
 	EXPECT_RELATION_EQ(io::Loader::shortcuts::load("test/lin_xxxs.tbl"), r);
 }
 
+TEST_F (VisibilityTests, block_summaries_follow_modifications) {
+	TableBuilder::param_list list;
+	list.append().set_type("INTEGER").set_name("a");
+	auto main = TableBuilder::build(list);
+	main->resize(10);
+	for (size_t row = 0; row < main->size(); ++row)
+		main->setValue<hyrise_int_t>(0, row, row);
+	auto store = std::make_shared<Store>(main);
+	store->merge();
+
+	auto& txmgr = hyrise::tx::TransactionManager::getInstance();
+	auto expectVisible = [&store] (tx::transaction_cid_t lc, tx::transaction_id_t tid) {
+		pos_list_t expected;
+		for (pos_t pos = 0; pos < store->size(); ++pos)
+			if (store->isVisibleForTransaction(pos, lc, tid))
+				expected.push_back(pos);
+		ASSERT_EQ(expected, store->buildValidPositions(lc, tid));
+	};
+
+	// fill more than two blocks of the delta
+	const size_t offset = store->deltaOffset();
+	const size_t rows = 2 * Store::VISIBILITY_BLOCK_SIZE + 100;
+	auto ctx_insert = txmgr.buildContext();
+	store->appendToDelta(rows);
+	pos_list_t inserted(rows);
+	std::iota(inserted.begin(), inserted.end(), offset);
+	store->commitPositions(inserted, txmgr.prepareCommit(), true);
+	txmgr.commit(ctx_insert.tid);
+
+	auto ctx_a = txmgr.buildContext();
+	ASSERT_FALSE(store->isBlockVisibleForTransaction(offset, ctx_a.lastCid, ctx_a.tid)) << "blocks are summarized lazily";
+	expectVisible(ctx_a.lastCid, ctx_a.tid);
+	EXPECT_TRUE(store->isBlockVisibleForTransaction(offset, ctx_a.lastCid, ctx_a.tid));
+	EXPECT_TRUE(store->isBlockVisibleForTransaction(offset + Store::VISIBILITY_BLOCK_SIZE, ctx_a.lastCid, ctx_a.tid));
+	EXPECT_FALSE(store->isBlockVisibleForTransaction(offset + rows - 1, ctx_a.lastCid, ctx_a.tid)) << "the last block is not full";
+	EXPECT_FALSE(store->isBlockVisibleForTransaction(offset, ctx_insert.lastCid, ctx_a.tid)) << "the block was inserted later";
+
+	// delete a row of the second block and insert another row
+	const pos_t deleted = offset + Store::VISIBILITY_BLOCK_SIZE + 5;
+	ASSERT_EQ(tx::TX_CODE::TX_OK, store->markForDeletion(deleted, ctx_a.tid));
+	EXPECT_FALSE(store->isBlockVisibleForTransaction(deleted, ctx_a.lastCid, ctx_a.tid));
+	EXPECT_TRUE(store->isBlockVisibleForTransaction(offset, ctx_a.lastCid, ctx_a.tid));
+	auto row = TableBuilder::build(list);
+	row->resize(1);
+	row->setValue<hyrise_int_t>(0, 0, 42);
+	store->appendToDelta(1);
+	store->copyRowToDelta(row, 0, rows, ctx_a.tid);
+
+	auto ctx_b = txmgr.buildContext();
+	expectVisible(ctx_a.lastCid, ctx_a.tid);
+	expectVisible(ctx_b.lastCid, ctx_b.tid);
+
+	auto cid = txmgr.prepareCommit();
+	store->commitPositions({deleted}, cid, false);
+	store->commitPositions({offset + rows}, cid, true);
+	txmgr.commit(ctx_a.tid);
+
+	auto ctx_c = txmgr.buildContext();
+	expectVisible(ctx_b.lastCid, ctx_b.tid);
+	expectVisible(ctx_c.lastCid, ctx_c.tid);
+	EXPECT_EQ(store->size() - 1, store->buildValidPositions(ctx_c.lastCid, ctx_c.tid).size());
+	EXPECT_FALSE(store->isBlockVisibleForTransaction(deleted, ctx_c.lastCid, ctx_c.tid));
+	EXPECT_TRUE(store->isBlockVisibleForTransaction(offset, ctx_c.lastCid, ctx_c.tid));
+
+	pos_list_t positions = {0, offset, deleted - 1, deleted, offset + rows};
+	store->validatePositions(positions, ctx_c.lastCid, ctx_c.tid);
+	EXPECT_EQ((pos_list_t {0, offset, deleted - 1, offset + rows}), positions);
+}
+
+TEST_F (VisibilityTests, main_rows_keep_versions_only_if_modified) {
+	auto& txmgr = hyrise::tx::TransactionManager::getInstance();
+	auto ctx_a = txmgr.buildContext();
+	auto ctx_b = txmgr.buildContext();
+	const auto rows = linxxxs->size();
+	ASSERT_EQ(rows, linxxxs->deltaOffset());
+	EXPECT_EQ(rows, linxxxs->buildValidPositions(ctx_a.lastCid, ctx_a.tid).size());
+	EXPECT_TRUE(linxxxs->isBlockVisibleForTransaction(0, ctx_a.lastCid, ctx_a.tid));
+
+	// a locked row is invisible for its own transaction only
+	ASSERT_EQ(tx::TX_CODE::TX_OK, linxxxs->markForDeletion(1, ctx_a.tid));
+	EXPECT_EQ(tx::TX_CODE::TX_FAIL_CONCURRENT_COMMIT, linxxxs->markForDeletion(1, ctx_b.tid));
+	EXPECT_EQ(ctx_a.tid, linxxxs->tid(1));
+	EXPECT_FALSE(linxxxs->isBlockVisibleForTransaction(0, ctx_a.lastCid, ctx_a.tid));
+	EXPECT_EQ(rows - 1, linxxxs->buildValidPositions(ctx_a.lastCid, ctx_a.tid).size());
+	EXPECT_EQ(rows, linxxxs->buildValidPositions(ctx_b.lastCid, ctx_b.tid).size());
+
+	// unlocking restores the unmodified version
+	linxxxs->unmarkForDeletion({1}, ctx_a.tid);
+	EXPECT_EQ(tx::START_TID, linxxxs->tid(1));
+	EXPECT_TRUE(linxxxs->isBlockVisibleForTransaction(0, ctx_a.lastCid, ctx_a.tid));
+
+	ASSERT_EQ(tx::TX_CODE::TX_OK, linxxxs->markForDeletion(2, ctx_a.tid));
+	linxxxs->commitPositions({2}, txmgr.prepareCommit(), false);
+	txmgr.commit(ctx_a.tid);
+	auto ctx_c = txmgr.buildContext();
+	EXPECT_EQ(rows, linxxxs->buildValidPositions(ctx_b.lastCid, ctx_b.tid).size());
+	pos_list_t positions = {0, 1, 2, 3};
+	linxxxs->validatePositions(positions, ctx_c.lastCid, ctx_c.tid);
+	EXPECT_EQ((pos_list_t {0, 1, 3}), positions);
+
+	// the merge drops the deleted row and its version
+	linxxxs->merge();
+	EXPECT_EQ(rows - 1, linxxxs->size());
+	EXPECT_TRUE(linxxxs->isBlockVisibleForTransaction(0, ctx_c.lastCid, ctx_c.tid));
+	EXPECT_EQ(rows - 1, linxxxs->buildValidPositions(ctx_c.lastCid, ctx_c.tid).size());
+}
+
+TEST_F (VisibilityTests, concurrent_main_row_locks_have_one_winner) {
+	auto& txmgr = hyrise::tx::TransactionManager::getInstance();
+	const size_t threads = 4;
+	std::vector<tx::transaction_id_t> tids;
+	for (size_t thread = 0; thread < threads; ++thread)
+		tids.push_back(txmgr.buildContext().tid);
+	const auto rows = linxxxs->deltaOffset();
+
+	std::vector<std::vector<pos_t> > locked(threads);
+	run_threads(threads, [&] (size_t thread) {
+		for (pos_t row = 0; row < rows; ++row) {
+			if (linxxxs->markForDeletion(row, tids[thread]) == tx::TX_CODE::TX_OK)
+				locked[thread].push_back(row);
+		}
+	});
+
+	size_t total = 0;
+	for (size_t thread = 0; thread < threads; ++thread) {
+		total += locked[thread].size();
+		for (const auto& row : locked[thread])
+			EXPECT_EQ(tids[thread], linxxxs->tid(row));
+		linxxxs->unmarkForDeletion(pos_list_t(locked[thread].begin(), locked[thread].end()), tids[thread]);
+	}
+	EXPECT_EQ(rows, total);
+	EXPECT_TRUE(linxxxs->isBlockVisibleForTransaction(0, txmgr.buildContext().lastCid, tids[0]));
+}
+
 }}
@@ -1,17 +1,21 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <ctime>
+#include <thread>
 #include <sys/time.h>
 
 #include "testing/test.h"
 
 #include "access/NoOp.h"
 
+#include "taskscheduler/ParallelTasks.h"
 #include "taskscheduler/SharedScheduler.h"
 #include "taskscheduler/CoreBoundQueuesScheduler.h"
 #include "taskscheduler/WSCoreBoundQueuesScheduler.h"
+#include "taskscheduler/LockFreeWSCoreBoundQueuesScheduler.h"
 #include "taskscheduler/ThreadPerTaskScheduler.h"
 #include "taskscheduler/DynamicPriorityScheduler.h"
 
@@ -29,6 +33,7 @@ using ::testing::ValuesIn;
 // list schedulers to be tested
 std::vector<std::string> getSchedulersToTest() {
  return {"WSCoreBoundQueuesScheduler",
+           "LockFreeWSCoreBoundQueuesScheduler",
            "CoreBoundQueuesScheduler",
            "CentralScheduler",
            "CentralPriorityScheduler",
@@ -265,5 +270,74 @@ TEST(SchedulerBlockTest, dont_block_test_with_work_stealing) {
   long_block_test(scheduler.get());
 }
 
+TEST(SchedulerBlockTest, dont_block_test_with_lock_free_work_stealing) {
+  auto scheduler = std::make_shared<LockFreeWSCoreBoundQueuesScheduler>(2);
+  long_block_test(scheduler.get());
+}
+
+TEST(ParallelTasksTest, run_parallel_runs_every_part_once) {
+  SharedScheduler::getInstance().resetScheduler("WSCoreBoundQueuesScheduler", 4);
+  std::vector<std::atomic<int> > runs(100);
+  for (auto &run : runs)
+    run = 0;
+  runParallel(runs.size(), [&runs] (size_t part) { ++runs[part]; });
+  for (const auto &run : runs)
+    EXPECT_EQ(1, run);
+
+  EXPECT_THROW(runParallel(8, [] (size_t part) {
+        if (part == 5)
+          throw std::runtime_error("part failed");
+      }), std::runtime_error);
+}
+
+namespace {
+class BlockingTask : public Task {
+  std::atomic<bool> &_released;
+ public:
+  explicit BlockingTask(std::atomic<bool> &released) : _released(released) {}
+  virtual void operator()() {
+    while (!_released)
+      std::this_thread::yield();
+  }
+  const std::string vname() { return "BlockingTask"; }
+};
+
+class FlagTask : public Task {
+  std::atomic<bool> &_flag;
+ public:
+  explicit FlagTask(std::atomic<bool> &flag) : _flag(flag) {}
+  virtual void operator()() {
+    _flag = true;
+  }
+  const std::string vname() { return "FlagTask"; }
+};
+}
+
+TEST(ParallelTasksTest, run_parallel_runs_the_parts_of_busy_workers_itself) {
+  SharedScheduler::getInstance().resetScheduler("CoreBoundQueuesScheduler", 1);
+  std::atomic<bool> released(false);
+  SharedScheduler::getInstance().getScheduler()->schedule(std::make_shared<BlockingTask>(released));
+
+  // the only worker is blocked, the parts queued for it run here
+  std::atomic<size_t> parts(0);
+  runParallel(4, [&parts] (size_t) { ++parts; });
+  EXPECT_EQ(4u, parts);
+  released = true;
+}
+
+TEST(SchedulerBlockTest, parked_lock_free_workers_steal_from_a_busy_worker) {
+  auto scheduler = std::make_shared<LockFreeWSCoreBoundQueuesScheduler>(2);
+  std::atomic<bool> released(false), stolen(false);
+  scheduler->schedule(std::make_shared<BlockingTask>(released), 0);
+  // the other worker parks meanwhile
+  usleep(50000);
+
+  scheduler->schedule(std::make_shared<FlagTask>(stolen), 0);
+  for (int i = 0; i < 5000 && !stolen; ++i)
+    usleep(1000);
+  EXPECT_TRUE(stolen);
+  released = true;
+}
+
 } } // namespace hyrise::taskscheduler
 
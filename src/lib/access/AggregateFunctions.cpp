@@ -1,5 +1,6 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "AggregateFunctions.h"
+#include <access/DenseDomain.h>
 #include <storage/meta_storage.h>
 #include "json.h"
 
@@ -165,6 +166,120 @@ struct max_aggregate_functor : aggregate_functor{
   }
 };
 
+namespace {
+  template <typename R>
+  float averageOf(const R& sum, size_t count) {
+    return (float)sum / count;
+  }
+
+  float averageOf(const std::string&, size_t) {
+    throw std::runtime_error("Cannot calculate average for column of StringType");
+  }
+}
+
+struct dense_aggregate_functor {
+  typedef void value_type;
+
+  const c_atable_ptr_t& input;
+  atable_ptr_t& target;
+  field_t sourceField;
+  std::string targetColumn;
+  const std::vector<value_id_t>& groups;
+  const pos_list_t& targetRows;
+  size_t threads;
+  access::AggregateFunctions::type kind;
+
+  dense_aggregate_functor(const c_atable_ptr_t& i,
+                          atable_ptr_t& t,
+                          field_t sourceF,
+                          std::string column,
+                          const std::vector<value_id_t>& g,
+                          const pos_list_t& toRows,
+                          size_t n,
+                          access::AggregateFunctions::type k): input(i), target(t), sourceField(sourceF), targetColumn(column),
+                                                               groups(g), targetRows(toRows), threads(n), kind(k) {}
+
+  // adds cur to the accumulated value of a group that is not empty
+  template <typename R>
+  void accumulate(R& value, const R& cur) const {
+    switch (kind) {
+      case access::AggregateFunctions::MIN:
+        if (cur < value)
+          value = cur;
+        break;
+      case access::AggregateFunctions::MAX:
+        if (cur > value)
+          value = cur;
+        break;
+      case access::AggregateFunctions::COUNT:
+        break;
+      default:
+        value += cur;
+    }
+  }
+
+  template <typename R>
+  value_type operator()() {
+    const size_t groupCount = targetRows.size();
+    std::vector<std::vector<R> > values(threads);
+    std::vector<std::vector<size_t> > counts(threads);
+
+    access::forEachSlice(input->size(), threads, [&] (size_t thread, size_t first, size_t last) {
+      auto& value = values[thread];
+      auto& count = counts[thread];
+      count.assign(groupCount, 0);
+      if (kind == access::AggregateFunctions::COUNT) {
+        for (size_t row = first; row < last; ++row)
+          ++count[groups[row]];
+        return;
+      }
+      value.resize(groupCount);
+      for (size_t row = first; row < last; ++row) {
+        const auto group = groups[row];
+        const R cur = input->getValue<R>(sourceField, row);
+        if (count[group]++ == 0)
+          value[group] = cur;
+        else
+          accumulate(value[group], cur);
+      }
+    });
+
+    // the first thread's arrays receive the groups of all threads
+    access::forEachSlice(groupCount, threads, [&] (size_t, size_t first, size_t last) {
+      for (size_t thread = 1; thread < threads; ++thread) {
+        for (size_t group = first; group < last; ++group) {
+          if (counts[thread][group] == 0)
+            continue;
+          if (kind != access::AggregateFunctions::COUNT) {
+            if (counts[0][group] == 0)
+              values[0][group] = values[thread][group];
+            else
+              accumulate(values[0][group], values[thread][group]);
+          }
+          counts[0][group] += counts[thread][group];
+        }
+      }
+    });
+
+    const auto column = target->numberOfColumn(targetColumn);
+    for (size_t group = 0; group < groupCount; ++group) {
+      const size_t count = counts[0][group];
+      if (count == 0)
+        continue;
+      switch (kind) {
+        case access::AggregateFunctions::COUNT:
+          target->setValue<hyrise_int_t>(column, targetRows[group], count);
+          break;
+        case access::AggregateFunctions::AVG:
+          target->setValue<float>(column, targetRows[group], averageOf(values[0][group], count));
+          break;
+        default:
+          target->setValue<R>(column, targetRows[group], values[0][group]);
+      }
+    }
+  }
+};
+
 } // namespace storage
 
 namespace access {
@@ -224,6 +339,12 @@ void AggregateFun::walk(const storage::AbstractTable &table) {
 }
 
 
+void AggregateFun::processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+                                      const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads) {
+  throw std::runtime_error("Aggregation function does not support dense groups");
+}
+
+
 void SumAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows,
                                            storage::atable_ptr_t& target, size_t targetRow) {
   storage::sum_aggregate_functor fun(t, target, rows, _field, columnName(), targetRow);
@@ -231,6 +352,13 @@ void SumAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, pos
   ts(_dataType, fun);
 }
 
+void SumAggregateFun::processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+                                         const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads) {
+  storage::dense_aggregate_functor fun(t, target, _field, columnName(), groups, targetRows, threads, AggregateFunctions::SUM);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *SumAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new SumAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new SumAggregateFun(f["field"].asString());
@@ -250,6 +378,12 @@ void CountAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, p
   target->setValue<hyrise_int_t>(target->numberOfColumn(columnName()), targetRow, count);
 }
 
+void CountAggregateFun::processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+                                           const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads) {
+  storage::dense_aggregate_functor fun(t, target, _field, columnName(), groups, targetRows, threads, AggregateFunctions::COUNT);
+  fun.operator()<hyrise_int_t>();
+}
+
 size_t CountAggregateFun::countRows(const storage::c_atable_ptr_t& t, pos_list_t *rows) {
   if (rows != nullptr)
     return rows->size();
@@ -327,6 +461,13 @@ void AverageAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t,
     ts(_dataType, fun);
 }
 
+void AverageAggregateFun::processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+                                             const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads) {
+  storage::dense_aggregate_functor fun(t, target, _field, columnName(), groups, targetRows, threads, AggregateFunctions::AVG);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *AverageAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new AverageAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new AverageAggregateFun(f["field"].asString());
@@ -341,6 +482,13 @@ void MinAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, pos
     ts(_dataType, fun);
 }
 
+void MinAggregateFun::processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+                                         const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads) {
+  storage::dense_aggregate_functor fun(t, target, _field, columnName(), groups, targetRows, threads, AggregateFunctions::MIN);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *MinAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new MinAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new MinAggregateFun(f["field"].asString());
@@ -355,6 +503,13 @@ void MaxAggregateFun::processValuesForRows(const storage::c_atable_ptr_t& t, pos
     ts(_dataType, fun);
 }
 
+void MaxAggregateFun::processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+                                         const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads) {
+  storage::dense_aggregate_functor fun(t, target, _field, columnName(), groups, targetRows, threads, AggregateFunctions::MAX);
+  storage::type_switch<hyrise_basic_types> ts;
+  ts(_dataType, fun);
+}
+
 AggregateFun *MaxAggregateFun::parse(const Json::Value &f) {
   if (f["field"].isNumeric()) return new MaxAggregateFun(f["field"].asUInt());
   else if (f["field"].isString()) return new MaxAggregateFun(f["field"].asString());
@@ -52,6 +52,16 @@ class AggregateFun {
   virtual ~AggregateFun() { }
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, 
     pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) = 0;
+  /*!
+   * aggregates all groups of a dense domain at once: groups[row] is the
+   * group of row and group g is written to targetRows[g] of target.
+   * Every thread accumulates a slice of the rows into arrays indexed by
+   * group, the arrays are merged group-wise in parallel.
+   */
+  virtual void processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+    const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads);
+  /// whether processDenseGroups is supported
+  virtual bool supportsDenseGroups() const { return true; }
   virtual DataType getType() const = 0;
   std::string columnName() const
   {
@@ -85,6 +95,8 @@ class SumAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow);
+  virtual void processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+    const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads);
 
   virtual DataType getType() const {
     return _dataType;
@@ -121,6 +133,9 @@ class CountAggregateFun: public AggregateFun {
    * are considered for counting.
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow);
+  virtual void processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+    const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads);
+  virtual bool supportsDenseGroups() const { return !_distinct; }
   size_t countRows(const storage::c_atable_ptr_t& t, pos_list_t *rows);
   size_t countRowsDistinct(const storage::c_atable_ptr_t& t, pos_list_t *rows);
 
@@ -160,6 +175,8 @@ class AverageAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) ;
+  virtual void processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+    const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads);
 
   virtual DataType getType() const {
     return FloatType;
@@ -196,6 +213,8 @@ class MinAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) ;
+  virtual void processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+    const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads);
 
   virtual DataType getType() const {
     return _dataType;
@@ -229,6 +248,8 @@ class MaxAggregateFun: public AggregateFun {
    * on all rows of the input table
    */
   virtual void processValuesForRows(const storage::c_atable_ptr_t& t, pos_list_t *rows, storage::atable_ptr_t& target, size_t targetRow) ;
+  virtual void processDenseGroups(const storage::c_atable_ptr_t& t, const std::vector<value_id_t>& groups,
+    const pos_list_t& targetRows, storage::atable_ptr_t& target, size_t threads);
 
   virtual DataType getType() const {
     return _dataType;
@@ -0,0 +1,50 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/CheckpointHandler.h"
+
+#include <stdexcept>
+
+#include "json.h"
+#include "helper/Settings.h"
+#include "net/AbstractConnection.h"
+#include "io/Checkpoint.h"
+
+namespace hyrise {
+namespace access {
+
+bool CheckpointHandler::registered =
+    net::Router::registerRoute<CheckpointHandler>("/checkpoint/");
+
+CheckpointHandler::CheckpointHandler(net::AbstractConnection *data)
+    : _connection_data(data) {}
+
+std::string CheckpointHandler::name() {
+  return "CheckpointHandler";
+}
+
+const std::string CheckpointHandler::vname() {
+  return "CheckpointHandler";
+}
+
+std::string CheckpointHandler::constructResponse() {
+  Json::Value result;
+  const auto directory = Settings::getInstance()->getCheckpointPath();
+  if (directory.empty()) {
+    result["error"] = "No checkpoint path configured";
+  } else {
+    try {
+      result["cid"] = Json::Int64(tx::Checkpoint::create(directory));
+    } catch (const std::exception &e) {
+      result["error"] = e.what();
+    }
+  }
+  Json::StyledWriter writer;
+  return writer.write(result);
+}
+
+void CheckpointHandler::operator()() {
+  std::string response(constructResponse());
+  _connection_data->respond(response);
+}
+
+}
+}
@@ -0,0 +1,23 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include "net/Router.h"
+
+namespace hyrise {
+namespace net { class AbstractConnection; }
+namespace access {
+
+/// Writes a checkpoint of all stores to the configured checkpoint path and
+/// responds with its commit id
+class CheckpointHandler : public net::AbstractRequestHandler {
+  static bool registered;
+  net::AbstractConnection *_connection_data;
+ public:
+  explicit CheckpointHandler(net::AbstractConnection *data);
+  std::string constructResponse();
+  void operator()();
+  static std::string name();
+  const std::string vname();
+};
+
+}}
@@ -29,7 +29,7 @@ void DeleteOp::executePlanOperation() {
 	// A delete is nothing more than marking the positions as deleted in the TX
 	// Modifications record
 	auto& modRecord = txmgr[_txContext.tid];
-	for(const auto& p : *(tab->getPositions())) {
+	tab->forEachPosition([&](const pos_t& p) {
 		LOG4CXX_DEBUG(logger, "Deleting row:" << p);
 		bool deleteOk = store->markForDeletion(p, _txContext.tid) == tx::TX_CODE::TX_OK;
 		if(!deleteOk) {
@@ -37,11 +37,11 @@ void DeleteOp::executePlanOperation() {
 			throw std::runtime_error("Aborted TX because TID of other TX found");
 		}
 		modRecord.deletePos(tab->getActualTable(), p);
-	}
+	});
 
 	auto rsp = getResponseTask();
   if (rsp != nullptr)
-    rsp->incAffectedRows(tab->getPositions()->size());
+    rsp->incAffectedRows(tab->size());
 
 	addResult(getInputTable(0));
 }
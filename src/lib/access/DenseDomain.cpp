@@ -0,0 +1,117 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/DenseDomain.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/AbstractDictionary.h"
+#include "storage/AbstractTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/TableRangeView.h"
+#include "taskscheduler/ParallelTasks.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  // rows below which a pass over a column stays on a single thread
+  const size_t MIN_ROWS_PER_THREAD = 1 << 16;
+
+  // dictionary of all rows [first, last) of column, nullptr if the rows
+  // may use different dictionaries
+  storage::AbstractTable::SharedDictionaryPtr sharedDictionary(const storage::AbstractTable &table, storage::field_t column,
+                                                               size_t first, size_t last) {
+    if (dynamic_cast<const storage::Table *>(&table) != nullptr)
+      return table.dictionaryAt(column);
+    if (const auto store = dynamic_cast<const storage::Store *>(&table)) {
+      if (last <= store->deltaOffset() || first >= store->deltaOffset())
+        return store->dictionaryAt(column, first);
+      return nullptr;
+    }
+    if (const auto view = dynamic_cast<const storage::TableRangeView *>(&table))
+      return sharedDictionary(*view->getTable(), column, view->getStart() + first, view->getStart() + last);
+    if (const auto vertical = dynamic_cast<const storage::MutableVerticalTable *>(&table))
+      return sharedDictionary(*vertical->containerAt(column), vertical->getOffsetInContainer(column), first, last);
+    if (const auto pointers = dynamic_cast<const storage::PointerCalculator *>(&table)) {
+      // the range of all positions covers the positions of [first, last)
+      const auto& underlying = pointers->getTable();
+      if (underlying->size() == 0 || dynamic_cast<const storage::PointerCalculator *>(underlying.get()) != nullptr)
+        return nullptr;
+      storage::pos_t low = underlying->size(), high = 0;
+      pointers->forEachPosition([&] (storage::pos_t pos) {
+        low = std::min(low, pos);
+        high = std::max(high, pos);
+      });
+      if (low > high)
+        return nullptr;
+      return sharedDictionary(*underlying, pointers->getTableColumnForColumn(column), low, high + 1);
+    }
+    // horizontal tables, whose parts may have dictionaries of their own
+    return nullptr;
+  }
+}
+
+size_t denseDomainSize(const storage::c_atable_ptr_t &table, storage::field_t field, size_t maxDomain) {
+  if (table->size() == 0)
+    return 0;
+  const auto dictionary = sharedDictionary(*table, field, 0, table->size());
+  if (!dictionary)
+    return 0;
+  const size_t domain = dictionary->size();
+  return domain <= maxDomain ? domain : 0;
+}
+
+size_t denseThreads(size_t rows, size_t domain) {
+  const size_t rowsPerThread = std::max(MIN_ROWS_PER_THREAD, domain);
+  return std::max<size_t>(1, std::min<size_t>(taskscheduler::parallelWorkers(), rows / rowsPerThread));
+}
+
+void forEachSlice(size_t size, size_t threads, const std::function<void(size_t, size_t, size_t)> &fun) {
+  taskscheduler::runParallel(threads, [&] (size_t thread) {
+    fun(thread, size * thread / threads, size * (thread + 1) / threads);
+  });
+}
+
+storage::pos_list_t firstOccurrences(const storage::c_atable_ptr_t &table, storage::field_t field, size_t domain,
+                                     size_t threads, std::vector<storage::value_id_t> *valueIds) {
+  if (valueIds)
+    valueIds->resize(table->size());
+
+  std::vector<std::vector<std::pair<storage::pos_t, storage::value_id_t> > > firsts(threads);
+  forEachSlice(table->size(), threads, [&] (size_t thread, size_t first, size_t last) {
+    std::vector<uint64_t> seen((domain + 63) / 64, 0);
+    auto& own = firsts[thread];
+    for (size_t row = first; row < last; ++row) {
+      const auto id = table->getValueId(field, row).valueId;
+      if (id >= domain)
+        throw std::runtime_error("Value id outside of the dense domain of the column");
+      if (valueIds)
+        (*valueIds)[row] = id;
+      auto& word = seen[id / 64];
+      const uint64_t bit = 1ull << (id % 64);
+      if (!(word & bit)) {
+        word |= bit;
+        own.emplace_back(row, id);
+      }
+    }
+  });
+
+  std::vector<uint64_t> seen((domain + 63) / 64, 0);
+  storage::pos_list_t result;
+  for (const auto& own : firsts) {
+    for (const auto& first : own) {
+      auto& word = seen[first.second / 64];
+      const uint64_t bit = 1ull << (first.second % 64);
+      if (!(word & bit)) {
+        word |= bit;
+        result.push_back(first.first);
+      }
+    }
+  }
+  return result;
+}
+
+} } // namespace hyrise::access
@@ -0,0 +1,44 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+  Helpers for operators that work on the value ids of a single column
+  as a dense domain [0, dictionary size) instead of hashing them. This
+  requires all rows of the column to share one dictionary, i.e. a main
+  without delta rows or a delta without main rows.
+ */
+
+/// Largest dictionary for which dense arrays are used instead of hashing
+static const size_t MAX_DENSE_DOMAIN = 1 << 20;
+
+/// Size of the dense domain of field, 0 if the rows of field may use
+/// different dictionaries or the dictionary has more than maxDomain values
+size_t denseDomainSize(const storage::c_atable_ptr_t &table, storage::field_t field, size_t maxDomain = MAX_DENSE_DOMAIN);
+
+/// Threads for a pass over rows with per-thread arrays of domain entries,
+/// every thread handles at least as many rows as its arrays have entries
+/// and there are no more threads than scheduler workers
+size_t denseThreads(size_t rows, size_t domain);
+
+/// Calls fun(thread, first, last) for slices [first, last) of [0, size)
+/// in threads scheduler tasks, see taskscheduler::runParallel, the first
+/// slice runs in the calling thread
+void forEachSlice(size_t size, size_t threads, const std::function<void(size_t, size_t, size_t)> &fun);
+
+/// Row of the first occurrence of every value id of field in ascending
+/// order of rows. Every thread marks the value ids of its rows in a
+/// bitmap of its own, the first occurrences of all threads are merged in
+/// the order of the threads. If valueIds is given, it receives the value
+/// id of every row.
+storage::pos_list_t firstOccurrences(const storage::c_atable_ptr_t &table, storage::field_t field, size_t domain,
+                                     size_t threads, std::vector<storage::value_id_t> *valueIds = nullptr);
+
+} } // namespace hyrise::access
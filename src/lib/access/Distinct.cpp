@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 
+#include "access/DenseDomain.h"
 #include "access/system/BasicParser.h"
 #include "access/system/QueryParser.h"
 
@@ -23,16 +24,23 @@ Distinct::~Distinct() {
 // Executing this on a store with delta results in undefined behavior
 // Execution with horizontal tables results in undefined behavior
 void Distinct::executePlanOperation() {
-  // Map to cache values
-  std::unordered_map<storage::value_id_t, storage::pos_t> map;
   auto distinct = _field_definition[0];
-
-  // iterate over all rows
   const auto &in = input.getTable(0);
   uint64_t numRows = in->size();
+
+  // value ids of a single dictionary form a dense domain that is marked
+  // in bitmaps instead of a hash map
+  if (const size_t domain = denseDomainSize(in, distinct)) {
+    auto pos = new storage::pos_list_t(firstOccurrences(in, distinct, domain, denseThreads(numRows, domain)));
+    addResult(storage::PointerCalculator::create(in, pos));
+    return;
+  }
+
+  // Map to cache values
+  std::unordered_map<storage::value_id_t, storage::pos_t> map;
   ValueId val;
 
-  // Build distinct value list
+  // iterate over all rows and build distinct value list
   for (uint64_t i = 0; i < numRows; ++i) {
     val = in->getValueId(distinct, i);
     if (map.count(val.valueId) == 0)
@@ -41,7 +49,7 @@ void Distinct::executePlanOperation() {
 
   //Build result list
   storage::atable_ptr_t result;
-  auto pos = new storage::pos_list_t;
+  auto pos = newPositionList();
   for (const auto &e : map)
     pos->push_back(e.second);
 
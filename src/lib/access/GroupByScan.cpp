@@ -1,10 +1,12 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/GroupByScan.h"
 
+#include "access/DenseDomain.h"
 #include "access/system/QueryParser.h"
 #include "storage/ColumnMetadata.h"
 #include "storage/DictionaryFactory.h"
 #include "storage/HashTable.h"
+#include "storage/HorizontalTable.h"
 #include "storage/SharedHashTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/OrderIndifferentDictionary.h"
@@ -73,22 +75,46 @@ void GroupByScan::setupPlanOperation() {
 }
 
 void GroupByScan::executePlanOperation() {
-  if ((_field_definition.size() != 0) && (input.numberOfHashTables() >= 1)) {
+  const bool groupsByHashTable = (_field_definition.size() != 0) && (input.numberOfHashTables() >= 1);
+
+  // In morsel mode, the groups of a hash table are split into morsels
+  // of buckets. Everything else is done by the single instance that
+  // claims the whole input, the others return empty results.
+  if (usesMorsels() && (!groupsByHashTable || _sharedHashTable)) {
+    size_t first, last;
+    if (!nextMorsel(1, first, last)) {
+      addResult(createResultTableLayout());
+      return;
+    }
+  }
+
+  if (executeDenseGroupBy())
+    return;
+
+  if (groupsByHashTable) {
     if (_globalAggregation) {
       if (_field_definition.size() == 1) {
+        if (usesMorsels())
+          return executeGroupByMorsels<storage::SingleJoinHashTable>();
         return executeGroupBy<storage::SingleJoinHashTable, storage::join_single_hash_map_t, storage::join_single_key_t>();
       } else {
+        if (usesMorsels())
+          return executeGroupByMorsels<storage::JoinHashTable>();
         return executeGroupBy<storage::JoinHashTable, storage::join_hash_map_t, storage::join_key_t>();
       }
     }
     if (_field_definition.size() == 1) {
         if(_sharedHashTable)
             return executeGroupBy<storage::SingleAggregateSharedHashTableBase, storage::shared_aggregate_single_hash_map_t, storage::aggregate_single_key_t>();
+        else if (usesMorsels())
+            return executeGroupByMorsels<storage::SingleAggregateHashTable>();
         else
             return executeGroupBy<storage::SingleAggregateHashTable, storage::aggregate_single_hash_map_t, storage::aggregate_single_key_t>();
     } else {
         if(_sharedHashTable)
             return executeGroupBy<storage::AggregateSharedHashTableBase, storage::shared_aggregate_hash_map_t, storage::aggregate_key_t>();
+        else if (usesMorsels())
+            return executeGroupByMorsels<storage::AggregateHashTable>();
         else
             return executeGroupBy<storage::AggregateHashTable, storage::aggregate_hash_map_t, storage::aggregate_key_t>();
     }
@@ -174,7 +200,7 @@ void GroupByScan::hashTableInputIsShared(bool sharedHashTable) {
 
 void GroupByScan::splitInput() {
   hash_table_list_t hashTables = input.getHashTables();
-  if (_count > 0 && !hashTables.empty()) {
+  if (_count > 0 && !hashTables.empty() && !usesMorsels()) {
     auto r = distribute(hashTables[0]->numKeys(), _part, _count);
 
     if ((_indexed_field_definition.size() + _named_field_definition.size()) == 1)
@@ -206,6 +232,43 @@ void GroupByScan::writeGroupResult(storage::atable_ptr_t &resultTab,
   }
 }
 
+bool GroupByScan::executeDenseGroupBy() {
+  if (_field_definition.size() != 1 || _sharedHashTable || usesMorsels() || _count > 0)
+    return false;
+  for (const auto & funct: _aggregate_functions) {
+    if (!funct->supportsDenseGroups())
+      return false;
+  }
+
+  const auto &table = getInputTable(0);
+  const field_t field = _field_definition[0];
+  const size_t domain = denseDomainSize(table, field);
+  if (domain == 0)
+    return false;
+
+  // groups are numbered by their first row, value ids map to result rows
+  const size_t threads = denseThreads(table->size(), domain);
+  std::vector<value_id_t> valueIds;
+  const auto firsts = firstOccurrences(table, field, domain, threads, &valueIds);
+  pos_list_t targetRows(domain, 0);
+  for (size_t row = 0; row < firsts.size(); ++row)
+    targetRows[valueIds[firsts[row]]] = row;
+
+  auto resultTab = createResultTableLayout();
+  resultTab->resize(firsts.size());
+  storage::type_switch<hyrise_basic_types> ts;
+  for (size_t row = 0; row < firsts.size(); ++row) {
+    storage::write_group_functor fun(table, resultTab, firsts[row], field, row);
+    ts(table->typeOfColumn(field), fun);
+  }
+  for (const auto & funct: _aggregate_functions) {
+    funct->processDenseGroups(table, valueIds, targetRows, resultTab, threads);
+  }
+
+  addResult(resultTab);
+  return true;
+}
+
 template<typename HashTableType, typename MapType, typename KeyType>
 void GroupByScan::executeGroupBy() {
   auto resultTab = createResultTableLayout();
@@ -246,6 +309,50 @@ void GroupByScan::executeGroupBy() {
 
   this->addResult(resultTab);
 }
+template<typename HashTableType>
+void GroupByScan::executeGroupByMorsels() {
+  const auto& map = std::dynamic_pointer_cast<const HashTableType>(getInputHashTable())->getMap();
+
+  // every worker writes the groups of the buckets it claims into a
+  // result table of its own
+  std::vector<storage::atable_ptr_t> results(morselWorkers());
+  for (auto& result : results)
+    result = createResultTableLayout();
+  runMorselWorkers([&] (size_t worker) {
+      auto resultTab = results[worker];
+      pos_t row = 0;
+      size_t first, last;
+      std::vector<std::shared_ptr<pos_list_t> > groups;
+      while (nextMorsel(map.bucket_count(), first, last)) {
+        groups.clear();
+        for (size_t bucket = first; bucket < last; ++bucket) {
+          // equal keys share a bucket and are adjacent within it
+          for (auto it1 = map.begin(bucket), it2 = it1, end = map.end(bucket); it1 != end; it1 = it2) {
+            auto pos_list = std::make_shared<pos_list_t>();
+            for (; (it2 != end) && (it1->first == it2->first); ++it2) {
+              pos_list->push_back(it2->second);
+            }
+            groups.push_back(pos_list);
+          }
+        }
+
+        resultTab->resize(row + groups.size());
+        for (const auto& pos_list : groups) {
+          writeGroupResult(resultTab, pos_list, row++);
+        }
+      }
+    });
+
+  std::vector<storage::c_atable_ptr_t> filled;
+  for (const auto& result : results) {
+    if (result->size() > 0)
+      filled.push_back(result);
+  }
+  if (filled.size() > 1)
+    this->addResult(std::make_shared<const storage::HorizontalTable>(filled));
+  else
+    this->addResult(filled.empty() ? results.front() : filled.front());
+}
 
 }
 }
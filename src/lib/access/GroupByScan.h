@@ -46,6 +46,7 @@ public:
   /// adds a given AggregateFunction to group by scan instance SUM or COUNT
   void addFunction(AggregateFun *fun);
   void hashTableInputIsShared(bool sharedHashTable);
+  virtual bool supportsMorsels() const { return true; }
 
 private:
   void splitInput();
@@ -55,6 +56,13 @@ private:
   /// Depending on the number of fields to group by choose the appropriate map type
   template<typename HashTableType, typename MapType, typename KeyType>
   void executeGroupBy();
+  /// Groups the buckets of the hash table claimed as morsels
+  template<typename HashTableType>
+  void executeGroupByMorsels();
+  /// Groups a single field whose rows share one small dictionary by
+  /// value id with arrays instead of the hash table, returns false if the
+  /// input does not qualify
+  bool executeDenseGroupBy();
 
   std::vector<AggregateFun *> _aggregate_functions;
 
@@ -14,22 +14,49 @@ namespace {
 HashBuild::~HashBuild() {
 }
 
-void HashBuild::executePlanOperation() {
+template <typename HashTable>
+void HashBuild::build() {
+  if (usesMorsels()) {
+    // every worker hashes the morsels it claims into a table of its own,
+    // the tables of the workers that claimed any are merged
+    const auto& table = getInputTable();
+    std::vector<std::shared_ptr<const storage::AbstractHashTable> > built(morselWorkers());
+    runMorselWorkers([&] (size_t worker) {
+        built[worker] = std::make_shared<HashTable>(table, _field_definition, [&](size_t &first, size_t &last) {
+            return nextMorsel(table->size(), first, last);
+          });
+      });
+    std::vector<std::shared_ptr<const storage::AbstractHashTable> > filled;
+    for (const auto &hashTable : built) {
+      if (hashTable->size() > 0)
+        filled.push_back(hashTable);
+    }
+    if (filled.size() > 1)
+      addResult(std::make_shared<HashTable>(filled));
+    else
+      addResult(filled.empty() ? built.front() : filled.front());
+    return;
+  }
+
   size_t row_offset = 0;
   // check if table is a TableRangeView; if yes, provide the offset to HashTable
   auto input = std::dynamic_pointer_cast<const storage::TableRangeView>(getInputTable());
   if(input)
     row_offset = input->getStart();
+  addResult(std::make_shared<HashTable>(getInputTable(), _field_definition, row_offset));
+}
+
+void HashBuild::executePlanOperation() {
   if (_key == "groupby" || _key == "selfjoin" ) {
     if (_field_definition.size() == 1)
-        addResult(std::make_shared<storage::SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset));
+        build<storage::SingleAggregateHashTable>();
       else
-        addResult(std::make_shared<storage::AggregateHashTable>(getInputTable(), _field_definition, row_offset));
+        build<storage::AggregateHashTable>();
   } else if (_key == "join") {
     if (_field_definition.size() == 1)
-      addResult(std::make_shared<storage::SingleJoinHashTable>(getInputTable(), _field_definition, row_offset));
+      build<storage::SingleJoinHashTable>();
     else
-      addResult(std::make_shared<storage::JoinHashTable>(getInputTable(), _field_definition, row_offset));
+      build<storage::JoinHashTable>();
   } else {
     throw std::runtime_error("Type in Plan operation HashBuild not supported; key: " + _key);
   }
@@ -30,8 +30,12 @@ public:
   const std::string vname();
   void setKey(const std::string &key);
   const std::string getKey() const;
+  virtual bool supportsMorsels() const { return true; }
 
 protected:
+  template <typename HashTable>
+  void build();
+
   std::string _key;
 };
 
@@ -28,8 +28,8 @@ void HashJoinProbe::setupPlanOperation() {
 }
 
 void HashJoinProbe::executePlanOperation() {
-  storage::pos_list_t *buildTablePosList = new pos_list_t;
-  storage::pos_list_t *probeTablePosList = new pos_list_t;
+  storage::pos_list_t *buildTablePosList = newPositionList();
+  storage::pos_list_t *probeTablePosList = newPositionList();
 
   if (_selfjoin) {
     if (_field_definition.size() == 1)
@@ -37,8 +37,8 @@ class HashValueJoin : public PlanOperation {
     }
 
     map_type hash;
-    std::vector<pos_t> *build_pos = new std::vector<pos_t>();
-    std::vector<pos_t> *probe_pos = new std::vector<pos_t>();
+    pos_list_t *build_pos = newPositionList();
+    pos_list_t *probe_pos = newPositionList();
 
     T value;
 
@@ -97,15 +97,17 @@ void MergeIndexScan::executePlanOperation() {
   auto left = std::dynamic_pointer_cast<const storage::PointerCalculator>(input.getTable(0));
   auto right = std::dynamic_pointer_cast<const storage::PointerCalculator>(input.getTable(1));
 
-  storage::pos_list_t result(std::max(left->getPositions()->size(), right->getPositions()->size()));
+  auto result = newPositionList();
+  result->resize(std::max(left->getPositions()->size(), right->getPositions()->size()));
 
   auto it = std::set_intersection(left->getPositions()->begin(),
                                   left->getPositions()->end(),
                                   right->getPositions()->begin(),
                                   right->getPositions()->end(),
-                                  result.begin());
+                                  result->begin());
+  result->erase(it, result->end());
 
-  auto tmp = storage::PointerCalculator::create(left->getActualTable(), new storage::pos_list_t(result.begin(), it));
+  auto tmp = storage::PointerCalculator::create(left->getActualTable(), result);
   addResult(tmp);
 }
 
@@ -83,16 +83,13 @@ void InsertScan::executePlanOperation() {
   if (!_data)
     _data = buildFromJson();
 
-  auto writeArea = store->appendToDelta(_data->size());
+  auto writeArea = store->appendRowsToDelta(_data, _txContext.tid);
 
-  const size_t firstPosition = store->getMainTable()->size() + writeArea.first;
+  const size_t firstPosition = store->deltaOffset() + writeArea.first;
 
   // Get the modifications record
   auto& mods = tx::TransactionManager::getInstance()[_txContext.tid];
-  for(size_t i=0, upper = _data->size(); i < upper; ++i) {
-    store->copyRowToDelta(_data, i, writeArea.first+i, _txContext.tid);
-    mods.insertPos(store, firstPosition+i);
-  }
+  mods.insertPositions(store, firstPosition, firstPosition + _data->size());
 
   auto rsp = getResponseTask();
   if (rsp != nullptr)
@@ -29,7 +29,7 @@ void LayoutTable::executePlanOperation() {
   auto dest = createEmptyLayoutedTable(_layout);
 
   // Add all table to the game
-  std::vector<storage::c_atable_ptr_t> tables { main, store->getDeltaTable() };
+  std::vector<storage::c_atable_ptr_t> tables { main, store->getUnmergedDelta() };
   
   // Call the Merge
   storage::TableMerger merger(new storage::DefaultMergeStrategy(), new storage::SequentialHeapMerger());
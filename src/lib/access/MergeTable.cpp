@@ -4,6 +4,7 @@
 #include "access/system/QueryParser.h"
 
 #include "helper/checked_cast.h"
+#include "io/TransactionManager.h"
 #include "storage/Store.h"
 
 namespace hyrise {
@@ -22,7 +23,7 @@ void MergeTable::executePlanOperation() {
   for (auto& table: input.getTables()) {
     if (auto store = std::dynamic_pointer_cast<const storage::Store>(table)) {
       tables.push_back(store->getMainTable());
-      tables.push_back(store->getDeltaTable());
+      tables.push_back(store->getUnmergedDelta());
     } else {
       tables.push_back(table);
     }
@@ -57,12 +58,17 @@ MergeStore::~MergeStore() {
 void MergeStore::executePlanOperation() {
   auto t = checked_pointer_cast<const storage::Store>(getInputTable());
   auto store = std::const_pointer_cast<storage::Store>(t);
-  store->merge();
+  if (_online)
+    store->mergeOnline();
+  else
+    tx::TransactionManager::mergeStore(store);
   addResult(store);
 }
 
 std::shared_ptr<PlanOperation> MergeStore::parse(const Json::Value& data) {
-  return std::make_shared<MergeStore>();
+  auto op = std::make_shared<MergeStore>();
+  op->_online = data["online"].asBool();
+  return op;
 }
 
 
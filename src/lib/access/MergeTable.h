@@ -21,6 +21,10 @@ public:
   virtual ~MergeStore();
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+
+private:
+  // merge committed delta rows without blocking, see Store::mergeOnline()
+  bool _online = false;
 };
 
 
@@ -0,0 +1,43 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/PlanCacheHandler.h"
+
+#include "json.h"
+#include "net/AbstractConnection.h"
+#include "access/system/PlanCache.h"
+
+namespace hyrise {
+namespace access {
+
+bool PlanCacheHandler::registered =
+    net::Router::registerRoute<PlanCacheHandler>("/plancache/");
+
+PlanCacheHandler::PlanCacheHandler(net::AbstractConnection *data)
+    : _connection_data(data) {}
+
+std::string PlanCacheHandler::name() {
+  return "PlanCacheHandler";
+}
+
+const std::string PlanCacheHandler::vname() {
+  return "PlanCacheHandler";
+}
+
+std::string PlanCacheHandler::constructResponse() {
+  const auto &cache = PlanCache::getInstance();
+  Json::Value result;
+  result["hits"] = Json::UInt64(cache.getHits());
+  result["misses"] = Json::UInt64(cache.getMisses());
+  result["evictions"] = Json::UInt64(cache.getEvictions());
+  result["size"] = Json::UInt64(cache.size());
+  result["capacity"] = Json::UInt64(cache.getCapacity());
+  Json::StyledWriter writer;
+  return writer.write(result);
+}
+
+void PlanCacheHandler::operator()() {
+  std::string response(constructResponse());
+  _connection_data->respond(response);
+}
+
+}
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include "net/Router.h"
+
+namespace hyrise {
+namespace net { class AbstractConnection; }
+namespace access {
+
+/// Responds with the hit, miss and eviction counters of the plan cache
+class PlanCacheHandler : public net::AbstractRequestHandler {
+  static bool registered;
+  net::AbstractConnection *_connection_data;
+ public:
+  explicit PlanCacheHandler(net::AbstractConnection *data);
+  std::string constructResponse();
+  void operator()();
+  static std::string name();
+  const std::string vname();
+};
+
+}}
@@ -38,7 +38,7 @@ void PosUpdateScan::executePlanOperation() {
   // we need to increase by the positions we are inserting
   auto writeArea = store->appendToDelta(c_pc->getPositions()->size());
 
-  const size_t firstPosition = store->getMainTable()->size() + writeArea.first;
+  const size_t firstPosition = store->deltaOffset() + writeArea.first;
 
   // Get the modification record for the current transaction
   auto& txmgr = tx::TransactionManager::getInstance();
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/ProjectionScan.h"
 
+#include <numeric>
+
 #include "access/system/QueryParser.h"
 #include "access/system/BasicParser.h"
 
@@ -12,6 +14,13 @@ namespace access {
 
 namespace {
   auto _ = QueryParser::registerPlanOperation<ProjectionScan>("ProjectionScan");
+
+// Appends the positions [first, last) with a single allocation
+void appendPositions(storage::pos_list_t &positions, size_t first, size_t last) {
+  const size_t size = positions.size();
+  positions.resize(size + last - first);
+  std::iota(positions.begin() + size, positions.end(), first);
+}
 }
 
 void ProjectionScan::setupPlanOperation() {
@@ -23,12 +32,19 @@ void ProjectionScan::executePlanOperation() {
   _limit = _limit > input.getTable(0)->size() ? input.getTable(0)->size() : _limit;
 
   storage::pos_list_t *pos_list = nullptr;
-  if (_limit != input.getTable(0)->size()) {
-    pos_list = new pos_list_t();
+  if (usesMorsels()) {
+    pos_list = newPositionList();
+    scanMorsels(_limit, [] (size_t first, size_t last, storage::pos_list_t &found) {
+        appendPositions(found, first, last);
+      }, *pos_list);
+  } else if (_count > 0) {
+    pos_list = newPositionList();
 
-    for (size_t i = 0; i < _limit; i++) {
-      pos_list->push_back(i);
-    }
+    auto r = distribute(_limit, _part, _count);
+    appendPositions(*pos_list, r.first, r.second);
+  } else if (_limit != input.getTable(0)->size()) {
+    pos_list = newPositionList();
+    appendPositions(*pos_list, 0, _limit);
   }
 
   // copy the field definition
@@ -2,15 +2,18 @@
 #ifndef SRC_LIB_ACCESS_PROJECTIONSCAN_H_
 #define SRC_LIB_ACCESS_PROJECTIONSCAN_H_
 
-#include "access/system/PlanOperation.h"
+#include "access/system/ParallelizablePlanOperation.h"
 
 namespace hyrise {
 namespace access {
 
-class ProjectionScan : public PlanOperation {
+class ProjectionScan : public ParallelizablePlanOperation {
 public:
   void setupPlanOperation();
   void executePlanOperation();
+  /// Parallel instances select their rows by position in the whole input
+  virtual void splitInput() {}
+  virtual bool supportsMorsels() const { return true; }
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
 };
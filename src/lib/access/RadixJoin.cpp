@@ -7,10 +7,15 @@
 #include "access/system/ResponseTask.h"
 #include "access/system/QueryParser.h"
 #include "access/radixjoin/Histogram.h"
+#include "access/radixjoin/KeyDomain.h"
 #include "access/radixjoin/NestedLoopEquiJoin.h"
+#include "access/radixjoin/PartitionedHashJoin.h"
 #include "access/radixjoin/PrefixSum.h"
 #include "access/radixjoin/RadixCluster.h"
 #include "helper/types.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "taskscheduler/ParallelTasks.h"
 #include "log4cxx/logger.h"
 
 namespace hyrise {
@@ -23,13 +28,95 @@ namespace {
 
 const size_t RadixJoin::MaxParallelizationDegree;
 
+RadixJoin::RadixJoin() : _bits1(0), _bits2(0), _threads(0) {
+}
+
 void RadixJoin::executePlanOperation() {
+  const auto type = input.getTable(0)->typeOfColumn(_field_definition[0]);
+  if (type != input.getTable(1)->typeOfColumn(_field_definition[1]))
+    throw std::runtime_error("RadixJoin requires join columns of the same type");
+
+  switch (type) {
+  case IntegerType:
+  case IntegerTypeDelta:
+  case IntegerTypeDeltaConcurrent:
+    return executeDictionaryJoin<storage::hyrise_int_t>();
+  case IntegerNoDictType:
+    return executeValueJoin<storage::hyrise_int32_t>();
+  case FloatType:
+  case FloatTypeDelta:
+  case FloatTypeDeltaConcurrent:
+    return executeDictionaryJoin<storage::hyrise_float_t>();
+  case FloatNoDictType:
+    return executeValueJoin<storage::hyrise_float_t>();
+  case StringType:
+  case StringTypeDelta:
+  case StringTypeDeltaConcurrent:
+    return executeDictionaryJoin<storage::hyrise_string_t>();
+  default:
+    throw std::runtime_error("RadixJoin does not support the type of the join columns");
+  }
+}
+
+size_t RadixJoin::joinThreads() const {
+  return _threads > 0 ? _threads : taskscheduler::parallelWorkers();
+}
+
+template <typename T>
+void RadixJoin::executeDictionaryJoin() {
+  radixjoin::KeyDomain<T> domain;
+  const auto leftKeys = domain.keys(input.getTable(0), _field_definition[0], joinThreads());
+  const auto rightKeys = domain.keys(input.getTable(1), _field_definition[1], joinThreads());
+  executePartitionedHashJoin(leftKeys, rightKeys);
+}
+
+template <typename T>
+void RadixJoin::executeValueJoin() {
+  const size_t threads = joinThreads();
+  auto materialize = [threads] (const storage::c_atable_ptr_t& table, field_t field) {
+    std::vector<T> keys(table->size());
+    taskscheduler::runParallel(threads, [&] (size_t thread) {
+      const size_t last = keys.size() * (thread + 1) / threads;
+      for (size_t row = keys.size() * thread / threads; row < last; ++row)
+        keys[row] = table->getValue<T>(field, row);
+    });
+    return keys;
+  };
+  executePartitionedHashJoin(materialize(input.getTable(0), _field_definition[0]),
+                             materialize(input.getTable(1), _field_definition[1]));
+}
+
+template <typename KEY>
+void RadixJoin::executePartitionedHashJoin(const std::vector<KEY>& leftKeys, const std::vector<KEY>& rightKeys) {
+  const auto& left = input.getTable(0);
+  const auto& right = input.getTable(1);
+  const size_t threads = joinThreads();
+
+  // the smaller input is the build side, its partitions determine the bits
+  auto leftRows = newPositionList(), rightRows = newPositionList();
+  if (leftKeys.size() <= rightKeys.size()) {
+    const auto bits = radixjoin::choosePartitionBits(leftKeys.size(), threads);
+    radixjoin::partitionedHashJoin(rightKeys, leftKeys, bits, threads, *rightRows, *leftRows);
+  } else {
+    const auto bits = radixjoin::choosePartitionBits(rightKeys.size(), threads);
+    radixjoin::partitionedHashJoin(leftKeys, rightKeys, bits, threads, *leftRows, *rightRows);
+  }
+  LOG4CXX_DEBUG(_logger, "RadixJoin matched " << leftRows->size() << " rows with " << threads << " threads");
+
+  std::vector<storage::atable_ptr_t> parts;
+  parts.push_back(storage::PointerCalculator::create(left, leftRows));
+  parts.push_back(storage::PointerCalculator::create(right, rightRows));
+  addResult(std::make_shared<storage::MutableVerticalTable>(parts));
 }
 
 std::shared_ptr<PlanOperation> RadixJoin::parse(const Json::Value &data) {
   auto instance = BasicParser<RadixJoin>::parse(data);
-  instance->setBits1(data["bits1"].asUInt());
-  instance->setBits2(data["bits2"].asUInt());
+  if (data.isMember("bits1"))
+    instance->setBits1(data["bits1"].asUInt());
+  if (data.isMember("bits2"))
+    instance->setBits2(data["bits2"].asUInt());
+  if (data.isMember("threads"))
+    instance->setThreads(data["threads"].asUInt());
   return instance;
 }
 
@@ -53,6 +140,10 @@ uint32_t RadixJoin::bits2() const {
   return _bits2;
 }
 
+void RadixJoin::setThreads(const size_t threads) {
+  _threads = threads;
+}
+
 size_t RadixJoin::getTotalTableSize() {
   const auto& dep = std::dynamic_pointer_cast<PlanOperation>(_dependencies[0]);
   const auto& dep2 = std::dynamic_pointer_cast<PlanOperation>(_dependencies[1]);
@@ -82,6 +173,11 @@ double RadixJoin::calcA(double totalTblSizeIn100k) {
 
 // FIXME merge logic with RadixJoinTransformation.
 std::vector<taskscheduler::task_ptr_t> RadixJoin::applyDynamicParallelization(size_t dynamicCount){
+  // without radix bits the join schedules its partitions itself
+  if (_bits1 == 0) {
+    _threads = dynamicCount;
+    return {shared_from_this()};
+  }
 
   std::vector<taskscheduler::task_ptr_t> tasks;
 
@@ -8,8 +8,19 @@
 namespace hyrise {
 namespace access {
 
+/*
+  Equi join of the first field of input 0 with the second field of
+  input 1. If bits1 is set, the join is planned as a graph of histogram,
+  prefix sum, radix cluster and nested loop join operators. Otherwise it
+  runs as a single operator: both inputs are partitioned in parallel,
+  with the number of radix bits derived from the size of the smaller
+  input and the L2 cache, and the threads take partitions from a shared
+  queue until all partitions are joined. The threads are tasks on idle
+  workers of the shared scheduler.
+ */
 class RadixJoin : public PlanOperation {
 public:
+  RadixJoin();
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
@@ -17,6 +28,8 @@ public:
   void setBits2(const uint32_t b);
   uint32_t bits1() const;
   uint32_t bits2() const;
+  /// Threads of the single operator join, 0 for one per scheduler worker
+  void setThreads(const size_t threads);
 
   virtual std::vector<taskscheduler::task_ptr_t> applyDynamicParallelization(size_t dynamicCount);
 
@@ -32,8 +45,22 @@ protected:
   virtual double a_b() { return 251.463168551956 ; }
 
 private:
+  /// Joins dictionary encoded columns on the ids of a KeyDomain
+  template <typename T>
+  void executeDictionaryJoin();
+
+  /// Joins columns without dictionaries on their values
+  template <typename T>
+  void executeValueJoin();
+
+  template <typename KEY>
+  void executePartitionedHashJoin(const std::vector<KEY>& leftKeys, const std::vector<KEY>& rightKeys);
+
+  size_t joinThreads() const;
+
   uint32_t _bits1;
   uint32_t _bits2;
+  size_t _threads;
   static const size_t MaxParallelizationDegree = 24;
 
 void distributePartitions(
@@ -86,7 +86,7 @@ void SimpleRawTableScan::executePlanOperation() {
   // Prepare the copy operator
   storage::copy_value_functor_raw_table fun(result, table);
   storage::type_switch<hyrise_basic_types> ts;
-  auto positions = new storage::pos_list_t;
+  auto positions = newPositionList();
 
   size_t tabSize = table->size();
   for(size_t row=0; row < tabSize; ++row) {
@@ -2,6 +2,7 @@
 #include "access/SimpleTableScan.h"
 
 #include "access/expressions/pred_buildExpression.h"
+#include "access/expressions/pred_scanPositions.h"
 
 #include "storage/Store.h"
 #include "storage/PointerCalculator.h"
@@ -25,20 +26,27 @@ SimpleTableScan::~SimpleTableScan() {
 
 void SimpleTableScan::setupPlanOperation() {
   _comparator->walk(input.getTables());
+  _compiled = compilePredicate(*_comparator, input.getTable(0));
+}
+
+size_t SimpleTableScan::firstRow() const {
+  return _ofDelta ? checked_pointer_cast<const storage::Store>(input.getTable(0))->deltaOffset() : 0;
 }
 
 void SimpleTableScan::executePositional() {
   auto tbl = input.getTable(0);
-  storage::pos_list_t *pos_list = new pos_list_t();
-
-
-  size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size(); row < input_size; ++row) {
-    if ((*_comparator)(row)) {
-      pos_list->push_back(row);
-    }
+  const size_t row = firstRow();
+  // matches are marked in a bitmap, dense results are kept as bitmap or range
+  const pos_t base = row & ~pos_t(63);
+  std::vector<uint64_t> words((tbl->size() - base + 63) / 64, 0);
+  if (usesMorsels()) {
+    markMorsels(tbl->size() - row, [&] (size_t first, size_t last, uint64_t *marked) {
+        scanBitmap(*_comparator, _compiled.get(), row + first, row + last, base, marked);
+      }, words);
+  } else {
+    scanBitmap(*_comparator, _compiled.get(), row, tbl->size(), base, words.data());
   }
-  addResult(storage::PointerCalculator::create(tbl, pos_list));
+  addResult(storage::PointerCalculator::create(tbl, storage::PositionSet::fromBitmap(base, std::move(words))));
 }
 
 void SimpleTableScan::executeMaterialized() {
@@ -46,19 +54,23 @@ void SimpleTableScan::executeMaterialized() {
   auto result_table = tbl->copy_structure_modifiable();
   size_t target_row = 0;
 
-  size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size();
-       row < input_size;
-       ++row) {
-    if ((*_comparator)(row)) {
-        // TODO materializing result set will make the allocation the boundary
-      result_table->resize(target_row + 1);
-      result_table->copyRowFrom(input.getTable(0),
-                                row,
-                                target_row++,
-                                true /* Copy Value*/,
-                                false /* Use Memcpy */);
-    }
+  const size_t row = firstRow();
+  pos_list_t positions;
+  if (usesMorsels()) {
+    scanMorsels(tbl->size() - row, [&] (size_t first, size_t last, pos_list_t &found) {
+        scanPositions(*_comparator, _compiled.get(), row + first, row + last, found);
+      }, positions);
+  } else {
+    scanPositions(*_comparator, _compiled.get(), row, tbl->size(), positions);
+  }
+  for (const auto& position : positions) {
+    // TODO materializing result set will make the allocation the boundary
+    result_table->resize(target_row + 1);
+    result_table->copyRowFrom(input.getTable(0),
+                              position,
+                              target_row++,
+                              true /* Copy Value*/,
+                              false /* Use Memcpy */);
   }
   addResult(result_table);
 }
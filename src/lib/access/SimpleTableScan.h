@@ -4,6 +4,7 @@
 
 #include "access/system/ParallelizablePlanOperation.h"
 #include "access/expressions/pred_SimpleExpression.h"
+#include "access/expressions/pred_CompiledPredicate.h"
 
 namespace hyrise {
 namespace access {
@@ -20,9 +21,15 @@ public:
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
   void setPredicate(SimpleExpression *c);
+  virtual bool supportsMorsels() const { return true; }
 
 private:
+  /// First row of the input to scan
+  size_t firstRow() const;
+
   SimpleExpression *_comparator;
+  // _comparator specialized for the input table during setup, may be nullptr
+  std::unique_ptr<CompiledPredicate> _compiled;
   bool _ofDelta = false;
 };
 
@@ -2,86 +2,144 @@
 #include "access/SortScan.h"
 
 #include <algorithm>
+#include <memory>
 
 #include "access/system/QueryParser.h"
 
+#include "helper/parallel_sort.hpp"
+
 #include "storage/AbstractTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/Table.h"
 
+#include "taskscheduler/ParallelTasks.h"
+
 namespace hyrise {
 namespace access {
 
-template <typename T>
-struct ExtractValue {
-  static inline T extractValue(const storage::c_atable_ptr_t &table,
-                               const size_t &col,
-                               const size_t &row) {
-    return table->getValue<T>(col, row);
-  }
-};
-
-template <typename T>
-struct ExtractValueId {
-  static inline ValueId extractValue(const storage::c_atable_ptr_t &table,
-                                     const size_t &col,
-                                     const size_t &row) {
-    return table->getValueId(col, row);
-  }
-};
-
-template <typename T, template<typename> class ExtractFunctor>
-class ColumnSorter {
-  typedef struct pair {
-      T value;
-      size_t row;
-  } pair_t;
-
-  const storage::c_atable_ptr_t &_t;
-  field_t _f;
-  bool _asc;
-
-public:
-  ColumnSorter(const storage::c_atable_ptr_t &t,
-               const field_t f,
-               const bool asc):
-               _t(t),
-               _f(f),
-               _asc(asc) {
-  }
+namespace {
+  auto _ = QueryParser::registerPlanOperation<SortScan>("SortScan");
+
+  // inputs are sorted in a single part up to this number of rows per part
+  const size_t MIN_ROWS_PER_THREAD = 1 << 16;
 
-  std::vector<pos_t>* sort() const {
-    std::vector<pair_t> result;
+  // row with the value ids of all sort fields packed into one key
+  struct NormalizedKey {
+    uint64_t key;
+    pos_t row;
+  };
 
-    for (size_t row = 0; row < _t->size(); ++row) {
-      result.push_back({ExtractFunctor<T>::extractValue(_t, _f, row), row});
+  /// Values of one sort field, materialized for comparisons of rows
+  class FieldComparator {
+  public:
+    virtual ~FieldComparator() {}
+    /// Negative, zero or positive if row a sorts before, with or after row b
+    virtual int compare(pos_t a, pos_t b) const = 0;
+  };
+
+  template <typename T>
+  class TypedFieldComparator : public FieldComparator {
+    std::vector<T> _values;
+    bool _asc;
+
+  public:
+    TypedFieldComparator(const storage::c_atable_ptr_t &table, const field_t field, const bool asc, const size_t threads) :
+        _values(table->size()), _asc(asc) {
+      taskscheduler::runParallel(threads, [&] (size_t thread) {
+        const size_t last = _values.size() * (thread + 1) / threads;
+        for (size_t row = _values.size() * thread / threads; row < last; ++row)
+          _values[row] = table->getValue<T>(field, row);
+      });
     }
 
-    auto asc_sort = [](const pair_t& left, const pair_t& right) { 
-      return (left.value < right.value); 
-    };
+    int compare(pos_t a, pos_t b) const {
+      const int result = _values[a] < _values[b] ? -1 : (_values[b] < _values[a] ? 1 : 0);
+      return _asc ? result : -result;
+    }
+  };
 
-    auto desc_sort = [](const pair_t& left, const pair_t& right) { 
-      return (left.value > right.value); 
-    };
+  std::unique_ptr<FieldComparator> createComparator(const storage::c_atable_ptr_t &table,
+                                                    const field_t field,
+                                                    const bool asc,
+                                                    const size_t threads) {
+    switch (table->metadataAt(field).getType()) {
+    case IntegerType:
+    case IntegerTypeDelta:
+    case IntegerTypeDeltaConcurrent:
+      return std::unique_ptr<FieldComparator>(new TypedFieldComparator<hyrise_int_t>(table, field, asc, threads));
+    case IntegerNoDictType:
+      return std::unique_ptr<FieldComparator>(new TypedFieldComparator<hyrise_int32_t>(table, field, asc, threads));
+    case FloatType:
+    case FloatTypeDelta:
+    case FloatTypeDeltaConcurrent:
+    case FloatNoDictType:
+      return std::unique_ptr<FieldComparator>(new TypedFieldComparator<hyrise_float_t>(table, field, asc, threads));
+    case StringType:
+    case StringTypeDelta:
+    case StringTypeDeltaConcurrent:
+      return std::unique_ptr<FieldComparator>(new TypedFieldComparator<hyrise_string_t>(table, field, asc, threads));
+    default:
+      throw std::runtime_error("Datatype not supported");
+    }
+  }
 
+  // orders rows by all sort fields, ties by row
+  struct RowLess {
+    const std::vector<std::unique_ptr<FieldComparator> > *fields;
 
-    std::stable_sort(result.begin(),
-                     result.end(),
-                     _asc ? asc_sort : desc_sort
-                     );
+    bool operator()(pos_t a, pos_t b) const {
+      for (const auto& field : *fields) {
+        const int result = field->compare(a, b);
+        if (result != 0)
+          return result < 0;
+      }
+      return a < b;
+    }
+  };
 
-    auto r = new std::vector<pos_t>;
-    r->reserve(result.size());
-    for (const pair_t& p: result)
-      r->push_back(p.row);
+  struct NormalizedKeyLess {
+    bool operator()(const NormalizedKey &a, const NormalizedKey &b) const {
+      return a.key < b.key || (a.key == b.key && a.row < b.row);
+    }
+  };
 
-    return r;
+  inline size_t bitsFor(size_t values) {
+    return values > 1 ? 64 - __builtin_clzll(values - 1) : 0;
   }
-};
 
-namespace {
-  auto _ = QueryParser::registerPlanOperation<SortScan>("SortScan");
+  /*
+    Smallest limit elements of [0, rows) in order, element(i) creates the
+    element of row i. Every part keeps a max heap of its smallest limit
+    elements, the heaps are merged in the end.
+   */
+  template <typename T, typename Less, typename Element>
+  std::vector<T> selectTop(const size_t rows, const size_t limit, const size_t threads, Less less, Element element) {
+    std::vector<std::vector<T> > heaps(threads);
+    taskscheduler::runParallel(threads, [&] (size_t thread) {
+      auto &heap = heaps[thread];
+      heap.reserve(limit);
+      const size_t last = rows * (thread + 1) / threads;
+      for (size_t row = rows * thread / threads; row < last; ++row) {
+        const T e = element(row);
+        if (heap.size() < limit) {
+          heap.push_back(e);
+          std::push_heap(heap.begin(), heap.end(), less);
+        } else if (less(e, heap.front())) {
+          std::pop_heap(heap.begin(), heap.end(), less);
+          heap.back() = e;
+          std::push_heap(heap.begin(), heap.end(), less);
+        }
+      }
+    });
+
+    std::vector<T> result;
+    for (const auto& heap : heaps)
+      result.insert(result.end(), heap.begin(), heap.end());
+    const size_t count = std::min(limit, result.size());
+    std::partial_sort(result.begin(), result.begin() + count, result.end(), less);
+    result.resize(count);
+    return result;
+  }
 }
 
 SortScan::~SortScan() {
@@ -89,34 +147,73 @@ SortScan::~SortScan() {
 
 void SortScan::executePlanOperation() {
   const auto& table = input.getTable(0);
-  // Sorted Position List
-  std::vector<pos_t> *sorted_pos;
+  const size_t rows = table->size();
+  const size_t limit = _limit > 0 ? std::min<size_t>(_limit, rows) : rows;
+  const auto sort_fields = _sort_fields.empty() ? std::vector<SortField>{{0, true}} : _sort_fields;
 
-  // When table is not only a table but also using an ordered dictionary on sort field,
-  // we can just sort by value_id
+  size_t threads = _threads;
+  if (threads == 0)
+    threads = std::max<size_t>(1, std::min<size_t>(taskscheduler::parallelWorkers(), rows / MIN_ROWS_PER_THREAD));
+
+  // When table is not only a table but also uses ordered dictionaries on
+  // all sort fields, we can sort by value ids
   // TODO: fix Table<> template
-  auto base_table = std::dynamic_pointer_cast<const storage::Table>(table);
-  if ((table->dictionaryAt(_sort_field)->isOrdered()) && (base_table)) {
-    sorted_pos = ColumnSorter<ValueId, ExtractValueId>(table, _sort_field, asc).sort();
-  } else {
-    switch (table->metadataAt(_sort_field).getType()) {
-    case IntegerType:
-    case IntegerTypeDelta:
-    case IntegerTypeDeltaConcurrent:
-      sorted_pos = ColumnSorter<hyrise_int_t, ExtractValue>(table, _sort_field, asc).sort();
-      break;
-    case FloatType:
-    case FloatTypeDelta:
-    case FloatTypeDeltaConcurrent:
-      sorted_pos = ColumnSorter<hyrise_float_t, ExtractValue>(table, _sort_field, asc).sort();
-      break;
-    case StringType:
-    case StringTypeDelta:
-    case StringTypeDeltaConcurrent:
-        sorted_pos = ColumnSorter<hyrise_string_t, ExtractValue>(table, _sort_field, asc).sort();
+  std::vector<size_t> key_bits;
+  size_t total_bits = 0;
+  if (std::dynamic_pointer_cast<const storage::Table>(table)) {
+    for (const auto& sort_field : sort_fields) {
+      const auto& dictionary = table->dictionaryAt(sort_field.field);
+      if (!dictionary || !dictionary->isOrdered())
         break;
-      default:
-        throw std::runtime_error("Datatype not supported");
+      key_bits.push_back(bitsFor(dictionary->size()));
+      total_bits += key_bits.back();
+    }
+  }
+
+  // Sorted Position List
+  auto sorted_pos = newPositionList();
+  sorted_pos->reserve(limit);
+
+  if (key_bits.size() == sort_fields.size() && total_bits <= 64) {
+    // the first sort field occupies the highest bits of the key
+    auto normalize = [&] (pos_t row) {
+      uint64_t key = 0;
+      for (size_t i = 0; i < sort_fields.size(); ++i) {
+        const uint64_t value_id = table->getValueId(sort_fields[i].field, row).valueId;
+        const uint64_t mask = key_bits[i] == 0 ? 0 : ~0ull >> (64 - key_bits[i]);
+        key = (key_bits[i] == 64 ? 0 : key << key_bits[i]) | (sort_fields[i].asc ? value_id : mask - value_id);
+      }
+      return NormalizedKey {key, row};
+    };
+
+    std::vector<NormalizedKey> keys;
+    if (limit < rows) {
+      keys = selectTop<NormalizedKey>(rows, limit, threads, NormalizedKeyLess(), normalize);
+    } else {
+      keys.resize(rows);
+      taskscheduler::runParallel(threads, [&] (size_t thread) {
+        const size_t last = rows * (thread + 1) / threads;
+        for (size_t row = rows * thread / threads; row < last; ++row)
+          keys[row] = normalize(row);
+      });
+      parallel_radix_sort(keys, total_bits, threads, taskscheduler::runParallel);
+    }
+    for (const auto& key : keys)
+      sorted_pos->push_back(key.row);
+  } else {
+    std::vector<std::unique_ptr<FieldComparator> > fields;
+    for (const auto& sort_field : sort_fields)
+      fields.push_back(createComparator(table, sort_field.field, sort_field.asc, threads));
+    RowLess less {&fields};
+
+    if (limit < rows) {
+      const auto top = selectTop<pos_t>(rows, limit, threads, less, [] (pos_t row) { return row; });
+      sorted_pos->assign(top.begin(), top.end());
+    } else {
+      sorted_pos->resize(rows);
+      for (size_t row = 0; row < rows; ++row)
+        (*sorted_pos)[row] = row;
+      ParallelSort<pos_t, RowLess, pos_list_t::allocator_type>::sort(sorted_pos, threads, less, taskscheduler::runParallel);
     }
   }
 
@@ -137,17 +234,31 @@ void SortScan::executePlanOperation() {
 
 std::shared_ptr<PlanOperation> SortScan::parse(const Json::Value &data) {
   std::shared_ptr<SortScan> s = std::make_shared<SortScan>();
-  s->setSortField(data["fields"][0u].asUInt());
-  if (data.isMember("asc"))
-    s->asc = data["asc"].asBool();
+  // "asc" is either a flag for all fields or a list with a flag per field
+  const auto& asc = data["asc"];
+  for (unsigned i = 0; i < std::max(1u, data["fields"].size()); ++i)
+    s->addSortField(data["fields"][i].asUInt(), asc.isArray() ? asc.get(i, true).asBool() : (asc.isNull() || asc.asBool()));
+  if (data.isMember("limit"))
+    s->setLimit(data["limit"].asUInt());
+  if (data.isMember("threads"))
+    s->setThreads(data["threads"].asUInt());
   return s;
 }
 
 const std::string SortScan::vname() {
   return "SortScan";
 }
+
 void SortScan::setSortField(const unsigned s) {
-  _sort_field = s;
+  _sort_fields = {{s, true}};
+}
+
+void SortScan::addSortField(const unsigned s, const bool asc) {
+  _sort_fields.push_back({s, asc});
+}
+
+void SortScan::setThreads(const size_t threads) {
+  _threads = threads;
 }
 
 }
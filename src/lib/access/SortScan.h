@@ -7,6 +7,15 @@
 namespace hyrise {
 namespace access {
 
+/*
+  Sorts the input by one or more fields, each ascending or descending,
+  rows with equal keys keep their order. If all fields of a Table use
+  ordered dictionaries, their value ids are packed into a single 64 bit
+  key that is radix sorted; other fields are compared by value with a
+  parallel merge sort. With a limit only the first limit rows are
+  produced, which are selected with bounded heaps per part. The parts
+  of the sort run as tasks on idle workers of the shared scheduler.
+ */
 class SortScan : public PlanOperation {
 public:
   virtual ~SortScan();
@@ -14,11 +23,22 @@ public:
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
+  /// Sorts by field s only
   void setSortField(const unsigned s);
+  /// Sorts by field s after all fields added before
+  void addSortField(const unsigned s, const bool asc = true);
+  /// Parts the sort is split into, 0 to choose by input size and the
+  /// number of scheduler workers
+  void setThreads(const size_t threads);
 
 private:
-  unsigned _sort_field;
-  bool asc = true;
+  struct SortField {
+    unsigned field;
+    bool asc;
+  };
+
+  std::vector<SortField> _sort_fields;
+  size_t _threads = 0;
 };
 
 }
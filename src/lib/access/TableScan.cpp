@@ -33,6 +33,11 @@ void TableScan::setupPlanOperation() {
 }
 
 void TableScan::executePlanOperation() {
+  if (usesMorsels()) {
+    executeMorsels();
+    return;
+  }
+
   size_t start, stop;
   const auto& tablerange = std::dynamic_pointer_cast<const storage::TableRangeView>(getInputTable());
   if(tablerange){
@@ -43,21 +48,55 @@ void TableScan::executePlanOperation() {
     stop = getInputTable()->size();
   }
 
+  const auto& table = tablerange ? tablerange->getActualTable() : getInputTable();
+  if (_expr->supportsBitmaps()) {
+    // matches are marked in a bitmap, dense results are kept as bitmap or range
+    const pos_t base = start & ~pos_t(63);
+    std::vector<uint64_t> words((stop - base + 63) / 64, 0);
+    if (start < stop)
+      _expr->matchBitmap(start, stop, base, words.data());
+    addResult(storage::PointerCalculator::create(table, storage::PositionSet::fromBitmap(base, std::move(words))));
+    return;
+  }
+
   // When the input is 0, dont bother trying to generate results
   pos_list_t* positions = nullptr;
   if(stop - start > 0)
     positions = _expr->match(start, stop);
   else
-    positions = new pos_list_t();
+    positions = newPositionList();
 
-  std::shared_ptr<storage::PointerCalculator> result;
+  addResult(storage::PointerCalculator::create(table, positions));
+}
 
-  if(tablerange)
-    result = storage::PointerCalculator::create(tablerange->getActualTable(), positions);
-  else
-    result = storage::PointerCalculator::create(getInputTable(), positions);
+void TableScan::executeMorsels() {
+  // the expression walked the table below a range view, so morsels are
+  // claimed on the view and shifted to its rows in the table
+  auto table = getInputTable();
+  size_t start = 0;
+  const size_t rows = table->size();
+  if (const auto& tablerange = std::dynamic_pointer_cast<const storage::TableRangeView>(table)) {
+    start = tablerange->getStart();
+    table = tablerange->getActualTable();
+  }
+
+  if (_expr->supportsBitmaps()) {
+    const pos_t base = start & ~pos_t(63);
+    std::vector<uint64_t> words((start + rows - base + 63) / 64, 0);
+    markMorsels(rows, [&] (size_t first, size_t last, uint64_t *marked) {
+        _expr->matchBitmap(start + first, start + last, base, marked);
+      }, words);
+    addResult(storage::PointerCalculator::create(table, storage::PositionSet::fromBitmap(base, std::move(words))));
+    return;
+  }
+
+  auto positions = newPositionList();
+  scanMorsels(rows, [&] (size_t first, size_t last, pos_list_t &found) {
+      std::unique_ptr<pos_list_t> matches(_expr->match(start + first, start + last));
+      found.insert(found.end(), matches->begin(), matches->end());
+    }, *positions);
 
-  addResult(result);
+  addResult(storage::PointerCalculator::create(table, positions));
 }
 
 std::shared_ptr<PlanOperation> TableScan::parse(const Json::Value& data) {
@@ -92,7 +131,8 @@ std::vector<taskscheduler::task_ptr_t> TableScan::applyDynamicParallelization(si
     _doneObservers.clear();
   }
 
-  // set part and count for this task as first task
+  // set part and count for this task as first task, in morsel mode
+  // all instances share the cursor and each works alone
   setPart(0);
   setCount(dynamicCount);
   tasks.push_back(std::static_pointer_cast<taskscheduler::Task>(shared_from_this()));
@@ -107,6 +147,7 @@ std::vector<taskscheduler::task_ptr_t> TableScan::applyDynamicParallelization(si
 
     // build tabletask
     t->setProducesPositions(producesPositions);
+    t->setMorselCursor(_morselCursor);
     t->setPart(i);
     t->setCount(dynamicCount);
     t->setPriority(_priority);
@@ -19,10 +19,12 @@ class TableScan : public ParallelizablePlanOperation {
   /// Parse TableScan from 
   const std::string vname() { return "TableScan"; }
   virtual std::vector<taskscheduler::task_ptr_t> applyDynamicParallelization(size_t dynamicCount);
+  virtual bool supportsMorsels() const { return true; }
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
  protected:
   void setupPlanOperation();
   void executePlanOperation();
+  void executeMorsels();
 
   // for determineDynamicCount
   virtual size_t getTotalTableSize();
@@ -13,6 +13,14 @@ class AbstractExpression {
   virtual ~AbstractExpression() {}
   virtual void walk(const std::vector<storage::c_atable_ptr_t> &l) = 0;
   virtual storage::pos_list_t* match(const size_t start, const size_t stop) = 0;
+  /// True if the expression implements matchBitmap()
+  virtual bool supportsBitmaps() const {
+    return false;
+  }
+  /// Sets bit row - base of words for every matching row in [start, stop)
+  virtual void matchBitmap(const size_t start, const size_t stop, const storage::pos_t base, uint64_t *words) {
+    throw std::runtime_error("Expression does not match into bitmaps");
+  }
   virtual std::unique_ptr<AbstractExpression> clone(){
     throw std::runtime_error("Cannot clone base class; implement in derived");
   }
@@ -67,6 +67,16 @@ class BetweenExpression : public SimpleFieldExpression {
     T value = table->getValue<T>(field, row);
     return (value <= upper_value) && (value >= lower_value);
   }
+
+  // Rows of main partitions always take one of the first two branches above
+  virtual bool valueIdRange(const storage::AbstractTable *t, field_t &column,
+                            storage::bitunpacking::ValueIdRange &range) const {
+    if (t != table.get())
+      return false;
+    column = field;
+    range = storage::bitunpacking::ValueIdRange::between(lower_bound.valueId, upper_bound.valueId);
+    return true;
+  }
 };
 
 } } // namespace hyrise::access
@@ -0,0 +1,307 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "pred_CompiledPredicate.h"
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+#include "helper/make_unique.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/FixedLengthVector.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/TableRangeView.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+typedef storage::BaseAttributeVector<value_id_t> vector_t;
+typedef storage::FixedLengthVector<value_id_t> fixed_vector_t;
+typedef storage::BitCompressedVector<value_id_t> packed_vector_t;
+
+struct Partition {
+  std::shared_ptr<vector_t> vector;
+  // column inside the attribute vector
+  size_t column;
+  // the first `rows` rows of the table live in the vector, starting at `offset`
+  size_t rows;
+  size_t offset;
+};
+
+storage::c_atable_ptr_t mainTable(const storage::c_atable_ptr_t &table) {
+  if (auto view = std::dynamic_pointer_cast<const storage::TableRangeView>(table)) {
+    return mainTable(view->getTable());
+  }
+
+  storage::c_atable_ptr_t main = table;
+  if (auto store = std::dynamic_pointer_cast<const storage::Store>(table)) {
+    main = store->getMainTable();
+  }
+
+  // Only these tables expose their attribute vectors
+  if (!std::dynamic_pointer_cast<const storage::Table>(main) &&
+      !std::dynamic_pointer_cast<const storage::MutableVerticalTable>(main)) {
+    return nullptr;
+  }
+  return main;
+}
+
+Partition findPartition(const storage::c_atable_ptr_t &table, field_t column) {
+  Partition result {nullptr, 0, 0, 0};
+
+  if (auto view = std::dynamic_pointer_cast<const storage::TableRangeView>(table)) {
+    result = findPartition(view->getTable(), column);
+    if (result.rows <= view->getStart()) {
+      result.rows = 0;
+    } else {
+      result.rows = std::min(result.rows - view->getStart(), view->size());
+      result.offset += view->getStart();
+    }
+    return result;
+  }
+
+  const auto& main = mainTable(table);
+  if (!main) {
+    return result;
+  }
+
+  const auto& avs = main->getAttributeVectors(column);
+  if (avs.size() != 1) {
+    return result;
+  }
+
+  result.vector = std::dynamic_pointer_cast<vector_t>(avs.front().attribute_vector);
+  if (result.vector) {
+    result.column = avs.front().attribute_offset;
+    result.rows = std::min(main->size(), result.vector->size());
+  }
+  return result;
+}
+
+/*
+  Terms read value ids through qualified calls to the concrete vector
+  type, which bypass the virtual accessors and let the compiler inline
+  the whole conjunction into the scan loop.
+ */
+template <typename Vector>
+inline value_id_t valueIdAt(const Vector *vector, size_t column, size_t row) {
+  return vector->Vector::get(column, row);
+}
+
+template <>
+inline value_id_t valueIdAt(const fixed_vector_t *vector, size_t column, size_t row) {
+  return vector->fixed_vector_t::getRef(column, row);
+}
+
+template <typename Vector>
+class RangeTerm {
+  const Vector *_vector;
+  size_t _column;
+  storage::bitunpacking::ValueIdRange _range;
+
+ public:
+  RangeTerm(const Vector *vector, size_t column, const ValueIdTerm &term) :
+      _vector(vector), _column(column), _range(term.range) {}
+
+  inline bool matches(size_t row) const {
+    return _range.matches(valueIdAt(_vector, _column, row));
+  }
+};
+
+template <typename Vector>
+class ListTerm {
+  const Vector *_vector;
+  size_t _column;
+  value_id_t _lower;
+  // bit i is set if _lower + i is in the list
+  std::vector<uint64_t> _bitmap;
+
+ public:
+  ListTerm(const Vector *vector, size_t column, const ValueIdTerm &term) :
+      _vector(vector), _column(column), _lower(term.values.front()),
+      _bitmap((term.values.back() - term.values.front()) / 64 + 1, 0) {
+    for (const auto& value : term.values) {
+      _bitmap[(value - _lower) / 64] |= 1ull << ((value - _lower) % 64);
+    }
+  }
+
+  inline bool matches(size_t row) const {
+    const value_id_t bit = valueIdAt(_vector, _column, row) - _lower;
+    return bit / 64 < _bitmap.size() && ((_bitmap[bit / 64] >> (bit % 64)) & 1);
+  }
+};
+
+template <size_t I, size_t N>
+struct AllMatch {
+  template <typename Tuple>
+  static inline bool matches(const Tuple &terms, size_t row) {
+    return std::get<I>(terms).matches(row) && AllMatch<I + 1, N>::matches(terms, row);
+  }
+};
+
+template <size_t N>
+struct AllMatch<N, N> {
+  template <typename Tuple>
+  static inline bool matches(const Tuple &, size_t) { return true; }
+};
+
+template <typename... Terms>
+class Conjunction : public CompiledPredicate {
+  std::tuple<Terms...> _terms;
+  size_t _rows;
+  size_t _offset;
+
+ public:
+  Conjunction(size_t rows, size_t offset, Terms... terms) :
+      _terms(terms...), _rows(rows), _offset(offset) {}
+
+  virtual size_t rows() const {
+    return _rows;
+  }
+
+  virtual void scan(size_t start, size_t stop, pos_list_t &positions) const {
+    for (size_t row = start + _offset, end = stop + _offset; row < end; ++row) {
+      if (AllMatch<0, sizeof...(Terms)>::matches(_terms, row)) {
+        positions.push_back(row - _offset);
+      }
+    }
+  }
+
+  virtual void scanBitmap(size_t start, size_t stop, pos_t base, uint64_t *words) const {
+    for (size_t row = start; row < stop; ++row) {
+      const uint64_t match = AllMatch<0, sizeof...(Terms)>::matches(_terms, row + _offset);
+      words[(row - base) / 64] |= match << ((row - base) % 64);
+    }
+  }
+};
+
+/// A single range on a bit-packed column uses the bulk unpacking kernels
+class PackedRangeScan : public CompiledPredicate {
+  const packed_vector_t *_vector;
+  size_t _column;
+  storage::bitunpacking::ValueIdRange _range;
+  size_t _rows;
+  size_t _offset;
+
+ public:
+  PackedRangeScan(const packed_vector_t *vector, size_t column, const storage::bitunpacking::ValueIdRange &range,
+                  size_t rows, size_t offset) :
+      _vector(vector), _column(column), _range(range), _rows(rows), _offset(offset) {}
+
+  virtual size_t rows() const {
+    return _rows;
+  }
+
+  virtual void scan(size_t start, size_t stop, pos_list_t &positions) const {
+    size_t first = positions.size();
+    _vector->scan(_column, start + _offset, stop + _offset, _range, positions);
+    if (_offset > 0) {
+      for (size_t i = first; i < positions.size(); ++i)
+        positions[i] -= _offset;
+    }
+  }
+
+  virtual void scanBitmap(size_t start, size_t stop, pos_t base, uint64_t *words) const {
+    std::vector<uint64_t> bitmap;
+    _vector->scanBitmap(_column, start + _offset, stop + _offset, _range, bitmap);
+    // bit i of the scanned bitmap is row start + i
+    const size_t first = (start - base) / 64, shift = (start - base) % 64;
+    for (size_t i = 0; i < bitmap.size(); ++i) {
+      words[first + i] |= bitmap[i] << shift;
+      if (shift > 0 && (bitmap[i] >> (64 - shift)) != 0)
+        words[first + i + 1] |= bitmap[i] >> (64 - shift);
+    }
+  }
+};
+
+struct ResolvedTerm {
+  const ValueIdTerm *term;
+  const vector_t *vector;
+  size_t column;
+};
+
+/// Binds the terms one after another to their specialized type and
+/// instantiates the conjunction once all of them are bound
+template <typename Vector, typename... Bound>
+typename std::enable_if<(sizeof...(Bound) == kMaxCompiledTerms), std::unique_ptr<CompiledPredicate>>::type
+instantiate(const std::vector<ResolvedTerm> &terms, size_t rows, size_t offset, Bound... bound) {
+  return make_unique<Conjunction<Bound...>>(rows, offset, bound...);
+}
+
+template <typename Vector, typename... Bound>
+typename std::enable_if<(sizeof...(Bound) < kMaxCompiledTerms), std::unique_ptr<CompiledPredicate>>::type
+instantiate(const std::vector<ResolvedTerm> &terms, size_t rows, size_t offset, Bound... bound) {
+  if (sizeof...(Bound) == terms.size()) {
+    return make_unique<Conjunction<Bound...>>(rows, offset, bound...);
+  }
+
+  const auto& next = terms[sizeof...(Bound)];
+  const auto *vector = static_cast<const Vector *>(next.vector);
+  if (next.term->values.empty()) {
+    return instantiate<Vector>(terms, rows, offset, bound..., RangeTerm<Vector>(vector, next.column, *next.term));
+  }
+  return instantiate<Vector>(terms, rows, offset, bound..., ListTerm<Vector>(vector, next.column, *next.term));
+}
+
+template <typename Vector>
+bool allOfType(const std::vector<ResolvedTerm> &terms) {
+  return std::all_of(terms.begin(), terms.end(), [](const ResolvedTerm& t) {
+      return dynamic_cast<const Vector *>(t.vector) != nullptr;
+    });
+}
+
+}  // namespace
+
+const CompiledPredicate *SimpleExpression::compiledFor(const storage::c_atable_ptr_t &table) {
+  if (!compiled_current) {
+    compiled = compilePredicate(*this, table);
+    compiled_current = true;
+  }
+  return compiled.get();
+}
+
+std::unique_ptr<CompiledPredicate> compilePredicate(const SimpleExpression &expression,
+                                                    const storage::c_atable_ptr_t &table) {
+  if (!table || !mainTable(table)) {
+    return nullptr;
+  }
+
+  value_id_terms_t terms;
+  if (!expression.valueIdTerms(table.get(), terms) || terms.empty() || terms.size() > kMaxCompiledTerms) {
+    return nullptr;
+  }
+
+  std::vector<ResolvedTerm> resolved;
+  size_t rows = 0, offset = 0;
+  for (const auto& term : terms) {
+    const auto& partition = findPartition(table, term.column);
+    if (!partition.vector || partition.rows == 0) {
+      return nullptr;
+    }
+    if (resolved.empty()) {
+      rows = partition.rows;
+      offset = partition.offset;
+    } else if (partition.offset != offset) {
+      return nullptr;
+    }
+    rows = std::min(rows, partition.rows);
+    resolved.push_back({&term, partition.vector.get(), partition.column});
+  }
+
+  if (allOfType<packed_vector_t>(resolved)) {
+    if (resolved.size() == 1 && terms.front().values.empty()) {
+      return make_unique<PackedRangeScan>(static_cast<const packed_vector_t *>(resolved.front().vector),
+                                          resolved.front().column, terms.front().range, rows, offset);
+    }
+    return instantiate<packed_vector_t>(resolved, rows, offset);
+  }
+  if (allOfType<fixed_vector_t>(resolved)) {
+    return instantiate<fixed_vector_t>(resolved, rows, offset);
+  }
+  return nullptr;
+}
+
+} } // namespace hyrise::access
@@ -0,0 +1,42 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <memory>
+
+#include "helper/types.h"
+#include "pred_SimpleExpression.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+  A predicate specialized for the attribute vector types of one table.
+  It evaluates the first rows() rows of the table, which live in main
+  partitions; the remaining rows, e.g. the delta of a store, have to be
+  evaluated by the expression it was compiled from.
+ */
+class CompiledPredicate {
+ public:
+  virtual ~CompiledPredicate() {}
+
+  virtual size_t rows() const = 0;
+
+  /// Appends all matching rows in [start, stop) to positions, stop <= rows()
+  virtual void scan(size_t start, size_t stop, pos_list_t &positions) const = 0;
+
+  /// Sets bit row - base of words for all matching rows in [start, stop),
+  /// base <= start and stop <= rows()
+  virtual void scanBitmap(size_t start, size_t stop, pos_t base, uint64_t *words) const = 0;
+};
+
+/// Maximum number of terms in a conjunction that gets compiled
+const size_t kMaxCompiledTerms = 4;
+
+/// Compiles `expression` for `table` if it is a single comparison,
+/// BETWEEN, IN, or a conjunction of up to kMaxCompiledTerms of those
+/// on columns of `table`; returns nullptr otherwise. The expression
+/// has to be walked before.
+std::unique_ptr<CompiledPredicate> compilePredicate(const SimpleExpression &expression,
+                                                    const storage::c_atable_ptr_t &table);
+
+} } // namespace hyrise::access
@@ -11,6 +11,9 @@ class CompoundExpression : public SimpleExpression {
 
   ExpressionType type;
 
+  // first input table, the one match() scans
+  storage::c_atable_ptr_t table;
+
  public:
 
   SimpleExpression *lhs;
@@ -36,6 +39,11 @@ class CompoundExpression : public SimpleExpression {
   }
 
   virtual void walk(const std::vector<storage::c_atable_ptr_t > &l) {
+    compiled_current = false;
+    if (!l.empty()) {
+      table = l.front();
+    }
+
     lhs->walk(l);
 
     if (!one_leg) {
@@ -63,6 +71,30 @@ class CompoundExpression : public SimpleExpression {
     }
   }
 
+  virtual bool valueIdRange(const storage::AbstractTable *table, field_t &column,
+                            storage::bitunpacking::ValueIdRange &range) const {
+    if (type != NOT || !lhs->valueIdRange(table, column, range))
+      return false;
+    range = range.negate();
+    return true;
+  }
+
+  virtual bool valueIdTerms(const storage::AbstractTable *t, value_id_terms_t &terms) const {
+    if (type != AND)
+      return SimpleExpression::valueIdTerms(t, terms);
+    return lhs->valueIdTerms(t, terms) && rhs->valueIdTerms(t, terms);
+  }
+
+  virtual pos_list_t* match(const size_t start, const size_t stop) {
+    auto pl = new pos_list_t;
+    scanPositions(*this, compiledFor(table), start, stop, *pl);
+    return pl;
+  }
+
+  virtual void matchBitmap(const size_t start, const size_t stop, const pos_t base, uint64_t *words) {
+    scanBitmap(*this, compiledFor(table), start, stop, base, words);
+  }
+
   inline void add(SimpleExpression *e) {
     if (!lhs) lhs = e;
     else if (!rhs) rhs = e;
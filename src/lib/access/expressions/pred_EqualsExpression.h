@@ -54,6 +54,16 @@ class EqualsExpression : public SimpleFieldExpression {
   inline virtual bool operator()(size_t row) {
     return value_exists && table->getValueId(field, row) == lower_bound;
   }
+
+  virtual bool valueIdRange(const storage::AbstractTable *t, field_t &column,
+                            storage::bitunpacking::ValueIdRange &range) const {
+    if (t != table.get())
+      return false;
+    column = field;
+    range = value_exists ? storage::bitunpacking::ValueIdRange::equals(lower_bound.valueId) :
+        storage::bitunpacking::ValueIdRange::none();
+    return true;
+  }
 };
 
 
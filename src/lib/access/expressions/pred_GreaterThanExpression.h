@@ -13,6 +13,8 @@ class GreaterThanExpression : public SimpleFieldExpression {
   T value;
   std::shared_ptr<storage::BaseDictionary<T>> valueIdMap;
   bool value_exists;
+  // whether rows holding lower_bound match although value is not in the dictionary
+  bool lower_bound_matches;
 
  public:
 
@@ -37,6 +39,8 @@ class GreaterThanExpression : public SimpleFieldExpression {
     lower_bound.valueId = valueIdMap->getValueIdForValue(value);
     value_exists = valueIdMap->isValueIdValid(lower_bound.valueId) &&
         value == valueIdMap->getValueForValueId(lower_bound.valueId);
+    lower_bound_matches = !value_exists && valueIdMap->isValueIdValid(lower_bound.valueId) &&
+        valueIdMap->getValueForValueId(lower_bound.valueId) > value;
   }
 
   inline virtual bool operator()(size_t row) {
@@ -58,6 +62,16 @@ class GreaterThanExpression : public SimpleFieldExpression {
 
     return table->getValue<T>(field, row) > value;
   }
+
+  virtual bool valueIdRange(const storage::AbstractTable *t, field_t &column,
+                            storage::bitunpacking::ValueIdRange &range) const {
+    if (t != table.get())
+      return false;
+    column = field;
+    range = lower_bound_matches ? storage::bitunpacking::ValueIdRange::greaterEqual(lower_bound.valueId) :
+        storage::bitunpacking::ValueIdRange::greaterThan(lower_bound.valueId);
+    return true;
+  }
 };
 
 
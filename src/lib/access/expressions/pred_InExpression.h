@@ -47,6 +47,37 @@ public:
     return std::find(values.cbegin(), values.cend(), currentValue) != values.cend();
   }
 
+  ///
+  /// In main partitions the value id has to be one of the value ids of the listed values
+  ///
+  virtual bool valueIdTerms(const storage::AbstractTable *t, value_id_terms_t &terms) const {
+    if (t != table.get())
+      return false;
+    const auto& dictionary = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(table->dictionaryAt(field));
+    if (!dictionary)
+      return false;
+
+    std::vector<value_id_t> value_ids;
+    for (const auto& value : values) {
+      if (dictionary->valueExists(value))
+        value_ids.push_back(dictionary->getValueIdForValue(value));
+    }
+    std::sort(value_ids.begin(), value_ids.end());
+    value_ids.erase(std::unique(value_ids.begin(), value_ids.end()), value_ids.end());
+
+    ValueIdTerm term;
+    term.column = field;
+    if (value_ids.empty()) {
+      term.range = storage::bitunpacking::ValueIdRange::none();
+    } else {
+      term.range = storage::bitunpacking::ValueIdRange::between(value_ids.front(), value_ids.back());
+      if (value_ids.size() > 1)
+        term.values = value_ids;
+    }
+    terms.push_back(term);
+    return true;
+  }
+
 private:
   const std::vector<T> values;
   ///
@@ -46,6 +46,15 @@ class LessThanExpression : public SimpleFieldExpression {
     } else
       return false;
   }
+
+  virtual bool valueIdRange(const storage::AbstractTable *t, field_t &column,
+                            storage::bitunpacking::ValueIdRange &range) const {
+    if (t != table.get())
+      return false;
+    column = field;
+    range = storage::bitunpacking::ValueIdRange::lessThan(lower_bound.valueId);
+    return true;
+  }
 };
 
 
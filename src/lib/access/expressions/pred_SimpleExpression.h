@@ -1,20 +1,36 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <memory>
+
 #include "storage/storage_types.h"
+#include "storage/BitUnpacking.h"
 #include "helper/types.h"
 #include "access/expressions/AbstractExpression.h"
 
 namespace hyrise {
 namespace access {
 
+/// Condition on the value ids of one column in main partitions: the
+/// value id lies in range and, if values is not empty, is one of the
+/// sorted values.
+struct ValueIdTerm {
+  field_t column;
+  storage::bitunpacking::ValueIdRange range;
+  std::vector<value_id_t> values;
+};
+
+typedef std::vector<ValueIdTerm> value_id_terms_t;
+
+class CompiledPredicate;
+
 class SimpleExpression : public access::AbstractExpression {
  public:
   virtual void walk(const std::vector<storage::c_atable_ptr_t> &l) = 0;
 
   virtual pos_list_t* match(const size_t start, const size_t stop) {
     auto pl = new pos_list_t;
-    for(size_t row=0; row < stop; ++row) {
+    for(size_t row=start; row < stop; ++row) {
       if (operator()(row)) {
         pl->push_back(row);
       }
@@ -22,9 +38,50 @@ class SimpleExpression : public access::AbstractExpression {
     return pl;
   }
 
+  virtual bool supportsBitmaps() const {
+    return true;
+  }
+
+  virtual void matchBitmap(const size_t start, const size_t stop, const pos_t base, uint64_t *words) {
+    for (size_t row = start; row < stop; ++row) {
+      if (operator()(row)) {
+        words[(row - base) / 64] |= 1ull << ((row - base) % 64);
+      }
+    }
+  }
+
   inline virtual bool operator()(size_t row) {
     throw std::runtime_error("Cannot call base class");
   }
+
+  /// If the expression only compares the value ids of one column of
+  /// `table`, stores that column and the range of value ids that match
+  /// in main partitions and returns true. Scans use this to evaluate
+  /// bit-packed partitions in bulk instead of row by row.
+  virtual bool valueIdRange(const storage::AbstractTable *table, field_t &column,
+                            storage::bitunpacking::ValueIdRange &range) const {
+    return false;
+  }
+
+  /// Appends the conjunction of value id terms the expression is
+  /// equivalent to in main partitions of `table` and returns true, or
+  /// returns false if there is no such conjunction.
+  virtual bool valueIdTerms(const storage::AbstractTable *table, value_id_terms_t &terms) const {
+    ValueIdTerm term;
+    if (!valueIdRange(table, term.column, term.range))
+      return false;
+    terms.push_back(term);
+    return true;
+  }
+
+ protected:
+  /// Predicate compiled for table by the first call after walk(), the
+  /// morsels of a scan share it instead of compiling it again; nullptr
+  /// if the expression cannot be compiled
+  const CompiledPredicate *compiledFor(const storage::c_atable_ptr_t &table);
+
+  std::shared_ptr<const CompiledPredicate> compiled;
+  bool compiled_current = false;
 };
 
 } } // namespace hyrise::access
@@ -3,6 +3,7 @@
 
 #include "helper/types.h"
 #include "pred_common.h"
+#include "pred_scanPositions.h"
 
 namespace hyrise {
 namespace access {
@@ -35,6 +36,7 @@ class SimpleFieldExpression : public SimpleExpression {
   virtual ~SimpleFieldExpression() { }
 
   virtual void walk(const std::vector<storage::c_atable_ptr_t > &l) {
+    compiled_current = false;
     if (!table) {
       table = l.at(input);
     }
@@ -47,6 +49,16 @@ class SimpleFieldExpression : public SimpleExpression {
   inline virtual bool operator()(size_t row) {
     throw std::runtime_error("Cannot call base class");
   }
+
+  virtual pos_list_t* match(const size_t start, const size_t stop) {
+    auto pl = new pos_list_t;
+    scanPositions(*this, compiledFor(table), start, stop, *pl);
+    return pl;
+  }
+
+  virtual void matchBitmap(const size_t start, const size_t stop, const pos_t base, uint64_t *words) {
+    scanBitmap(*this, compiledFor(table), start, stop, base, words);
+  }
 };
 
 template <typename T, class Op = std::equal_to<T> >
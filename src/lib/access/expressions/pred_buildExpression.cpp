@@ -4,6 +4,7 @@
 #include <json.h>
 
 #include "expression_types.h"
+#include "ExpressionRegistration.h"
 #include "../json_converters.h"
 #include "predicates.h"
 #include "pred_expression_factory.h"
@@ -12,6 +13,20 @@
 namespace hyrise {
 namespace access {
 
+namespace {
+
+/// Makes the predicates of SimpleTableScan available to TableScan,
+/// which compiles them on match
+struct PredicateExpression {
+  static std::unique_ptr<SimpleExpression> parse(const Json::Value &data) {
+    return std::unique_ptr<SimpleExpression>(buildExpression(data["predicates"]));
+  }
+};
+
+auto _ = Expressions::add<PredicateExpression>("hyrise::predicates");
+
+}  // namespace
+
 SimpleFieldExpression *buildFieldExpression(PredicateType::type pred_type, const Json::Value &predicate) {
   storage::type_switch<hyrise_basic_types> ts;
   expression_factory fun;
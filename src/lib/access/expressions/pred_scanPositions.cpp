@@ -0,0 +1,52 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "pred_scanPositions.h"
+
+#include <algorithm>
+
+#include "pred_CompiledPredicate.h"
+
+namespace hyrise {
+namespace access {
+
+void scanPositions(SimpleExpression &expression, const storage::c_atable_ptr_t &table,
+                   size_t start, size_t stop, pos_list_t &positions) {
+  std::unique_ptr<CompiledPredicate> compiled;
+  if (start < stop) {
+    compiled = compilePredicate(expression, table);
+  }
+  scanPositions(expression, compiled.get(), start, stop, positions);
+}
+
+void scanPositions(SimpleExpression &expression, const CompiledPredicate *compiled,
+                   size_t start, size_t stop, pos_list_t &positions) {
+  size_t row = start;
+
+  if (compiled && start < std::min(stop, compiled->rows())) {
+    row = std::min(stop, compiled->rows());
+    compiled->scan(start, row, positions);
+  }
+
+  for (; row < stop; ++row) {
+    if (expression(row)) {
+      positions.push_back(row);
+    }
+  }
+}
+
+void scanBitmap(SimpleExpression &expression, const CompiledPredicate *compiled,
+                size_t start, size_t stop, pos_t base, uint64_t *words) {
+  size_t row = start;
+
+  if (compiled && start < std::min(stop, compiled->rows())) {
+    row = std::min(stop, compiled->rows());
+    compiled->scanBitmap(start, row, base, words);
+  }
+
+  for (; row < stop; ++row) {
+    if (expression(row)) {
+      words[(row - base) / 64] |= 1ull << ((row - base) % 64);
+    }
+  }
+}
+
+} } // namespace hyrise::access
@@ -0,0 +1,28 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include "helper/types.h"
+#include "pred_SimpleExpression.h"
+
+namespace hyrise {
+namespace access {
+
+class CompiledPredicate;
+
+/// Appends all rows in [start, stop) of `table` that satisfy
+/// `expression` to `positions`. Rows stored in main partitions are
+/// evaluated by a predicate compiled for the table whenever the
+/// expression can be compiled, all other rows through operator().
+void scanPositions(SimpleExpression &expression, const storage::c_atable_ptr_t &table,
+                   size_t start, size_t stop, pos_list_t &positions);
+
+/// Same as above, but with a predicate compiled before, which may be nullptr
+void scanPositions(SimpleExpression &expression, const CompiledPredicate *compiled,
+                   size_t start, size_t stop, pos_list_t &positions);
+
+/// Sets bit row - base of words for all rows in [start, stop) that
+/// satisfy `expression`, base <= start; compiled may be nullptr
+void scanBitmap(SimpleExpression &expression, const CompiledPredicate *compiled,
+                size_t start, size_t stop, pos_t base, uint64_t *words);
+
+} } // namespace hyrise::access
@@ -0,0 +1,150 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_RADIXJOIN_KEYDOMAIN_H_
+#define SRC_LIB_ACCESS_RADIXJOIN_KEYDOMAIN_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "helper/checked_cast.h"
+#include "helper/types.h"
+#include "storage/AbstractTable.h"
+#include "storage/BaseDictionary.h"
+#include "taskscheduler/ParallelTasks.h"
+
+namespace hyrise {
+namespace access {
+namespace radixjoin {
+
+/*
+  Join keys of dictionary encoded columns as ids of one domain, equal
+  ids stand for equal values. The values of the first dictionary keep
+  their value ids, so inputs that share a dictionary join on their value
+  ids as they are. Every further dictionary is translated once per value:
+  values of the first dictionary take its value id, all other values get
+  ids above the range of value ids. Rows are never decoded one by one.
+
+  The translations cover the values a dictionary held when it was added.
+  Value ids added later, e.g. by inserts into the delta while the join
+  runs, are translated by value when a row refers to them.
+ */
+template <typename T>
+class KeyDomain {
+ public:
+  /// Key of every row of field of table
+  std::vector<uint64_t> keys(const storage::c_atable_ptr_t &table, field_t field, size_t threads) {
+    const size_t rows = table->size();
+    std::vector<uint64_t> result(rows);
+    if (rows == 0)
+      return result;
+    threads = std::max<size_t>(1, std::min(threads, rows));
+    auto first = [&] (size_t thread) { return rows * thread / threads; };
+
+    // the dictionaries of the rows, usually the main and the delta of a store
+    std::vector<std::vector<std::shared_ptr<storage::AbstractDictionary> > > seen(threads);
+    taskscheduler::runParallel(threads, [&] (size_t thread) {
+      const storage::AbstractDictionary *last = nullptr;
+      for (size_t row = first(thread); row < first(thread + 1); ++row) {
+        const auto& dictionary = table->dictionaryAt(field, row);
+        if (dictionary.get() != last && std::find(seen[thread].begin(), seen[thread].end(), dictionary) == seen[thread].end())
+          seen[thread].push_back(dictionary);
+        last = dictionary.get();
+      }
+    });
+    for (const auto& dictionaries : seen) {
+      for (const auto& dictionary : dictionaries)
+        add(dictionary);
+    }
+
+    taskscheduler::runParallel(threads, [&] (size_t thread) {
+      const storage::AbstractDictionary *last = nullptr;
+      const Translation *translation = nullptr;
+      for (size_t row = first(thread); row < first(thread + 1); ++row) {
+        const auto dictionary = table->dictionaryAt(field, row).get();
+        if (dictionary != last) {
+          translation = &find(dictionary);
+          last = dictionary;
+        }
+        const auto id = table->getValueId(field, row).valueId;
+        if (id >= translation->size) {
+          result[row] = translateAdded(*translation, id);
+        } else {
+          result[row] = translation->identity ? id : translation->ids[id];
+        }
+      }
+    });
+    return result;
+  }
+
+ private:
+  struct Translation {
+    std::shared_ptr<storage::BaseDictionary<T> > dictionary;
+    // number of values of the dictionary when it was added
+    size_t size;
+    bool identity;
+    // id in the domain of every value id below size
+    std::vector<uint64_t> ids;
+  };
+
+  const Translation &find(const storage::AbstractDictionary *dictionary) const {
+    for (const auto& translation : _translations) {
+      if (translation.dictionary.get() == dictionary)
+        return translation;
+    }
+    throw std::runtime_error("Dictionary of the join column changed during the join");
+  }
+
+  void add(const std::shared_ptr<storage::AbstractDictionary> &dictionary) {
+    for (const auto& translation : _translations) {
+      if (translation.dictionary == dictionary)
+        return;
+    }
+
+    const auto& typed = checked_pointer_cast<storage::BaseDictionary<T> >(dictionary);
+    Translation translation {typed, typed->size(), _translations.empty(), {}};
+    if (translation.identity) {
+      _first = typed;
+      _firstSize = translation.size;
+    } else {
+      translation.ids.resize(translation.size);
+      for (value_id_t id = 0; id < translation.size; ++id)
+        translation.ids[id] = idOf(typed->getValueForValueId(id));
+    }
+    _translations.push_back(std::move(translation));
+  }
+
+  // id of value in the domain, only the values the first dictionary held
+  // when it was added keep their value id
+  uint64_t idOf(const T &value) {
+    if (_first->valueExists(value)) {
+      const value_id_t id = _first->getValueIdForValue(value);
+      if (id < _firstSize)
+        return id;
+    }
+    const uint64_t next = (uint64_t(1) << 32) + _missing.size();
+    return _missing.emplace(value, next).first->second;
+  }
+
+  uint64_t translateAdded(const Translation &translation, value_id_t id) {
+    const T value = translation.dictionary->getValueForValueId(id);
+    std::lock_guard<std::mutex> lock(_mutex);
+    return idOf(value);
+  }
+
+  std::shared_ptr<storage::BaseDictionary<T> > _first;
+  size_t _firstSize = 0;
+  std::vector<Translation> _translations;
+  // ids of the values missing in the first dictionary
+  std::unordered_map<T, uint64_t> _missing;
+  std::mutex _mutex;
+};
+
+}
+}
+}
+
+#endif  // SRC_LIB_ACCESS_RADIXJOIN_KEYDOMAIN_H_
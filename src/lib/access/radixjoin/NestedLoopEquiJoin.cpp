@@ -54,8 +54,8 @@ void NestedLoopEquiJoin::executePlanOperation() {
   // join
   size_t left_begin = 0, left_end = 0, right_begin = 0, right_end = 0, partition = 0, rpart = 0;
   uint32_t lhash;
-  auto lpos_list = new pos_list_t;
-  auto rpos_list = new pos_list_t;
+  auto lpos_list = newPositionList();
+  auto rpos_list = newPositionList();
 
   lpos_list->reserve(lhvector->size());
   rpos_list->reserve(lhvector->size());
@@ -0,0 +1,109 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/radixjoin/PartitionedHashJoin.h"
+
+#include <unistd.h>
+
+
+namespace hyrise {
+namespace access {
+namespace radixjoin {
+
+namespace {
+
+// tuples of one cache line, the unit written by the write-combining buffers
+const size_t TUPLES_PER_LINE = 64 / sizeof(JoinTuple);
+
+// bytes of a build tuple and its share of the bucket-chained hash table
+const size_t BYTES_PER_BUILD_ROW = sizeof(JoinTuple) + 2 * sizeof(uint32_t);
+
+size_t l2CacheSize() {
+  static const size_t size = [] {
+    const long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    return bytes > 0 ? static_cast<size_t>(bytes) : size_t(256 * 1024);
+  }();
+  return size;
+}
+
+inline size_t partitionOf(uint64_t hash, uint32_t bits) {
+  return bits == 0 ? 0 : hash >> (64 - bits);
+}
+
+struct alignas(64) CacheLine {
+  JoinTuple tuples[TUPLES_PER_LINE];
+};
+
+}  // namespace
+
+uint32_t choosePartitionBits(size_t buildRows, size_t threads) {
+  // partitions of the build side use at most half of the L2 cache, the
+  // probe side streams through the other half
+  const size_t partitionRows = std::max<size_t>(1, l2CacheSize() / 2 / BYTES_PER_BUILD_ROW);
+  uint32_t bits = 0;
+  while ((buildRows >> bits) > partitionRows)
+    ++bits;
+  // large inputs get enough partitions for every thread to steal from
+  if (bits > 0) {
+    while ((size_t(1) << bits) < 4 * threads)
+      ++bits;
+  }
+  return std::min(bits, MAX_PARTITION_BITS);
+}
+
+Partitions partition(const std::vector<JoinTuple>& tuples, uint32_t bits, size_t threads) {
+  const size_t partitions = size_t(1) << bits;
+  Partitions result;
+  result.offsets.assign(partitions + 1, 0);
+  if (bits == 0) {
+    result.tuples = tuples;
+    result.offsets[1] = tuples.size();
+    return result;
+  }
+
+  threads = std::max<size_t>(1, std::min(threads, tuples.size() / TUPLES_PER_LINE));
+  auto first = [&] (size_t thread) { return tuples.size() * thread / threads; };
+
+  // histograms of the ranges of all threads
+  std::vector<std::vector<size_t>> histograms(threads, std::vector<size_t>(partitions, 0));
+  taskscheduler::runParallel(threads, [&] (size_t thread) {
+    auto& histogram = histograms[thread];
+    for (size_t t = first(thread); t < first(thread + 1); ++t)
+      ++histogram[partitionOf(tuples[t].hash, bits)];
+  });
+
+  // every thread writes its tuples of partition p to the region following
+  // the regions of the threads before it
+  size_t offset = 0;
+  for (size_t p = 0; p < partitions; ++p) {
+    result.offsets[p] = offset;
+    for (auto& histogram : histograms) {
+      const size_t count = histogram[p];
+      histogram[p] = offset;
+      offset += count;
+    }
+  }
+  result.offsets[partitions] = offset;
+  result.tuples.resize(tuples.size());
+
+  taskscheduler::runParallel(threads, [&] (size_t thread) {
+    auto& positions = histograms[thread];
+    std::vector<CacheLine> buffers(partitions);
+    std::vector<uint8_t> filled(partitions, 0);
+    JoinTuple *out = result.tuples.data();
+    for (size_t t = first(thread); t < first(thread + 1); ++t) {
+      const size_t p = partitionOf(tuples[t].hash, bits);
+      buffers[p].tuples[filled[p]++] = tuples[t];
+      if (filled[p] == TUPLES_PER_LINE) {
+        std::memcpy(out + positions[p], buffers[p].tuples, sizeof(CacheLine));
+        positions[p] += TUPLES_PER_LINE;
+        filled[p] = 0;
+      }
+    }
+    for (size_t p = 0; p < partitions; ++p)
+      std::memcpy(out + positions[p], buffers[p].tuples, filled[p] * sizeof(JoinTuple));
+  });
+  return result;
+}
+
+}
+}
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_RADIXJOIN_PARTITIONEDHASHJOIN_H_
+#define SRC_LIB_ACCESS_RADIXJOIN_PARTITIONEDHASHJOIN_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "helper/types.h"
+#include "taskscheduler/ParallelTasks.h"
+
+namespace hyrise {
+namespace access {
+namespace radixjoin {
+
+/// Row of a join input as it is partitioned: the hash of its key and
+/// the row of the input, four tuples fill a cache line
+struct JoinTuple {
+  uint64_t hash;
+  uint64_t row;
+};
+
+/// Tuples of one join input clustered by partition, the tuples of
+/// partition p are [offsets[p], offsets[p + 1])
+struct Partitions {
+  std::vector<JoinTuple> tuples;
+  std::vector<size_t> offsets;
+};
+
+/// Largest number of radix bits of a single partitioning pass, more
+/// partitions than TLB entries and write-combining buffers fitting into
+/// L1 cost more than a second pass would save
+static const uint32_t MAX_PARTITION_BITS = 12;
+
+/// Number of radix bits, so that the partitions of the build side and
+/// their hash tables fit into the L2 cache and all threads find work
+uint32_t choosePartitionBits(size_t buildRows, size_t threads);
+
+/// Clusters the tuples by the highest bits bits of their hashes. Each
+/// thread partitions a range of tuples through software write-combining
+/// buffers of a cache line per partition, the tuples of a partition keep
+/// their order.
+Partitions partition(const std::vector<JoinTuple>& tuples, uint32_t bits, size_t threads);
+
+inline uint64_t hashKey(uint64_t key) {
+  // fibonacci hashing spreads dense keys over the high bits
+  return key * 11400714819323198485ull;
+}
+
+inline uint64_t hashKey(int64_t key) { return hashKey(static_cast<uint64_t>(key)); }
+inline uint64_t hashKey(int32_t key) { return hashKey(static_cast<uint64_t>(static_cast<int64_t>(key))); }
+inline uint64_t hashKey(uint32_t key) { return hashKey(static_cast<uint64_t>(key)); }
+
+inline uint64_t hashKey(float key) {
+  // -0.0 and 0.0 are equal keys
+  if (key == 0.0f)
+    key = 0.0f;
+  uint32_t bits;
+  std::memcpy(&bits, &key, sizeof(bits));
+  return hashKey(bits);
+}
+
+inline uint64_t hashKey(const std::string& key) { return hashKey(static_cast<uint64_t>(std::hash<std::string>()(key))); }
+
+/// The tuples of all rows of keys
+template <typename KEY>
+std::vector<JoinTuple> buildTuples(const std::vector<KEY>& keys, size_t threads) {
+  std::vector<JoinTuple> tuples(keys.size());
+  taskscheduler::runParallel(threads, [&] (size_t thread) {
+    const size_t last = keys.size() * (thread + 1) / threads;
+    for (size_t row = keys.size() * thread / threads; row < last; ++row)
+      tuples[row] = {hashKey(keys[row]), row};
+  });
+  return tuples;
+}
+
+/*
+  Radix partitioned hash join of the keys of two inputs. Both inputs are
+  partitioned by the same radix bits, the partitions are joined with a
+  bucket-chained hash table on the build side. Threads take partitions
+  from a shared queue, largest first, so that skewed partitions do not
+  leave the other threads idle. Appends the matching row pairs in
+  partition order, which does not depend on the number of threads.
+ */
+template <typename KEY>
+void partitionedHashJoin(const std::vector<KEY>& probeKeys, const std::vector<KEY>& buildKeys,
+                         uint32_t bits, size_t threads,
+                         storage::pos_list_t& probeRows, storage::pos_list_t& buildRows) {
+  const auto probe = partition(buildTuples(probeKeys, threads), bits, threads);
+  const auto build = partition(buildTuples(buildKeys, threads), bits, threads);
+
+  const size_t partitions = size_t(1) << bits;
+  std::vector<size_t> order(partitions);
+  for (size_t p = 0; p < partitions; ++p)
+    order[p] = p;
+  auto work = [&] (size_t p) {
+    return (build.offsets[p + 1] - build.offsets[p]) + (probe.offsets[p + 1] - probe.offsets[p]);
+  };
+  std::stable_sort(order.begin(), order.end(), [&work] (size_t a, size_t b) { return work(a) > work(b); });
+
+  std::vector<storage::pos_list_t> probeResults(partitions), buildResults(partitions);
+  std::atomic<size_t> next(0);
+  taskscheduler::runParallel(std::min(threads, partitions), [&] (size_t) {
+    static const uint32_t EMPTY = static_cast<uint32_t>(-1);
+    std::vector<uint32_t> heads, chain;
+    for (size_t i = next++; i < partitions; i = next++) {
+      const size_t p = order[i];
+      const auto buildFirst = build.tuples.data() + build.offsets[p];
+      const size_t buildCount = build.offsets[p + 1] - build.offsets[p];
+      if (buildCount == 0 || probe.offsets[p + 1] == probe.offsets[p])
+        continue;
+
+      // the radix bits are equal within a partition, buckets use the low bits
+      size_t buckets = 1;
+      while (buckets < buildCount)
+        buckets <<= 1;
+      const uint64_t mask = buckets - 1;
+      heads.assign(buckets, EMPTY);
+      chain.resize(buildCount);
+      for (uint32_t b = 0; b < buildCount; ++b) {
+        auto& head = heads[buildFirst[b].hash & mask];
+        chain[b] = head;
+        head = b;
+      }
+
+      auto& probeResult = probeResults[p];
+      auto& buildResult = buildResults[p];
+      for (size_t t = probe.offsets[p]; t < probe.offsets[p + 1]; ++t) {
+        const auto& tuple = probe.tuples[t];
+        for (uint32_t b = heads[tuple.hash & mask]; b != EMPTY; b = chain[b]) {
+          if (buildFirst[b].hash == tuple.hash && probeKeys[tuple.row] == buildKeys[buildFirst[b].row]) {
+            probeResult.push_back(tuple.row);
+            buildResult.push_back(buildFirst[b].row);
+          }
+        }
+      }
+    }
+  });
+
+  size_t matches = 0;
+  for (const auto& result : probeResults)
+    matches += result.size();
+  probeRows.reserve(probeRows.size() + matches);
+  buildRows.reserve(buildRows.size() + matches);
+  for (size_t p = 0; p < partitions; ++p) {
+    probeRows.insert(probeRows.end(), probeResults[p].begin(), probeResults[p].end());
+    buildRows.insert(buildRows.end(), buildResults[p].begin(), buildResults[p].end());
+  }
+}
+
+}
+}
+}
+
+#endif  // SRC_LIB_ACCESS_RADIXJOIN_PARTITIONEDHASHJOIN_H_
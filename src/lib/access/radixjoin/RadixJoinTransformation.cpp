@@ -278,6 +278,10 @@ void RadixJoinTransformation::distributePartitions(
 }
 
 void RadixJoinTransformation::transform(Json::Value &op, const std::string &operatorId, Json::Value &query){
+  // without radix bits the join runs as a single operator
+  if (!op.isMember("bits1"))
+    return;
+
   int probe_par = op["probe_par"].asInt();
   int hash_par = op["hash_par"].asInt();
   int join_par = op["join_par"].asInt();
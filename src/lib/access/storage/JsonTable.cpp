@@ -82,13 +82,11 @@ void JsonTable::executePlanOperation() {
 	size_t rows = _data.size();
 	if (rows > 0 ) {
 
-		if (_useStoreFlag)
-			std::dynamic_pointer_cast<storage::Store>(result)->appendToDelta(rows);
-		else
-			result->resize(rows);
+		// Rows for a store are collected in a batch and appended at once
+		storage::atable_ptr_t target = _useStoreFlag ? result->copy_structure_modifiable() : result;
+		target->resize(rows);
 
-
-		set_string_value_functor fun(_useStoreFlag ? std::dynamic_pointer_cast<storage::Store>(result)->getDeltaTable() : result);
+		set_string_value_functor fun(target);
 		storage::type_switch<hyrise_basic_types> ts;
 
 
@@ -104,16 +102,18 @@ void JsonTable::executePlanOperation() {
 				if (std::find(_serialFields.begin(), _serialFields.end(), _names[j]) != _serialFields.end()) {
 					auto serial_name = std::to_string(result->getUuid()) + "_" + _names[j];
 					auto ser = res_man.get<storage::Serial>(serial_name);
-					result->setValue<hyrise_int_t>(j, i, ser->next());
+					target->setValue<hyrise_int_t>(j, i, ser->next());
 					offset++;
 				} else {
 					fun.set(j, i, row[j-offset]);
-					ts(result->typeOfColumn(j), fun);
+					ts(target->typeOfColumn(j), fun);
 				}
 			}
 		}
 
 		if (_useStoreFlag) {
+			std::dynamic_pointer_cast<storage::Store>(result)->appendRowsToDelta(target, tx::START_TID);
+
 			// Hijacking transactions
 			pos_list_t pl(rows);
 			size_t counter = 0;
@@ -26,8 +26,13 @@ void DumpTable::executePlanOperation() {
   // First merge to avoid trouble
   const auto& tab = std::const_pointer_cast<storage::Store>(c_tab);
   tab->merge();
-  storage::SimpleTableDump dump(Settings::getInstance()->getDBPath());
-  dump.dump(_name, tab);
+  if (_mapped) {
+    storage::MappedTableDump dump(Settings::getInstance()->getDBPath());
+    dump.dump(_name, tab);
+  } else {
+    storage::SimpleTableDump dump(Settings::getInstance()->getDBPath());
+    dump.dump(_name, tab);
+  }
 
   // No Output here
 }
@@ -35,20 +40,28 @@ void DumpTable::executePlanOperation() {
 std::shared_ptr<PlanOperation> DumpTable::parse(const Json::Value& data) {
   const auto& pop = std::make_shared<DumpTable>();
   pop->_name = data["name"].asString(); 
+  pop->_mapped = data["mapped"].asBool();
   return pop;
 }
 
 void LoadDumpedTable::executePlanOperation() {
-  io::TableDumpLoader input(Settings::getInstance()->getDBPath(), _name);
   io::CSVHeader header(Settings::getInstance()->getDBPath() + "/" + _name + "/header.dat", io::CSVHeader::params().setCSVParams(io::csv::HYRISE_FORMAT));
 
-  auto t = io::Loader::load(io::Loader::params().setInput(input).setHeader(header));
+  storage::atable_ptr_t t;
+  if (_mapped) {
+    io::MappedTableDumpLoader input(Settings::getInstance()->getDBPath(), _name);
+    t = io::Loader::load(io::Loader::params().setInput(input).setHeader(header));
+  } else {
+    io::TableDumpLoader input(Settings::getInstance()->getDBPath(), _name);
+    t = io::Loader::load(io::Loader::params().setInput(input).setHeader(header));
+  }
   addResult(checked_pointer_cast<storage::Store>(t));
 }
 
 std::shared_ptr<PlanOperation> LoadDumpedTable::parse(const Json::Value& data) {
   const auto& pop = std::make_shared<LoadDumpedTable>();
   pop->_name = data["name"].asString();
+  pop->_mapped = data["mapped"].asBool();
   return pop;
 }
 
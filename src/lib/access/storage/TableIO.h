@@ -10,6 +10,8 @@ namespace access {
 class DumpTable : public PlanOperation {
 
   std::string _name;
+  // binary format that is loaded by mapping the files into memory
+  bool _mapped = false;
 
 public:
   virtual ~DumpTable() = default;
@@ -22,6 +24,8 @@ public:
 class LoadDumpedTable : public PlanOperation {
 
   std::string _name;
+  // binary format that is loaded by mapping the files into memory
+  bool _mapped = false;
 
 public:
   virtual ~LoadDumpedTable() = default;
@@ -7,6 +7,9 @@
 #include "io/shortcuts.h"
 #include "io/StorageManager.h"
 
+#include "storage/HorizontalTable.h"
+#include "storage/NumaPlacement.h"
+
 #include "log4cxx/logger.h"
 
 namespace hyrise {
@@ -20,7 +23,8 @@ namespace {
 TableLoad::TableLoad(): _hasDelimiter(false),
                         _binary(false),
                         _unsafe(false),
-                        _raw(false) {
+                        _raw(false),
+                        _numa(false) {
 }
 
 TableLoad::~TableLoad() {
@@ -60,6 +64,8 @@ void TableLoad::executePlanOperation() {
 
     // We don't load unless the necessary prerequisites are met,
     // let StorageManager error if table does not exist
+    if (_numa && sm->exists(_table_name))
+      sm->replaceTable(_table_name, storage::placeOnAllNodes(sm->getTable(_table_name)));
   } else {
     sm->getTable(_table_name);
   }
@@ -76,6 +82,7 @@ std::shared_ptr<PlanOperation> TableLoad::parse(const Json::Value &data) {
   s->setHeaderString(data["header_string"].asString());
   s->setUnsafe(data["unsafe"].asBool());
   s->setRaw(data["raw"].asBool());
+  s->setNuma(data["numa"].asBool());
   if (data.isMember("delimiter")) {
     s->setDelimiter(data["delimiter"].asString());
   }
@@ -114,6 +121,10 @@ void TableLoad::setRaw(const bool raw) {
   _raw = raw;
 }
 
+void TableLoad::setNuma(const bool numa) {
+  _numa = numa;
+}
+
 void TableLoad::setDelimiter(const std::string &d) {
   _delimiter = d;
   _hasDelimiter = true;
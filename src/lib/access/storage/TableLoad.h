@@ -29,6 +29,9 @@ public:
   void setUnsafe(const bool unsafe);
   void setRaw(const bool raw);
   void setDelimiter(const std::string &d);
+  /// Place the partitions of the loaded table on all numa nodes, the
+  /// table is read-only afterwards
+  void setNuma(const bool numa);
 
 private:
   std::string _table_name;
@@ -40,6 +43,7 @@ private:
   bool _binary;
   bool _unsafe;
   bool _raw;
+  bool _numa;
 };
 
 }
@@ -0,0 +1,638 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/ArrowStreamWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "helper/Epochs.h"
+#include "storage/AbstractDictionary.h"
+#include "storage/AbstractTable.h"
+#include "storage/BaseDictionary.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/TableRangeView.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+/*
+  Minimal flatbuffers encoder for the metadata of Arrow messages. A
+  FlatValue describes a table, string or vector; FlatWriter lays them
+  out front to back, every table is followed by the objects it refers
+  to, since offsets in a flatbuffer always point forward.
+ */
+struct FlatValue {
+  enum Kind { SCALAR, TABLE, STRING, TABLES, STRUCTS };
+
+  Kind kind;
+  // value of a SCALAR, text of a STRING, elements of STRUCTS
+  std::string bytes;
+  // alignment of a SCALAR or of the elements of STRUCTS
+  size_t align;
+  // elements of STRUCTS
+  size_t count;
+  // slots of the fields of a TABLE and their values
+  std::vector<size_t> slots;
+  std::vector<FlatValue> values;
+
+  explicit FlatValue(Kind k = TABLE) : kind(k), align(1), count(0) {}
+
+  FlatValue &field(size_t slot, const FlatValue &value) {
+    slots.push_back(slot);
+    values.push_back(value);
+    return *this;
+  }
+};
+
+template <typename T>
+FlatValue flatScalar(T value) {
+  FlatValue result(FlatValue::SCALAR);
+  result.bytes.assign(reinterpret_cast<const char *>(&value), sizeof(T));
+  result.align = sizeof(T);
+  return result;
+}
+
+FlatValue flatString(const std::string &text) {
+  FlatValue result(FlatValue::STRING);
+  result.bytes = text;
+  return result;
+}
+
+FlatValue flatTables(const std::vector<FlatValue> &tables) {
+  FlatValue result(FlatValue::TABLES);
+  result.values = tables;
+  return result;
+}
+
+template <typename S>
+FlatValue flatStructs(const std::vector<S> &structs) {
+  FlatValue result(FlatValue::STRUCTS);
+  result.bytes.assign(reinterpret_cast<const char *>(structs.data()), structs.size() * sizeof(S));
+  result.align = 8;
+  result.count = structs.size();
+  return result;
+}
+
+class FlatWriter {
+ public:
+  /// Flatbuffer with root as its root table, padded to 8 bytes
+  std::string finish(const FlatValue &root) {
+    _out.assign(sizeof(uint32_t), '\0');
+    patch<uint32_t>(0, write(root));
+    pad(8);
+    return _out;
+  }
+
+ private:
+  void pad(size_t alignment) {
+    _out.resize((_out.size() + alignment - 1) / alignment * alignment, '\0');
+  }
+
+  template <typename T>
+  void put(T value) {
+    _out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  void patch(size_t pos, T value) {
+    std::memcpy(&_out[pos], &value, sizeof(T));
+  }
+
+  // reserves a forward offset at the end of the buffer
+  size_t offsetSlot() {
+    pad(sizeof(uint32_t));
+    const size_t pos = _out.size();
+    put<uint32_t>(0);
+    return pos;
+  }
+
+  void link(size_t slot, const FlatValue &value) {
+    const size_t target = write(value);
+    patch<uint32_t>(slot, target - slot);
+  }
+
+  size_t write(const FlatValue &value) {
+    size_t pos;
+    switch (value.kind) {
+      case FlatValue::STRING:
+        pos = offsetSlot();
+        patch<uint32_t>(pos, value.bytes.size());
+        _out.append(value.bytes);
+        _out.push_back('\0');
+        return pos;
+      case FlatValue::STRUCTS:
+        // the elements following the length are aligned
+        while ((_out.size() + sizeof(uint32_t)) % value.align != 0)
+          _out.push_back('\0');
+        pos = _out.size();
+        put<uint32_t>(value.count);
+        _out.append(value.bytes);
+        return pos;
+      case FlatValue::TABLES: {
+        pos = offsetSlot();
+        patch<uint32_t>(pos, value.values.size());
+        std::vector<size_t> elements;
+        for (size_t i = 0; i < value.values.size(); ++i)
+          elements.push_back(offsetSlot());
+        for (size_t i = 0; i < value.values.size(); ++i)
+          link(elements[i], value.values[i]);
+        return pos;
+      }
+      case FlatValue::TABLE:
+        return writeTable(value);
+      default:
+        throw std::runtime_error("FlatWriter: scalars are only written as fields of tables");
+    }
+  }
+
+  size_t writeTable(const FlatValue &table) {
+    size_t slots = 0;
+    for (const auto &slot : table.slots)
+      slots = std::max(slots, slot + 1);
+
+    pad(sizeof(uint16_t));
+    const size_t vtable = _out.size();
+    put<uint16_t>(sizeof(uint16_t) * (2 + slots));
+    put<uint16_t>(0);
+    _out.append(sizeof(uint16_t) * slots, '\0');
+
+    pad(8);
+    const size_t pos = _out.size();
+    put<int32_t>(pos - vtable);
+    std::vector<size_t> references(table.values.size());
+    for (size_t i = 0; i < table.values.size(); ++i) {
+      const auto &value = table.values[i];
+      size_t field;
+      if (value.kind == FlatValue::SCALAR) {
+        pad(value.align);
+        field = _out.size();
+        _out.append(value.bytes);
+      } else {
+        field = references[i] = offsetSlot();
+      }
+      patch<uint16_t>(vtable + sizeof(uint16_t) * (2 + table.slots[i]), field - pos);
+    }
+    patch<uint16_t>(vtable + sizeof(uint16_t), _out.size() - pos);
+
+    for (size_t i = 0; i < table.values.size(); ++i) {
+      if (table.values[i].kind != FlatValue::SCALAR)
+        link(references[i], table.values[i]);
+    }
+    return pos;
+  }
+
+  std::string _out;
+};
+
+// Arrow metadata, see Schema.fbs and Message.fbs of the Arrow format
+const int16_t METADATA_V5 = 4;
+const uint8_t HEADER_SCHEMA = 1;
+const uint8_t HEADER_DICTIONARY_BATCH = 2;
+const uint8_t HEADER_RECORD_BATCH = 3;
+const uint8_t TYPE_INT = 2;
+const uint8_t TYPE_FLOATING_POINT = 3;
+const uint8_t TYPE_UTF8 = 5;
+const int16_t PRECISION_SINGLE = 1;
+const uint32_t CONTINUATION = 0xFFFFFFFF;
+
+struct FieldNode {
+  int64_t length;
+  int64_t null_count;
+};
+
+struct BufferSpec {
+  int64_t offset;
+  int64_t length;
+};
+
+FlatValue intType(int32_t bitWidth) {
+  return FlatValue().field(0, flatScalar<int32_t>(bitWidth)).field(1, flatScalar<uint8_t>(1));
+}
+
+FlatValue schemaField(const std::string &name, uint8_t typeType, const FlatValue &type) {
+  return FlatValue()
+      .field(0, flatString(name))
+      .field(1, flatScalar<uint8_t>(0))
+      .field(2, flatScalar<uint8_t>(typeType))
+      .field(3, type)
+      .field(5, flatTables({}));
+}
+
+/// Body of a message, every buffer starts at a multiple of 8 bytes
+class Body {
+ public:
+  void add(const void *data, size_t length) {
+    _buffers.push_back({static_cast<int64_t>(_bytes.size()), static_cast<int64_t>(length)});
+    _bytes.append(static_cast<const char *>(data), length);
+    _bytes.resize((_bytes.size() + 7) / 8 * 8, '\0');
+  }
+
+  /// Validity bitmap of a column without nulls
+  void addNoNulls() {
+    add(nullptr, 0);
+  }
+
+  void addNode(size_t length) {
+    _nodes.push_back({static_cast<int64_t>(length), 0});
+  }
+
+  /// RecordBatch table of the nodes and buffers added
+  FlatValue recordBatch(size_t length) const {
+    return FlatValue()
+        .field(0, flatScalar<int64_t>(length))
+        .field(1, flatStructs(_nodes))
+        .field(2, flatStructs(_buffers));
+  }
+
+  const std::string &bytes() const { return _bytes; }
+
+ private:
+  std::string _bytes;
+  std::vector<FieldNode> _nodes;
+  std::vector<BufferSpec> _buffers;
+};
+
+void writeMessage(net::AbstractConnection *connection, uint8_t headerType, const FlatValue &header,
+                  const std::string &body) {
+  const std::string metadata = FlatWriter().finish(FlatValue()
+      .field(0, flatScalar<int16_t>(METADATA_V5))
+      .field(1, flatScalar<uint8_t>(headerType))
+      .field(2, header)
+      .field(3, flatScalar<int64_t>(body.size())));
+  const uint32_t prefix[2] = {CONTINUATION, static_cast<uint32_t>(metadata.size())};
+  connection->writeStream(reinterpret_cast<const char *>(prefix), sizeof(prefix));
+  connection->writeStream(metadata.data(), metadata.size());
+  connection->writeStream(body.data(), body.size());
+}
+
+/*
+  Rows [first, last) of the written table whose column uses one
+  dictionary, nullptr if the structure of the table does not tell. If the
+  value ids of the rows lie in a bit compressed vector, they start at row
+  packedRow of column packedColumn of packed and are unpacked in bulk.
+ */
+struct ColumnRange {
+  size_t first;
+  size_t last;
+  storage::AbstractTable::SharedDictionaryPtr dictionary;
+  std::shared_ptr<const storage::BitCompressedVector<value_id_t> > packed;
+  size_t packedColumn;
+  size_t packedRow;
+};
+
+/// Appends the ranges of the rows [first, last) of column of table, which
+/// are the rows starting at row outer of the written table
+void addRanges(const storage::c_atable_ptr_t &table, size_t column, size_t first, size_t last, size_t outer,
+               std::vector<ColumnRange> &ranges) {
+  if (first == last)
+    return;
+  if (const auto store = std::dynamic_pointer_cast<const storage::Store>(table)) {
+    // rows up to the end of the main are read from the main
+    const storage::c_atable_ptr_t main = store->getMainTable();
+    const size_t split = std::min(last, std::max(first, main->size()));
+    addRanges(main, column, first, split, outer, ranges);
+    addRanges(store->getDeltaTable(), column, split - store->deltaOffset(), last - store->deltaOffset(),
+              outer + (split - first), ranges);
+    return;
+  }
+  if (const auto view = std::dynamic_pointer_cast<const storage::TableRangeView>(table)) {
+    addRanges(view->getTable(), column, view->getStart() + first, view->getStart() + last, outer, ranges);
+    return;
+  }
+  if (const auto vertical = std::dynamic_pointer_cast<const storage::MutableVerticalTable>(table)) {
+    addRanges(vertical->containerAt(column), vertical->getOffsetInContainer(column), first, last, outer, ranges);
+    return;
+  }
+
+  ColumnRange range {outer, outer + (last - first), nullptr, nullptr, 0, 0};
+  if (std::dynamic_pointer_cast<const storage::Table>(table)) {
+    range.dictionary = table->dictionaryAt(column);
+    const auto vectors = table->getAttributeVectors(column);
+    if (vectors.size() == 1) {
+      range.packed = std::dynamic_pointer_cast<const storage::BitCompressedVector<value_id_t> >(vectors.front().attribute_vector);
+      range.packedColumn = vectors.front().attribute_offset;
+      range.packedRow = first;
+    }
+  } else if (const auto pointers = std::dynamic_pointer_cast<const storage::PointerCalculator>(table)) {
+    // the rows share a dictionary if the range of their positions does
+    size_t low = pointers->getTableRowForRow(first), high = low;
+    for (size_t row = first + 1; row < last; ++row) {
+      const size_t position = pointers->getTableRowForRow(row);
+      low = std::min(low, position);
+      high = std::max(high, position);
+    }
+    std::vector<ColumnRange> underlying;
+    addRanges(pointers->getTable(), pointers->getTableColumnForColumn(column), low, high + 1, 0, underlying);
+    if (underlying.size() == 1)
+      range.dictionary = underlying.front().dictionary;
+  }
+  ranges.push_back(range);
+}
+
+/// Ranges of the rows [first, last) of column, in order of the rows
+std::vector<ColumnRange> columnRanges(const storage::c_atable_ptr_t &table, size_t column, size_t first, size_t last) {
+  std::vector<ColumnRange> ranges;
+  if (table->typeOfColumn(column) >= IntegerNoDictType) {
+    if (first < last)
+      ranges.push_back({first, last, nullptr, nullptr, 0, 0});
+    return ranges;
+  }
+  addRanges(table, column, first, last, first, ranges);
+  return ranges;
+}
+
+/// Ordered dictionary of all ranges, if it has at most as many values as
+/// the ranges have rows, nullptr otherwise
+storage::AbstractTable::SharedDictionaryPtr sentDictionary(const std::vector<ColumnRange> &ranges) {
+  if (ranges.empty())
+    return nullptr;
+  const auto &dictionary = ranges.front().dictionary;
+  if (!dictionary || !dictionary->isOrdered() || dictionary->size() > ranges.back().last - ranges.front().first)
+    return nullptr;
+  for (const auto &range : ranges) {
+    if (range.dictionary != dictionary)
+      return nullptr;
+  }
+  return dictionary;
+}
+
+class ColumnEncoder {
+ public:
+  ColumnEncoder(const storage::c_atable_ptr_t &table, size_t column, size_t first, size_t last)
+      : _table(table), _column(column), _ranges(columnRanges(table, column, first, last)) {}
+  virtual ~ColumnEncoder() {}
+
+  /// Field of the column in the schema
+  virtual FlatValue field() const = 0;
+  virtual bool hasDictionary() const { return false; }
+  /// Adds the dictionary values to body and returns their number
+  virtual size_t addDictionary(Body &body) const { return 0; }
+  /// Adds the rows [first, last) of the table to body
+  virtual void addRows(Body &body, size_t first, size_t last) const = 0;
+
+ protected:
+  /// Calls fun(range, from, to) for the rows [from, to) of every range
+  /// within [first, last)
+  template <typename F>
+  void forEachRange(size_t first, size_t last, F fun) const {
+    auto range = std::partition_point(_ranges.begin(), _ranges.end(),
+                                      [first] (const ColumnRange &r) { return r.last <= first; });
+    for (; range != _ranges.end() && range->first < last; ++range)
+      fun(*range, std::max(first, range->first), std::min(last, range->last));
+  }
+
+  /// Value ids of the rows [from, to) of range, which has a dictionary
+  void valueIds(const ColumnRange &range, size_t from, size_t to, value_id_t *out) const {
+    if (range.packed) {
+      range.packed->decode(range.packedColumn, range.packedRow + (from - range.first),
+                           range.packedRow + (to - range.first), out);
+      return;
+    }
+    for (size_t row = from; row < to; ++row)
+      *out++ = _table->getValueId(_column, row).valueId;
+  }
+
+  const storage::c_atable_ptr_t &_table;
+  const size_t _column;
+  const std::vector<ColumnRange> _ranges;
+};
+
+template <typename T>
+struct arrow_type;
+
+template <>
+struct arrow_type<hyrise_int_t> {
+  static uint8_t id() { return TYPE_INT; }
+  static FlatValue type() { return intType(64); }
+};
+
+template <>
+struct arrow_type<hyrise_int32_t> {
+  static uint8_t id() { return TYPE_INT; }
+  static FlatValue type() { return intType(32); }
+};
+
+template <>
+struct arrow_type<hyrise_float_t> {
+  static uint8_t id() { return TYPE_FLOATING_POINT; }
+  static FlatValue type() { return FlatValue().field(0, flatScalar<int16_t>(PRECISION_SINGLE)); }
+};
+
+template <typename T>
+class ValueEncoder : public ColumnEncoder {
+ public:
+  ValueEncoder(const storage::c_atable_ptr_t &table, size_t column, size_t first, size_t last)
+      : ColumnEncoder(table, column, first, last) {
+    // the values of a small dictionary are decoded once, in order
+    if ((_dictionary = sentDictionary(_ranges))) {
+      const auto &values = std::static_pointer_cast<storage::BaseDictionary<T>>(_dictionary);
+      _values.reserve(_dictionary->size());
+      for (auto it = values->begin(), end = values->end(); it != end; ++it)
+        _values.push_back(*it);
+    }
+  }
+
+  FlatValue field() const {
+    return schemaField(_table->nameOfColumn(_column), arrow_type<T>::id(), arrow_type<T>::type());
+  }
+
+  void addRows(Body &body, size_t first, size_t last) const {
+    std::vector<T> values(last - first);
+    std::vector<value_id_t> ids;
+    forEachRange(first, last, [&] (const ColumnRange &range, size_t from, size_t to) {
+      T *out = values.data() + (from - first);
+      if (!range.dictionary) {
+        for (size_t row = from; row < to; ++row)
+          *out++ = _table->getValue<T>(_column, row);
+        return;
+      }
+      ids.resize(to - from);
+      valueIds(range, from, to, ids.data());
+      if (range.dictionary == _dictionary) {
+        for (const auto id : ids)
+          *out++ = _values[id];
+      } else {
+        const auto &dictionary = std::static_pointer_cast<storage::BaseDictionary<T>>(range.dictionary);
+        for (const auto id : ids)
+          *out++ = dictionary->getValueForValueId(id);
+      }
+    });
+    body.addNode(last - first);
+    body.addNoNulls();
+    body.add(values.data(), values.size() * sizeof(T));
+  }
+
+ private:
+  storage::AbstractTable::SharedDictionaryPtr _dictionary;
+  std::vector<T> _values;
+};
+
+class StringEncoder : public ColumnEncoder {
+ public:
+  StringEncoder(const storage::c_atable_ptr_t &table, size_t column, size_t first, size_t last)
+      : ColumnEncoder(table, column, first, last), _first(first), _ordered(false) {
+    if (const auto &dictionary = sentDictionary(_ranges)) {
+      const auto &values = std::static_pointer_cast<storage::BaseDictionary<hyrise_string_t>>(dictionary);
+      _ordered = true;
+      // front coded strings are decoded one after the other
+      _values.reserve(dictionary->size());
+      for (auto it = values->begin(), end = values->end(); it != end; ++it)
+        _values.push_back(*it);
+      return;
+    }
+
+    std::unordered_map<hyrise_string_t, int32_t> indices;
+    auto indexOf = [&] (const hyrise_string_t &value) {
+      const auto inserted = indices.insert({value, _values.size()});
+      if (inserted.second)
+        _values.push_back(value);
+      return inserted.first->second;
+    };
+    _indices.resize(last - first);
+    std::vector<value_id_t> ids;
+    forEachRange(first, last, [&] (const ColumnRange &range, size_t from, size_t to) {
+      int32_t *out = _indices.data() + (from - first);
+      if (!range.dictionary) {
+        for (size_t row = from; row < to; ++row)
+          *out++ = indexOf(_table->getValue<hyrise_string_t>(_column, row));
+        return;
+      }
+      // every value id of the range is decoded once
+      const auto &dictionary = std::static_pointer_cast<storage::BaseDictionary<hyrise_string_t>>(range.dictionary);
+      std::unordered_map<value_id_t, int32_t> known;
+      ids.resize(to - from);
+      valueIds(range, from, to, ids.data());
+      for (const auto id : ids) {
+        const auto inserted = known.insert({id, 0});
+        if (inserted.second)
+          inserted.first->second = indexOf(dictionary->getValueForValueId(id));
+        *out++ = inserted.first->second;
+      }
+    });
+  }
+
+  FlatValue field() const {
+    return schemaField(_table->nameOfColumn(_column), TYPE_UTF8, FlatValue())
+        .field(4, FlatValue()
+               .field(0, flatScalar<int64_t>(_column))
+               .field(1, intType(32))
+               .field(2, flatScalar<uint8_t>(_ordered)));
+  }
+
+  bool hasDictionary() const { return true; }
+
+  size_t addDictionary(Body &body) const {
+    std::vector<int32_t> offsets(1, 0);
+    std::string data;
+    for (const auto &value : _values) {
+      data.append(value);
+      offsets.push_back(data.size());
+    }
+    body.addNode(_values.size());
+    body.addNoNulls();
+    body.add(offsets.data(), offsets.size() * sizeof(int32_t));
+    body.add(data.data(), data.size());
+    return _values.size();
+  }
+
+  void addRows(Body &body, size_t first, size_t last) const {
+    body.addNode(last - first);
+    body.addNoNulls();
+    if (_ordered) {
+      // value ids are the indices, int32 and value_id_t share their width
+      static_assert(sizeof(value_id_t) == sizeof(int32_t), "Value ids are sent as int32 indices");
+      std::vector<value_id_t> indices(last - first);
+      forEachRange(first, last, [&] (const ColumnRange &range, size_t from, size_t to) {
+        valueIds(range, from, to, indices.data() + (from - first));
+      });
+      body.add(indices.data(), indices.size() * sizeof(int32_t));
+    } else {
+      body.add(_indices.data() + (first - _first), (last - first) * sizeof(int32_t));
+    }
+  }
+
+ private:
+  const size_t _first;
+  bool _ordered;
+  std::vector<hyrise_string_t> _values;
+  // index into _values of every row, unless the table's dictionary is sent
+  std::vector<int32_t> _indices;
+};
+
+std::unique_ptr<ColumnEncoder> makeEncoder(const storage::c_atable_ptr_t &table, size_t column, size_t first, size_t last) {
+  switch (table->typeOfColumn(column)) {
+    case IntegerType:
+    case IntegerTypeDelta:
+    case IntegerTypeDeltaConcurrent:
+      return std::unique_ptr<ColumnEncoder>(new ValueEncoder<hyrise_int_t>(table, column, first, last));
+    case IntegerNoDictType:
+      return std::unique_ptr<ColumnEncoder>(new ValueEncoder<hyrise_int32_t>(table, column, first, last));
+    case FloatType:
+    case FloatTypeDelta:
+    case FloatTypeDeltaConcurrent:
+    case FloatNoDictType:
+      return std::unique_ptr<ColumnEncoder>(new ValueEncoder<hyrise_float_t>(table, column, first, last));
+    case StringType:
+    case StringTypeDelta:
+    case StringTypeDeltaConcurrent:
+      return std::unique_ptr<ColumnEncoder>(new StringEncoder(table, column, first, last));
+    default:
+      throw std::runtime_error("Arrow: unsupported type of column " + table->nameOfColumn(column));
+  }
+}
+
+}  // namespace
+
+void writeArrowStream(net::AbstractConnection *connection, const storage::c_atable_ptr_t &table,
+                      size_t limit, size_t offset, const std::string &metadata, size_t batchRows) {
+  // stores are read from one main throughout the stream
+  EpochGuard pin;
+  const size_t first = std::min(offset, table->size());
+  const size_t last = limit > 0 ? std::min(table->size(), first + limit) : table->size();
+
+  std::vector<std::unique_ptr<ColumnEncoder>> encoders;
+  std::vector<FlatValue> fields;
+  for (size_t column = 0; column < table->columnCount(); ++column) {
+    encoders.push_back(makeEncoder(table, column, first, last));
+    fields.push_back(encoders.back()->field());
+  }
+
+  const FlatValue keyValue = FlatValue().field(0, flatString("hyrise")).field(1, flatString(metadata));
+  writeMessage(connection, HEADER_SCHEMA, FlatValue()
+               .field(0, flatScalar<int16_t>(0))
+               .field(1, flatTables(fields))
+               .field(2, flatTables({keyValue})), "");
+
+  for (size_t column = 0; column < encoders.size(); ++column) {
+    if (!encoders[column]->hasDictionary())
+      continue;
+    Body body;
+    const size_t length = encoders[column]->addDictionary(body);
+    writeMessage(connection, HEADER_DICTIONARY_BATCH, FlatValue()
+                 .field(0, flatScalar<int64_t>(column))
+                 .field(1, body.recordBatch(length))
+                 .field(2, flatScalar<uint8_t>(0)), body.bytes());
+  }
+
+  for (size_t batch = first; batch < last; batch += batchRows) {
+    const size_t batchLast = std::min(last, batch + batchRows);
+    Body body;
+    for (const auto &encoder : encoders)
+      encoder->addRows(body, batch, batchLast);
+    writeMessage(connection, HEADER_RECORD_BATCH, body.recordBatch(batchLast - batch), body.bytes());
+  }
+
+  const uint32_t endOfStream[2] = {CONTINUATION, 0};
+  connection->writeStream(reinterpret_cast<const char *>(endOfStream), sizeof(endOfStream));
+}
+
+} } // namespace hyrise::access
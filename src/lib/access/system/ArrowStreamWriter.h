@@ -0,0 +1,43 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SYSTEM_ARROWSTREAMWRITER_H_
+#define SRC_LIB_ACCESS_SYSTEM_ARROWSTREAMWRITER_H_
+
+#include <string>
+
+#include "helper/types.h"
+#include "net/AbstractConnection.h"
+
+namespace hyrise {
+namespace access {
+
+/// Content type of responses in the Arrow IPC streaming format
+static const std::string ARROW_STREAM_CONTENT_TYPE = "application/vnd.apache.arrow.stream";
+
+/// Rows of a record batch unless the caller asks for another size
+static const size_t ARROW_BATCH_ROWS = 64 * 1024;
+
+/*
+  Writes the rows [offset, offset + limit) of table, all rows after
+  offset if limit is 0, to the streamed response of connection in the
+  Arrow IPC streaming format: the schema, a dictionary batch for every
+  string column, record batches of up to batchRows rows and the end of
+  stream marker. Integer columns become int64 (int32 without
+  dictionary), float columns float32 and string columns dictionary
+  encoded utf8 with int32 indices. metadata is attached to the schema as
+  custom metadata with the key "hyrise".
+
+  Columns whose rows share an ordered dictionary, like those of a main
+  partition, are sent with that dictionary if it is not larger than the
+  rows written; the value ids are the indices of the rows. All other
+  columns are decoded through the dictionaries of their partitions,
+  string columns into a dictionary in order of first occurrence. Value
+  ids of bit compressed partitions are unpacked in bulk, and stores are
+  read from the main of one epoch.
+ */
+void writeArrowStream(net::AbstractConnection *connection, const storage::c_atable_ptr_t &table,
+                      size_t limit, size_t offset, const std::string &metadata,
+                      size_t batchRows = ARROW_BATCH_ROWS);
+
+} } // namespace hyrise::access
+
+#endif  // SRC_LIB_ACCESS_SYSTEM_ARROWSTREAMWRITER_H_
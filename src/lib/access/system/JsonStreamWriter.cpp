@@ -0,0 +1,209 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/JsonStreamWriter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "storage/AbstractTable.h"
+#include "storage/FrontCodedDictionary.h"
+#include "storage/SimpleStore.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Writes the decimal digits of v backwards from end, returns the first
+char *formatUnsigned(uint64_t v, char *end) {
+  while (v >= 100) {
+    const size_t pair = (v % 100) * 2;
+    v /= 100;
+    *--end = DIGIT_PAIRS[pair + 1];
+    *--end = DIGIT_PAIRS[pair];
+  }
+  if (v >= 10) {
+    *--end = DIGIT_PAIRS[v * 2 + 1];
+    *--end = DIGIT_PAIRS[v * 2];
+  } else {
+    *--end = static_cast<char>('0' + v);
+  }
+  return end;
+}
+
+template <typename T>
+struct write_value_functor {
+  typedef void value_type;
+
+  JsonStreamWriter &writer;
+  const T &table;
+  size_t column;
+  size_t row;
+
+  write_value_functor(JsonStreamWriter &w, const T &t) : writer(w), table(t), column(0), row(0) {}
+
+  template <typename R>
+  value_type operator()() {
+    writer.value(table->template getValue<R>(column, row));
+  }
+};
+
+/*
+  Writes the values of a string column. Front coded values are decoded
+  into a reused buffer instead of a new string per row, the dictionary
+  of the previous row is remembered to avoid a cast per row.
+ */
+class StringColumnWriter {
+  typedef storage::FrontCodedDictionary front_coded_t;
+
+  const storage::AbstractDictionary *_last = nullptr;
+  const front_coded_t *_frontCoded = nullptr;
+  std::string _buffer;
+
+ public:
+  template <typename T>
+  void write(JsonStreamWriter &writer, const T &table, size_t column, size_t row) {
+    const auto valueId = table->getValueId(column, row);
+    if (valueId.table == 0) {
+      const auto *dictionary = table->dictionaryAt(column, row).get();
+      if (dictionary != _last) {
+        _last = dictionary;
+        _frontCoded = dynamic_cast<const front_coded_t *>(dictionary);
+      }
+      if (_frontCoded != nullptr) {
+        _frontCoded->decodeValue(valueId.valueId, _buffer);
+        writer.value(_buffer);
+        return;
+      }
+    }
+    writer.value(table->template getValueForValueId<hyrise_string_t>(column, valueId, row));
+  }
+};
+
+template <typename T>
+void writeRowsJsonT(JsonStreamWriter &writer, const T &table, size_t limit, size_t offset) {
+  storage::type_switch<hyrise_basic_types> ts;
+  write_value_functor<T> fun(writer, table);
+  std::vector<StringColumnWriter> strings(table->columnCount());
+  const size_t last = limit > 0 ? std::min(table->size(), offset + limit) : table->size();
+  writer.raw("[", 1);
+  for (size_t row = offset; row < last; ++row) {
+    writer.raw(row == offset ? "[" : ",[", row == offset ? 1 : 2);
+    fun.row = row;
+    for (size_t col = 0; col < table->columnCount(); ++col) {
+      if (col > 0)
+        writer.raw(",", 1);
+      const auto type = table->typeOfColumn(col);
+      if (types::getOrderedType(type) == StringType) {
+        strings[col].write(writer, table, col, row);
+        continue;
+      }
+      fun.column = col;
+      ts(type, fun);
+    }
+    writer.raw("]", 1);
+  }
+  writer.raw("]", 1);
+}
+
+}  // namespace
+
+JsonStreamWriter::JsonStreamWriter(net::AbstractConnection *connection, size_t chunkSize)
+    : _connection(connection), _chunkSize(chunkSize) {
+  _buffer.reserve(_chunkSize);
+}
+
+void JsonStreamWriter::raw(const char *text, size_t length) {
+  while (length > 0) {
+    if (_buffer.size() == _chunkSize)
+      flush();
+    const size_t part = std::min(length, _chunkSize - _buffer.size());
+    _buffer.append(text, part);
+    text += part;
+    length -= part;
+  }
+}
+
+void JsonStreamWriter::value(int64_t v) {
+  char digits[24];
+  char *end = digits + sizeof(digits);
+  // negate in unsigned arithmetic, -INT64_MIN does not fit into int64_t
+  char *first = formatUnsigned(v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v), end);
+  if (v < 0)
+    *--first = '-';
+  raw(first, end - first);
+}
+
+void JsonStreamWriter::value(double v) {
+  // %.16g prints integral values below 10^16 without a fraction, the
+  // digits of these are formatted without going through printf
+  if (v > -1e15 && v < 1e15 && v == std::floor(v) && !(v == 0 && std::signbit(v))) {
+    value(static_cast<int64_t>(v));
+    return;
+  }
+  char text[32];
+  const int length = snprintf(text, sizeof(text), "%.16g", v);
+  raw(text, length);
+}
+
+void JsonStreamWriter::value(const std::string &v) {
+  static const char HEX[] = "0123456789ABCDEF";
+  put('"');
+  const char *run = v.data();
+  const char *end = v.data() + v.size();
+  // copies runs of characters that need no escaping as a whole
+  for (const char *c = run; c != end; ++c) {
+    const unsigned char u = static_cast<unsigned char>(*c);
+    if (u >= 0x20 && u != '"' && u != '\\')
+      continue;
+    raw(run, c - run);
+    run = c + 1;
+    put('\\');
+    switch (u) {
+      case '"': put('"'); break;
+      case '\\': put('\\'); break;
+      case '\b': put('b'); break;
+      case '\f': put('f'); break;
+      case '\n': put('n'); break;
+      case '\r': put('r'); break;
+      case '\t': put('t'); break;
+      default: {
+        const char escaped[] = {'u', '0', '0', HEX[u >> 4], HEX[u & 0xF]};
+        raw(escaped, sizeof(escaped));
+      }
+    }
+  }
+  raw(run, end - run);
+  put('"');
+}
+
+void JsonStreamWriter::flush() {
+  if (_buffer.empty())
+    return;
+  _connection->writeStream(_buffer.data(), _buffer.size());
+  _buffer.clear();
+}
+
+void writeRowsJson(JsonStreamWriter &writer, const storage::c_atable_ptr_t &table, size_t limit, size_t offset) {
+  if (const auto &store = std::dynamic_pointer_cast<const storage::SimpleStore>(table)) {
+    writeRowsJsonT(writer, store, limit, offset);
+  } else {
+    writeRowsJsonT(writer, table, limit, offset);
+  }
+}
+
+} } // namespace hyrise::access
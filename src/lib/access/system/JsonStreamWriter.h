@@ -0,0 +1,55 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SYSTEM_JSONSTREAMWRITER_H_
+#define SRC_LIB_ACCESS_SYSTEM_JSONSTREAMWRITER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "helper/types.h"
+#include "net/AbstractConnection.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+  Writes JSON text into a streamed response of a connection. The text
+  is collected in a buffer of chunkSize bytes that is handed to the
+  connection whenever it is full, so that the memory of a response does
+  not depend on its size. Numbers and strings are formatted the way
+  Json::FastWriter formats them.
+ */
+class JsonStreamWriter {
+ public:
+  explicit JsonStreamWriter(net::AbstractConnection *connection, size_t chunkSize = 64 * 1024);
+
+  void raw(const char *text, size_t length);
+  void raw(const std::string &text) { raw(text.data(), text.size()); }
+
+  void value(int64_t v);
+  void value(int32_t v) { value(static_cast<int64_t>(v)); }
+  void value(double v);
+  void value(float v) { value(static_cast<double>(v)); }
+  void value(const std::string &v);
+
+  /// Hands the buffered text to the connection
+  void flush();
+
+ private:
+  inline void put(char c) {
+    if (_buffer.size() == _chunkSize)
+      flush();
+    _buffer.push_back(c);
+  }
+
+  net::AbstractConnection *_connection;
+  const size_t _chunkSize;
+  std::string _buffer;
+};
+
+/// Writes the rows [offset, offset + limit) of table as a JSON array of
+/// arrays, all rows after offset if limit is 0
+void writeRowsJson(JsonStreamWriter &writer, const storage::c_atable_ptr_t &table, size_t limit, size_t offset);
+
+} } // namespace hyrise::access
+
+#endif  // SRC_LIB_ACCESS_SYSTEM_JSONSTREAMWRITER_H_
@@ -0,0 +1,22 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/MorselCursor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hyrise { namespace access {
+
+MorselCursor::MorselCursor(size_t morselSize) : _next(0), _morselSize(morselSize) {
+  if (morselSize == 0)
+    throw std::invalid_argument("Morsel size must be positive");
+}
+
+bool MorselCursor::next(size_t numberOfElements, size_t &first, size_t &last) {
+  first = _next.fetch_add(_morselSize, std::memory_order_relaxed);
+  if (first >= numberOfElements)
+    return false;
+  last = std::min(first + _morselSize, numberOfElements);
+  return true;
+}
+
+}}
@@ -0,0 +1,33 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SYSTEM_MORSELCURSOR_H_
+#define SRC_LIB_ACCESS_SYSTEM_MORSELCURSOR_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace hyrise { namespace access {
+
+/// Hands out consecutive ranges (morsels) of a fixed number of elements
+/// to all instances of a parallelized operator. The instances pull
+/// morsels until every element is taken, so faster instances simply
+/// process more of them.
+class MorselCursor {
+ public:
+  static const size_t DEFAULT_MORSEL_SIZE = 100000;
+
+  explicit MorselCursor(size_t morselSize = DEFAULT_MORSEL_SIZE);
+
+  /// Claims the next morsel [first, last) of numberOfElements elements,
+  /// returns false once all elements are claimed
+  bool next(size_t numberOfElements, size_t &first, size_t &last);
+
+  size_t morselSize() const { return _morselSize; }
+
+ private:
+  std::atomic<size_t> _next;
+  const size_t _morselSize;
+};
+
+}}
+
+#endif  // SRC_LIB_ACCESS_SYSTEM_MORSELCURSOR_H_
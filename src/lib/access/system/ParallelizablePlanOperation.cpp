@@ -1,6 +1,11 @@
 #include "access/system/ParallelizablePlanOperation.h"
 
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/HorizontalTable.h"
 #include "storage/TableRangeView.h"
+#include "taskscheduler/ParallelTasks.h"
 
 namespace hyrise {  namespace access {
 
@@ -14,10 +19,54 @@ std::pair<std::uint64_t, std::uint64_t> ParallelizablePlanOperation::distribute(
   return {first, last};
 }
 
+std::pair<std::uint64_t, std::uint64_t> ParallelizablePlanOperation::distribute(
+    const storage::HorizontalTable& table,
+    const std::size_t part,
+    const std::size_t count) {
+  const std::size_t parts = table.partCount();
+  if (count < parts) {
+    // every instance takes whole partitions
+    const std::size_t first = part * parts / count;
+    const std::size_t last = (part + 1) * parts / count;
+    return {table.partOffset(first), last == parts ? table.size() : table.partOffset(last)};
+  }
+  // instance i works on partition i * parts / count, the instances of a
+  // partition split its rows
+  const std::size_t partition = part * parts / count;
+  const std::size_t firstInstance = (partition * count + parts - 1) / parts;
+  const std::size_t instances = ((partition + 1) * count + parts - 1) / parts - firstInstance;
+  const auto r = distribute(table.part(partition)->size(), part - firstInstance, instances);
+  return {table.partOffset(partition) + r.first, table.partOffset(partition) + r.second};
+}
+
+std::shared_ptr<const storage::HorizontalTable> ParallelizablePlanOperation::placedInput() const {
+  storage::c_atable_ptr_t table;
+  if (input.numberOfTables() > 0) {
+    table = input.getTable(0);
+  } else if (!_dependencies.empty()) {
+    if (const auto& dependency = std::dynamic_pointer_cast<PlanOperation>(_dependencies[0]))
+      table = dependency->getResultTable();
+  }
+  const auto placed = std::dynamic_pointer_cast<const storage::HorizontalTable>(table);
+  return (placed && placed->isPlaced()) ? placed : nullptr;
+}
+
+int ParallelizablePlanOperation::getPreferredNode() const {
+  if (_count > 0 && !usesMorsels()) {
+    if (const auto table = placedInput()) {
+      const auto r = distribute(*table, _part, _count);
+      if (r.first < r.second)
+        return table->partNode(table->partForRow(r.first));
+    }
+  }
+  return PlanOperation::getPreferredNode();
+}
+
 void ParallelizablePlanOperation::splitInput() {
   const auto& tables = input.getTables();
-  if (_count > 0 && !tables.empty()) {
-    auto r = distribute(tables[0]->size(), _part, _count);
+  if (_count > 0 && !tables.empty() && !usesMorsels()) {
+    const auto placed = std::dynamic_pointer_cast<const storage::HorizontalTable>(tables[0]);
+    auto r = (placed && placed->isPlaced()) ? distribute(*placed, _part, _count) : distribute(tables[0]->size(), _part, _count);
     input.setTable(storage::TableRangeView::create(std::const_pointer_cast<storage::AbstractTable>(tables[0]), r.first, r.second), 0);
   }
 }
@@ -35,4 +84,71 @@ void ParallelizablePlanOperation::setCount(size_t count) {
   _count = count;
 }
 
+void ParallelizablePlanOperation::setMorselCursor(const std::shared_ptr<MorselCursor> &cursor) {
+  if (cursor && !supportsMorsels()) {
+    throw std::runtime_error(vname() + " does not support morsel-driven execution");
+  }
+  _morselCursor = cursor;
+}
+
+bool ParallelizablePlanOperation::usesMorsels() const {
+  return _morselCursor != nullptr;
+}
+
+bool ParallelizablePlanOperation::nextMorsel(size_t numberOfElements, size_t &first, size_t &last) {
+  return _morselCursor->next(numberOfElements, first, last);
+}
+
+size_t ParallelizablePlanOperation::morselWorkers() const {
+  return _count > 1 ? 1 : taskscheduler::parallelWorkers();
+}
+
+void ParallelizablePlanOperation::runMorselWorkers(const std::function<void(size_t)> &work) {
+  taskscheduler::runParallel(morselWorkers(), work);
+}
+
+void ParallelizablePlanOperation::scanMorsels(size_t numberOfElements,
+                                              const std::function<void(size_t, size_t, storage::pos_list_t &)> &scan,
+                                              storage::pos_list_t &positions) {
+  typedef std::pair<size_t, storage::pos_list_t> morsel_t;
+  std::vector<std::vector<morsel_t> > found(morselWorkers());
+  runMorselWorkers([&] (size_t worker) {
+      size_t first, last;
+      while (nextMorsel(numberOfElements, first, last)) {
+        found[worker].emplace_back(first, storage::pos_list_t());
+        scan(first, last, found[worker].back().second);
+      }
+    });
+
+  std::vector<const morsel_t *> morsels;
+  for (const auto &morselsOfWorker : found) {
+    for (const auto &morsel : morselsOfWorker)
+      morsels.push_back(&morsel);
+  }
+  std::sort(morsels.begin(), morsels.end(), [] (const morsel_t *a, const morsel_t *b) { return a->first < b->first; });
+  for (const auto &morsel : morsels)
+    positions.insert(positions.end(), morsel->second.begin(), morsel->second.end());
+}
+
+void ParallelizablePlanOperation::markMorsels(size_t numberOfElements,
+                                              const std::function<void(size_t, size_t, uint64_t *)> &mark,
+                                              std::vector<uint64_t> &words) {
+  // worker 0 marks words, the others allocate their bitmap once they
+  // claimed a morsel
+  std::vector<std::vector<uint64_t> > marked(morselWorkers());
+  runMorselWorkers([&] (size_t worker) {
+      size_t first, last;
+      while (nextMorsel(numberOfElements, first, last)) {
+        if (worker > 0 && marked[worker].empty())
+          marked[worker].resize(words.size(), 0);
+        mark(first, last, worker > 0 ? marked[worker].data() : words.data());
+      }
+    });
+
+  for (const auto &bitmap : marked) {
+    for (size_t word = 0; word < bitmap.size(); ++word)
+      words[word] |= bitmap[word];
+  }
+}
+
 }}
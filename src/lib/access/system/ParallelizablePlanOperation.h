@@ -1,9 +1,17 @@
 #ifndef SRC_LIB_ACCESS_PARALLELIZABLEOPERATION_H_
 #define SRC_LIB_ACCESS_PARALLELIZABLEOPERATION_H_
 
+#include <functional>
+
 #include "access/system/PlanOperation.h"
+#include "access/system/MorselCursor.h"
+
+namespace hyrise {
+namespace storage {
+class HorizontalTable;
+}
 
-namespace hyrise { namespace access {
+namespace access {
 
 class ParallelizablePlanOperation : public PlanOperation {
  public:
@@ -12,7 +20,12 @@ class ParallelizablePlanOperation : public PlanOperation {
   static std::pair<std::uint64_t, std::uint64_t> distribute(std::uint64_t numberOfElements,
                                                             std::size_t part,
                                                             std::size_t count);
-  
+  /// Compute start and end of part `part` of `count` parts of a table
+  /// placed on numa nodes, so that no part spans two partitions
+  static std::pair<std::uint64_t, std::uint64_t> distribute(const storage::HorizontalTable& table,
+                                                            std::size_t part,
+                                                            std::size_t count);
+
   /// If operator is supposed to be a parallel instance of an operator,
   /// separate input data based on instance enumeration.
   virtual void splitInput();
@@ -20,9 +33,53 @@ class ParallelizablePlanOperation : public PlanOperation {
 
   void setPart(size_t part);
   void setCount(size_t count);
+
+  /// Switches to morsel mode: instead of a static part of the input,
+  /// the operator processes the morsels it claims from the cursor,
+  /// which is shared with all other instances of the operator.
+  void setMorselCursor(const std::shared_ptr<MorselCursor> &cursor);
+  bool usesMorsels() const;
+  /// Whether the operator implements morsel mode
+  virtual bool supportsMorsels() const { return false; }
+
+  /// The node holding the part of a placed input table this instance
+  /// works on, so that the scheduler runs it next to its data
+  virtual int getPreferredNode() const;
  protected:
+  /// The first input table if it was placed on numa nodes; before the
+  /// input was refreshed it is taken from the first dependency
+  std::shared_ptr<const storage::HorizontalTable> placedInput() const;
+
+  /// Claims the next morsel of numberOfElements input elements
+  bool nextMorsel(size_t numberOfElements, size_t &first, size_t &last);
+
+  /// Number of workers pulling the morsels of this instance. A single
+  /// operator in morsel mode starts one per worker of the scheduler when
+  /// it executes, the instances of a parallelized operator work alone.
+  size_t morselWorkers() const;
+
+  /// Runs work(worker) for every morsel worker on the scheduler, the
+  /// calling thread is worker 0, see taskscheduler::runParallel()
+  void runMorselWorkers(const std::function<void(size_t)> &work);
+
+  /// Claims all morsels of numberOfElements elements on the morsel
+  /// workers and appends the positions that scan(first, last, positions)
+  /// finds for each of them to positions, in the order of the morsels
+  void scanMorsels(size_t numberOfElements,
+                   const std::function<void(size_t, size_t, storage::pos_list_t &)> &scan,
+                   storage::pos_list_t &positions);
+
+  /// Claims all morsels of numberOfElements elements on the morsel
+  /// workers and sets the bits of words that mark(first, last, words)
+  /// sets for each of them. Morsels need not align to words, so every
+  /// worker marks a bitmap of its own, which are or-ed into words.
+  void markMorsels(size_t numberOfElements,
+                   const std::function<void(size_t, size_t, uint64_t *)> &mark,
+                   std::vector<uint64_t> &words);
+
   size_t _part = 0;
   size_t _count = 0;
+  std::shared_ptr<MorselCursor> _morselCursor;
 };
 
 }}
@@ -0,0 +1,110 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/PlanCache.h"
+
+#include <stdexcept>
+
+namespace hyrise {
+namespace access {
+
+namespace {
+const std::string PARAMETER_KEY = "$param";
+
+bool isParameter(const Json::Value &value) {
+  return value.isObject() && value.size() == 1 && value.isMember(PARAMETER_KEY);
+}
+}
+
+const size_t PlanCache::DEFAULT_CAPACITY;
+
+PlanCache::PlanCache(size_t capacity) : _capacity(capacity), _hits(0), _misses(0), _evictions(0) {}
+
+PlanCache &PlanCache::getInstance() {
+  static PlanCache cache;
+  return cache;
+}
+
+PlanCache::plan_t PlanCache::get(const std::string &key) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _index.find(key);
+  if (it == _index.end()) {
+    ++_misses;
+    return nullptr;
+  }
+  ++_hits;
+  _entries.splice(_entries.begin(), _entries, it->second);
+  return it->second->second;
+}
+
+void PlanCache::put(const std::string &key, const plan_t &plan) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_capacity == 0)
+    return;
+
+  auto it = _index.find(key);
+  if (it != _index.end()) {
+    // another request for the same plan finished first
+    it->second->second = plan;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return;
+  }
+  _entries.emplace_front(key, plan);
+  _index[key] = _entries.begin();
+  evict();
+}
+
+void PlanCache::evict() {
+  while (_entries.size() > _capacity) {
+    _index.erase(_entries.back().first);
+    _entries.pop_back();
+    ++_evictions;
+  }
+}
+
+void PlanCache::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _entries.clear();
+  _index.clear();
+}
+
+void PlanCache::setCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _capacity = capacity;
+  evict();
+}
+
+size_t PlanCache::getCapacity() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _capacity;
+}
+
+size_t PlanCache::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _entries.size();
+}
+
+bool hasParameters(const Json::Value &plan) {
+  if (isParameter(plan))
+    return true;
+  if (plan.isObject() || plan.isArray()) {
+    for (const auto& member : plan) {
+      if (hasParameters(member))
+        return true;
+    }
+  }
+  return false;
+}
+
+void bindParameters(Json::Value &plan, const Json::Value &parameters) {
+  if (isParameter(plan)) {
+    const auto index = plan[PARAMETER_KEY].asUInt();
+    if (!parameters.isArray() || index >= parameters.size())
+      throw std::runtime_error("No value given for parameter " + std::to_string(index));
+    plan = parameters[index];
+  } else if (plan.isObject() || plan.isArray()) {
+    for (auto& member : plan) {
+      bindParameters(member, parameters);
+    }
+  }
+}
+
+} } // namespace hyrise::access
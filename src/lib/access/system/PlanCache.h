@@ -0,0 +1,73 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <json.h>
+
+namespace hyrise {
+namespace access {
+
+/*
+  Bounded LRU cache of query plans that were parsed and transformed
+  before, keyed by the hash of the query string. A cached plan is a
+  template: tasks are deserialized from it for every request, after
+  binding the request's parameters.
+ */
+class PlanCache {
+ public:
+  typedef std::shared_ptr<const Json::Value> plan_t;
+
+  static const size_t DEFAULT_CAPACITY = 1024;
+
+  explicit PlanCache(size_t capacity = DEFAULT_CAPACITY);
+
+  static PlanCache &getInstance();
+
+  /// Returns the cached plan or nullptr, marks the plan as recently used
+  plan_t get(const std::string &key);
+
+  /// Caches the plan and evicts the least recently used plans beyond capacity
+  void put(const std::string &key, const plan_t &plan);
+
+  void clear();
+
+  /// A capacity of zero disables caching
+  void setCapacity(size_t capacity);
+  size_t getCapacity() const;
+  size_t size() const;
+
+  size_t getHits() const { return _hits; }
+  size_t getMisses() const { return _misses; }
+  size_t getEvictions() const { return _evictions; }
+
+ private:
+  typedef std::list<std::pair<std::string, plan_t> > entries_t;
+
+  void evict();
+
+  mutable std::mutex _mutex;
+  // most recently used first
+  entries_t _entries;
+  std::unordered_map<std::string, entries_t::iterator> _index;
+  size_t _capacity;
+
+  std::atomic<size_t> _hits;
+  std::atomic<size_t> _misses;
+  std::atomic<size_t> _evictions;
+};
+
+/// Returns whether plan contains parameter slots, i.e. objects of the
+/// form {"$param": i}
+bool hasParameters(const Json::Value &plan);
+
+/// Replaces each parameter slot {"$param": i} in plan by parameters[i];
+/// throws std::runtime_error if no such parameter is given
+void bindParameters(Json::Value &plan, const Json::Value &parameters);
+
+} } // namespace hyrise::access
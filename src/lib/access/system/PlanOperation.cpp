@@ -6,6 +6,7 @@
 
 #include "access/system/ResponseTask.h"
 #include "helper/epoch.h"
+#include "helper/Epochs.h"
 #include "helper/PapiTracer.h"
 #include "io/StorageManager.h"
 #include "storage/AbstractResource.h"
@@ -188,6 +189,9 @@ const PlanOperation * PlanOperation::execute() {
 
   PapiTracer pt;
 
+  // all reads of the operation use the same versions of the mains
+  EpochGuard pin;
+
   // Start the execution
   refreshInput();
   setupPlanOperation();
@@ -258,5 +262,15 @@ std::shared_ptr<access::ResponseTask> PlanOperation::getResponseTask() const {
   return _responseTask.lock();
 }
 
+std::shared_ptr<Arena> PlanOperation::getArena() const {
+  if (auto responseTask = getResponseTask())
+    return responseTask->getArena();
+  return nullptr;
+}
+
+storage::pos_list_t *PlanOperation::newPositionList() const {
+  return new storage::pos_list_t(ArenaAllocator<pos_t>(getArena()));
+}
+
 
 }}
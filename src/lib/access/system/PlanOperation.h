@@ -103,6 +103,12 @@ class PlanOperation : public OutputTask {
   void setErrorMessage(const std::string& message);
   void setResponseTask(const std::shared_ptr<ResponseTask>& responseTask);
   std::shared_ptr<ResponseTask> getResponseTask() const;
+
+  /// Arena of the query, nullptr for operations without a response task
+  std::shared_ptr<Arena> getArena() const;
+  /// Empty position list in the arena of the query, to be owned by a
+  /// result like the position lists of the global heap
+  storage::pos_list_t *newPositionList() const;
  protected:
   /// Containers to store and handle input/output or rather result data.
   OperationData input;
@@ -36,6 +36,8 @@ void QueryParser::buildTasks(
     task_map_t &task_map) const {
   const Json::Value::Members& members = query["operators"].getMemberNames();
   std::string papiEventName = getPapiEventName(query);
+  // cursors shared by the instances of morsel-driven operators
+  std::map<std::string, std::shared_ptr<MorselCursor> > morselCursors;
   for (unsigned i = 0; i < members.size(); ++i) {
     const Json::Value& planOperationSpec = query["operators"][members[i]];
     std::string typeName = planOperationSpec["type"].asString();
@@ -47,8 +49,14 @@ void QueryParser::buildTasks(
     if (auto para = std::dynamic_pointer_cast<ParallelizablePlanOperation>(planOperation)) {
       para->setPart(planOperationSpec["part"].asUInt());
       para->setCount(planOperationSpec["count"].asUInt());
+      if (planOperationSpec.isMember("morselSize")) {
+        auto &cursor = morselCursors[planOperationSpec.get("morselGroup", members[i]).asString()];
+        if (!cursor)
+          cursor = std::make_shared<MorselCursor>(planOperationSpec["morselSize"].asUInt());
+        para->setMorselCursor(cursor);
+      }
     } else {
-      if (planOperationSpec.isMember("part") || planOperationSpec.isMember("count")) {
+      if (planOperationSpec.isMember("part") || planOperationSpec.isMember("count") || planOperationSpec.isMember("morselSize")) {
         throw std::runtime_error("Trying to parallelize " + typeName + ", which is not a subclass of Parallelizable");
       }
     }
@@ -91,6 +91,10 @@ Json::Value QueryTransformationEngine::nextInstanceOf(
   nextInstance["instances"] = 1;
   nextInstance["part"] = Json::Value((Json::UInt) instanceId);
   nextInstance["count"] = Json::Value((Json::UInt) numberOfInstances);
+  // all instances pull their morsels from the cursor of the original operator
+  if (operatorConfiguration.isMember("morselSize")) {
+    nextInstance["morselGroup"] = operatorId;
+  }
   if (numberOfCores > 0) {
     nextInstance["core"] = operatorConfiguration["cores"][(int)(instanceId % numberOfCores)];
   }
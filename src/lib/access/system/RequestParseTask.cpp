@@ -12,6 +12,7 @@
 #include "boost/lexical_cast.hpp"
 
 #include "access/system/ResponseTask.h"
+#include "access/system/PlanCache.h"
 #include "access/system/PlanOperation.h"
 #include "access/system/QueryTransformationEngine.h"
 #include "access/tx/Commit.h"
@@ -27,6 +28,7 @@
 #include "net/AbstractConnection.h"
 
 #include "taskscheduler/AbstractTaskScheduler.h"
+#include "taskscheduler/ParallelTasks.h"
 #include "taskscheduler/SharedScheduler.h"
 
 namespace hyrise {
@@ -103,8 +105,16 @@ void RequestParseTask::operator()() {
     Json::Reader reader;
 
     const std::string& query_string = urldecode(body_data["query"]);
+    const std::string& final_hash = hash(query_string);
 
-    if (reader.parse(query_string, request_data)) {
+    // plans seen before skip parsing and transformation; a plan is
+    // transformed for the workers of the scheduler, so it is only reused
+    // while their number stays the same
+    auto& plan_cache = PlanCache::getInstance();
+    const std::string& cache_key = final_hash + std::to_string(taskscheduler::parallelWorkers());
+    PlanCache::plan_t plan = plan_cache.get(cache_key);
+
+    if (plan || reader.parse(query_string, request_data)) {
       _responseTask->setTxContext(ctx);
       recordPerformance = getOrDefault(body_data, "performance", "false") == "true";
       _responseTask->setRecordPerformanceData(recordPerformance);
@@ -114,26 +124,39 @@ void RequestParseTask::operator()() {
         performance_data.push_back(std::unique_ptr<performance_attributes_t>(new performance_attributes_t));
       }
 
-      LOG4CXX_DEBUG(_query_logger, request_data);
+      const Json::Value& query = plan ? *plan : request_data;
+      LOG4CXX_DEBUG(_query_logger, query);
 
-      const std::string& final_hash = hash(query_string);
       std::shared_ptr<Task> result = nullptr;
 
-      if(request_data.isMember("priority"))
-        priority = request_data["priority"].asInt();
-      if(request_data.isMember("sessionId"))
-        sessionId = request_data["sessionId"].asInt();
+      if(query.isMember("priority"))
+        priority = query["priority"].asInt();
+      if(query.isMember("sessionId"))
+        sessionId = query["sessionId"].asInt();
       _responseTask->setPriority(priority);
       _responseTask->setSessionId(sessionId);
       _responseTask->setRecordPerformanceData(recordPerformance);
       try {
-        tasks = QueryParser::instance().deserialize(
-                  QueryTransformationEngine::getInstance()->transform(request_data),
-                  &result);
+        if (!plan) {
+          auto transformed = std::make_shared<Json::Value>();
+          transformed->swap(QueryTransformationEngine::getInstance()->transform(request_data));
+          plan = transformed;
+          plan_cache.put(cache_key, plan);
+        }
 
+        if (hasParameters(*plan)) {
+          Json::Value parameters;
+          if (!reader.parse(urldecode(body_data["parameters"]), parameters))
+            throw std::runtime_error("Parsing parameters: " + reader.getFormatedErrorMessages());
+          Json::Value bound(*plan);
+          bindParameters(bound, parameters);
+          tasks = QueryParser::instance().deserialize(bound, &result);
+        } else {
+          tasks = QueryParser::instance().deserialize(*plan, &result);
+        }
       } catch (const std::exception &ex) {
         // clean up, so we don't end up with a whole mess due to thrown exceptions
-        LOG4CXX_ERROR(_logger, "Received\n:" << request_data);
+        LOG4CXX_ERROR(_logger, "Received\n:" << (plan ? *plan : request_data));
         LOG4CXX_ERROR(_logger, "Exception thrown during query deserialization:\n" << ex.what());
         _responseTask->addErrorMessage(std::string("RequestParseTask: ") + ex.what());
         tasks.clear();
@@ -191,6 +214,9 @@ void RequestParseTask::operator()() {
     if (atoi(body_data["offset"].c_str()) > 0)
       _responseTask->setTransmitOffset(atol(body_data["offset"].c_str()));
 
+    // "format=arrow" requests the result as Arrow IPC stream
+    _responseTask->setTransmitArrow(getOrDefault(body_data, "format", "json") == "arrow");
+
   } else {
     LOG4CXX_WARN(_logger, "no body received!");
   }
@@ -7,16 +7,17 @@
 #include "log4cxx/logger.h"
 #include "boost/lexical_cast.hpp"
 
+#include "access/system/ArrowStreamWriter.h"
+#include "access/system/JsonStreamWriter.h"
 #include "access/system/PlanOperation.h"
 #include "access/system/OutputTask.h"
 #include "io/TransactionManager.h"
+#include "helper/Epochs.h"
 #include "helper/PapiTracer.h"
 
 #include "net/AsyncConnection.h"
 
 #include "storage/AbstractTable.h"
-#include "storage/SimpleStore.h"
-#include "storage/meta_storage.h"
 
 
 namespace hyrise {
@@ -26,58 +27,6 @@ namespace {
 log4cxx::LoggerPtr _logger(log4cxx::Logger::getLogger("hyrise.net"));
 }
 
-template <typename T>
-struct json_functor {
-  typedef Json::Value value_type;
-
-  const T& table;
-  size_t column;
-  size_t row;
-
-  explicit json_functor(const T& t): table(t), column(0), row(0) {}
-
-  template <typename R>
-  value_type operator()() {
-    return Json::Value(table->template getValue<R>(column, row));
-  }
-};
-
-template<typename T>
-Json::Value generateRowsJsonT(const T& table, const size_t transmitLimit, const size_t transmitOffset) {
-  storage::type_switch<hyrise_basic_types> ts;
-  json_functor<T> fun(table);
-  Json::Value rows(Json::arrayValue);
-  for (size_t row = 0; row < table->size(); ++row) {
-
-    // Align offset
-    if (row < transmitOffset)
-      continue;
-
-    // Break if limit reached
-    if (transmitLimit > 0 && row == (transmitOffset + transmitLimit))
-      break;
-
-    fun.row = row;
-    Json::Value json_row(Json::arrayValue);
-    for (size_t col = 0; col < table->columnCount(); ++col) {
-      fun.column = col;
-      json_row.append(ts(table->typeOfColumn(col), fun));
-    }
-    rows.append(json_row);
-
-  }
-  return rows;
-}
-
-Json::Value generateRowsJson(const std::shared_ptr<const storage::AbstractTable>& table,
-                             const size_t transmitLimit, const size_t transmitOffset) {
-  if (const auto& store = std::dynamic_pointer_cast<const storage::SimpleStore>(table)) {
-    return generateRowsJsonT(store, transmitLimit, transmitOffset);
-  } else {
-    return generateRowsJsonT(table, transmitLimit, transmitOffset);
-  }
-}
-
 const std::string ResponseTask::vname() {
   return "ResponseTask";
 }
@@ -125,8 +74,13 @@ task_states_t ResponseTask::getState() const {
 }
 
 void ResponseTask::operator()() {
+  // all operations are done, the arena is freed as soon as the results
+  // allocated from it are released after sending the response
+  _arena.reset();
   epoch_t responseStart = _recordPerformanceData ? get_epoch_nanoseconds() : 0;
   Json::Value response;
+  // the rows are not part of response, they are streamed to the client
+  storage::c_atable_ptr_t rows;
 
   if (getDependencyCount() > 0) {
     PapiTracer pt;
@@ -150,10 +104,9 @@ void ResponseTask::operator()() {
           json_header.append(colname);
         }
 
-        // Copy the complete result
         response["real_size"] = result->size();
-        response["rows"] = generateRowsJson(result, _transmitLimit, _transmitOffset);
         response["header"] = json_header;
+        rows = result;
       }
 
       ////////////////////////////////////////////////////////////////////////////////////////
@@ -214,7 +167,30 @@ void ResponseTask::operator()() {
   LOG4CXX_DEBUG(_logger, response);
 
   Json::FastWriter fw;
-  connection->respond(fw.write(response));
+  const std::string members = fw.write(response);
+  // the rows are decoded with the dictionaries of one version of each main
+  EpochGuard pin;
+  if (rows && _transmitArrow) {
+    // the other members travel as custom metadata of the schema
+    connection->beginStream(200, ARROW_STREAM_CONTENT_TYPE);
+    writeArrowStream(connection, rows, _transmitLimit, _transmitOffset, members.substr(0, members.size() - 1));
+    connection->endStream();
+    return;
+  }
+
+  connection->beginStream();
+  JsonStreamWriter writer(connection);
+  if (rows) {
+    // "rows" is written first, followed by the members of response
+    writer.raw("{\"rows\":", 8);
+    writeRowsJson(writer, rows, _transmitLimit, _transmitOffset);
+    writer.raw(",", 1);
+    writer.raw(members.data() + 1, members.size() - 1);
+  } else {
+    writer.raw(members);
+  }
+  writer.flush();
+  connection->endStream();
 }
 
 }
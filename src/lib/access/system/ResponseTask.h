@@ -5,6 +5,7 @@
 #include <atomic>
 #include <mutex>
 
+#include "helper/Arena.h"
 #include "helper/epoch.h"
 #include "access/system/OutputTask.h"
 #include "net/AbstractConnection.h"
@@ -21,6 +22,7 @@ class ResponseTask : public taskscheduler::Task {
 
   size_t _transmitLimit = 0; // Used for serialization only
   size_t _transmitOffset = 0; // Used for serialization only
+  bool _transmitArrow = false; // Send the result as Arrow IPC stream instead of JSON
 
   std::atomic<unsigned long> _affectedRows;
   tx::TXContext _txContext;
@@ -37,9 +39,12 @@ class ResponseTask : public taskscheduler::Task {
 
   bool _recordPerformanceData = true;
 
+  // Memory of the intermediate results of the query
+  std::shared_ptr<Arena> _arena;
+
  public:
   explicit ResponseTask(net::AbstractConnection *connection) :
-      connection(connection) {
+      connection(connection), _arena(std::make_shared<Arena>()) {
         _affectedRows = 0;
   }
 
@@ -55,6 +60,12 @@ class ResponseTask : public taskscheduler::Task {
 
   void registerPlanOperation(const std::shared_ptr<PlanOperation>& planOp);
 
+  /// Arena the operations of the query allocate their intermediate
+  /// results from, nullptr once the response is being sent
+  const std::shared_ptr<Arena>& getArena() const {
+    return _arena;
+  }
+
   void addErrorMessage(std::string message) {
     std::lock_guard<std::mutex> guard(errorMutex);
     _error_messages.push_back(message);
@@ -83,6 +94,10 @@ class ResponseTask : public taskscheduler::Task {
     _transmitOffset = o;
   }
 
+  void setTransmitArrow(bool arrow) {
+    _transmitArrow = arrow;
+  }
+
   void incAffectedRows(unsigned long inc) {
     _affectedRows += inc;
   }
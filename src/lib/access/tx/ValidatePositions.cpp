@@ -1,6 +1,7 @@
 #include "ValidatePositions.h"
 
 #include <storage/PointerCalculator.h>
+#include <storage/PositionSet.h>
 #include <storage/Store.h>
 #include <access/system/QueryParser.h>
 #include <io/TransactionManager.h>
@@ -23,8 +24,9 @@ void ValidatePositions::executePlanOperation() {
   if (std::dynamic_pointer_cast<const storage::Store>(getInputTable(0))) {
 
     const auto& tab = checked_pointer_cast<const storage::Store>(getInputTable(0));
-    auto pc = tab->buildValidPositions(_txContext.lastCid, _txContext.tid);
-    addResult(std::make_shared<storage::PointerCalculator>(tab, new pos_list_t(std::move(pc))));
+    // tables whose rows are all visible result in a range of positions
+    auto positions = storage::PositionSet::fromSorted(tab->buildValidPositions(_txContext.lastCid, _txContext.tid));
+    addResult(std::make_shared<storage::PointerCalculator>(tab, std::move(positions)));
 
   } else {
     // If it's no store it has to be a pointer calculator otherwise there is
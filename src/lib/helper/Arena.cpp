@@ -0,0 +1,69 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "helper/Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace hyrise {
+
+const size_t Arena::MIN_BLOCK_SIZE;
+const size_t Arena::MAX_BLOCK_SIZE;
+const size_t Arena::MAX_ALLOCATION;
+
+Arena::Arena() : _current(nullptr), _nextBlockSize(MIN_BLOCK_SIZE), _reserved(0) {
+}
+
+Arena::~Arena() {
+  for (char *block : _blocks)
+    ::operator delete(block);
+}
+
+void *Arena::bump(Block &block, size_t bytes, size_t alignment) {
+  size_t used = block.used.load(std::memory_order_relaxed);
+  while (true) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block.begin) + used;
+    const size_t first = used + (alignment - address % alignment) % alignment;
+    if (first + bytes > block.size)
+      return nullptr;
+    if (block.used.compare_exchange_weak(used, first + bytes, std::memory_order_relaxed))
+      return block.begin + first;
+  }
+}
+
+void *Arena::allocate(size_t bytes, size_t alignment) {
+  if (Block *block = _current.load(std::memory_order_acquire)) {
+    if (void *memory = bump(*block, bytes, alignment))
+      return memory;
+  }
+
+  std::lock_guard<std::mutex> guard(_mutex);
+  // another thread may have started a new block in the meantime
+  if (Block *block = _current.load(std::memory_order_relaxed)) {
+    if (void *memory = bump(*block, bytes, alignment))
+      return memory;
+  }
+
+  // large allocations get a block of their own and keep the current block
+  if (bytes > _nextBlockSize / 4) {
+    char *block = static_cast<char *>(::operator new(bytes));
+    _blocks.push_back(block);
+    _reserved += bytes;
+    return block;
+  }
+
+  // blocks of operator new are aligned for every fundamental type
+  char *block = static_cast<char *>(::operator new(_nextBlockSize));
+  _blocks.push_back(block);
+  _reserved += _nextBlockSize;
+  _bumpBlocks.emplace_back(block, _nextBlockSize, bytes);
+  _current.store(&_bumpBlocks.back(), std::memory_order_release);
+  _nextBlockSize = std::min(2 * _nextBlockSize, MAX_BLOCK_SIZE);
+  return block;
+}
+
+size_t Arena::reservedBytes() const {
+  std::lock_guard<std::mutex> guard(_mutex);
+  return _reserved;
+}
+
+} // namespace hyrise
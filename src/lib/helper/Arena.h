@@ -0,0 +1,119 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace hyrise {
+
+/*
+  Memory of a single query. Allocations are carved out of blocks of
+  growing size and are never returned one by one, all blocks are freed
+  together with the arena. Intermediate results of a query allocate from
+  the arena of its ResponseTask instead of contending for the global
+  heap with the other workers. Threads bump the offset of the current
+  block with a CAS, only starting a new block takes the lock.
+ */
+class Arena {
+ public:
+  static const size_t MIN_BLOCK_SIZE = 64 * 1024;
+  static const size_t MAX_BLOCK_SIZE = 1024 * 1024;
+  /// Largest allocation of an ArenaAllocator served by the arena
+  static const size_t MAX_ALLOCATION = 16 * 1024;
+
+  Arena();
+  ~Arena();
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  /// Memory of bytes bytes aligned to alignment, a power of two up to 16
+  void *allocate(size_t bytes, size_t alignment);
+
+  /// Bytes of all blocks of the arena
+  size_t reservedBytes() const;
+
+ private:
+  struct Block {
+    Block(char *begin, size_t size, size_t used) : begin(begin), size(size), used(used) {}
+
+    char *const begin;
+    const size_t size;
+    // bytes of the block that are handed out
+    std::atomic<size_t> used;
+  };
+
+  // memory of block without taking the lock, nullptr if it does not fit
+  static void *bump(Block &block, size_t bytes, size_t alignment);
+
+  mutable std::mutex _mutex;
+  // all memory of the arena
+  std::vector<char *> _blocks;
+  // blocks to bump, a deque keeps them in place while it grows
+  std::deque<Block> _bumpBlocks;
+  std::atomic<Block *> _current;
+  size_t _nextBlockSize;
+  size_t _reserved;
+};
+
+/*
+  Allocator of a container in an arena. Every allocator shares the
+  ownership of its arena, so a container that outlives its query keeps
+  the memory of the arena alive. Memory released by the container is
+  only freed together with the arena. Default constructed allocators use
+  the global heap.
+ */
+template <typename T>
+class ArenaAllocator {
+  template <typename U> friend class ArenaAllocator;
+
+  std::shared_ptr<Arena> _arena;
+
+ public:
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  ArenaAllocator() {}
+  explicit ArenaAllocator(const std::shared_ptr<Arena> &arena) : _arena(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other._arena) {}
+
+  T *allocate(size_t n) {
+    if (!fromArena(n))
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, size_t n) {
+    if (!fromArena(n))
+      ::operator delete(p);
+  }
+
+  bool fromArena(size_t n) const {
+    return _arena != nullptr && n * sizeof(T) <= Arena::MAX_ALLOCATION;
+  }
+
+  const std::shared_ptr<Arena> &arena() const {
+    return _arena;
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &other) const {
+    return _arena == other._arena;
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U> &other) const {
+    return _arena != other._arena;
+  }
+};
+
+} // namespace hyrise
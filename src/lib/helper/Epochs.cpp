@@ -0,0 +1,74 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "helper/Epochs.h"
+
+#include <mutex>
+#include <set>
+
+namespace hyrise {
+
+const uint64_t Epochs::LATEST;
+
+namespace {
+
+// Pinning reads the current epoch and registers it in one critical
+// section, so an epoch is never pinned while its version is installed or
+// reclaimed
+struct Registry {
+  std::mutex mutex;
+  uint64_t current = 0;
+  std::multiset<uint64_t> pinned;
+};
+
+Registry &registry() {
+  static Registry instance;
+  return instance;
+}
+
+thread_local uint64_t pinnedEpoch = Epochs::LATEST;
+
+}  // namespace
+
+uint64_t Epochs::publish(const std::function<void(uint64_t)> &install) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  install(r.current + 1);
+  return ++r.current;
+}
+
+uint64_t Epochs::pinned() {
+  return pinnedEpoch;
+}
+
+uint64_t Epochs::oldestPinned() {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  return r.pinned.empty() ? r.current : *r.pinned.begin();
+}
+
+EpochGuard::EpochGuard() : _outermost(pinnedEpoch == Epochs::LATEST) {
+  if (_outermost)
+    pin(Epochs::LATEST);
+}
+
+EpochGuard::EpochGuard(uint64_t epoch) : _outermost(pinnedEpoch == Epochs::LATEST && epoch != Epochs::LATEST) {
+  if (_outermost)
+    pin(epoch);
+}
+
+void EpochGuard::pin(uint64_t epoch) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  pinnedEpoch = epoch == Epochs::LATEST ? r.current : epoch;
+  r.pinned.insert(pinnedEpoch);
+}
+
+EpochGuard::~EpochGuard() {
+  if (!_outermost)
+    return;
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.pinned.erase(r.pinned.find(pinnedEpoch));
+  pinnedEpoch = Epochs::LATEST;
+}
+
+} // namespace hyrise
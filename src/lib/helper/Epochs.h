@@ -0,0 +1,55 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace hyrise {
+
+/*
+  Epochs of readers of versioned data. A writer publishes each new
+  version of a structure under a new epoch. A reader pins the current
+  epoch with an EpochGuard and reads the versions published up to it,
+  so all reads of one operation see the same version while newer ones
+  are published. A replaced version is freed once no reader pins an
+  epoch before its replacement.
+ */
+class Epochs {
+ public:
+  /// Epoch of threads that pin none, they read the latest versions
+  static const uint64_t LATEST = std::numeric_limits<uint64_t>::max();
+
+  /// Calls install with a new epoch and returns it. Threads pin the new
+  /// epoch only after install returned, so install publishes the version
+  /// tagged with it before any reader expects to see it.
+  static uint64_t publish(const std::function<void(uint64_t)> &install);
+
+  /// Epoch pinned by the calling thread, LATEST if it pins none
+  static uint64_t pinned();
+
+  /// Oldest epoch pinned by any thread or the current epoch if none is
+  /// pinned. Versions replaced up to this epoch are no longer read.
+  static uint64_t oldestPinned();
+};
+
+/// Pins the current epoch for the calling thread until it is destroyed.
+/// Nested guards keep the epoch of the outermost guard.
+class EpochGuard {
+ public:
+  EpochGuard();
+  /// Pins epoch in a thread that works for a reader holding it, e.g. a
+  /// task started by an operation. LATEST pins nothing.
+  explicit EpochGuard(uint64_t epoch);
+  ~EpochGuard();
+
+  EpochGuard(const EpochGuard &) = delete;
+  EpochGuard &operator=(const EpochGuard &) = delete;
+
+ private:
+  void pin(uint64_t epoch);
+
+  bool _outermost;
+};
+
+} // namespace hyrise
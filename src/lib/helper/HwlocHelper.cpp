@@ -73,3 +73,26 @@ unsigned getNumberOfCoresPerNumaNode(){
   number_of_nodes = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
   return number_of_cores/number_of_nodes;
 };
+
+bool bindCurrentThreadToNode(unsigned node){
+  hwloc_topology_t topology = getHWTopology();
+  hwloc_obj_t obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, node);
+  if (obj == nullptr)
+    return false;
+  bool bound = hwloc_set_cpubind(topology, obj->cpuset, HWLOC_CPUBIND_THREAD) == 0;
+  bound &= hwloc_set_membind(topology, obj->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET) == 0;
+  return bound;
+}
+
+int getNodeOfMemory(const void *addr){
+  hwloc_topology_t topology = getHWTopology();
+  hwloc_nodeset_t nodeset = hwloc_bitmap_alloc();
+  int node = -1;
+  if (hwloc_get_area_memlocation(topology, addr, 1, nodeset, HWLOC_MEMBIND_BYNODESET) == 0 && !hwloc_bitmap_iszero(nodeset)) {
+    hwloc_obj_t obj = hwloc_get_numanode_obj_by_os_index(topology, hwloc_bitmap_first(nodeset));
+    if (obj != nullptr)
+      node = obj->logical_index;
+  }
+  hwloc_bitmap_free(nodeset);
+  return node;
+}
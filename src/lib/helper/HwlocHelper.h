@@ -17,4 +17,9 @@ hwloc_topology_t getHWTopology();
 std::vector<unsigned> getCoresForNode(hwloc_topology_t topology, unsigned node);
 unsigned getNumberOfNodes(hwloc_topology_t topology);
 unsigned getNumberOfCoresPerNumaNode();
+// binds the calling thread to the cores of node and its future allocations
+// to the memory of node, returns false if the system refuses either
+bool bindCurrentThreadToNode(unsigned node);
+// node holding the page at addr, -1 if it is unknown
+int getNodeOfMemory(const void *addr);
 
@@ -3,6 +3,10 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
+
+#include "helper/Arena.h"
+
 // produces sorted intersection of two pos lists. based on
 // baeza-yates algorithm with average complexity nicely
 // adapting to the smaller list size, whereas std::set_intersection
@@ -10,7 +14,9 @@
 template <typename IterT, typename OutputIter>
 void intersect_pos_list(IterT beg1, IterT end1, IterT beg2, IterT end2, OutputIter resultIter, bool first_sorted=true, bool second_sorted=true)
 {
-  std::vector<typename std::iterator_traits<IterT>::value_type> input1_sorted, input2_sorted;
+  // the copies have to be of the type of position lists to share their iterators
+  typedef typename std::iterator_traits<IterT>::value_type value_t;
+  std::vector<value_t, hyrise::ArenaAllocator<value_t> > input1_sorted, input2_sorted;
 
   auto size_1 = std::distance(beg1, end1);
   auto size_2 = std::distance(beg2, end2);
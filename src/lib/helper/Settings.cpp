@@ -8,6 +8,7 @@ Settings::Settings() : threadpoolSize(1) {
   setDBPath(getEnv("HYRISE_DB_PATH", ""));
   setScriptPath(getEnv("HYRISE_SCRIPT_PATH", ""));
   setProfilePath(getEnv("HYRISE_PROFILE_PATH","."));
+  setCheckpointPath(getEnv("HYRISE_CHECKPOINT_PATH", ""));
 
 }
 
@@ -23,6 +23,7 @@ class Settings {
   ADD_MEMBER(std::string, ScriptPath);
   ADD_MEMBER(std::string, ProfilePath);
   ADD_MEMBER(std::string, DBPath);
+  ADD_MEMBER(std::string, CheckpointPath);
 
 
   Settings();
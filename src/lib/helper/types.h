@@ -7,6 +7,8 @@
 #include <memory>
 #include <vector>
 
+#include "helper/Arena.h"
+
 namespace hyrise { namespace storage {
 class AbstractResource;
 class AbstractTable;
@@ -94,7 +96,7 @@ typedef size_t field_t;
 typedef std::string field_name_t;
 typedef std::vector<field_name_t> field_name_list_t;
 
-typedef std::vector<pos_t> pos_list_t;
+typedef std::vector<pos_t, ArenaAllocator<pos_t> > pos_list_t;
 typedef std::vector<field_t> field_list_t;
 }
 
@@ -37,6 +37,13 @@ class AbstractInput : public cloneable {
   virtual bool needs_store_wrap() {
     return true;
   };
+
+  /// True if the last load left ordered dictionaries and their value ids
+  /// in every column, the table is used as the main of its store without
+  /// merging it
+  virtual bool loaded_main() {
+    return false;
+  }
 };
 
 
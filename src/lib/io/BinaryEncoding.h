@@ -0,0 +1,58 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace hyrise {
+namespace io {
+
+/// Helpers for the binary files of the redo log and of checkpoints. Values
+/// are stored in host byte order, strings are prefixed with their length.
+
+template <typename T>
+inline void writeRaw(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+inline void writeString(std::string &out, const std::string &value) {
+  writeRaw<uint32_t>(out, value.size());
+  out.append(value);
+}
+
+/// Reads from an encoded buffer, throws on reading beyond its end
+class BinaryReader {
+  const char *_data;
+  const char *_end;
+
+ public:
+  BinaryReader(const char *data, size_t size) : _data(data), _end(data + size) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string readString() {
+    auto size = read<uint32_t>();
+    return std::string(take(size), size);
+  }
+
+  const char *take(size_t size) {
+    if (static_cast<size_t>(_end - _data) < size)
+      throw std::runtime_error("Binary data is truncated");
+    const char *result = _data;
+    _data += size;
+    return result;
+  }
+
+  bool atEnd() const {
+    return _data == _end;
+  }
+};
+
+} } // namespace hyrise::io
@@ -7,8 +7,10 @@
 
 #include "io/GenericCSV.h"
 #include "io/MetadataCreation.h"
+#include "io/ParallelCSVLoader.h"
 #include "storage/AbstractTable.h"
 #include "storage/ColumnMetadata.h"
+#include "taskscheduler/ParallelTasks.h"
 
 namespace hyrise {
 namespace io {
@@ -101,6 +103,19 @@ std::shared_ptr<storage::AbstractTable> CSVInput::load(std::shared_ptr<storage::
   csv::params params(_parameters.getCSVParams());
 
   if (detectHeader(args.getBasePath() + _filename)) params.setLineStart(5);
+  _loadedMain = false;
+
+  // Files without quoted fields are parsed in place by the workers of the
+  // scheduler, the parser of libcsv is left for quoted fields and limited
+  // line counts
+  if (params.getLineCount() == -1 && params.getDelimiter() != ' ' && params.getDelimiter() != '\t' &&
+      parallelLoadCSV(args.getBasePath() + _filename, params, _parameters.getUnsafe(), intable,
+                      taskscheduler::parallelWorkers())) {
+    _loadedMain = true;
+    for (size_t column = 0; column < intable->columnCount(); ++column)
+      _loadedMain = _loadedMain && buildsOrderedDictionary(intable->typeOfColumn(column));
+    return intable;
+  }
 
   // Resize the table based on the file size
   data.table->resize(countLines(args.getBasePath() + _filename) - params.getLineStart() + 1);
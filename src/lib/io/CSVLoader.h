@@ -34,10 +34,15 @@ class CSVInput : public AbstractInput {
 
   std::shared_ptr<storage::AbstractTable> load(std::shared_ptr<storage::AbstractTable>, const storage::compound_metadata_list *, const Loader::params &args);
 
+  bool loaded_main() {
+    return _loadedMain;
+  }
+
   CSVInput *clone() const;
  private:
   std::string _filename;
   params _parameters;
+  bool _loadedMain = false;
 };
 
 class CSVHeader : public AbstractHeader {
@@ -0,0 +1,564 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/Checkpoint.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "helper/Epochs.h"
+#include "io/BinaryEncoding.h"
+#include "io/RedoLog.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "storage/AttributeVectorFactory.h"
+#include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/DictionaryFactory.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
+#include "storage/meta_storage.h"
+#include "taskscheduler/SharedScheduler.h"
+
+namespace hyrise {
+namespace tx {
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+using io::writeRaw;
+using io::writeString;
+using io::BinaryReader;
+
+const std::string CHECKPOINT_PREFIX = "checkpoint_";
+const std::string TMP_SUFFIX = ".tmp";
+const std::string MANIFEST_FILE = "manifest.dat";
+const std::string TABLE_FILE = "table.dat";
+const std::string DELTA_FILE = "delta.log";
+const std::string DICT_EXT = ".dict";
+const std::string ATTR_EXT = ".attr";
+
+void writeFile(const std::string &path, const std::string &data) {
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    throw std::runtime_error("Could not write " + path + ": " + std::strerror(errno));
+  for (size_t written = 0; written < data.size();) {
+    auto result = ::write(fd, data.data() + written, data.size() - written);
+    if (result < 0) {
+      if (errno == EINTR)
+        continue;
+      ::close(fd);
+      throw std::runtime_error("Could not write " + path + ": " + std::strerror(errno));
+    }
+    written += result;
+  }
+  if (::fsync(fd) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not sync " + path + ": " + std::strerror(errno));
+  }
+  ::close(fd);
+}
+
+void syncDirectory(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+  ::fsync(fd);
+  ::close(fd);
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    throw std::runtime_error("Could not read " + path);
+  std::string data(file.tellg(), '\0');
+  file.seekg(0);
+  file.read(&data[0], data.size());
+  return data;
+}
+
+template <typename T>
+void writeValue(std::string &out, const T &value) {
+  writeRaw(out, value);
+}
+
+void writeValue(std::string &out, const hyrise_string_t &value) {
+  writeString(out, value);
+}
+
+template <typename T>
+T readValue(BinaryReader &in) {
+  return in.read<T>();
+}
+
+template <>
+hyrise_string_t readValue<hyrise_string_t>(BinaryReader &in) {
+  return in.readString();
+}
+
+struct write_dictionary_functor {
+  typedef void value_type;
+
+  const storage::AbstractTable *table;
+  size_t column;
+  std::string *out;
+
+  template <typename T>
+  void operator()() {
+    auto dict = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(table->dictionaryAt(column));
+    if (!dict)
+      throw std::runtime_error("Cannot checkpoint column " + table->nameOfColumn(column));
+    const size_t size = dict->size();
+    writeRaw<uint64_t>(*out, size);
+    if (dict->isOrdered()) {
+      // ordered dictionaries iterate in value id order, front coded
+      // strings are decoded one after the other
+      for (auto it = dict->begin(), end = dict->end(); it != end; ++it)
+        writeValue(*out, *it);
+    } else {
+      for (value_id_t vid = 0; vid < size; ++vid)
+        writeValue(*out, dict->getValueForValueId(vid));
+    }
+  }
+};
+
+struct read_dictionary_functor {
+  typedef storage::AbstractTable::SharedDictionaryPtr value_type;
+
+  DataType type;
+  BinaryReader *in;
+
+  template <typename T>
+  value_type operator()() {
+    const auto size = in->read<uint64_t>();
+    auto dict = storage::makeDictionary(type, size);
+    auto values = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(dict);
+    for (uint64_t i = 0; i < size; ++i)
+      values->addValue(readValue<T>(*in));
+    return dict;
+  }
+};
+
+struct set_default_functor {
+  typedef void value_type;
+
+  storage::AbstractTable *table;
+  size_t column;
+
+  template <typename T>
+  void operator()() {
+    table->setValue<T>(column, 0, T());
+  }
+};
+
+/// Jobs shared by the tasks of runTasks(), each task runs the next
+/// unclaimed job
+struct Jobs {
+  std::vector<std::function<void()> > jobs;
+  std::vector<std::exception_ptr> errors;
+  std::atomic<size_t> next;
+  size_t done;
+  std::mutex mutex;
+  std::condition_variable finished;
+
+  explicit Jobs(const std::vector<std::function<void()> > &jobs) :
+      jobs(jobs), errors(jobs.size()), next(0), done(0) {}
+
+  /// Runs jobs until all are claimed
+  void run() {
+    for (size_t i = next++; i < jobs.size(); i = next++) {
+      try {
+        // each job reads one version of the main of its store
+        EpochGuard pin;
+        jobs[i]();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++done == jobs.size())
+        finished.notify_all();
+    }
+  }
+};
+
+class CheckpointTask : public taskscheduler::Task {
+  std::shared_ptr<Jobs> _jobs;
+
+ public:
+  explicit CheckpointTask(const std::shared_ptr<Jobs> &jobs) : _jobs(jobs) {}
+
+  void operator()() {
+    _jobs->run();
+  }
+
+  const std::string vname() {
+    return "CheckpointTask";
+  }
+};
+
+/// Runs the jobs as tasks of the shared scheduler and rethrows the first
+/// error of a job. The calling thread works on the jobs as well, so that
+/// this does not deadlock when it is called from a task itself.
+void runTasks(const std::vector<std::function<void()> > &jobs) {
+  auto shared = std::make_shared<Jobs>(jobs);
+  if (auto scheduler = taskscheduler::SharedScheduler::getInstance().getScheduler()) {
+    for (size_t i = 1; i < jobs.size(); ++i)
+      scheduler->schedule(std::make_shared<CheckpointTask>(shared));
+  }
+  shared->run();
+  {
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->finished.wait(lock, [&shared] { return shared->done == shared->jobs.size(); });
+  }
+
+  for (const auto& error : shared->errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
+void checkpointColumn(const std::string &path, const storage::atable_ptr_t &main, size_t rows, size_t column) {
+  std::string dictionary;
+  storage::type_switch<hyrise_basic_types> ts;
+  write_dictionary_functor fun {main.get(), column, &dictionary};
+  ts(main->typeOfColumn(column), fun);
+  writeFile(path + "/" + std::to_string(column) + DICT_EXT, dictionary);
+
+  std::string attribute(rows * sizeof(value_id_t), '\0');
+  for (size_t row = 0; row < rows; ++row) {
+    const value_id_t vid = main->getValueId(column, row).valueId;
+    std::memcpy(&attribute[row * sizeof(value_id_t)], &vid, sizeof(value_id_t));
+  }
+  writeFile(path + "/" + std::to_string(column) + ATTR_EXT, attribute);
+}
+
+void checkpointTable(const std::string &path,
+                     const std::string &name,
+                     const storage::store_ptr_t &store,
+                     const storage::atable_ptr_t &main,
+                     size_t rows,
+                     uint64_t generation,
+                     transaction_cid_t cid) {
+  std::string layout;
+  writeRaw<uint64_t>(layout, rows);
+  writeRaw<uint64_t>(layout, generation);
+  writeRaw<uint64_t>(layout, cid);
+  writeRaw<uint32_t>(layout, main->columnCount());
+  for (size_t column = 0; column < main->columnCount(); ++column) {
+    writeString(layout, main->nameOfColumn(column));
+    writeRaw<uint8_t>(layout, main->metadataAt(column).getType());
+  }
+  writeFile(path + "/" + TABLE_FILE, layout);
+
+  // the delta rows and deleted main rows as of the snapshot, other
+  // transactions only change rows with a higher commit id meanwhile
+  const auto valid = store->buildValidPositions(cid, MERGE_TID);
+  const auto firstDeltaRow = std::lower_bound(valid.begin(), valid.end(), rows);
+  pos_list_t deleted;
+  auto next = valid.begin();
+  for (pos_t row = 0; row < rows; ++row) {
+    if (next != firstDeltaRow && *next == row)
+      ++next;
+    else
+      deleted.push_back(row);
+  }
+  const pos_list_t inserted(firstDeltaRow, valid.end());
+
+  RedoLogRecord record;
+  record.changes.push_back(RedoLogRecord::TableChanges::capture(name, store, inserted, deleted));
+  writeFile(path + "/" + DELTA_FILE, RedoLog::frame(cid, UNKNOWN, record.serialize()));
+}
+
+/// Adds a job per column that reads the column of a checkpointed main
+/// table, cid receives the commit id the table was checkpointed at
+void addColumnLoads(const std::string &path,
+                    std::vector<std::function<void()> > &jobs,
+                    std::vector<storage::atable_ptr_t> &columns,
+                    size_t &rows,
+                    uint64_t &generation,
+                    transaction_cid_t &cid) {
+  const auto layout = readFile(path + "/" + TABLE_FILE);
+  BinaryReader in(layout.data(), layout.size());
+  rows = in.read<uint64_t>();
+  generation = in.read<uint64_t>();
+  cid = in.read<uint64_t>();
+  columns.resize(in.read<uint32_t>());
+  for (size_t column = 0; column < columns.size(); ++column) {
+    const auto name = in.readString();
+    const auto type = static_cast<DataType>(in.read<uint8_t>());
+    const auto size = rows;
+    jobs.push_back([path, column, name, type, size, &columns] () {
+      const auto data = readFile(path + "/" + std::to_string(column) + DICT_EXT);
+      BinaryReader dictionaryData(data.data(), data.size());
+      storage::type_switch<hyrise_basic_types> ts;
+      read_dictionary_functor fun {type, &dictionaryData};
+      auto dictionary = ts(type, fun);
+
+      const auto attribute = readFile(path + "/" + std::to_string(column) + ATTR_EXT);
+      if (attribute.size() != size * sizeof(value_id_t))
+        throw std::runtime_error("Checkpoint column " + path + "/" + name + " is truncated");
+      // the main is bit compressed as after a merge
+      const uint64_t bits = dictionary->size() <= 1 ? 1 : std::ceil(std::log(dictionary->size()) / std::log(2.0));
+      auto values = storage::AttributeVectorFactory::getAttributeVector2<value_id_t>(1, size, true, {bits});
+      values->resize(size);
+      for (size_t row = 0; row < size; ++row) {
+        value_id_t vid;
+        std::memcpy(&vid, &attribute[row * sizeof(value_id_t)], sizeof(value_id_t));
+        values->set(0, row, vid);
+      }
+      columns[column] = std::make_shared<storage::Table>(std::vector<storage::ColumnMetadata> {storage::ColumnMetadata(name, type)},
+                                                         values,
+                                                         std::vector<storage::AbstractTable::SharedDictionaryPtr> {dictionary});
+    });
+  }
+}
+
+}  // namespace
+
+transaction_cid_t Checkpoint::create(const std::string &directory) {
+  std::map<std::string, storage::store_ptr_t> stores;
+  for (const auto& kv : io::StorageManager::getInstance()->all()) {
+    if (auto store = std::dynamic_pointer_cast<storage::Store>(kv.second))
+      stores[kv.first] = store;
+  }
+
+  // every store is written as of a commit id of its own, taken while the
+  // store is locked, the checkpoint is named after the oldest one
+  const transaction_cid_t cid = TransactionManager::getInstance().getLastCommitId();
+
+  const std::string target = directory + "/" + CHECKPOINT_PREFIX + std::to_string(cid);
+  const std::string tmp = target + TMP_SUFFIX;
+  fs::remove_all(tmp);
+  fs::create_directories(tmp);
+
+  std::string manifest;
+  writeRaw<uint64_t>(manifest, cid);
+  writeRaw<uint32_t>(manifest, stores.size());
+
+  size_t index = 0;
+  for (const auto& kv : stores) {
+    const std::string path = tmp + "/" + std::to_string(index++);
+    fs::create_directory(path);
+    writeString(manifest, kv.first);
+
+    const auto store = kv.second;
+    const auto name = kv.first;
+    // merges renumber rows, so none may run while the store is read; the
+    // other stores are merged meanwhile
+    auto merges = store->blockMerges();
+    const transaction_cid_t storeCid = TransactionManager::getInstance().getLastCommitId();
+    const uint64_t generation = store->generation();
+    const auto main = store->getMainTable();
+    // Rows merged online are checkpointed as delta rows, they may hold
+    // commits after storeCid that the log tail replays as inserts. The main
+    // keeps the value ids of the rows before, so its dictionaries serve.
+    const size_t rows = store->deltaOffset();
+    std::vector<std::function<void()> > jobs;
+    for (size_t column = 0; column < main->columnCount(); ++column)
+      jobs.push_back([path, main, rows, column] () { checkpointColumn(path, main, rows, column); });
+    jobs.push_back([path, name, store, main, rows, generation, storeCid] () {
+        checkpointTable(path, name, store, main, rows, generation, storeCid);
+      });
+    runTasks(jobs);
+  }
+
+  writeFile(tmp + "/" + MANIFEST_FILE, manifest);
+  syncDirectory(tmp);
+  fs::remove_all(target);
+  fs::rename(tmp, target);
+  syncDirectory(directory);
+  return cid;
+}
+
+std::string Checkpoint::latest(const std::string &directory, transaction_cid_t &cid) {
+  std::string result;
+  if (!fs::is_directory(directory))
+    return result;
+
+  for (fs::directory_iterator it(directory); it != fs::directory_iterator(); ++it) {
+    const std::string name = it->path().filename().string();
+    if (name.compare(0, CHECKPOINT_PREFIX.size(), CHECKPOINT_PREFIX) != 0 ||
+        name.find_first_not_of("0123456789", CHECKPOINT_PREFIX.size()) != std::string::npos ||
+        !fs::exists(it->path() / MANIFEST_FILE))
+      continue;
+    const transaction_cid_t candidate = std::stoll(name.substr(CHECKPOINT_PREFIX.size()));
+    if (result.empty() || candidate > cid) {
+      cid = candidate;
+      result = it->path().string();
+    }
+  }
+  return result;
+}
+
+transaction_cid_t Checkpoint::recover(const std::string &directory, const std::string &redoLog) {
+  transaction_cid_t cid = UNKNOWN_CID;
+  // the stores with replayed changes
+  std::set<std::string> replayed;
+  // commit id every checkpointed store was written at, the log tail
+  // changes each store after its own commit id only
+  std::map<std::string, transaction_cid_t> checkpointed;
+  const auto path = latest(directory, cid);
+  if (!path.empty()) {
+    const auto manifest = readFile(path + "/" + MANIFEST_FILE);
+    BinaryReader in(manifest.data(), manifest.size());
+    in.read<uint64_t>();
+    std::vector<std::string> names(in.read<uint32_t>());
+    for (auto& name : names) {
+      name = in.readString();
+      replayed.insert(name);
+    }
+
+    // all columns of all tables are loaded in parallel
+    std::vector<std::function<void()> > jobs;
+    std::vector<std::vector<storage::atable_ptr_t> > columns(names.size());
+    std::vector<size_t> rows(names.size());
+    std::vector<uint64_t> generations(names.size());
+    std::vector<transaction_cid_t> cids(names.size());
+    for (size_t i = 0; i < names.size(); ++i)
+      addColumnLoads(path + "/" + std::to_string(i), jobs, columns[i], rows[i], generations[i], cids[i]);
+    runTasks(jobs);
+    for (size_t i = 0; i < names.size(); ++i)
+      checkpointed[names[i]] = cids[i];
+
+    auto *storageManager = io::StorageManager::getInstance();
+    jobs.clear();
+    for (size_t i = 0; i < names.size(); ++i) {
+      auto main = std::make_shared<storage::MutableVerticalTable>(columns[i], rows[i]);
+      auto store = std::make_shared<storage::Store>(main);
+      store->setGeneration(generations[i]);
+      // the main has the ordered types of its dictionaries, the delta takes
+      // concurrent unordered dictionaries as the delta of a loaded store
+      store->setDelta(main->copy_structure(
+          [] (DataType type) { return storage::makeDictionary(types::getConcurrentType(types::getUnorderedType(type))); },
+          [] (size_t columns) { return std::make_shared<storage::ConcurrentFixedLengthVector<value_id_t> >(columns, 0); }));
+      if (storageManager->exists(names[i]))
+        storageManager->replaceTable(names[i], store);
+      else
+        storageManager->loadTable(names[i], store);
+
+      const std::string table = path + "/" + std::to_string(i);
+      jobs.push_back([table] () {
+        for (const auto& record : RedoLog::read(table + "/" + DELTA_FILE))
+          replay(record);
+      });
+    }
+    runTasks(jobs);
+  }
+
+  if (!redoLog.empty() && fs::exists(redoLog)) {
+    std::map<transaction_cid_t, RedoLogRecord> tail;
+    for (auto& record : RedoLog::read(redoLog)) {
+      if (record.cid > cid)
+        tail[record.cid] = std::move(record);
+    }
+
+    // commits behind a gap were never acknowledged
+    std::string recovered;
+    for (auto it = tail.begin(); it != tail.end() && it->first == cid + 1; ++it) {
+      recovered.append(RedoLog::frame(it->first, it->second.tid, it->second.serialize()));
+      auto &changes = it->second.changes;
+      const auto commit = it->first;
+      changes.erase(std::remove_if(changes.begin(), changes.end(), [&checkpointed, commit] (const RedoLogRecord::TableChanges &table) {
+            const auto store = checkpointed.find(table.table);
+            return store != checkpointed.end() && store->second >= commit;
+          }), changes.end());
+      replay(it->second);
+      for (const auto& table : changes)
+        replayed.insert(table.table);
+      cid = commit;
+    }
+
+    // the log continues after the replayed commits, without a torn tail
+    // or commits that are already part of the checkpoint
+    writeFile(redoLog + TMP_SUFFIX, recovered);
+    fs::rename(redoLog + TMP_SUFFIX, redoLog);
+    const auto parent = fs::path(redoLog).parent_path().string();
+    syncDirectory(parent.empty() ? "." : parent);
+  }
+
+  // rows reserved by transactions that did not commit before the crash
+  // never commit, so later online merges pass over them
+  for (const auto& name : replayed)
+    std::dynamic_pointer_cast<storage::Store>(io::StorageManager::getInstance()->getTable(name))->abortUncommitted();
+
+  TransactionManager::getInstance().setLastCommitId(cid);
+  return cid;
+}
+
+void Checkpoint::replay(const RedoLogRecord &record) {
+  for (const auto& changes : record.changes) {
+    auto store = std::dynamic_pointer_cast<storage::Store>(io::StorageManager::getInstance()->getTable(changes.table));
+    if (!store)
+      throw std::runtime_error("Cannot replay changes of " + changes.table + ", it is not a store");
+
+    if (changes.merged) {
+      // a store checkpointed right after its merge, before the merge
+      // committed, already holds the merged main
+      if (changes.generation == store->generation())
+        continue;
+      if (changes.generation != store->generation() + 1)
+        throw std::runtime_error("Cannot replay the merge of " + changes.table + ", a merge is missing in the redo log");
+      // the merge drops the rows that were invisible as of the commit before it
+      TransactionManager::getInstance().setLastCommitId(record.cid - 1);
+      store->merge();
+      continue;
+    }
+    // positions of another generation refer to other rows
+    if (changes.generation != store->generation())
+      throw std::runtime_error("Cannot replay changes of " + changes.table + " logged for another merge generation");
+
+    if (!changes.inserted.empty()) {
+      const auto offset = store->deltaOffset();
+      const auto minmax = std::minmax_element(changes.inserted.begin(), changes.inserted.end());
+      if (*minmax.first < offset)
+        throw std::runtime_error("Cannot replay inserts into the main table of " + changes.table);
+
+      if (*minmax.second >= store->size()) {
+        // rows reserved by transactions that did not commit before the
+        // crash hold default values and stay invisible
+        const size_t first = store->size();
+        store->appendToDelta(*minmax.second + 1 - first);
+        auto defaults = store->copy_structure_modifiable(nullptr, 1);
+        defaults->resize(1);
+        storage::type_switch<hyrise_basic_types> ts;
+        set_default_functor fun {defaults.get(), 0};
+        for (size_t column = 0; column < defaults->columnCount(); ++column) {
+          fun.column = column;
+          ts(defaults->typeOfColumn(column), fun);
+        }
+
+        pos_list_t inserted(changes.inserted);
+        std::sort(inserted.begin(), inserted.end());
+        for (pos_t row = first; row < store->size(); ++row) {
+          if (!std::binary_search(inserted.begin(), inserted.end(), row))
+            store->copyRowToDelta(defaults, 0, row - offset, START_TID);
+        }
+      }
+
+      auto rows = store->copy_structure_modifiable(nullptr, changes.inserted.size());
+      rows->resize(changes.inserted.size());
+      changes.copyInsertedRowsTo(rows, 0);
+      for (size_t i = 0; i < changes.inserted.size(); ++i)
+        store->copyRowToDelta(rows, i, changes.inserted[i] - offset, record.tid);
+      store->commitPositions(changes.inserted, record.cid, true);
+    }
+    store->commitPositions(changes.deleted, record.cid, false);
+  }
+}
+
+} } // namespace hyrise::tx
@@ -0,0 +1,56 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <string>
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace tx {
+
+struct RedoLogRecord;
+
+/*
+ * Consistent checkpoints of all stores in the StorageManager and recovery
+ * from a checkpoint and the tail of the redo log.
+ *
+ * A checkpoint captures every store as of a commit id without blocking
+ * transactions: the dictionaries and value ids of the main tables are
+ * written in a binary format, one task per column, and the rows of the
+ * delta together with the main rows deleted up to the snapshot are written
+ * as one redo log record per table. Row positions are kept as they are, so
+ * that the positions in the redo log stay valid.
+ *
+ * The checkpoint is written to checkpoint_<cid>.tmp below the checkpoint
+ * directory and renamed to checkpoint_<cid> once complete. Merging a store
+ * renumbers its rows, so a checkpoint blocks the merges of one store at a
+ * time while it reads that store, and keeps the merge generation and the
+ * last commit id at that moment. Recovery replays the commits of the log
+ * tail after the commit id of each store. Merges logged by
+ * TransactionManager::mergeStore() are replayed in commit order, log
+ * records of another generation are refused.
+ */
+class Checkpoint {
+ public:
+  /// Writes all stores to a new checkpoint below `directory`, each as of
+  /// the last commit id when it is read. Returns the commit id of the
+  /// checkpoint, the last commit id before the first store was read
+  static transaction_cid_t create(const std::string &directory);
+
+  /// Returns the path of the latest complete checkpoint below `directory`
+  /// and stores its commit id in `cid`, returns an empty path if there is
+  /// no checkpoint
+  static std::string latest(const std::string &directory, transaction_cid_t &cid);
+
+  /// Loads the latest checkpoint below `directory` into the StorageManager,
+  /// one task per column, and replays the gap-free sequence of commits of
+  /// `redoLog` that follows it. The log is rewritten to hold only the
+  /// replayed commits and the TransactionManager continues after the last
+  /// of them, which is returned. Has to run before transactions start.
+  static transaction_cid_t recover(const std::string &directory, const std::string &redoLog);
+
+  /// Applies a logged transaction to the stores of the StorageManager
+  static void replay(const RedoLogRecord &record);
+};
+
+} } // namespace hyrise::tx
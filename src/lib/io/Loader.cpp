@@ -131,7 +131,8 @@ std::shared_ptr<storage::AbstractTable> Loader::load(const params &args) {
     auto s = std::make_shared<storage::Store>(result);
     auto merger = new storage::TableMerger(new storage::DefaultMergeStrategy(), new storage::SequentialHeapMerger(), args.getCompressed());
     s->setMerger(merger);
-    s->merge();
+    if (!input->loaded_main())
+      s->merge();
     result = s;
   }
 
@@ -0,0 +1,44 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace hyrise {
+namespace io {
+
+MappedFile::MappedFile(const std::string &filename) : _data(nullptr), _size(0) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Could not open " + filename + ": " + std::strerror(errno));
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not stat " + filename + ": " + std::strerror(errno));
+  }
+  _size = info.st_size;
+
+  if (_size > 0) {
+    _data = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (_data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Could not map " + filename + ": " + std::strerror(errno));
+    }
+  }
+  // the mapping stays valid after closing the descriptor
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (_data != nullptr)
+    ::munmap(_data, _size);
+}
+
+} } // namespace hyrise::io
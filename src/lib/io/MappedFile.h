@@ -0,0 +1,41 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace hyrise {
+namespace io {
+
+/*
+ * A file mapped into memory as a whole. The mapping is private, so that
+ * the memory can be written to without changing the file, pages are only
+ * copied when they are modified. The mapping is removed together with
+ * the object, users of the memory share ownership of the MappedFile.
+ */
+class MappedFile {
+  void *_data;
+  size_t _size;
+
+ public:
+  explicit MappedFile(const std::string &filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  static std::shared_ptr<MappedFile> open(const std::string &filename) {
+    return std::make_shared<MappedFile>(filename);
+  }
+
+  char *data() const {
+    return static_cast<char *>(_data);
+  }
+
+  size_t size() const {
+    return _size;
+  }
+};
+
+} } // namespace hyrise::io
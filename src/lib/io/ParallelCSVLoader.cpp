@@ -0,0 +1,375 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/ParallelCSVLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+#include "helper/parallel_sort.hpp"
+#include "io/CSVLoader.h"
+#include "io/MappedFile.h"
+#include "storage/AbstractTable.h"
+#include "storage/OrderPreservingDictionary.h"
+#include "taskscheduler/ParallelTasks.h"
+
+namespace hyrise {
+namespace io {
+
+namespace {
+
+// Rows of a word of 64 bit of any attribute vector, threads writing
+// slices of multiples of these rows never write to the same word
+static const size_t ROWS_PER_SLICE = 64;
+
+// Bytes of a field within the mapped file
+struct FieldRef {
+  const char *data;
+  size_t size;
+
+  bool operator<(const FieldRef &other) const {
+    const int result = std::memcmp(data, other.data, std::min(size, other.size));
+    return result < 0 || (result == 0 && size < other.size);
+  }
+
+  bool operator==(const FieldRef &other) const {
+    return size == other.size && std::memcmp(data, other.data, size) == 0;
+  }
+};
+
+enum Kind { INT_VALUES, FLOAT_VALUES, STRING_VALUES };
+
+// Values of a column, only the vector of its kind is used
+struct ColumnValues {
+  std::vector<hyrise_int_t> ints;
+  std::vector<hyrise_float_t> floats;
+  std::vector<FieldRef> strings;
+};
+
+template <typename T> std::vector<T> &valuesOf(ColumnValues &values);
+template <> std::vector<hyrise_int_t> &valuesOf(ColumnValues &values) { return values.ints; }
+template <> std::vector<hyrise_float_t> &valuesOf(ColumnValues &values) { return values.floats; }
+template <> std::vector<FieldRef> &valuesOf(ColumnValues &values) { return values.strings; }
+
+hyrise_int_t toValue(hyrise_int_t value) { return value; }
+hyrise_float_t toValue(hyrise_float_t value) { return value; }
+hyrise_string_t toValue(const FieldRef &value) { return hyrise_string_t(value.data, value.size); }
+
+// Same result as atol for the field
+hyrise_int_t parseInt(const FieldRef &field) {
+  const char *p = field.data;
+  const char *end = field.data + field.size;
+  bool negative = false;
+  if (p != end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  uint64_t value = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; ++p)
+    value = value * 10 + (*p - '0');
+  return static_cast<hyrise_int_t>(negative ? 0 - value : value);
+}
+
+// atof needs a terminated string, the mapped file stays untouched
+hyrise_float_t parseFloat(const FieldRef &field) {
+  char buffer[64];
+  if (field.size < sizeof(buffer)) {
+    std::memcpy(buffer, field.data, field.size);
+    buffer[field.size] = '\0';
+    return std::atof(buffer);
+  }
+  return std::atof(toValue(field).c_str());
+}
+
+bool isBlank(char c) {
+  return c == ' ' || c == '\t';
+}
+
+// Lines [first, last) of the file and their parsed values per column
+struct Chunk {
+  const char *first;
+  const char *last;
+  size_t rows;
+  std::vector<ColumnValues> columns;
+};
+
+void append(ColumnValues &values, Kind kind, const FieldRef &field) {
+  switch (kind) {
+    case INT_VALUES:
+      values.ints.push_back(parseInt(field));
+      break;
+    case FLOAT_VALUES:
+      values.floats.push_back(parseFloat(field));
+      break;
+    case STRING_VALUES:
+      values.strings.push_back(field);
+      break;
+  }
+}
+
+// Splits the lines of chunk like libcsv does for unquoted fields: blanks
+// around fields are removed and blank lines are skipped. Returns false
+// as soon as a quoted field is found.
+bool parseChunk(Chunk &chunk, const std::vector<Kind> &kinds, char delimiter, bool unsafe) {
+  chunk.rows = 0;
+  chunk.columns.resize(kinds.size());
+  for (const char *line = chunk.first; line < chunk.last;) {
+    const char *end = static_cast<const char *>(std::memchr(line, '\n', chunk.last - line));
+    if (end == nullptr)
+      end = chunk.last;
+    const char *next = end + 1;
+    while (end != line && (end[-1] == '\r' || isBlank(end[-1])))
+      --end;
+    while (line != end && isBlank(*line))
+      ++line;
+    if (line == end) {
+      line = next;
+      continue;
+    }
+
+    size_t column = 0;
+    for (const char *field = line;; ++column) {
+      const char *stop = static_cast<const char *>(std::memchr(field, delimiter, end - field));
+      if (stop == nullptr)
+        stop = end;
+      FieldRef value = {field, static_cast<size_t>(stop - field)};
+      while (value.size > 0 && isBlank(*value.data)) {
+        ++value.data;
+        --value.size;
+      }
+      while (value.size > 0 && isBlank(value.data[value.size - 1]))
+        --value.size;
+      if (value.size > 0 && *value.data == '"')
+        return false;
+
+      if (column < kinds.size())
+        append(chunk.columns[column], kinds[column], value);
+      else if (!unsafe)
+        throw CSVLoaderError("There is more data than columns!");
+
+      if (stop == end)
+        break;
+      field = stop + 1;
+    }
+
+    if (++column < kinds.size()) {
+      if (!unsafe)
+        throw CSVLoaderError("Less data than columns");
+      for (; column < kinds.size(); ++column)
+        append(chunk.columns[column], kinds[column], {end, 0});
+    }
+    ++chunk.rows;
+    line = next;
+  }
+  return true;
+}
+
+// Sorted distinct values of column in all chunks
+template <typename T>
+std::vector<T> sortedDistinct(std::vector<Chunk> &chunks, size_t column, size_t threads) {
+  size_t size = 0;
+  for (auto &chunk : chunks)
+    size += valuesOf<T>(chunk.columns[column]).size();
+  std::vector<T> distinct;
+  distinct.reserve(size);
+  for (auto &chunk : chunks) {
+    const auto &values = valuesOf<T>(chunk.columns[column]);
+    distinct.insert(distinct.end(), values.begin(), values.end());
+  }
+  ParallelSort<T>::sort(&distinct, threads, std::less<T>(), taskscheduler::runParallel);
+  distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+  return distinct;
+}
+
+template <typename T, typename R>
+void setDictionary(const storage::atable_ptr_t &table, size_t column, std::vector<Chunk> &chunks, ColumnValues &distinct, size_t threads) {
+  auto &values = valuesOf<T>(distinct);
+  values = sortedDistinct<T>(chunks, column, threads);
+  auto dict = std::make_shared<storage::OrderPreservingDictionary<R>>(values.size());
+  for (const auto &value : values)
+    dict->addValue(toValue(value));
+  table->setDictionaryAt(dict, column);
+}
+
+// Writes the value ids of values [first, first + count) of column of
+// chunk to the rows starting at row
+template <typename T>
+void writeValueIds(const storage::atable_ptr_t &table, size_t column, Chunk &chunk, ColumnValues &distinct,
+                   size_t first, size_t count, size_t row) {
+  const auto &values = valuesOf<T>(chunk.columns[column]);
+  const auto &dictionary = valuesOf<T>(distinct);
+  for (size_t i = first; i < first + count; ++i, ++row) {
+    const auto id = std::lower_bound(dictionary.begin(), dictionary.end(), values[i]) - dictionary.begin();
+    table->setValueId(column, row, ValueId(id, 0));
+  }
+}
+
+template <typename T, typename R>
+void setValues(const storage::atable_ptr_t &table, size_t column, std::vector<Chunk> &chunks) {
+  size_t row = 0;
+  for (auto &chunk : chunks) {
+    for (const auto &value : valuesOf<T>(chunk.columns[column]))
+      table->setValue<R>(column, row++, toValue(value));
+  }
+}
+
+}  // namespace
+
+bool buildsOrderedDictionary(DataType type) {
+  return type == IntegerType || type == FloatType || type == StringType;
+}
+
+bool parallelLoadCSV(const std::string &filename,
+                     const csv::params &params,
+                     bool unsafe,
+                     const storage::atable_ptr_t &table,
+                     size_t threads,
+                     size_t minChunkBytes) {
+  const auto file = MappedFile::open(filename);
+  const char *first = file->data();
+  const char *last = first + file->size();
+  for (ssize_t line = params.getLineStart(); line > 1 && first != last; --line) {
+    const char *end = static_cast<const char *>(std::memchr(first, '\n', last - first));
+    first = end == nullptr ? last : end + 1;
+  }
+
+  const size_t columns = table->columnCount();
+  std::vector<Kind> kinds(columns);
+  std::vector<bool> ordered(columns);
+  for (size_t column = 0; column < columns; ++column) {
+    const DataType type = table->typeOfColumn(column);
+    switch (type) {
+      case IntegerType:
+      case IntegerTypeDelta:
+      case IntegerTypeDeltaConcurrent:
+      case IntegerNoDictType:
+        kinds[column] = INT_VALUES;
+        break;
+      case FloatType:
+      case FloatTypeDelta:
+      case FloatTypeDeltaConcurrent:
+      case FloatNoDictType:
+        kinds[column] = FLOAT_VALUES;
+        break;
+      case StringType:
+      case StringTypeDelta:
+      case StringTypeDeltaConcurrent:
+        kinds[column] = STRING_VALUES;
+        break;
+      default:
+        throw std::runtime_error("Unsupported column type");
+    }
+    ordered[column] = buildsOrderedDictionary(type);
+  }
+
+  // every chunk but the first starts behind the line break following its share of the file
+  const size_t size = last - first;
+  threads = std::max<size_t>(1, std::min(threads, size / std::max<size_t>(1, minChunkBytes)));
+  std::vector<Chunk> chunks(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    const char *start = i == 0 ? first : std::max(chunks[i - 1].first, first + size * i / threads);
+    if (i > 0 && start != last) {
+      const char *end = static_cast<const char *>(std::memchr(start - 1, '\n', last - start + 1));
+      start = end == nullptr ? last : end + 1;
+    }
+    chunks[i].first = start;
+    if (i > 0)
+      chunks[i - 1].last = start;
+  }
+  chunks.back().last = last;
+
+  std::vector<std::exception_ptr> errors(threads);
+  std::atomic<bool> quoted(false);
+  taskscheduler::runParallel(threads, [&] (size_t thread) {
+    try {
+      if (!parseChunk(chunks[thread], kinds, params.getDelimiter(), unsafe))
+        quoted = true;
+    } catch (...) {
+      errors[thread] = std::current_exception();
+    }
+  });
+  // a quoted field may span lines and break up the rows of other chunks
+  if (quoted)
+    return false;
+  for (const auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  std::vector<size_t> chunkRows(threads + 1, 0);
+  for (size_t i = 0; i < threads; ++i)
+    chunkRows[i + 1] = chunkRows[i] + chunks[i].rows;
+  const size_t rows = chunkRows.back();
+
+  // dictionaries are replaced while the table is empty, bit compressed
+  // attribute vectors cannot change their width later
+  std::vector<ColumnValues> distinct(columns);
+  for (size_t column = 0; column < columns && rows > 0; ++column) {
+    if (!ordered[column])
+      continue;
+    switch (kinds[column]) {
+      case INT_VALUES:
+        setDictionary<hyrise_int_t, hyrise_int_t>(table, column, chunks, distinct[column], threads);
+        break;
+      case FLOAT_VALUES:
+        setDictionary<hyrise_float_t, hyrise_float_t>(table, column, chunks, distinct[column], threads);
+        break;
+      case STRING_VALUES:
+        setDictionary<FieldRef, hyrise_string_t>(table, column, chunks, distinct[column], threads);
+        break;
+    }
+  }
+  table->resize(rows);
+
+  const size_t slices = (rows + ROWS_PER_SLICE - 1) / ROWS_PER_SLICE;
+  const size_t writers = std::max<size_t>(1, std::min(threads, slices));
+  taskscheduler::runParallel(writers, [&] (size_t thread) {
+    size_t row = std::min(rows, slices * thread / writers * ROWS_PER_SLICE);
+    const size_t stop = std::min(rows, slices * (thread + 1) / writers * ROWS_PER_SLICE);
+    size_t chunk = std::upper_bound(chunkRows.begin(), chunkRows.end(), row) - chunkRows.begin() - 1;
+    for (; row < stop; ++chunk) {
+      const size_t end = std::min(stop, chunkRows[chunk + 1]);
+      for (size_t column = 0; column < columns; ++column) {
+        if (!ordered[column])
+          continue;
+        const size_t index = row - chunkRows[chunk];
+        switch (kinds[column]) {
+          case INT_VALUES:
+            writeValueIds<hyrise_int_t>(table, column, chunks[chunk], distinct[column], index, end - row, row);
+            break;
+          case FLOAT_VALUES:
+            writeValueIds<hyrise_float_t>(table, column, chunks[chunk], distinct[column], index, end - row, row);
+            break;
+          case STRING_VALUES:
+            writeValueIds<FieldRef>(table, column, chunks[chunk], distinct[column], index, end - row, row);
+            break;
+        }
+      }
+      row = end;
+    }
+  });
+
+  for (size_t column = 0; column < columns; ++column) {
+    if (ordered[column])
+      continue;
+    if (table->typeOfColumn(column) == IntegerNoDictType) {
+      setValues<hyrise_int_t, hyrise_int32_t>(table, column, chunks);
+      continue;
+    }
+    switch (kinds[column]) {
+      case INT_VALUES:
+        setValues<hyrise_int_t, hyrise_int_t>(table, column, chunks);
+        break;
+      case FLOAT_VALUES:
+        setValues<hyrise_float_t, hyrise_float_t>(table, column, chunks);
+        break;
+      case STRING_VALUES:
+        setValues<FieldRef, hyrise_string_t>(table, column, chunks);
+        break;
+    }
+  }
+  return true;
+}
+
+} } // namespace hyrise::io
@@ -0,0 +1,35 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "helper/types.h"
+#include "io/GenericCSV.h"
+
+namespace hyrise {
+namespace io {
+
+/*
+  Loads a delimited file into table without going through libcsv. The
+  file is mapped into memory and split at line boundaries into a chunk
+  per thread of at least minChunkBytes, every thread parses the fields
+  of its chunk in place into typed values. Columns of ordered types get
+  a dictionary built from a parallel sort of their values and their
+  value ids are written in parallel, all other columns are filled row
+  by row through setValue. Missing fields of unsafe loads are empty.
+  Returns false without changing table if a field is quoted, those
+  files are left to the generic parser. The threads are tasks on idle
+  workers of the shared scheduler, see taskscheduler::runParallel.
+ */
+/// True if parallelLoadCSV builds an ordered dictionary for columns of type
+bool buildsOrderedDictionary(DataType type);
+
+bool parallelLoadCSV(const std::string &filename,
+                     const csv::params &params,
+                     bool unsafe,
+                     const storage::atable_ptr_t &table,
+                     size_t threads,
+                     size_t minChunkBytes = 1 << 20);
+
+} } // namespace hyrise::io
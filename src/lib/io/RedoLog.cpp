@@ -0,0 +1,363 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "io/RedoLog.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <boost/crc.hpp>
+
+#include "io/BinaryEncoding.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "storage/AbstractTable.h"
+#include "storage/Store.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace tx {
+
+const std::chrono::microseconds RedoLog::DEFAULT_GROUP_COMMIT_WINDOW(1000);
+const size_t RedoLog::DEFAULT_MAX_GROUP_SIZE;
+
+namespace {
+
+using io::writeRaw;
+using io::writeString;
+using io::BinaryReader;
+
+struct encode_value_functor {
+  typedef void value_type;
+
+  const storage::AbstractTable *table;
+  size_t column;
+  size_t row;
+  std::string *out;
+
+  template <typename T>
+  void operator()() {
+    writeRaw(*out, table->getValue<T>(column, row));
+  }
+};
+
+template <>
+void encode_value_functor::operator()<hyrise_string_t>() {
+  writeString(*out, table->getValue<hyrise_string_t>(column, row));
+}
+
+struct decode_value_functor {
+  typedef void value_type;
+
+  storage::AbstractTable *table;
+  size_t column;
+  size_t row;
+  BinaryReader *in;
+
+  template <typename T>
+  void operator()() {
+    table->setValue<T>(column, row, in->read<T>());
+  }
+};
+
+template <>
+void decode_value_functor::operator()<hyrise_string_t>() {
+  table->setValue<hyrise_string_t>(column, row, in->readString());
+}
+
+void writePositions(std::string &out, const pos_list_t &positions) {
+  writeRaw<uint32_t>(out, positions.size());
+  for (const auto& pos : positions)
+    writeRaw<uint64_t>(out, pos);
+}
+
+pos_list_t readPositions(BinaryReader &in) {
+  pos_list_t positions(in.read<uint32_t>());
+  for (auto& pos : positions)
+    pos = in.read<uint64_t>();
+  return positions;
+}
+
+uint32_t checksum(const char *data, size_t size) {
+  boost::crc_32_type crc;
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+
+}  // namespace
+
+void RedoLogRecord::TableChanges::copyInsertedRowsTo(const storage::atable_ptr_t &table, size_t firstRow) const {
+  if (table->columnCount() != types.size())
+    throw std::runtime_error("Redo log record for " + this->table + " does not match the table layout");
+
+  BinaryReader in(rows.data(), rows.size());
+  storage::type_switch<hyrise_basic_types> ts;
+  decode_value_functor fun {table.get(), 0, 0, &in};
+  for (size_t row = 0; row < inserted.size(); ++row) {
+    fun.row = firstRow + row;
+    for (size_t column = 0; column < types.size(); ++column) {
+      fun.column = column;
+      ts(types[column], fun);
+    }
+  }
+}
+
+RedoLogRecord::TableChanges RedoLogRecord::TableChanges::capture(const std::string &name,
+                                                                const storage::c_atable_ptr_t &table,
+                                                                const pos_list_t &inserted,
+                                                                const pos_list_t &deleted) {
+  TableChanges result;
+  result.table = name;
+  if (auto store = std::dynamic_pointer_cast<const storage::Store>(table))
+    result.generation = store->generation();
+  for (size_t column = 0; column < table->columnCount(); ++column)
+    result.types.push_back(table->typeOfColumn(column));
+  result.inserted.assign(inserted.begin(), inserted.end());
+  result.deleted.assign(deleted.begin(), deleted.end());
+
+  storage::type_switch<hyrise_basic_types> ts;
+  encode_value_functor fun {table.get(), 0, 0, &result.rows};
+  for (const auto& row : inserted) {
+    fun.row = row;
+    for (size_t column = 0; column < result.types.size(); ++column) {
+      fun.column = column;
+      ts(result.types[column], fun);
+    }
+  }
+  return result;
+}
+
+std::string RedoLogRecord::serialize() const {
+  std::string out;
+  writeRaw<uint32_t>(out, changes.size());
+  for (const auto& table : changes) {
+    writeString(out, table.table);
+    writeRaw<uint64_t>(out, table.generation);
+    writeRaw<uint8_t>(out, table.merged);
+    writeRaw<uint32_t>(out, table.types.size());
+    for (const auto& type : table.types)
+      writeRaw<uint8_t>(out, type);
+    writePositions(out, table.inserted);
+    writePositions(out, table.deleted);
+    writeString(out, table.rows);
+  }
+  return out;
+}
+
+RedoLog::RedoLog(const std::string &filename,
+                 transaction_cid_t lastCommitId,
+                 std::chrono::microseconds groupCommitWindow,
+                 size_t maxGroupSize) :
+    _filename(filename),
+    _groupCommitWindow(groupCommitWindow),
+    _maxGroupSize(maxGroupSize),
+    _fd(::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644)),
+    _queueSize(0),
+    _durableCid(lastCommitId),
+    _stop(false) {
+  if (_fd < 0)
+    throw std::runtime_error("Could not open redo log " + filename + ": " + std::strerror(errno));
+  _writer = std::thread(&RedoLog::run, this);
+}
+
+RedoLog::~RedoLog() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _pending.notify_one();
+  _writer.join();
+  ::close(_fd);
+}
+
+std::string RedoLog::tableName(const storage::c_atable_ptr_t &table) {
+  std::lock_guard<std::mutex> lock(_namesMutex);
+  auto it = _names.find(table);
+  if (it != _names.end())
+    return it->second;
+
+  std::string name;
+  for (const auto& kv : io::StorageManager::getInstance()->all()) {
+    if (std::dynamic_pointer_cast<const storage::AbstractTable>(kv.second) == table) {
+      name = kv.first;
+      break;
+    }
+  }
+  // tables created later under the same name are different objects, so
+  // a name is not cached for tables unknown to the StorageManager
+  if (!name.empty())
+    _names[table] = name;
+  return name;
+}
+
+std::string RedoLog::serialize(const TXModifications &modifications) {
+  // collect the names first to log the tables in a stable order
+  std::map<std::string, storage::c_atable_ptr_t> tables;
+  for (const auto* data : {&modifications.inserted, &modifications.deleted}) {
+    for (const auto& kv : *data) {
+      if (auto table = kv.first.lock()) {
+        const auto& name = tableName(table);
+        if (!name.empty())
+          tables[name] = table;
+      }
+    }
+  }
+
+  RedoLogRecord record;
+  for (const auto& kv : tables) {
+    const auto& table = kv.second;
+    static const pos_list_t none;
+    const auto& inserted = modifications.hasInserted(table) ? modifications.getInserted(table) : none;
+    const auto& deleted = modifications.hasDeleted(table) ? modifications.getDeleted(table) : none;
+    record.changes.push_back(RedoLogRecord::TableChanges::capture(kv.first, table, inserted, deleted));
+  }
+  return record.serialize();
+}
+
+std::string RedoLog::serializeMerge(const storage::c_atable_ptr_t &store) {
+  RedoLogRecord record;
+  const auto& name = tableName(store);
+  if (!name.empty()) {
+    record.changes.push_back(RedoLogRecord::TableChanges::capture(name, store, {}, {}));
+    record.changes.back().merged = true;
+  }
+  return record.serialize();
+}
+
+void RedoLog::append(transaction_cid_t cid, transaction_id_t tid, std::string record) {
+  bool notify;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queueSize += record.size();
+    _queue.push_back({cid, tid, std::move(record)});
+    // the writer waits for the first record of a group and for full groups
+    notify = _queue.size() == 1 || _queueSize >= _maxGroupSize;
+  }
+  if (notify)
+    _pending.notify_one();
+}
+
+void RedoLog::waitDurable(transaction_cid_t cid) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _durable.wait(lock, [this, cid] { return _durableCid >= cid || !_error.empty(); });
+  if (_durableCid < cid)
+    throw std::runtime_error("Writing the redo log failed: " + _error);
+}
+
+transaction_cid_t RedoLog::getDurableCommitId() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _durableCid;
+}
+
+void RedoLog::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _pending.wait(lock, [this] { return _stop || !_queue.empty(); });
+    if (_queue.empty())
+      break;
+
+    // give concurrent transactions the chance to join the group
+    const auto deadline = std::chrono::steady_clock::now() + _groupCommitWindow;
+    _pending.wait_until(lock, deadline, [this] { return _stop || _queueSize >= _maxGroupSize; });
+
+    std::vector<PendingRecord> group;
+    group.swap(_queue);
+    _queueSize = 0;
+
+    lock.unlock();
+    std::string error;
+    try {
+      writeGroup(group);
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+    lock.lock();
+
+    if (!error.empty()) {
+      _error = error;
+    } else {
+      for (const auto& record : group)
+        _durableCids.insert(record.cid);
+      while (!_durableCids.empty() && *_durableCids.begin() == _durableCid + 1) {
+        _durableCids.erase(_durableCids.begin());
+        ++_durableCid;
+      }
+    }
+    _durable.notify_all();
+  }
+}
+
+std::string RedoLog::frame(transaction_cid_t cid, transaction_id_t tid, const std::string &body) {
+  std::string payload;
+  writeRaw<uint64_t>(payload, cid);
+  writeRaw<uint64_t>(payload, tid);
+  payload.append(body);
+
+  std::string out;
+  writeRaw<uint32_t>(out, payload.size());
+  writeRaw<uint32_t>(out, checksum(payload.data(), payload.size()));
+  out.append(payload);
+  return out;
+}
+
+void RedoLog::writeGroup(const std::vector<PendingRecord> &group) {
+  std::string buffer;
+  for (const auto& record : group)
+    buffer.append(frame(record.cid, record.tid, record.body));
+
+  for (size_t written = 0; written < buffer.size();) {
+    auto result = ::write(_fd, buffer.data() + written, buffer.size() - written);
+    if (result < 0) {
+      if (errno == EINTR)
+        continue;
+      throw std::runtime_error(std::strerror(errno));
+    }
+    written += result;
+  }
+  if (::fdatasync(_fd) != 0)
+    throw std::runtime_error(std::strerror(errno));
+}
+
+std::vector<RedoLogRecord> RedoLog::read(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  std::vector<RedoLogRecord> records;
+  BinaryReader log(data.data(), data.size());
+  try {
+    while (!log.atEnd()) {
+      const auto size = log.read<uint32_t>();
+      const auto crc = log.read<uint32_t>();
+      const char *payload = log.take(size);
+      if (checksum(payload, size) != crc)
+        break;
+
+      BinaryReader in(payload, size);
+      RedoLogRecord record;
+      record.cid = in.read<uint64_t>();
+      record.tid = in.read<uint64_t>();
+      record.changes.resize(in.read<uint32_t>());
+      for (auto& changes : record.changes) {
+        changes.table = in.readString();
+        changes.generation = in.read<uint64_t>();
+        changes.merged = in.read<uint8_t>() != 0;
+        changes.types.resize(in.read<uint32_t>());
+        for (auto& type : changes.types)
+          type = static_cast<DataType>(in.read<uint8_t>());
+        changes.inserted = readPositions(in);
+        changes.deleted = readPositions(in);
+        changes.rows = in.readString();
+      }
+      records.push_back(std::move(record));
+    }
+  } catch (const std::runtime_error &) {
+    // torn write at the end of the log
+  }
+  return records;
+}
+
+} } // namespace hyrise::tx
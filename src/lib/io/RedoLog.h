@@ -0,0 +1,157 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helper/types.h"
+#include "io/TXContext.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace tx {
+
+class TXModifications;
+
+/// The changes of one committed transaction, as read from a redo log
+struct RedoLogRecord {
+  struct TableChanges {
+    std::string table;
+    // generation of the store the positions refer to, see Store::generation()
+    uint64_t generation = 0;
+    // the store was merged into `generation`, no rows are changed
+    bool merged = false;
+    std::vector<DataType> types;
+    pos_list_t inserted;
+    pos_list_t deleted;
+    // encoded values of the inserted rows
+    std::string rows;
+
+    /// Encodes the values of the `inserted` rows of `table`
+    static TableChanges capture(const std::string &name,
+                                const storage::c_atable_ptr_t &table,
+                                const pos_list_t &inserted,
+                                const pos_list_t &deleted);
+
+    /// Writes the inserted rows to `table`, starting at `firstRow`
+    void copyInsertedRowsTo(const storage::atable_ptr_t &table, size_t firstRow) const;
+  };
+
+  /// Encodes the changes as a record body, as expected by RedoLog::append()
+  std::string serialize() const;
+
+  transaction_cid_t cid;
+  transaction_id_t tid;
+  std::vector<TableChanges> changes;
+};
+
+/*
+ * Write-ahead redo log with group commit.
+ *
+ * Committing transactions serialize their inserts and deletes before
+ * entering the commit critical section and hand the record over with
+ * append() afterwards. A single writer thread collects the records for up
+ * to the group commit window, writes them in one batch and syncs the file
+ * once for the whole group. waitDurable() returns once the transaction and
+ * all transactions with a lower commit id are on disk, so that a recovered
+ * log always holds a gap-free prefix of commits.
+ *
+ * Each record is stored as its size and CRC32 followed by the payload, so
+ * that a torn write at the end of the log is detected on reading.
+ * Positions of inserted and deleted rows refer to the generation of the
+ * store at the time of logging, a merge of the store is logged as a
+ * record of its own. Only tables registered at the StorageManager are
+ * logged.
+ */
+class RedoLog {
+ public:
+  static const std::chrono::microseconds DEFAULT_GROUP_COMMIT_WINDOW;
+  static const size_t DEFAULT_MAX_GROUP_SIZE = 1 << 20;
+
+  /// Appends to `filename`; `lastCommitId` is the commit id of the last
+  /// transaction that was made durable before
+  RedoLog(const std::string &filename,
+          transaction_cid_t lastCommitId,
+          std::chrono::microseconds groupCommitWindow = DEFAULT_GROUP_COMMIT_WINDOW,
+          size_t maxGroupSize = DEFAULT_MAX_GROUP_SIZE);
+
+  /// Writes all pending records and stops the writer thread
+  ~RedoLog();
+
+  RedoLog(const RedoLog &) = delete;
+  RedoLog &operator=(const RedoLog &) = delete;
+
+  /// Serializes the modifications of a transaction, to be called before
+  /// its commit id is known
+  std::string serialize(const TXModifications &modifications);
+
+  /// Serializes the merge of `store`, to be called after the merge; the
+  /// merge is appended with a commit id of its own
+  std::string serializeMerge(const storage::c_atable_ptr_t &store);
+
+  /// Hands over the serialized modifications of the transaction that
+  /// committed with `cid`; every commit id has to be appended exactly once
+  void append(transaction_cid_t cid, transaction_id_t tid, std::string record);
+
+  /// Blocks until all transactions up to `cid` are durable, throws
+  /// std::runtime_error if writing the log failed
+  void waitDurable(transaction_cid_t cid);
+
+  transaction_cid_t getDurableCommitId() const;
+
+  const std::string &getFilename() const { return _filename; }
+
+  /// Encodes a record with its size and checksum as it is written to the log
+  static std::string frame(transaction_cid_t cid, transaction_id_t tid, const std::string &body);
+
+  /// Reads all complete records of a redo log in the order they were
+  /// written, a torn or corrupted tail is ignored
+  static std::vector<RedoLogRecord> read(const std::string &filename);
+
+ private:
+  struct PendingRecord {
+    transaction_cid_t cid;
+    transaction_id_t tid;
+    std::string body;
+  };
+
+  void run();
+  void writeGroup(const std::vector<PendingRecord> &group);
+  std::string tableName(const storage::c_atable_ptr_t &table);
+
+  const std::string _filename;
+  const std::chrono::microseconds _groupCommitWindow;
+  const size_t _maxGroupSize;
+  int _fd;
+
+  mutable std::mutex _mutex;
+  // signals the writer that records are pending
+  std::condition_variable _pending;
+  // signals committers that records became durable
+  std::condition_variable _durable;
+
+  std::vector<PendingRecord> _queue;
+  size_t _queueSize;
+  // durable commit ids above the gap-free prefix
+  std::set<transaction_cid_t> _durableCids;
+  transaction_cid_t _durableCid;
+  std::string _error;
+  bool _stop;
+
+  // table names of logged tables, resolved through the StorageManager
+  std::mutex _namesMutex;
+  std::map<std::weak_ptr<const storage::AbstractTable>,
+           std::string,
+           std::owner_less<std::weak_ptr<const storage::AbstractTable> > > _names;
+
+  std::thread _writer;
+};
+
+} } // namespace hyrise::tx
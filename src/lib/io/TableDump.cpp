@@ -13,15 +13,22 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include "io/BinaryEncoding.h"
 #include "io/LoaderException.h"
 #include "io/GenericCSV.h"
 #include "io/CSVLoader.h"
+#include "io/MappedFile.h"
 
 #include "helper/stringhelpers.h"
 #include "helper/vector_helpers.h"
 
 #include "storage/AbstractTable.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/DictionaryFactory.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/OrderPreservingDictionary.h"
 #include "storage/Store.h"
+#include "storage/Table.h"
 #include "storage/storage_types.h"
 #include "storage/storage_types_helper.h"
 #include "storage/meta_storage.h"
@@ -33,10 +40,49 @@ namespace DumpHelper {
   static const std::string HEADER_EXT = "header.dat";
   static const std::string DICT_EXT = ".dict.dat";
   static const std::string ATTR_EXT = ".attr.dat";
+  static const std::string MAPPED_DICT_EXT = ".dict.map";
+  static const std::string MAPPED_ATTR_EXT = ".attr.map";
+
+  // Mapped files start with a header of this size, followed by the data
+  static const size_t MAPPED_HEADER_SIZE = 4096;
+  static const uint64_t MAPPED_MAGIC = 0x31504d4445535948ull; // "HYSEDMP1"
 
   static inline std::string buildPath(std::initializer_list<std::string> l) {
     return functional::foldLeft(l, std::string(), infix("/"));
   }
+
+  static inline size_t readSize(std::string path) {
+    std::ifstream data (path, std::ios::binary);
+    size_t numRows;
+    data >> numRows;
+    data.close();
+    return numRows;
+  }
+
+  /// Header of a mapped column file, padded to MAPPED_HEADER_SIZE
+  struct MappedHeader {
+    uint64_t magic;
+    uint32_t type;
+    uint64_t count;
+    uint64_t bits;
+  };
+
+  static inline void writeMappedHeader(std::ofstream &data, const MappedHeader &header) {
+    std::string out;
+    io::writeRaw(out, header);
+    out.resize(MAPPED_HEADER_SIZE, '\0');
+    data.write(out.data(), out.size());
+  }
+
+  static inline MappedHeader readMappedHeader(const io::MappedFile &file, const std::string &path) {
+    if (file.size() < MAPPED_HEADER_SIZE)
+      throw std::runtime_error("Mapped dump file " + path + " is truncated");
+    io::BinaryReader in(file.data(), MAPPED_HEADER_SIZE);
+    auto header = in.read<MappedHeader>();
+    if (header.magic != MAPPED_MAGIC)
+      throw std::runtime_error("Mapped dump file " + path + " has an invalid header");
+    return header;
+  }
 }
 
 /**
@@ -102,6 +148,64 @@ struct write_to_dict_functor {
 
 };
 
+/**
+ * Writes the values of an ordered dictionary in their binary
+ * representation
+ */
+struct write_mapped_dict_functor {
+  typedef void value_type;
+
+  std::ofstream& data;
+  std::shared_ptr<AbstractTable> table;
+  field_t col;
+  size_t size;
+
+  template <typename R>
+  void operator()() {
+    std::string out;
+    for (size_t i = 0; i < size; ++i)
+      io::writeRaw(out, table->getValueForValueId<R>(col, ValueId(i, 0)));
+    data.write(out.data(), out.size());
+  }
+};
+
+template <>
+void write_mapped_dict_functor::operator()<hyrise_string_t>() {
+  std::string out;
+  for (size_t i = 0; i < size; ++i)
+    io::writeString(out, table->getValueForValueId<hyrise_string_t>(col, ValueId(i, 0)));
+  data.write(out.data(), out.size());
+}
+
+/**
+ * Creates an ordered dictionary over the values of a mapped dictionary
+ * file, strings are read into the dictionary
+ */
+struct map_dict_functor {
+  typedef std::shared_ptr<AbstractDictionary> value_type;
+
+  std::shared_ptr<io::MappedFile> file;
+  std::string path;
+  size_t size;
+
+  template <typename R>
+  value_type operator()() {
+    if (file->size() < DumpHelper::MAPPED_HEADER_SIZE + size * sizeof(R))
+      throw std::runtime_error("Mapped dump file " + path + " is truncated");
+    auto values = reinterpret_cast<const R *>(file->data() + DumpHelper::MAPPED_HEADER_SIZE);
+    return std::make_shared<OrderPreservingDictionary<R> >(values, size, file);
+  }
+};
+
+template <>
+map_dict_functor::value_type map_dict_functor::operator()<hyrise_string_t>() {
+  io::BinaryReader in(file->data() + DumpHelper::MAPPED_HEADER_SIZE, file->size() - DumpHelper::MAPPED_HEADER_SIZE);
+  auto dict = std::make_shared<OrderPreservingDictionary<hyrise_string_t> >(size);
+  for (size_t i = 0; i < size; ++i)
+    dict->addValue(in.readString());
+  return dict;
+}
+
 void SimpleTableDump::prepare(std::string name) {
   struct stat buffer;
   // Check if the directories exists and create if necessary with basic permissions
@@ -115,8 +219,12 @@ void SimpleTableDump::prepare(std::string name) {
       throw std::runtime_error(strerror(errno));
 }
 
+std::string SimpleTableDump::columnPath(std::string name, std::shared_ptr<AbstractTable> table, size_t col) const {
+  return _baseDirectory + "/" + name + "/" + table->nameOfColumn(col);
+}
+
 void SimpleTableDump::dumpDictionary(std::string name, std::shared_ptr<AbstractTable> table, size_t col) {
-  std::string fullPath = _baseDirectory + "/" + name + "/" + table->nameOfColumn(col) + ".dict.dat";
+  std::string fullPath = columnPath(name, table, col) + DumpHelper::DICT_EXT;
   std::ofstream data (fullPath, std::ios::out | std::ios::binary);
 
   // We make a small hack here, first we obtain the size of the
@@ -134,7 +242,7 @@ void SimpleTableDump::dumpDictionary(std::string name, std::shared_ptr<AbstractT
 }
 
 void SimpleTableDump::dumpAttribute(std::string name, std::shared_ptr<AbstractTable> table, size_t col) {
-  std::string fullPath = _baseDirectory + "/" + name + "/" + table->nameOfColumn(col) + ".attr.dat";
+  std::string fullPath = columnPath(name, table, col) + DumpHelper::ATTR_EXT;
   std::ofstream data (fullPath, std::ios::out | std::ios::binary);
   ValueId v;
   for(size_t i=0; i < table->size(); ++i) {
@@ -211,17 +319,54 @@ bool SimpleTableDump::dump(std::string name, std::shared_ptr<AbstractTable> tabl
   return true;
 }
 
+void MappedTableDump::dumpDictionary(std::string name, std::shared_ptr<AbstractTable> table, size_t col) {
+  std::ofstream data (columnPath(name, table, col) + DumpHelper::MAPPED_DICT_EXT, std::ios::out | std::ios::binary);
+
+  // Dictionaries without stored values, e.g. for the no dict types,
+  // are created empty when loading
+  const auto& dictionary = table->dictionaryAt(col);
+  size_t dictionarySize = dictionary->isOrdered() ? dictionary->size() : 0;
+  DumpHelper::writeMappedHeader(data, {DumpHelper::MAPPED_MAGIC, static_cast<uint32_t>(table->typeOfColumn(col)), dictionarySize, 0});
+
+  write_mapped_dict_functor fun {data, table, col, dictionarySize};
+  type_switch<hyrise_basic_types> ts;
+  ts(table->typeOfColumn(col), fun);
+  data.close();
+}
+
+void MappedTableDump::dumpAttribute(std::string name, std::shared_ptr<AbstractTable> table, size_t col) {
+  std::ofstream data (columnPath(name, table, col) + DumpHelper::MAPPED_ATTR_EXT, std::ios::out | std::ios::binary);
+
+  // Value ids of ordered dictionaries are dense, value ids of the no
+  // dict types hold the values themselves
+  const auto& dictionary = table->dictionaryAt(col);
+  uint64_t bits = sizeof(value_id_t) * 8;
+  if (dictionary->isOrdered()) {
+    bits = 1;
+    while (bits < sizeof(value_id_t) * 8 && (1ull << bits) < dictionary->size())
+      ++bits;
+  }
+
+  const size_t rows = table->size();
+  BitCompressedVector<value_id_t> values(1, rows, {bits});
+  values.resize(rows);
+  for (size_t i = 0; i < rows; ++i)
+    values.set(0, i, table->getValueId(col, i).valueId);
+
+  DumpHelper::writeMappedHeader(data, {DumpHelper::MAPPED_MAGIC, static_cast<uint32_t>(table->typeOfColumn(col)), rows, bits});
+  data.write(reinterpret_cast<const char *>(values.blocks()), values.blockCount() * sizeof(uint64_t));
+  // the padding block read behind the last value by the bulk kernels
+  const uint64_t padding = 0;
+  data.write(reinterpret_cast<const char *>(&padding), sizeof(padding));
+  data.close();
+}
+
 } // namespace storage
 
 namespace io {
 
 size_t TableDumpLoader::getSize() {
-  std::string path = storage::DumpHelper::buildPath({_base, _table, storage::DumpHelper::META_DATA_EXT});
-  std::ifstream data (path, std::ios::binary);
-  size_t numRows;
-  data >> numRows;
-  data.close();
-  return numRows;
+  return storage::DumpHelper::readSize(storage::DumpHelper::buildPath({_base, _table, storage::DumpHelper::META_DATA_EXT}));
 }
 
 
@@ -273,5 +418,47 @@ std::shared_ptr<storage::AbstractTable> TableDumpLoader::load(std::shared_ptr<st
   return intable;
 }
 
+std::shared_ptr<storage::AbstractTable> MappedTableDumpLoader::load(std::shared_ptr<storage::AbstractTable> intable,
+                                                                    const storage::compound_metadata_list *meta,
+                                                                    const Loader::params &args) {
+  using namespace storage::DumpHelper;
+  const size_t rows = readSize(buildPath({_base, _table, META_DATA_EXT}));
+
+  std::vector<storage::atable_ptr_t> columns;
+  for (size_t i = 0; i < intable->columnCount(); ++i) {
+    const std::string name = intable->nameOfColumn(i);
+
+    const std::string dictPath = buildPath({_base, _table, name}) + MAPPED_DICT_EXT;
+    auto dictFile = MappedFile::open(dictPath);
+    auto dictHeader = readMappedHeader(*dictFile, dictPath);
+    const auto type = static_cast<DataType>(dictHeader.type);
+
+    std::shared_ptr<storage::AbstractDictionary> dictionary;
+    if (types::isDictionaryEncoded(type)) {
+      // the no dict types store no values
+      dictionary = storage::makeDictionary(type);
+    } else {
+      storage::map_dict_functor fun {dictFile, dictPath, dictHeader.count};
+      storage::type_switch<hyrise_basic_types> ts;
+      dictionary = ts(type, fun);
+    }
+
+    const std::string attrPath = buildPath({_base, _table, name}) + MAPPED_ATTR_EXT;
+    auto attrFile = MappedFile::open(attrPath);
+    auto attrHeader = readMappedHeader(*attrFile, attrPath);
+    const size_t blocks = (rows * attrHeader.bits + 63) / 64;
+    if (attrHeader.count != rows || attrFile->size() < MAPPED_HEADER_SIZE + (blocks + 1) * sizeof(uint64_t))
+      throw std::runtime_error("Mapped dump file " + attrPath + " is truncated");
+    auto values = std::make_shared<storage::BitCompressedVector<value_id_t> >(1, rows, std::vector<uint64_t> {attrHeader.bits},
+                                                                               attrFile->data() + MAPPED_HEADER_SIZE, attrFile);
+
+    columns.push_back(std::make_shared<storage::Table>(std::vector<storage::ColumnMetadata> {storage::ColumnMetadata(name, type)},
+                                                       values,
+                                                       std::vector<storage::AbstractTable::SharedDictionaryPtr> {dictionary}));
+  }
+
+  return std::make_shared<storage::Store>(std::make_shared<storage::MutableVerticalTable>(columns, rows));
+}
+
 } } // namespace hyrise::io
 
@@ -34,29 +34,33 @@ class SimpleTableDump {
   void prepare(std::string name);
 
   /**
-   * Dumps the dictionary and performs simple conversion based on the
-   * ofstream structure
    */
-  void dumpDictionary(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
+  void dumpMetaData(std::string name, std::shared_ptr<AbstractTable> t);
 
   /**
-   * Dumps the attrbite but writes the attribute data binary since its
-   * all value_id_t
    */
-  void dumpAttribute(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
+  void dumpHeader(std::string name, std::shared_ptr<AbstractTable> t);
 
   /**
+   * Check if the file is a store and not a horizontal table
    */
-  void dumpMetaData(std::string name, std::shared_ptr<AbstractTable> t);
+  void verify(std::shared_ptr<AbstractTable>);
+
+protected:
 
   /**
+   * Dumps the dictionary and performs simple conversion based on the
+   * ofstream structure
    */
-  void dumpHeader(std::string name, std::shared_ptr<AbstractTable> t);
+  virtual void dumpDictionary(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
 
   /**
-   * Check if the file is a store and not a horizontal table
+   * Dumps the attrbite but writes the attribute data binary since its
+   * all value_id_t
    */
-  void verify(std::shared_ptr<AbstractTable>);
+  virtual void dumpAttribute(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
+
+  std::string columnPath(std::string name, std::shared_ptr<AbstractTable> t, size_t col) const;
 
 public:
 
@@ -64,12 +68,35 @@ public:
   explicit SimpleTableDump(std::string outputDir): _baseDirectory(outputDir) {
   }
 
+  virtual ~SimpleTableDump() {}
+
   /**
    * For a table identified by name and table perform the dump
    */
   bool dump(std::string name, std::shared_ptr<AbstractTable> table);
 };
 
+/**
+ * Dumps a table in a binary format that can be mapped into memory by
+ * the MappedTableDumpLoader instead of being parsed.
+ *
+ * Header and metadata are written like for the SimpleTableDump. For
+ * each attribute the value ids are written as a bit compressed vector
+ * with the minimal number of bits for its dictionary, for each
+ * dictionary the sorted values are written in their binary
+ * representation, strings prefixed with their length. Each file starts
+ * with a header of one page, so that the column data is page aligned.
+ */
+class MappedTableDump : public SimpleTableDump {
+protected:
+  void dumpDictionary(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
+  void dumpAttribute(std::string name, std::shared_ptr<AbstractTable> t, size_t col);
+
+public:
+  explicit MappedTableDump(std::string outputDir): SimpleTableDump(outputDir) {
+  }
+};
+
 } // namespace storage
 
 namespace io {
@@ -105,5 +132,35 @@ public:
   }
 };
 
+/**
+ * Loads a table written by the MappedTableDump. The attribute vectors
+ * and the dictionaries of fixed width types are used directly from the
+ * mapped files without copying them, only string dictionaries are read.
+ * The mapping is private, pages of the files are only copied if the
+ * main partition is modified. Returns a Store with the loaded table as
+ * its main partition.
+ */
+class MappedTableDumpLoader : public AbstractInput {
+  std::string _base;
+  std::string _table;
+
+public:
+  MappedTableDumpLoader(std::string base, std::string table) :
+    _base(base), _table(table) {
+  }
+
+  std::shared_ptr<storage::AbstractTable> load(std::shared_ptr<storage::AbstractTable>,
+                                               const storage::compound_metadata_list *,
+                                               const Loader::params &args);
+
+  bool needs_store_wrap() {
+    return false;
+  }
+
+  MappedTableDumpLoader *clone() const {
+    return new MappedTableDumpLoader(*this);
+  }
+};
+
 } } // namespace hyrise::io
 
@@ -9,14 +9,23 @@
 #include "helper/make_unique.h"
 #include "helper/checked_cast.h"
 #include "helper/vector_helpers.h"
+#include "io/RedoLog.h"
 #include "storage/Store.h"
 
 namespace hyrise {
 namespace tx {
 
 void TXModifications::insertPos(const storage::c_atable_ptr_t& tab, pos_t pos) {
+  insertPositions(tab, pos, pos + 1);
+}
+
+void TXModifications::insertPositions(const storage::c_atable_ptr_t& tab, pos_t first, pos_t last) {
   static locking::Spinlock _mtx;
-  _handle(_mtx, inserted, tab, pos);
+  std::lock_guard<locking::Spinlock> lck(_mtx);
+  auto& positions = inserted[tab];
+  positions.reserve(positions.size() + (last - first));
+  for (pos_t pos = first; pos < last; ++pos)
+    positions.push_back(pos);
 }
 
 void TXModifications::deletePos(const storage::c_atable_ptr_t& tab, pos_t pos) {
@@ -133,6 +142,18 @@ void TransactionManager::reset() {
   _txData([] (map_t& txData) { txData.clear(); });
 }
 
+void TransactionManager::setLastCommitId(transaction_cid_t cid) {
+  _commitId = cid;
+}
+
+void TransactionManager::setRedoLog(const std::shared_ptr<RedoLog>& log) {
+  std::atomic_store(&_redoLog, log);
+}
+
+std::shared_ptr<RedoLog> TransactionManager::getRedoLog() const {
+  return std::atomic_load(&_redoLog);
+}
+
 TXContext TransactionManager::beginTransaction() {
   return getInstance().buildContext();
 }
@@ -171,53 +192,103 @@ void TransactionManager::rollbackTransaction(TXContext ctx) {
     auto store = getStore(kv.first.lock());
     store->unmarkForDeletion(kv.second, ctx.tid);
   }
+  // inserted rows stay in the delta as dead rows
+  for(auto& kv : getInstance()[ctx.tid].inserted) {
+    auto store = getStore(kv.first.lock());
+    store->abortPositions(kv.second);
+  }
 
   getInstance().endTransaction(ctx.tid);
 }
 
 transaction_cid_t TransactionManager::commitTransaction(TXContext ctx) {
   auto& txmgr = getInstance();
+
+  static const TXModifications unmodified;
+  auto mods = txmgr.getModifications(ctx.tid);
+  const auto& modifications = mods ? *mods : unmodified;
+  const auto& log = txmgr.getRedoLog();
+
+  // with a redo log, read-only transactions take neither a commit id nor
+  // a log record, so they do not enter the critical section and the log
+  // stays gap-free
+  if (log && modifications.inserted.empty() && modifications.deleted.empty()) {
+    txmgr.endTransaction(ctx.tid);
+    return ctx.lastCid;
+  }
+
+  // serialize the redo record before entering the critical section
+  std::string record;
+  if (log)
+    record = log->serialize(modifications);
+
   ctx.cid = txmgr.prepareCommit();
-  if (auto mods = txmgr.getModifications(ctx.tid)) {
-    const auto& modifications = *mods;
-    // Only update the required positions
-    for (auto& kv: modifications.deleted) {
-      auto weak_table = kv.first;
-      // Only deleted records have to be checked for validity as newly inserted
-      // records will be always only written by us
-      if (auto store = getStore(weak_table.lock())) {
-        if (TX_CODE::TX_OK != store->checkForConcurrentCommit(kv.second, ctx.tid)) {
-          txmgr.abort();
-          throw std::runtime_error("Aborted TX with Last Commit ID != New Commit ID");
-        }
+  // Only update the required positions
+  for (auto& kv: modifications.deleted) {
+    auto weak_table = kv.first;
+    // Only deleted records have to be checked for validity as newly inserted
+    // records will be always only written by us
+    if (auto store = getStore(weak_table.lock())) {
+      if (TX_CODE::TX_OK != store->checkForConcurrentCommit(kv.second, ctx.tid)) {
+        txmgr.abort();
+        throw std::runtime_error("Aborted TX with Last Commit ID != New Commit ID");
       }
     }
+  }
 
-    for (auto& kv: modifications.inserted) {
-      auto weak_table = kv.first;
-      if (auto store = getStore(weak_table.lock())) {
-        auto result = store->commitPositions(kv.second, ctx.cid, true);
-        if (result != TX_CODE::TX_OK) {
-          txmgr.abort();
-          throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
-        }
+  for (auto& kv: modifications.inserted) {
+    auto weak_table = kv.first;
+    if (auto store = getStore(weak_table.lock())) {
+      auto result = store->commitPositions(kv.second, ctx.cid, true);
+      if (result != TX_CODE::TX_OK) {
+        txmgr.abort();
+        throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
       }
     }
+  }
 
-    for (auto& kv: modifications.deleted) {
-      auto weak_table = kv.first;
-      if (auto store = getStore(weak_table.lock())) {
-        auto result = store->commitPositions(kv.second, ctx.cid, false);
-        if (result != TX_CODE::TX_OK) {
-          txmgr.abort();
-          throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
-        }
+  for (auto& kv: modifications.deleted) {
+    auto weak_table = kv.first;
+    if (auto store = getStore(weak_table.lock())) {
+      auto result = store->commitPositions(kv.second, ctx.cid, false);
+      if (result != TX_CODE::TX_OK) {
+        txmgr.abort();
+        throw std::runtime_error("Aborted TX with "); // TODO at return code to error message
       }
     }
   }
   txmgr.commit(ctx.tid);
+
+  if (log) {
+    log->append(ctx.cid, ctx.tid, std::move(record));
+    log->waitDurable(ctx.cid);
+  }
   return ctx.cid;
 }
 
-}}
+transaction_cid_t TransactionManager::mergeStore(const storage::store_ptr_t& store) {
+  auto& txmgr = getInstance();
+  const auto& log = txmgr.getRedoLog();
+  if (!log) {
+    store->merge();
+    return txmgr.getLastCommitId();
+  }
+
+  // holding the commit lock keeps commits out of the renumbering
+  const auto cid = txmgr.prepareCommit();
+  std::string record;
+  try {
+    store->merge();
+    record = log->serializeMerge(store);
+  } catch (...) {
+    txmgr.abort();
+    throw;
+  }
+  txmgr.commit(MERGE_TID);
 
+  log->append(cid, MERGE_TID, std::move(record));
+  log->waitDurable(cid);
+  return cid;
+}
+
+}}
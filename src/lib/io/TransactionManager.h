@@ -17,6 +17,8 @@
 namespace hyrise {
 namespace tx {
 
+class RedoLog;
+
 // Stores all modifications for a given transaction
 class TXModifications {
  public:
@@ -39,6 +41,9 @@ class TXModifications {
   // Keeps track of all inserted rows
   void insertPos(const storage::c_atable_ptr_t& tab, pos_t pos);
 
+  // Keeps track of the inserted rows [first, last)
+  void insertPositions(const storage::c_atable_ptr_t& tab, pos_t first, pos_t last);
+
   // Keeps track of all deleted rows
   void deletePos(const storage::c_atable_ptr_t& tab, pos_t pos);
 
@@ -89,6 +94,12 @@ class TransactionManager {
   /// \param tid transaction id to abort
   static void rollbackTransaction(TXContext ctx);
 
+  /// Merges the store with Store::merge(). With a redo log, the merge takes
+  /// a commit id of its own and is logged, so that recovery merges the
+  /// replayed store between the same commits. No transaction may run.
+  /// \returns commit id of the merge
+  static transaction_cid_t mergeStore(const storage::store_ptr_t& store);
+
   /// Check validity of a transactionId - this doesn't guarantee
   /// that the transaction is uncommitted
   /// \param tid transaction id under investigation
@@ -142,6 +153,15 @@ class TransactionManager {
 
   void reset();
 
+  /// Continues with commit ids after `cid` when the database was
+  /// recovered, must not be called while transactions are running
+  void setLastCommitId(transaction_cid_t cid);
+
+  /// Makes committed transactions durable in the given redo log before
+  /// commitTransaction() returns, nullptr disables logging
+  void setRedoLog(const std::shared_ptr<RedoLog>& log);
+  std::shared_ptr<RedoLog> getRedoLog() const;
+
 
  private:
   std::optional<const TXModifications&> getModifications(const transaction_id_t key) const;
@@ -158,6 +178,9 @@ class TransactionManager {
   // Spin Lock for transactions
   locking::Spinlock _txLock;
 
+  // Redo log for committed transactions, may be nullptr
+  std::shared_ptr<RedoLog> _redoLog;
+
   TransactionManager();
 
   // Get next transaction id
@@ -6,4 +6,20 @@ namespace net {
 
 AbstractConnection::~AbstractConnection() {}
 
+void AbstractConnection::beginStream(size_t status, const std::string& contentType) {
+  _stream_buffer.clear();
+  _stream_status = status;
+  _stream_content_type = contentType;
+}
+
+void AbstractConnection::writeStream(const char *data, size_t length) {
+  _stream_buffer.append(data, length);
+}
+
+void AbstractConnection::endStream() {
+  std::string message;
+  message.swap(_stream_buffer);
+  respond(message, _stream_status, _stream_content_type);
+}
+
 }}
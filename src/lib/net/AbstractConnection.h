@@ -14,9 +14,21 @@ class AbstractConnection {
   virtual std::string getPath() const = 0;
   virtual bool hasBody() const = 0;
   virtual void respond(const std::string &message, size_t status=200, const std::string& contentType="application/json") = 0;
+
+  /// Sends a response in parts: beginStream() once, writeStream() for
+  /// every part and endStream() after the last one. writeStream() may
+  /// block until the client has received earlier parts. Connections that
+  /// cannot stream collect all parts and respond() with them at the end.
+  virtual void beginStream(size_t status=200, const std::string& contentType="application/json");
+  virtual void writeStream(const char *data, size_t length);
+  virtual void endStream();
+
   void setResponseTask(taskscheduler::task_ptr_t task) { _response_task = task; }
  private:
   taskscheduler::task_ptr_t _response_task = nullptr;
+  std::string _stream_buffer;
+  size_t _stream_status = 200;
+  std::string _stream_content_type;
 };
 
 }
@@ -115,9 +115,7 @@ void request_body(ebb_request *request, const char *at, size_t length) {
   connection_data->body_len += length;
 }
 
-void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
-  AsyncConnection *conn = (AsyncConnection *) w->data;
-
+static void log_response(AsyncConnection *conn, bool sent) {
   char *method = (char *) "";
   switch (conn->request->method) {
     case EBB_GET:
@@ -141,13 +139,21 @@ void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
   timeinfo = localtime(&rawtime);
   strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S %z", timeinfo);
 
+  printf("%s [%s] %s %s (%f s)%s\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration, sent ? "" : " not sent");
+}
+
+void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
+  AsyncConnection *conn = (AsyncConnection *) w->data;
+  if (conn->isStreaming()) {
+    write_stream(conn);
+    return;
+  }
+
   // Handle the actual writing
   if (conn->connection != nullptr) {
     ebb_connection_write(conn->connection, conn->write_buffer, conn->write_buffer_len, continue_responding);
-    printf("%s [%s] %s %s (%f s)\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
-  } else {
-    printf("%s [%s] %s %s (%f s) not sent\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
   }
+  log_response(conn, conn->connection != nullptr);
   ev_async_stop(conn->ev_loop, &conn->ev_write);
   conn->waiting_for_response = false;
   // When connection is nullptr, `continue_responding` won't fire since we never sent data to the client,
@@ -155,9 +161,56 @@ void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
   if (conn->connection == nullptr) delete conn;
 }
 
+void write_stream(AsyncConnection *conn) {
+  std::unique_lock<std::mutex> lock(conn->stream_mutex);
+  if (conn->connection == nullptr) {
+    // The client is gone, drop the response and clean up as soon as the
+    // worker has finished writing it
+    conn->stream_pending.clear();
+    if (!conn->stream_finished)
+      return;
+    lock.unlock();
+    log_response(conn, false);
+    ev_async_stop(conn->ev_loop, &conn->ev_write);
+    delete conn;
+    return;
+  }
+
+  // libebb takes a single write at a time, stream_written continues
+  if (!conn->stream_sending.empty())
+    return;
+
+  if (conn->stream_pending.empty()) {
+    if (conn->stream_finished) {
+      lock.unlock();
+      log_response(conn, true);
+      ev_async_stop(conn->ev_loop, &conn->ev_write);
+      conn->waiting_for_response = false;
+      continue_responding(conn->connection);
+    }
+    return;
+  }
+
+  conn->stream_sending.swap(conn->stream_pending);
+  lock.unlock();
+  conn->stream_sent.notify_all();
+  ebb_connection_write(conn->connection, conn->stream_sending.data(), conn->stream_sending.size(), stream_written);
+}
+
+void stream_written(ebb_connection *connection) {
+  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
+  connection_data->stream_sending.clear();
+  write_stream(connection_data);
+}
+
 void on_close(ebb_connection *connection) {
   AsyncConnection *connection_data = (AsyncConnection *)connection->data;
-  connection_data->connection = nullptr;
+  {
+    // wakes up a worker waiting to stream to this connection
+    std::lock_guard<std::mutex> lock(connection_data->stream_mutex);
+    connection_data->connection = nullptr;
+  }
+  connection_data->stream_sent.notify_all();
   free(connection);
   if (!connection_data->waiting_for_response)
     delete connection_data;
@@ -179,6 +232,10 @@ void AsyncConnection::reset() {
   free(request); request = nullptr;
   free(write_buffer); write_buffer = nullptr;
   waiting_for_response = false;
+  streaming = false;
+  stream_finished = false;
+  stream_pending.clear();
+  stream_sending.clear();
 }
 
 void AsyncConnection::respond(const std::string &message, size_t status, const std::string & contentType) {
@@ -200,6 +257,54 @@ void AsyncConnection::respond(const std::string &message, size_t status, const s
   send_response();
 }
 
+void AsyncConnection::beginStream(size_t status, const std::string &contentType) {
+  char header[max_header_length];
+  const int header_length = snprintf(header, max_header_length,
+                                     "HTTP/1.1 %lu OK\r\nContent-Type: %s\r\nTransfer-Encoding: chunked\r\nConnection: %s\r\n\r\n",
+                                     status,
+                                     contentType.c_str(),
+                                     keep_alive_flag ? "Keep-Alive" : "Close");
+  std::lock_guard<std::mutex> lock(stream_mutex);
+  streaming = true;
+  stream_finished = false;
+  stream_pending.assign(header, header_length);
+}
+
+void AsyncConnection::writeStream(const char *data, size_t length) {
+  // an empty chunk would end the response
+  if (length == 0)
+    return;
+
+  char chunk_header[32];
+  const int chunk_header_length = snprintf(chunk_header, sizeof(chunk_header), "%lx\r\n", length);
+  {
+    std::unique_lock<std::mutex> lock(stream_mutex);
+    // Backpressure: a client that reads slower than the result is
+    // serialized holds up the worker instead of growing the queue
+    stream_sent.wait(lock, [this] () { return connection == nullptr || stream_pending.size() < max_pending_stream; });
+    if (connection == nullptr)
+      return;
+    stream_pending.append(chunk_header, chunk_header_length);
+    stream_pending.append(data, length);
+    stream_pending.append("\r\n", 2);
+  }
+  send_response();
+}
+
+void AsyncConnection::endStream() {
+  // Notifies the event loop while holding the lock, it may delete this
+  // connection as soon as it sees the finished stream
+  std::lock_guard<std::mutex> lock(stream_mutex);
+  stream_pending.append("0\r\n\r\n");
+  stream_finished = true;
+  send_response();
+}
+
+bool AsyncConnection::isStreaming() {
+  std::lock_guard<std::mutex> lock(stream_mutex);
+  return streaming;
+}
+
 void AsyncConnection::send_response() {
   ev_async_send(ev_loop, &ev_write);
 }
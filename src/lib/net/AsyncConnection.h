@@ -7,6 +7,8 @@
 #include <cstdlib>
 #include <ev.h>
 
+#include <condition_variable>
+#include <mutex>
 #include <string>
 
 #include "net/AbstractConnection.h"
@@ -37,6 +39,20 @@ class AsyncConnection : public AbstractConnection {
   bool keep_alive_flag;
   bool waiting_for_response = false;
 
+  /// Bytes of a streamed response that may be queued for the client
+  /// before writeStream() waits for the socket to catch up
+  static const size_t max_pending_stream = 4 * 1024 * 1024;
+
+  // A streamed response is written by a worker into stream_pending as
+  // chunks of the chunked transfer encoding, the event loop moves them
+  // to stream_sending and writes them to the socket one batch at a time.
+  std::mutex stream_mutex;
+  std::condition_variable stream_sent;
+  bool streaming = false;
+  bool stream_finished = false;
+  std::string stream_pending;
+  std::string stream_sending;
+
   AsyncConnection();
   ~AsyncConnection();
   void reset();
@@ -44,6 +60,10 @@ class AsyncConnection : public AbstractConnection {
   virtual bool hasBody() const;
   virtual std::string getPath() const;
   virtual void respond(const std::string &message, size_t status=200, const std::string& contentType="application/json");
+  virtual void beginStream(size_t status=200, const std::string& contentType="application/json");
+  virtual void writeStream(const char *data, size_t length);
+  virtual void endStream();
+  bool isStreaming();
  private:
   virtual void send_response();
 };
@@ -62,6 +82,10 @@ void write_cb(struct ev_loop *loop, struct ev_async *w, int revents);
 
 void continue_responding(ebb_connection *connection);
 
+void write_stream(AsyncConnection *connection_data);
+
+void stream_written(ebb_connection *connection);
+
 void on_close(ebb_connection *connection);
 
 int on_timeout(ebb_connection *connection);
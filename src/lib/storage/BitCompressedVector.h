@@ -6,12 +6,14 @@
 #include <cstdint>
 #include <cstring>
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <stdexcept>
 #include <type_traits>
 
 #include "storage/BaseAttributeVector.h"
+#include "storage/BitUnpacking.h"
 
 #ifndef WORD_LENGTH
 #define WORD_LENGTH 64
@@ -57,6 +59,9 @@ class BitCompressedVector : public BaseAttributeVector<T> {
   // The bits used for each column
   bit_size_list_t _bits;
 
+  // Owner of _data if it is not allocated by the vector itself
+  std::shared_ptr<void> _external;
+
 public:
   typedef T value_type;
 
@@ -68,8 +73,23 @@ public:
     reserve(rows);
   }
 
+  /*
+    Vector over rows that are already packed in external memory, e.g. a
+    memory mapped file, which has to hold one padding block behind the
+    packed rows. The memory is kept alive through owner and is only
+    replaced by an own copy if the vector grows.
+   */
+  BitCompressedVector(size_t columns,
+                      size_t rows,
+                      std::vector<uint64_t> bits,
+                      void *data,
+                      std::shared_ptr<void> owner): _data(static_cast<storage_t *>(data)), _size(rows), _columns(columns), _bits(bits), _external(owner) {
+    _allocatedBlocks = _blocks(rows);
+  }
+
   virtual ~BitCompressedVector() {
-    free(_data);
+    if (!_external)
+      free(_data);
   }
 
   void *data() {
@@ -147,7 +167,9 @@ public:
       std::swap(_data, newMemory);
 
       // Only deallocate if there was something allocated
-      if (newMemory != nullptr)
+      if (_external)
+        _external.reset();
+      else if (newMemory != nullptr)
         free(newMemory);
 
       // set new allocarted blocks
@@ -161,8 +183,12 @@ public:
    */
   void clear() {
     _size = 0;
-    free(_data);
+    if (_external)
+      _external.reset();
+    else
+      free(_data);
     _data = nullptr;
+    _allocatedBlocks = 0;
   }
 
   size_t size() {
@@ -191,6 +217,61 @@ public:
     }
   }
 
+  /*
+    Bulk access to a single column, see storage/BitUnpacking.h. Decodes
+    the rows [start, stop) into out, appends the rows whose value id
+    matches range to positions, or builds a selection bitmap for them.
+   */
+  void decode(size_t column, size_t start, size_t stop, T *out) const {
+    static_assert(std::is_same<T, value_id_t>::value, "Bulk decoding requires value ids");
+    checkRange(column, start, stop);
+    if (bitunpacking::supports(_bits[column])) {
+      bitunpacking::decode(packedColumn(column), start, stop, out);
+    } else {
+      for (size_t row = start; row < stop; ++row)
+        *out++ = get(column, row);
+    }
+  }
+
+  void scan(size_t column, size_t start, size_t stop, const bitunpacking::ValueIdRange &range, pos_list_t &positions) const {
+    checkRange(column, start, stop);
+    if (bitunpacking::supports(_bits[column])) {
+      bitunpacking::scan(packedColumn(column), start, stop, range, positions);
+    } else {
+      for (size_t row = start; row < stop; ++row)
+        if (range.matches(get(column, row)))
+          positions.push_back(row);
+    }
+  }
+
+  void scanBitmap(size_t column, size_t start, size_t stop, const bitunpacking::ValueIdRange &range, std::vector<uint64_t> &bitmap) const {
+    checkRange(column, start, stop);
+    if (bitunpacking::supports(_bits[column])) {
+      bitunpacking::scanBitmap(packedColumn(column), start, stop, range, bitmap);
+    } else {
+      bitmap.assign((stop - start + 63) / 64, 0);
+      for (size_t row = start; row < stop; ++row)
+        if (range.matches(get(column, row)))
+          bitmap[(row - start) / 64] |= 1ull << ((row - start) % 64);
+    }
+  }
+
+  uint64_t bitsForColumn(size_t column) const {
+    return _bits[column];
+  }
+
+  /*
+    The packed rows, blockCount() blocks followed by a padding block,
+    e.g. to write them to a file that is mapped back later
+   */
+  const uint64_t *blocks() const {
+    return _data;
+  }
+
+  uint64_t blockCount() const {
+    return _blocks(_size);
+  }
+
   std::shared_ptr<BaseAttributeVector<T>> copy() {
     std::shared_ptr<BitCompressedVector> b = std::make_shared<BitCompressedVector>(_columns, _size, _bits);
     b->resize(_size);
@@ -214,6 +295,17 @@ private:
 #endif
   }
 
+  inline void checkRange(const size_t& column, const size_t& start, const size_t& stop) const {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (start < stop)
+      checkAccess(column, stop - 1);
+#endif
+  }
+
+  inline bitunpacking::PackedColumn packedColumn(size_t column) const {
+    return {_data, _tupleWidth(), _offsetForColumn(column), _bits[column]};
+  }
+
   /*
     Calculates the offset for a given column from the begining of the
     row in bits
@@ -258,15 +350,17 @@ private:
   }
 
   /*
-  * Allocate memory given by the number of blocks
+  * Allocate memory given by the number of blocks, followed by one
+  * block of padding so that the bulk kernels may load whole words
+  * behind the last value
   */
   inline storage_t *_allocate(uint64_t numBlocks) {
 
-    auto data = static_cast<storage_t *>(malloc(numBlocks * sizeof(storage_t)));
+    auto data = static_cast<storage_t *>(malloc((numBlocks + 1) * sizeof(storage_t)));
     if (data == nullptr) {
       throw std::bad_alloc();
     }
-    std::memset(data, 0, numBlocks * sizeof(storage_t));
+    std::memset(data, 0, (numBlocks + 1) * sizeof(storage_t));
     return data;
   }
 
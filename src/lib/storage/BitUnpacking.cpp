@@ -0,0 +1,350 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/BitUnpacking.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace hyrise {
+namespace storage {
+namespace bitunpacking {
+
+namespace {
+
+// Number of rows evaluated together by the vectorized kernels
+#if defined(__AVX2__)
+const size_t kGroupSize = 8;
+#elif defined(__SSE4_1__)
+const size_t kGroupSize = 4;
+#else
+const size_t kGroupSize = 1;
+#endif
+
+// Reads the value starting at bit position bitpos. Values are at most
+// 32 bits wide, so together with the bit offset inside the first byte
+// they always fit into one unaligned word.
+inline value_id_t extract(const uint8_t *bytes, uint64_t bitpos, uint64_t mask) {
+  uint64_t word;
+  std::memcpy(&word, bytes + (bitpos >> 3), sizeof(word));
+  return (word >> (bitpos & 7)) & mask;
+}
+
+#if defined(__AVX2__)
+
+/*
+  Unpacks groups of eight consecutive rows. Eight rows span exactly
+  tupleWidth bytes, so the byte offsets and shifts of the lanes relative
+  to the group's first byte are the same for every group of a scan and
+  only need to be computed once.
+ */
+template <unsigned Bits, bool Wide = (Bits > 25)>
+class Unpacker;
+
+// Up to 25 bits a value and its bit offset fit into a 32 bit gather
+template <unsigned Bits>
+class Unpacker<Bits, false> {
+  const uint8_t *_cursor;
+  const uint64_t _stride;
+  __m256i _offsets;
+  __m256i _shifts;
+  const __m256i _mask;
+
+ public:
+  Unpacker(const uint8_t *bytes, uint64_t bitpos, uint64_t tupleWidth) :
+      _cursor(bytes + (bitpos >> 3)), _stride(tupleWidth),
+      _mask(_mm256_set1_epi32(static_cast<int>((1ull << Bits) - 1))) {
+    alignas(32) int32_t offsets[8], shifts[8];
+    for (uint64_t lane = 0; lane < 8; ++lane) {
+      uint64_t relative = (bitpos & 7) + lane * tupleWidth;
+      offsets[lane] = relative >> 3;
+      shifts[lane] = relative & 7;
+    }
+    _offsets = _mm256_load_si256(reinterpret_cast<const __m256i *>(offsets));
+    _shifts = _mm256_load_si256(reinterpret_cast<const __m256i *>(shifts));
+  }
+
+  inline __m256i next() {
+    __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int *>(_cursor), _offsets, 1);
+    _cursor += _stride;
+    return _mm256_and_si256(_mm256_srlv_epi32(v, _shifts), _mask);
+  }
+};
+
+// Wider values need 64 bit gathers, done as two halves of four lanes
+template <unsigned Bits>
+class Unpacker<Bits, true> {
+  const uint8_t *_cursor;
+  const uint64_t _stride;
+  __m128i _offsetsLow, _offsetsHigh;
+  __m256i _shiftsLow, _shiftsHigh;
+  const __m256i _mask;
+  const __m256i _pick;
+
+ public:
+  Unpacker(const uint8_t *bytes, uint64_t bitpos, uint64_t tupleWidth) :
+      _cursor(bytes + (bitpos >> 3)), _stride(tupleWidth),
+      _mask(_mm256_set1_epi32(static_cast<int>((1ull << Bits) - 1))),
+      _pick(_mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)) {
+    alignas(32) int32_t offsets[8];
+    alignas(32) int64_t shifts[8];
+    for (uint64_t lane = 0; lane < 8; ++lane) {
+      uint64_t relative = (bitpos & 7) + lane * tupleWidth;
+      offsets[lane] = relative >> 3;
+      shifts[lane] = relative & 7;
+    }
+    _offsetsLow = _mm_load_si128(reinterpret_cast<const __m128i *>(offsets));
+    _offsetsHigh = _mm_load_si128(reinterpret_cast<const __m128i *>(offsets + 4));
+    _shiftsLow = _mm256_load_si256(reinterpret_cast<const __m256i *>(shifts));
+    _shiftsHigh = _mm256_load_si256(reinterpret_cast<const __m256i *>(shifts + 4));
+  }
+
+  inline __m256i next() {
+    auto base = reinterpret_cast<const long long *>(_cursor);
+    __m256i low = _mm256_srlv_epi64(_mm256_i32gather_epi64(base, _offsetsLow, 1), _shiftsLow);
+    __m256i high = _mm256_srlv_epi64(_mm256_i32gather_epi64(base, _offsetsHigh, 1), _shiftsHigh);
+    _cursor += _stride;
+    // Move the lower halves of the 64 bit lanes into the lower 128 bits
+    low = _mm256_permutevar8x32_epi32(low, _pick);
+    high = _mm256_permutevar8x32_epi32(high, _pick);
+    return _mm256_and_si256(_mm256_permute2x128_si256(low, high, 0x20), _mask);
+  }
+};
+
+class Comparator {
+  const __m256i _lower;
+  const __m256i _upper;
+  const unsigned _flip;
+
+ public:
+  explicit Comparator(const ValueIdRange &range) :
+      _lower(_mm256_set1_epi32(static_cast<int>(range.lower))),
+      _upper(_mm256_set1_epi32(static_cast<int>(range.upper))),
+      _flip(range.negated ? 0xff : 0) {}
+
+  // Range check on unsigned lanes: v is inside iff clamping does not change it
+  inline unsigned operator()(__m256i v) const {
+    __m256i clamped = _mm256_min_epu32(_mm256_max_epu32(v, _lower), _upper);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(clamped, v))) ^ _flip;
+  }
+};
+
+#elif defined(__SSE4_1__)
+
+class Comparator {
+  const __m128i _lower;
+  const __m128i _upper;
+  const unsigned _flip;
+
+ public:
+  explicit Comparator(const ValueIdRange &range) :
+      _lower(_mm_set1_epi32(static_cast<int>(range.lower))),
+      _upper(_mm_set1_epi32(static_cast<int>(range.upper))),
+      _flip(range.negated ? 0xf : 0) {}
+
+  inline unsigned operator()(__m128i v) const {
+    __m128i clamped = _mm_min_epu32(_mm_max_epu32(v, _lower), _upper);
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(clamped, v))) ^ _flip;
+  }
+};
+
+#endif
+
+/*
+  Scan kernel for one column width. Matches are reported to the sink
+  as (row, mask) pairs where bit i of mask marks a match in row + i;
+  groups always start at start + a multiple of the group size.
+ */
+template <unsigned Bits>
+struct Kernel {
+  static const uint64_t mask = (1ull << Bits) - 1;
+
+  template <typename Sink>
+  static void scan(const PackedColumn &c, size_t start, size_t stop, const ValueIdRange &range, Sink &sink) {
+    auto bytes = reinterpret_cast<const uint8_t *>(c.data);
+    size_t row = start;
+#if defined(__AVX2__)
+    if (stop - start >= kGroupSize) {
+      Unpacker<Bits> unpacker(bytes, row * c.tupleWidth + c.columnOffset, c.tupleWidth);
+      Comparator compare(range);
+      for (; row + kGroupSize <= stop; row += kGroupSize) {
+        sink(row, compare(unpacker.next()));
+      }
+    }
+#elif defined(__SSE4_1__)
+    Comparator compare(range);
+    for (; row + kGroupSize <= stop; row += kGroupSize) {
+      uint64_t bitpos = row * c.tupleWidth + c.columnOffset;
+      __m128i v = _mm_setr_epi32(extract(bytes, bitpos, mask),
+                                 extract(bytes, bitpos + c.tupleWidth, mask),
+                                 extract(bytes, bitpos + 2 * c.tupleWidth, mask),
+                                 extract(bytes, bitpos + 3 * c.tupleWidth, mask));
+      sink(row, compare(v));
+    }
+#endif
+    for (uint64_t bitpos = row * c.tupleWidth + c.columnOffset; row < stop; ++row, bitpos += c.tupleWidth) {
+      sink(row, range.matches(extract(bytes, bitpos, mask)) ? 1u : 0u);
+    }
+  }
+
+  static void decode(const PackedColumn &c, size_t start, size_t stop, value_id_t *out) {
+    auto bytes = reinterpret_cast<const uint8_t *>(c.data);
+    size_t row = start;
+#if defined(__AVX2__)
+    if (stop - start >= kGroupSize) {
+      Unpacker<Bits> unpacker(bytes, row * c.tupleWidth + c.columnOffset, c.tupleWidth);
+      for (; row + kGroupSize <= stop; row += kGroupSize, out += kGroupSize) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), unpacker.next());
+      }
+    }
+#endif
+    for (uint64_t bitpos = row * c.tupleWidth + c.columnOffset; row < stop; ++row, bitpos += c.tupleWidth) {
+      *out++ = extract(bytes, bitpos, mask);
+    }
+  }
+};
+
+class PositionSink {
+  pos_list_t &_positions;
+
+ public:
+  explicit PositionSink(pos_list_t &positions) : _positions(positions) {}
+
+  inline void operator()(size_t row, unsigned matches) {
+    while (matches) {
+      _positions.push_back(row + __builtin_ctz(matches));
+      matches &= matches - 1;
+    }
+  }
+};
+
+class BitmapSink {
+  uint64_t *_bitmap;
+  const size_t _start;
+
+ public:
+  BitmapSink(uint64_t *bitmap, size_t start) : _bitmap(bitmap), _start(start) {}
+
+  // Groups are aligned to their size relative to start, so they never
+  // straddle two words of the bitmap
+  inline void operator()(size_t row, unsigned matches) {
+    size_t bit = row - _start;
+    _bitmap[bit >> 6] |= static_cast<uint64_t>(matches) << (bit & 63);
+  }
+};
+
+// Dispatch table holding one kernel instantiation per column width
+template <typename Sink>
+class ScanKernels {
+ public:
+  typedef void (*kernel_t)(const PackedColumn &, size_t, size_t, const ValueIdRange &, Sink &);
+
+  ScanKernels() { fill<32>(); }
+
+  kernel_t operator[](uint64_t bits) const { return _kernels[bits]; }
+
+ private:
+  kernel_t _kernels[33] = {nullptr};
+
+  template <unsigned Bits>
+  typename std::enable_if<Bits != 0>::type fill() {
+    _kernels[Bits] = &Kernel<Bits>::template scan<Sink>;
+    fill<Bits - 1>();
+  }
+
+  template <unsigned Bits>
+  typename std::enable_if<Bits == 0>::type fill() {}
+};
+
+class DecodeKernels {
+ public:
+  typedef void (*kernel_t)(const PackedColumn &, size_t, size_t, value_id_t *);
+
+  DecodeKernels() { fill<32>(); }
+
+  kernel_t operator[](uint64_t bits) const { return _kernels[bits]; }
+
+ private:
+  kernel_t _kernels[33] = {nullptr};
+
+  template <unsigned Bits>
+  typename std::enable_if<Bits != 0>::type fill() {
+    _kernels[Bits] = &Kernel<Bits>::decode;
+    fill<Bits - 1>();
+  }
+
+  template <unsigned Bits>
+  typename std::enable_if<Bits == 0>::type fill() {}
+};
+
+const ScanKernels<PositionSink> positionKernels;
+const ScanKernels<BitmapSink> bitmapKernels;
+const DecodeKernels decodeKernels;
+
+inline void checkWidth(const PackedColumn &column) {
+  if (!supports(column.bits)) {
+    throw std::out_of_range("No bit unpacking kernel for " + std::to_string(column.bits) + " bit columns");
+  }
+}
+
+}  // namespace
+
+const char *kernelName() {
+#if defined(__AVX2__)
+  return "avx2";
+#elif defined(__SSE4_1__)
+  return "sse4";
+#else
+  return "scalar";
+#endif
+}
+
+void decode(const PackedColumn &column, size_t start, size_t stop, value_id_t *out) {
+  checkWidth(column);
+  if (start < stop) {
+    decodeKernels[column.bits](column, start, stop, out);
+  }
+}
+
+void scan(const PackedColumn &column, size_t start, size_t stop, const ValueIdRange &range, pos_list_t &positions) {
+  checkWidth(column);
+  if (start >= stop || (range.empty() && !range.negated)) {
+    return;
+  }
+  if (range.empty()) {
+    for (size_t row = start; row < stop; ++row) {
+      positions.push_back(row);
+    }
+    return;
+  }
+  PositionSink sink(positions);
+  positionKernels[column.bits](column, start, stop, range, sink);
+}
+
+void scanBitmap(const PackedColumn &column, size_t start, size_t stop, const ValueIdRange &range, std::vector<uint64_t> &bitmap) {
+  checkWidth(column);
+  size_t rows = start < stop ? stop - start : 0;
+  bitmap.assign((rows + 63) / 64, 0);
+  if (rows == 0 || (range.empty() && !range.negated)) {
+    return;
+  }
+  if (range.empty()) {
+    std::fill(bitmap.begin(), bitmap.end(), ~0ull);
+    if (rows % 64) {
+      bitmap.back() = (1ull << (rows % 64)) - 1;
+    }
+    return;
+  }
+  BitmapSink sink(bitmap.data(), start);
+  bitmapKernels[column.bits](column, start, stop, range, sink);
+}
+
+} } } // namespace hyrise::storage::bitunpacking
+
@@ -0,0 +1,68 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace storage {
+namespace bitunpacking {
+
+/*
+  Inclusive range [lower, upper] of value ids. A value matches if it
+  lies inside the range, or outside of it if the range is negated. An
+  empty range (lower > upper) matches nothing, or everything if negated.
+ */
+struct ValueIdRange {
+  value_id_t lower;
+  value_id_t upper;
+  bool negated;
+
+  static ValueIdRange none() { return {1, 0, false}; }
+  static ValueIdRange all() { return {1, 0, true}; }
+  static ValueIdRange equals(value_id_t v) { return {v, v, false}; }
+  static ValueIdRange between(value_id_t lower, value_id_t upper) { return {lower, upper, false}; }
+  static ValueIdRange lessThan(value_id_t v) { return v == 0 ? none() : between(0, v - 1); }
+  static ValueIdRange greaterEqual(value_id_t v) { return between(v, std::numeric_limits<value_id_t>::max()); }
+  static ValueIdRange greaterThan(value_id_t v) {
+    return v == std::numeric_limits<value_id_t>::max() ? none() : greaterEqual(v + 1);
+  }
+
+  ValueIdRange negate() const { return {lower, upper, !negated}; }
+  bool empty() const { return lower > upper; }
+  bool matches(value_id_t v) const { return ((lower <= v) && (v <= upper)) != negated; }
+};
+
+/*
+  Describes a single column of a row-major, bit-packed attribute
+  vector: row r of the column starts at bit r * tupleWidth +
+  columnOffset of data and is bits wide. The data must be followed by
+  at least one word of padding, as the kernels load whole words.
+ */
+struct PackedColumn {
+  const uint64_t *data;
+  uint64_t tupleWidth;
+  uint64_t columnOffset;
+  uint64_t bits;
+};
+
+// Bulk kernels are available for column widths from 1 to 32 bits
+inline bool supports(const uint64_t bits) { return bits >= 1 && bits <= 32; }
+
+// Name of the instruction set the kernels were compiled for (avx2, sse4 or scalar)
+const char *kernelName();
+
+// Decodes rows [start, stop) of the column into out
+void decode(const PackedColumn &column, size_t start, size_t stop, value_id_t *out);
+
+// Appends all rows in [start, stop) whose value id matches range to positions
+void scan(const PackedColumn &column, size_t start, size_t stop, const ValueIdRange &range, pos_list_t &positions);
+
+// Builds a selection bitmap for [start, stop), bit i marks a match in row start + i
+void scanBitmap(const PackedColumn &column, size_t start, size_t stop, const ValueIdRange &range, std::vector<uint64_t> &bitmap);
+
+} } } // namespace hyrise::storage::bitunpacking
+
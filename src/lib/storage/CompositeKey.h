@@ -0,0 +1,139 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hyrise {
+namespace storage {
+
+/*
+  Key of a fixed number of trivially copyable values, e.g. the value ids
+  of the grouped columns. Keys of up to BYTES bytes are stored inline,
+  so that building keys for hash tables does not allocate; longer keys
+  are kept on the heap.
+ */
+template <typename T, size_t BYTES = 16>
+class CompositeKey {
+  static_assert(std::is_trivially_copyable<T>::value, "CompositeKey requires trivially copyable values");
+
+ public:
+  typedef T value_type;
+  typedef const T *const_iterator;
+
+  static const size_t inline_capacity = BYTES / sizeof(T);
+
+  CompositeKey() : _size(0), _capacity(inline_capacity) {}
+
+  CompositeKey(std::initializer_list<T> values) : CompositeKey() {
+    reserve(values.size());
+    for (const auto& value : values)
+      push_back(value);
+  }
+
+  CompositeKey(const CompositeKey &other) : _size(0), _capacity(inline_capacity) {
+    reserve(other._size);
+    std::memcpy(values(), other.values(), other._size * sizeof(T));
+    _size = other._size;
+  }
+
+  CompositeKey(CompositeKey &&other) noexcept : _size(other._size), _capacity(other._capacity) {
+    std::memcpy(&_storage, &other._storage, sizeof(_storage));
+    other._size = 0;
+    other._capacity = inline_capacity;
+  }
+
+  CompositeKey &operator=(CompositeKey other) noexcept {
+    std::swap(_size, other._size);
+    std::swap(_capacity, other._capacity);
+    std::swap(_storage, other._storage);
+    return *this;
+  }
+
+  ~CompositeKey() {
+    if (!isInline())
+      free(_storage.heap);
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity <= _capacity)
+      return;
+    auto data = static_cast<T *>(malloc(capacity * sizeof(T)));
+    if (data == nullptr)
+      throw std::bad_alloc();
+    std::memcpy(data, values(), _size * sizeof(T));
+    if (!isInline())
+      free(_storage.heap);
+    _storage.heap = data;
+    _capacity = capacity;
+  }
+
+  void push_back(const T &value) {
+    if (_size == _capacity)
+      reserve(_capacity * 2);
+    values()[_size++] = value;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  const T &operator[](size_t i) const {
+    return values()[i];
+  }
+
+  const_iterator begin() const {
+    return values();
+  }
+
+  const_iterator end() const {
+    return values() + _size;
+  }
+
+  bool operator==(const CompositeKey &other) const {
+    return _size == other._size && std::memcmp(values(), other.values(), _size * sizeof(T)) == 0;
+  }
+
+  bool operator!=(const CompositeKey &other) const {
+    return !(*this == other);
+  }
+
+  bool operator<(const CompositeKey &other) const {
+    for (size_t i = 0; i < _size && i < other._size; ++i) {
+      if (values()[i] != other.values()[i])
+        return values()[i] < other.values()[i];
+    }
+    return _size < other._size;
+  }
+
+ private:
+  bool isInline() const {
+    return _capacity == inline_capacity;
+  }
+
+  T *values() {
+    return isInline() ? _storage.values : _storage.heap;
+  }
+
+  const T *values() const {
+    return isInline() ? _storage.values : _storage.heap;
+  }
+
+  uint32_t _size;
+  uint32_t _capacity;
+  union {
+    T values[inline_capacity];
+    T *heap;
+  } _storage;
+};
+
+} } // namespace hyrise::storage
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "storage/FixedLengthVector.h"
 #include "helper/not_implemented.h"
 #include "tbb/concurrent_vector.h"
@@ -7,11 +12,35 @@
 namespace hyrise {
 namespace storage {
 
+/// Row-major vector that grows while it is read and written. The rows
+/// are kept in chunks of CHUNK_ROWS rows that never move, so the
+/// memory of rows that are no longer read can be released while rows
+/// are appended, see releaseRows().
 template <typename T>
 class ConcurrentFixedLengthVector : public AbstractFixedLengthVector<T> {
  public:
+  static const std::size_t CHUNK_ROWS = 4096;
+
   ConcurrentFixedLengthVector(std::size_t columns, std::size_t rows) :
-      _columns(columns), _values(columns * rows) {}
+      _columns(columns), _rows(0), _released(0) {
+    resize(rows);
+  }
+
+  ConcurrentFixedLengthVector(const ConcurrentFixedLengthVector& other) :
+      _columns(other._columns), _chunks(other._chunks.size()), _rows(other._rows.load()), _released(other._released) {
+    for (std::size_t chunk = 0; chunk < _chunks.size(); ++chunk) {
+      if (const T *values = other._chunks[chunk].values.load()) {
+        T *copied = new T[CHUNK_ROWS * _columns];
+        std::copy(values, values + CHUNK_ROWS * _columns, copied);
+        _chunks[chunk].values.store(copied);
+      }
+    }
+  }
+
+  virtual ~ConcurrentFixedLengthVector() {
+    for (auto& chunk : _chunks)
+      delete[] chunk.values.load();
+  }
 
   virtual T get(size_t column, size_t row) const override {
     return getRef(column, row);
@@ -19,28 +48,47 @@ class ConcurrentFixedLengthVector : public AbstractFixedLengthVector<T> {
 
   virtual const T& getRef(size_t column, size_t row) const override {
     check_access(column, row);
-    return _values[row * _columns + column];
+    return value(column, row);
   }
 
   virtual void set(size_t column, size_t row, T value) override {
     check_access(column, row);
-    _values[row * _columns + column] = value;
+    this->value(column, row) = value;
   }
 
   virtual void reserve(size_t rows) override {
-    _values.grow_to_at_least(_columns * rows);
+    const std::size_t chunks = (rows + CHUNK_ROWS - 1) / CHUNK_ROWS;
+    _chunks.grow_to_at_least(chunks);
+    // all chunks below the current size exist or were released
+    for (std::size_t chunk = _rows.load() / CHUNK_ROWS; chunk < chunks; ++chunk) {
+      if (_chunks[chunk].values.load() != nullptr)
+        continue;
+      T *values = new T[CHUNK_ROWS * _columns]();
+      T *expected = nullptr;
+      if (!_chunks[chunk].values.compare_exchange_strong(expected, values))
+        delete[] values;
+    }
   }
 
   virtual void resize(size_t rows) override {
     reserve(rows);
+    auto current = _rows.load();
+    while (current < rows && !_rows.compare_exchange_weak(current, rows)) {}
   }
 
   virtual std::uint64_t capacity() override {
-    return _values.capacity() / _columns;
+    return _chunks.size() * CHUNK_ROWS;
   }
 
   virtual std::uint64_t size() override {
-    return _values.size() / _columns;
+    return _rows.load();
+  }
+
+  /// Frees the chunks that only hold rows below rows, these rows must no
+  /// longer be accessed. Not safe to call concurrently with itself.
+  void releaseRows(std::size_t rows) {
+    for (; _released < std::min<std::size_t>(rows, _rows.load()) / CHUNK_ROWS; ++_released)
+      delete[] _chunks[_released].values.exchange(nullptr);
   }
 
   virtual void setNumRows(std::size_t num) override { NOT_IMPLEMENTED }
@@ -56,12 +104,29 @@ class ConcurrentFixedLengthVector : public AbstractFixedLengthVector<T> {
   void check_access(std::size_t columns, std::size_t rows) const {
 #ifdef EXPENSIVE_ASSERTIONS
     if (columns >= _columns) { throw std::out_of_range("Accessing column beyond boundaries"); }
-    if (rows >= (_values.size() / _columns)) { throw std::out_of_range("Accessing row beyond boundaries"); }
+    if (rows >= _rows.load()) { throw std::out_of_range("Accessing row beyond boundaries"); }
 #endif
   }
+
+  inline T& value(std::size_t column, std::size_t row) const {
+    return _chunks[row / CHUNK_ROWS].values.load(std::memory_order_acquire)[(row % CHUNK_ROWS) * _columns + column];
+  }
+
+  // the chunk table grows without moving its entries
+  struct Chunk {
+    std::atomic<T*> values;
+    Chunk() : values(nullptr) {}
+    Chunk(const Chunk& other) : values(other.values.load()) {}
+  };
+
   const std::size_t _columns;
-  tbb::concurrent_vector<T> _values;
+  tbb::concurrent_vector<Chunk> _chunks;
+  std::atomic<std::size_t> _rows;
+  //* Number of chunks at the beginning that were released
+  std::size_t _released;
 };
 
-} } // namespace hyrise::storage
+template <typename T>
+const std::size_t ConcurrentFixedLengthVector<T>::CHUNK_ROWS;
 
+} } // namespace hyrise::storage
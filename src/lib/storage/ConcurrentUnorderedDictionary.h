@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "helper/not_implemented.h"
 #include "storage/BaseDictionary.h"
 #include "storage/DictionaryIterator.h"
@@ -13,39 +17,54 @@ namespace storage {
 template <typename T>
 class ConcurrentUnorderedDictionaryIterator : public BaseIterator<T> {
   typedef ConcurrentUnorderedDictionaryIterator<T> iter_type;
-  typedef typename std::map<T, value_id_t>::iterator iter_t;
-  iter_t _it;
+  typedef std::vector<std::pair<T, value_id_t> > sorted_t;
+  const sorted_t *_sorted;
+  size_t _index;
+
+  // the end iterator may be created before the values are extracted
+  size_t position() const {
+    return std::min(_index, _sorted->size());
+  }
 public:
-  ConcurrentUnorderedDictionaryIterator(iter_t it) : _it(it) {}
+  ConcurrentUnorderedDictionaryIterator(const sorted_t *sorted, size_t index) : _sorted(sorted), _index(index) {}
 
   void increment() {
-    _it++;
+    _index++;
   }
 
   bool equal(const std::shared_ptr<BaseIterator<T>>& other) const {
-    return (_it == std::static_pointer_cast<iter_type>(other)->_it);
+    const auto &it = std::static_pointer_cast<iter_type>(other);
+    return _sorted == it->_sorted && position() == it->position();
   }
 
   T &dereference() const {
-    return (T&) _it->first;
+    return (T&) (*_sorted)[_index].first;
   }
 
   value_id_t getValueId() const {
-    return _it->second;
+    return (*_sorted)[_index].second;
   }
 };
 
 template <typename T>
 class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
  public:
-  explicit ConcurrentUnorderedDictionary(const size_t s=0) : _values(s) { }
+  explicit ConcurrentUnorderedDictionary(const size_t s=0) {
+    _values.reserve(s);
+  }
 
   // Semantics differ from other dictionaries: adding the same value twice yields
   // the same valueId. This is due to multiple threads pushing back the same
   // value and/or testing for its existance via valueExists
   // and the lag with inserting the resulting position into _index_unordered,
   // where the first writer wins.
+  // Values that are already indexed are found by a lock-free lookup and not
+  // appended again; only threads racing to add the same new value each
+  // append it, the slots of the losers stay unused.
   virtual value_id_t addValue(T value) override {
+    auto existing = _index_unordered.find(value);
+    if (existing != _index_unordered.end())
+      return existing->second;
     auto inserted = _values.push_back(value);
     auto result = std::distance(_values.begin(), inserted);
     auto r = _index_unordered.insert({value, result});
@@ -72,10 +91,10 @@ class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
     return _index_unordered.count(value) >= 1;
   }
   virtual const T getSmallestValue() {
-    return *std::min(_values.begin(), _values.end());
+    return *std::min_element(_values.begin(), _values.end());
   }
   virtual const T getGreatestValue() {
-    return *std::max(_values.begin(), _values.end());
+    return *std::max_element(_values.begin(), _values.end());
   }
   virtual void reserve(std::size_t s) override {
     _values.grow_to_at_least(s);
@@ -99,21 +118,25 @@ class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
 
   typedef DictionaryIterator<T> iterator;
 
-  // Unsafe method, calling this assumes no concurrent callers
+  // Unsafe method, calling this assumes no concurrent callers. Extracts
+  // the indexed values into a vector and sorts it, every value once.
   virtual iterator begin() override {
-    _index.clear();
-    _index.insert(_index_unordered.begin(), _index_unordered.end());
-    return iterator(std::make_shared<ConcurrentUnorderedDictionaryIterator<T> >(_index.begin()));
+    _sorted.assign(_index_unordered.begin(), _index_unordered.end());
+    std::sort(_sorted.begin(), _sorted.end(),
+              [] (const std::pair<T, value_id_t>& left, const std::pair<T, value_id_t>& right) {
+                return left.first < right.first;
+              });
+    return iterator(std::make_shared<ConcurrentUnorderedDictionaryIterator<T> >(&_sorted, 0));
   }
   virtual iterator end() override {
-    return iterator(std::make_shared<ConcurrentUnorderedDictionaryIterator<T> >(_index.end()));
+    return iterator(std::make_shared<ConcurrentUnorderedDictionaryIterator<T> >(&_sorted, std::numeric_limits<size_t>::max()));
   }
   virtual value_id_t getValueIdForValueSmaller(T other) { NOT_IMPLEMENTED }
   virtual value_id_t getValueIdForValueGreater(T other) { NOT_IMPLEMENTED }
  private:
   tbb::concurrent_unordered_map<T, value_id_t> _index_unordered; // a potentially laggy set
   tbb::concurrent_vector<T> _values;
-  std::map<T, value_id_t> _index;
+  std::vector<std::pair<T, value_id_t> > _sorted;
 };
 
 } } // namespace hyrise::storage
@@ -0,0 +1,252 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+  Open addressing multimap from keys to row positions.
+
+  Every distinct key occupies one slot of a flat array that is probed
+  linearly and keeps the key, its hash and its latest position. The
+  positions themselves are kept in a second array and chained per key
+  by index, so that neither keys nor positions are allocated one by
+  one. Iteration visits the keys slot by slot with all positions of a
+  key adjacent, latest first like in an unordered_multimap, and the
+  slots can be iterated one by one through the bucket interface.
+ */
+template <class KEY, class HASH>
+class FlatHashMultimap {
+ public:
+  typedef KEY key_type;
+  typedef pos_t mapped_type;
+  typedef HASH hasher;
+  typedef std::pair<KEY, pos_t> value_type;
+
+ private:
+  static const size_t npos = static_cast<size_t>(-1);
+  static const size_t min_bucket_count = 16;
+
+  struct Slot {
+    KEY key;
+    size_t hash;
+    // latest entry of the key, npos for empty slots
+    size_t head;
+  };
+
+  struct Entry {
+    pos_t pos;
+    size_t next;
+  };
+
+  std::vector<Slot> _slots;
+  std::vector<Entry> _entries;
+  size_t _keys;
+  size_t _shift;
+  float _max_load_factor;
+
+  // iterates all slots or, if LOCAL is set, the entries of a single slot
+  template <bool LOCAL>
+  class iterator_base : public std::iterator<std::forward_iterator_tag, const value_type> {
+    friend class FlatHashMultimap;
+
+    const FlatHashMultimap *_map;
+    size_t _slot;
+    size_t _entry;
+    value_type _value;
+
+    iterator_base(const FlatHashMultimap *map, size_t slot, size_t entry) : _map(map), _slot(slot), _entry(entry) {
+      if (_entry != npos) {
+        _value.first = _map->_slots[_slot].key;
+        _value.second = _map->_entries[_entry].pos;
+      }
+    }
+
+   public:
+    iterator_base() : _map(nullptr), _slot(0), _entry(npos) {}
+
+    const value_type &operator*() const {
+      return _value;
+    }
+
+    const value_type *operator->() const {
+      return &_value;
+    }
+
+    iterator_base &operator++() {
+      _entry = _map->_entries[_entry].next;
+      if (_entry == npos && !LOCAL) {
+        _slot = _map->nextOccupied(_slot + 1);
+        if (_slot != _map->_slots.size()) {
+          _entry = _map->_slots[_slot].head;
+          _value.first = _map->_slots[_slot].key;
+        }
+      }
+      if (_entry != npos)
+        _value.second = _map->_entries[_entry].pos;
+      return *this;
+    }
+
+    iterator_base operator++(int) {
+      iterator_base result(*this);
+      ++(*this);
+      return result;
+    }
+
+    bool operator==(const iterator_base &other) const {
+      return _slot == other._slot && _entry == other._entry;
+    }
+
+    bool operator!=(const iterator_base &other) const {
+      return !(*this == other);
+    }
+  };
+
+ public:
+  typedef iterator_base<false> const_iterator;
+  typedef iterator_base<true> const_local_iterator;
+
+  FlatHashMultimap() : _keys(0), _shift(64), _max_load_factor(0.7f) {}
+
+  const_iterator begin() const {
+    auto slot = nextOccupied(0);
+    return const_iterator(this, slot, slot == _slots.size() ? npos : _slots[slot].head);
+  }
+
+  const_iterator end() const {
+    return const_iterator(this, _slots.size(), npos);
+  }
+
+  /// Iterate the positions of the key in the given slot
+  const_local_iterator begin(size_t bucket) const {
+    return const_local_iterator(this, bucket, _slots[bucket].head);
+  }
+
+  const_local_iterator end(size_t bucket) const {
+    return const_local_iterator(this, bucket, npos);
+  }
+
+  /// Number of positions
+  size_t size() const {
+    return _entries.size();
+  }
+
+  bool empty() const {
+    return _entries.empty();
+  }
+
+  /// Number of distinct keys
+  size_t key_count() const {
+    return _keys;
+  }
+
+  size_t bucket_count() const {
+    return _slots.size();
+  }
+
+  float load_factor() const {
+    return _slots.empty() ? 0.0f : static_cast<float>(_keys) / _slots.size();
+  }
+
+  float max_load_factor() const {
+    return _max_load_factor;
+  }
+
+  /// Reserves memory for the given number of positions
+  void reserve(size_t positions) {
+    _entries.reserve(positions);
+  }
+
+  void insert(const value_type &value) {
+    insert(value.first, value.second);
+  }
+
+  void insert(const KEY &key, pos_t pos) {
+    const size_t hash = hasher()(key);
+    size_t slot = findSlot(key, hash);
+    if (_slots.empty() || _slots[slot].head == npos) {
+      if (_keys + 1 > _slots.size() * _max_load_factor) {
+        rehash(_slots.empty() ? size_t(min_bucket_count) : _slots.size() * 2);
+        slot = findSlot(key, hash);
+      }
+      _slots[slot].key = key;
+      _slots[slot].hash = hash;
+      ++_keys;
+    }
+    _entries.push_back({pos, _slots[slot].head});
+    _slots[slot].head = _entries.size() - 1;
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(const KEY &key) const {
+    const size_t slot = findSlot(key, hasher()(key));
+    if (_slots.empty() || _slots[slot].head == npos)
+      return {end(), end()};
+
+    const size_t next = nextOccupied(slot + 1);
+    return {const_iterator(this, slot, _slots[slot].head),
+            const_iterator(this, next, next == _slots.size() ? npos : _slots[next].head)};
+  }
+
+  /// Appends all positions of key to positions and returns their number
+  size_t copy_positions(const KEY &key, pos_list_t &positions) const {
+    if (_slots.empty())
+      return 0;
+    const auto &s = _slots[findSlot(key, hasher()(key))];
+    size_t count = 0;
+    for (size_t entry = s.head; entry != npos; entry = _entries[entry].next, ++count)
+      positions.push_back(_entries[entry].pos);
+    return count;
+  }
+
+ private:
+  // slot holding key, or the empty slot it would be inserted into
+  size_t findSlot(const KEY &key, size_t hash) const {
+    if (_slots.empty())
+      return 0;
+    const size_t mask = _slots.size() - 1;
+    // fibonacci hashing spreads hashes of dense value ids over the slots
+    size_t slot = (hash * 11400714819323198485ull) >> _shift;
+    while (_slots[slot].head != npos && (_slots[slot].hash != hash || !(_slots[slot].key == key)))
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  size_t nextOccupied(size_t slot) const {
+    while (slot < _slots.size() && _slots[slot].head == npos)
+      ++slot;
+    return slot;
+  }
+
+  void rehash(size_t buckets) {
+    std::vector<Slot> slots(buckets, Slot {KEY(), 0, npos});
+    std::swap(_slots, slots);
+    _shift = 64;
+    for (size_t b = buckets; b > 1; b >>= 1)
+      --_shift;
+
+    const size_t mask = buckets - 1;
+    for (auto &s : slots) {
+      if (s.head == npos)
+        continue;
+      size_t slot = (s.hash * 11400714819323198485ull) >> _shift;
+      while (_slots[slot].head != npos)
+        slot = (slot + 1) & mask;
+      _slots[slot] = std::move(s);
+    }
+  }
+};
+
+} } // namespace hyrise::storage
@@ -0,0 +1,167 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/FrontCodedDictionary.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+void writeLength(std::vector<char> &data, size_t length) {
+  while (length >= 0x80) {
+    data.push_back(static_cast<char>(length | 0x80));
+    length >>= 7;
+  }
+  data.push_back(static_cast<char>(length));
+}
+
+size_t readLength(const char *data, size_t &position) {
+  size_t length = 0;
+  for (size_t shift = 0; ; shift += 7) {
+    const unsigned char byte = data[position++];
+    length |= static_cast<size_t>(byte & 0x7F) << shift;
+    if (byte < 0x80)
+      return length;
+  }
+}
+
+}  // namespace
+
+const size_t FrontCodedDictionary::BLOCK_SIZE;
+
+std::shared_ptr<FrontCodedDictionary> FrontCodedDictionary::encode(BaseDictionary<hyrise_string_t> &sorted) {
+  auto result = std::make_shared<FrontCodedDictionary>(sorted.size());
+  for (auto it = sorted.begin(), end = sorted.end(); it != end; ++it)
+    result->addValue(*it);
+  result->shrink();
+  return result;
+}
+
+void FrontCodedDictionary::shrink() {
+  _data.shrink_to_fit();
+  _blocks.shrink_to_fit();
+}
+
+value_id_t FrontCodedDictionary::addValue(hyrise_string_t value) {
+#ifdef EXPENSIVE_ASSERTIONS
+  if ((_size > 0) && (value <= _last))
+    throw std::runtime_error("Can't insert value smaller or equal to last value");
+#endif
+  size_t prefix = 0;
+  if (_size % BLOCK_SIZE == 0) {
+    _blocks.push_back(_data.size());
+  } else {
+    const size_t limit = std::min(value.size(), _last.size());
+    while (prefix < limit && value[prefix] == _last[prefix])
+      ++prefix;
+  }
+  writeLength(_data, prefix);
+  writeLength(_data, value.size() - prefix);
+  _data.insert(_data.end(), value.begin() + prefix, value.end());
+  _last.swap(value);
+  return _size++;
+}
+
+size_t FrontCodedDictionary::decodeNext(size_t position, hyrise_string_t &value) const {
+  const size_t prefix = readLength(_data.data(), position);
+  const size_t suffix = readLength(_data.data(), position);
+  value.resize(prefix);
+  value.append(_data.data() + position, suffix);
+  return position + suffix;
+}
+
+void FrontCodedDictionary::decodeValue(value_id_t value_id, hyrise_string_t &value) const {
+#ifdef EXPENSIVE_ASSERTIONS
+  if (value_id >= _size)
+    throw std::out_of_range("Trying to access value_id larger than available values");
+#endif
+  // only the lengths of the preceding entries of the block are read
+  const size_t last = value_id % BLOCK_SIZE;
+  size_t prefixes[BLOCK_SIZE], suffixes[BLOCK_SIZE];
+  size_t position = _blocks[value_id / BLOCK_SIZE];
+  size_t length = 0;
+  for (size_t i = 0; i <= last; ++i) {
+    prefixes[i] = readLength(_data.data(), position);
+    length = readLength(_data.data(), position);
+    suffixes[i] = position;
+    position += length;
+  }
+
+  // every character is copied once, from the last entry that stores it
+  value.resize(prefixes[last] + length);
+  size_t needed = value.size();
+  for (size_t i = last + 1; i-- > 0 && needed > 0; ) {
+    if (prefixes[i] < needed) {
+      std::memcpy(&value[prefixes[i]], _data.data() + suffixes[i], needed - prefixes[i]);
+      needed = prefixes[i];
+    }
+  }
+}
+
+size_t FrontCodedDictionary::bound(const hyrise_string_t &value, bool upper, bool &found) const {
+  found = false;
+  // the first value of a block is stored as is and compared in place
+  auto compareHead = [&] (size_t block) {
+    size_t position = _blocks[block];
+    readLength(_data.data(), position);
+    const size_t length = readLength(_data.data(), position);
+    return value.compare(0, value.size(), _data.data() + position, length);
+  };
+  auto precedes = [&] (size_t block) {
+    const int cmp = compareHead(block);
+    return upper ? cmp >= 0 : cmp > 0;
+  };
+
+  // blocks [0, first) start with values that precede the bound
+  size_t first = 0, last = _blocks.size();
+  while (first < last) {
+    const size_t middle = first + (last - first) / 2;
+    if (precedes(middle))
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  if (first == 0) {
+    found = !upper && _size > 0 && compareHead(0) == 0;
+    return 0;
+  }
+
+  // the bound lies in block first - 1 or is the first value of block first
+  const size_t block = first - 1;
+  const size_t end = std::min(first * BLOCK_SIZE, _size);
+  hyrise_string_t current;
+  size_t position = _blocks[block];
+  for (size_t i = block * BLOCK_SIZE; i < end; ++i) {
+    position = decodeNext(position, current);
+    if (upper ? value < current : !(current < value)) {
+      found = current == value;
+      return i;
+    }
+  }
+  found = !upper && end < _size && compareHead(first) == 0;
+  return end;
+}
+
+FrontCodedIterator::FrontCodedIterator(const FrontCodedDictionary *dictionary, size_t index)
+    : _dictionary(dictionary), _index(index), _position(0) {
+  if (_index < _dictionary->_size) {
+    const size_t block = _index / FrontCodedDictionary::BLOCK_SIZE;
+    _position = _dictionary->_blocks[block];
+    for (size_t i = block * FrontCodedDictionary::BLOCK_SIZE; i <= _index; ++i)
+      _position = _dictionary->decodeNext(_position, _value);
+  }
+}
+
+void FrontCodedIterator::increment() {
+  if (++_index < _dictionary->_size)
+    _position = _dictionary->decodeNext(_position, _value);
+}
+
+bool FrontCodedIterator::equal(const std::shared_ptr<BaseIterator<hyrise_string_t>>& other) const {
+  const auto &it = std::dynamic_pointer_cast<FrontCodedIterator>(other);
+  return _dictionary == it->_dictionary && _index == it->_index;
+}
+
+} } // namespace hyrise::storage
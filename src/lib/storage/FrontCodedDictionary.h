@@ -0,0 +1,169 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/OrderPreservingDictionary.h"
+
+namespace hyrise {
+namespace storage {
+
+class FrontCodedDictionary;
+
+/*
+ * Iterator of the front coded dictionary, decodes the values in order
+ * and keeps the current one.
+ */
+class FrontCodedIterator : public BaseIterator<hyrise_string_t> {
+  const FrontCodedDictionary *_dictionary;
+  size_t _index;
+  // position of the next entry
+  size_t _position;
+  mutable hyrise_string_t _value;
+
+ public:
+  FrontCodedIterator(const FrontCodedDictionary *dictionary, size_t index);
+
+  void increment();
+
+  bool equal(const std::shared_ptr<BaseIterator<hyrise_string_t>>& other) const;
+
+  hyrise_string_t &dereference() const {
+    return _value;
+  }
+
+  value_id_t getValueId() const {
+    return _index;
+  }
+};
+
+/*
+ * Sorted strings packed into one buffer with front coding: the values
+ * form blocks of BLOCK_SIZE values, the first value of a block is stored
+ * as is, the others only store the length of the prefix they share with
+ * their predecessor and the remaining suffix. Every entry is
+ * varint(prefix) varint(suffix length) suffix. Lookups search the first
+ * values of the blocks and then decode a single block.
+ *
+ * Front coding trades lookups and materialization for memory, so it is
+ * only used by stores that opt in, see Store::setFrontCoding(). It is an
+ * OrderPreservingDictionary, so that operators requiring sorted
+ * dictionaries accept it, but none of the values of the base are used.
+ */
+class FrontCodedDictionary : public OrderPreservingDictionary<hyrise_string_t> {
+  friend class FrontCodedIterator;
+
+ public:
+  static const size_t BLOCK_SIZE = 16;
+
+ private:
+  std::vector<char> _data;
+  // offset of the first entry of every block in _data
+  std::vector<size_t> _blocks;
+  size_t _size;
+  // last value added, its successor is coded against it
+  hyrise_string_t _last;
+
+  // decodes the entry at position, which follows value, into value and
+  // returns the position of the next entry
+  size_t decodeNext(size_t position, hyrise_string_t &value) const;
+  // index of the first value that is not less than value (greater than
+  // value if upper), found tells whether that value equals value
+  size_t bound(const hyrise_string_t &value, bool upper, bool &found) const;
+
+ public:
+  FrontCodedDictionary() : _size(0) {}
+
+  explicit FrontCodedDictionary(size_t size) : _size(0) {
+    reserve(size);
+  }
+
+  virtual ~FrontCodedDictionary() {}
+
+  /// Front codes the values of a sorted dictionary, value ids stay the same
+  static std::shared_ptr<FrontCodedDictionary> encode(BaseDictionary<hyrise_string_t> &sorted);
+
+  void shrink();
+
+  value_id_t addValue(hyrise_string_t value);
+
+  hyrise_string_t getValueForValueId(value_id_t value_id) {
+    hyrise_string_t value;
+    decodeValue(value_id, value);
+    return value;
+  }
+
+  /// Decodes the value of value_id into value, reuses the memory of
+  /// value instead of allocating a new string
+  void decodeValue(value_id_t value_id, hyrise_string_t &value) const;
+
+  value_id_t getValueIdForValue(const hyrise_string_t &value) const {
+    bool found;
+    return bound(value, false, found);
+  }
+
+  value_id_t getValueIdForValueSmaller(hyrise_string_t other) {
+    bool found;
+    size_t index = bound(other, false, found);
+    assert(index > 0);
+    return index - 1;
+  }
+
+  value_id_t getValueIdForValueGreater(hyrise_string_t other) {
+    bool found;
+    return bound(other, true, found);
+  }
+
+  const hyrise_string_t getSmallestValue() {
+    assert(_size > 0);
+    return getValueForValueId(0);
+  }
+
+  const hyrise_string_t getGreatestValue() {
+    assert(_size > 0);
+    return _last;
+  }
+
+  bool isValueIdValid(value_id_t value_id) {
+    return value_id < _size;
+  }
+
+  bool valueExists(const hyrise_string_t &value) const {
+    bool found;
+    bound(value, false, found);
+    return found;
+  }
+
+  void reserve(size_t size) {
+    _blocks.reserve((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  }
+
+  size_t size() {
+    return _size;
+  }
+
+  /// Bytes of the coded values
+  size_t encodedSize() const {
+    return _data.size();
+  }
+
+  std::shared_ptr<AbstractDictionary> copy() {
+    return std::make_shared<FrontCodedDictionary>(*this);
+  }
+
+  std::shared_ptr<AbstractDictionary> copy_empty() {
+    return std::make_shared<FrontCodedDictionary>();
+  }
+
+  iterator begin() {
+    return iterator(std::make_shared<FrontCodedIterator>(this, 0));
+  }
+
+  iterator end() {
+    return iterator(std::make_shared<FrontCodedIterator>(this, _size));
+  }
+};
+
+} } // namespace hyrise::storage
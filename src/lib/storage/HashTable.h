@@ -3,8 +3,8 @@
 
 #include <atomic>
 #include <algorithm>
+#include <functional>
 #include <set>
-#include <unordered_map>
 #include <memory>
 #include <sstream>
 
@@ -13,6 +13,8 @@
 
 #include "storage/AbstractHashTable.h"
 #include "storage/AbstractTable.h"
+#include "storage/CompositeKey.h"
+#include "storage/FlatHashMultimap.h"
 #include "storage/storage_types.h"
 #include "storage/HashTableView.h"
 
@@ -20,10 +22,10 @@
 namespace hyrise {
 namespace storage {
 
-// Group of value_ids as key to an unordered map
-typedef std::vector<value_id_t> aggregate_key_t;
-// Group of hashed values as key to an unordered map
-typedef std::vector<size_t> join_key_t;
+// Group of value_ids as key to a hash map, up to four are kept inline
+typedef CompositeKey<value_id_t> aggregate_key_t;
+// Group of hashed values as key to a hash map, up to two are kept inline
+typedef CompositeKey<size_t> join_key_t;
 
 // Single Value ID as key to unordered map
 typedef value_id_t aggregate_single_key_t;
@@ -91,10 +93,10 @@ public:
                        const field_list_t &columns,
                        const size_t fieldCount,
                        const pos_t row) {
-    ValueIdList value_list = table->copyValueIds(row, &columns);
     T key;
-    for (size_t i = 0, key_size = fieldCount; i < key_size; i++)
-      key.push_back(extract<T>(table, columns[i], value_list[i]));
+    key.reserve(fieldCount);
+    for (size_t i = 0; i < fieldCount; i++)
+      key.push_back(extract<T>(table, columns[i], table->getValueId(columns[i], row)));
     return key;
   }
 };
@@ -116,12 +118,12 @@ public:
 };
 
 // Multi Keys
-typedef std::unordered_multimap<aggregate_key_t, pos_t, GroupKeyHash<aggregate_key_t> > aggregate_hash_map_t;
-typedef std::unordered_multimap<join_key_t, pos_t, GroupKeyHash<join_key_t> > join_hash_map_t;
+typedef FlatHashMultimap<aggregate_key_t, GroupKeyHash<aggregate_key_t> > aggregate_hash_map_t;
+typedef FlatHashMultimap<join_key_t, GroupKeyHash<join_key_t> > join_hash_map_t;
 
 // Single Keys
-typedef std::unordered_multimap<aggregate_single_key_t, pos_t, SingleGroupKeyHash<aggregate_single_key_t> > aggregate_single_hash_map_t;
-typedef std::unordered_multimap<join_single_key_t, pos_t, SingleGroupKeyHash<join_single_key_t> > join_single_hash_map_t;
+typedef FlatHashMultimap<aggregate_single_key_t, SingleGroupKeyHash<aggregate_single_key_t> > aggregate_single_hash_map_t;
+typedef FlatHashMultimap<join_single_key_t, SingleGroupKeyHash<join_single_key_t> > join_single_hash_map_t;
 
 /// HashTable based on a map; key specifies the key for the given map
 template<class MAP, class KEY> class HashTable;
@@ -132,7 +134,7 @@ typedef HashTable<join_hash_map_t, join_key_t> JoinHashTable;
 typedef HashTable<aggregate_single_hash_map_t, aggregate_single_key_t> SingleAggregateHashTable;
 typedef HashTable<join_single_hash_map_t, join_single_key_t> SingleJoinHashTable;
 
-/// Uses valueIds of specified columns as key for an unordered_multimap
+/// Uses valueIds of specified columns as key for a FlatHashMultimap
 template <class MAP, class KEY>
 class HashTable : public HashTableBase<MAP,KEY>, public std::enable_shared_from_this<HashTable<MAP, KEY> > {
 public:
@@ -143,35 +145,21 @@ public:
     typedef decltype(std::declval<const map_t>().equal_range(key_t())) map_const_range_t;
 
 private:
-  // populates map with values
-  inline void populate_map(size_t row_offset = 0) {
+  // populates map with the values of rows [first, last)
+  inline void populate_map(size_t first, size_t last, size_t row_offset = 0) {
     base_t::_dirty = true;
     size_t fieldSize = base_t::_fields.size();
-    size_t tableSize = base_t::_table->size();
-    for (pos_t row = 0; row < tableSize; ++row) {
-      key_t key = MAP::hasher::getGroupKey(base_t::_table, base_t::_fields, fieldSize, row);
-      base_t::_map.insert(typename map_t::value_type(key, row + row_offset));
+    for (pos_t row = first; row < last; ++row) {
+      base_t::_map.insert(MAP::hasher::getGroupKey(base_t::_table, base_t::_fields, fieldSize, row), row + row_offset);
     }
   }
 
-  pos_list_t constructPositions(const map_const_range_t &range) const {
-    return constructPositions(range.first, range.second);
-  }
-
-  pos_list_t constructPositions(const map_const_iterator_t &begin,  const map_const_iterator_t &end) const {
-    pos_list_t positions(std::distance(begin, end));
-    // decltype(*range.first) returns the type of iterator elements
-    std::transform(begin, end, positions.begin(), [&](decltype(*begin)& value) {
-      return value.second;
-    });
-    return positions;
-  }
-
 public:
   HashTable() {}
 
-  // create a new HashTable based on a number of HashTables
-  explicit HashTable(const std::vector<std::shared_ptr<const AbstractHashTable> >& hashTables) {
+  // create a new HashTable based on a number of HashTables of the same table and fields
+  explicit HashTable(const std::vector<std::shared_ptr<const AbstractHashTable> >& hashTables)
+      : base_t(hashTables.front()->getTable(), hashTables.front()->getFields()) {
     base_t::_dirty = true;
 
     // use copy operator for the first given hashtable
@@ -188,7 +176,18 @@ public:
   // row_offset is used if t is a TableRangeView, so that the HashTable can build the pos_lists based on the row numbers of the original table
   HashTable(c_atable_ptr_t t, const field_list_t &f, size_t row_offset = 0)
       : base_t(t, f) {
-    populate_map(row_offset);
+    base_t::_map.reserve(t->size());
+    populate_map(0, t->size(), row_offset);
+  }
+
+  // Hash the rows of the given table's columns in the ranges [first, last)
+  // that nextRows hands out until it returns false, e.g. morsel by morsel
+  HashTable(c_atable_ptr_t t, const field_list_t &f, const std::function<bool(size_t &, size_t &)> &nextRows)
+      : base_t(t, f) {
+    size_t first, last;
+    while (nextRows(first, last)) {
+      populate_map(first, last);
+    }
   }
 
   virtual ~HashTable() {}
@@ -227,29 +226,17 @@ public:
   virtual pos_list_t get(const c_atable_ptr_t& table,
                          const field_list_t &columns,
                          const pos_t row) const {
-      key_t key = MAP::hasher::getGroupKey(table, columns, columns.size(), row);
-      auto range = base_t::_map.equal_range(key);
-      return constructPositions(range);
+      return get(MAP::hasher::getGroupKey(table, columns, columns.size(), row));
     }
 
   virtual pos_list_t get(const key_t &key) const {
-    auto range = base_t::_map.equal_range(key);
-    return constructPositions(range);
+    pos_list_t positions;
+    base_t::_map.copy_positions(key, positions);
+    return positions;
   }
 
   virtual uint64_t numKeys() const {
-      if (base_t::_dirty) {
-        uint64_t result = 0;
-
-        for (map_const_iterator_t it1 = base_t::_map.begin(), it2 = it1, end = base_t::_map.end(); it1 != end; it1 = it2) {
-          for (; (it2 != end) && (it1->first == it2->first); ++it2) {}
-          ++result;
-        }
-
-        base_t::_numKeys = result;
-        base_t::_dirty = false;
-      }
-      return base_t::_numKeys;
+      return base_t::_map.key_count();
     }
 };
 
@@ -8,9 +8,11 @@
 
 namespace hyrise { namespace storage {
 
+const int HorizontalTable::NO_NODE;
+
 static std::vector<size_t> offsetsFromParts(const std::vector<c_atable_ptr_t>& parts) {
   std::vector<size_t> offsets(parts.size());
-  auto total_size = 0;
+  size_t total_size = 0;
   size_t i = 0;
   for (const auto& part: parts) {
     offsets[i++] = total_size;
@@ -32,13 +34,18 @@ static std::vector<table_id_t> tableIdOffsets(const std::vector<c_atable_ptr_t>&
 }
 
 HorizontalTable::HorizontalTable(std::vector<c_atable_ptr_t> parts)
-    : _parts(parts), _offsets(offsetsFromParts(_parts)), _table_id_offsets(tableIdOffsets(parts)) {
+    : HorizontalTable(parts, std::vector<int>(parts.size(), NO_NODE)) {
+}
+
+HorizontalTable::HorizontalTable(std::vector<c_atable_ptr_t> parts, std::vector<int> nodes)
+    : _parts(parts), _offsets(offsetsFromParts(_parts)), _table_id_offsets(tableIdOffsets(parts)), _nodes(nodes) {
   assert(_parts.size() != 0);
+  assert(_nodes.size() == _parts.size());
 }
 
 HorizontalTable::~HorizontalTable() = default;
 
-inline size_t HorizontalTable::partForRow(const size_t row) const {
+size_t HorizontalTable::partForRow(const size_t row) const {
   auto r = std::find_if(std::begin(_offsets), std::end(_offsets),
                         [=] (size_t offset) { return offset > row; });
   return std::distance(std::begin(_offsets), r) - 1;
@@ -92,6 +99,10 @@ size_t HorizontalTable::partitionWidth(const size_t slice) const {
   return _parts[0]->partitionWidth(slice);
 }
 
+bool HorizontalTable::isPlaced() const {
+  return std::find(_nodes.begin(), _nodes.end(), NO_NODE) == _nodes.end();
+}
+
 atable_ptr_t HorizontalTable::copy() const {
   throw std::runtime_error("Not implemented");
 }
@@ -106,7 +117,7 @@ void HorizontalTable::debugStructure(size_t level) const {
 size_t HorizontalTable::computeSize() const {
   return std::accumulate(_parts.begin(),
                          _parts.end(),
-                         0,
+                         size_t(0),
                          [] (size_t r, const c_atable_ptr_t& t) { return r + t->size(); });
 }
 
@@ -19,7 +19,13 @@ namespace hyrise { namespace storage {
 // Horizontally partitioned table layout of n AbstractTable instances.
 class HorizontalTable : public AbstractTable {
  public:
+  /// Node of parts that were not placed on a NUMA node
+  static const int NO_NODE = -1;
+
   explicit HorizontalTable(std::vector<c_atable_ptr_t> parts);
+  /// Table of parts whose memory was allocated on NUMA nodes, nodes[i]
+  /// is the node of parts[i]
+  HorizontalTable(std::vector<c_atable_ptr_t> parts, std::vector<int> nodes);
   virtual ~HorizontalTable();
   const ColumnMetadata& metadataAt(const size_t column_index, const size_t row_index = 0, const table_id_t table_id = 0) const override;
   const adict_ptr_t& dictionaryAt(size_t column, size_t row=0, table_id_t table_id=0) const override;
@@ -34,13 +40,23 @@ class HorizontalTable : public AbstractTable {
   table_id_t subtableCount() const override;
   atable_ptr_t copy() const override;
   void debugStructure(size_t level=0) const override;
- private:
+
+  size_t partCount() const { return _parts.size(); }
+  const c_atable_ptr_t& part(size_t part) const { return _parts[part]; }
+  /// First row of part
+  size_t partOffset(size_t part) const { return _offsets[part]; }
   size_t partForRow(size_t row) const;
+  /// NUMA node holding part, NO_NODE if the part was not placed
+  int partNode(size_t part) const { return _nodes[part]; }
+  /// True if the parts were placed on NUMA nodes
+  bool isPlaced() const;
+ private:
   size_t computeSize() const;
   /// subtables
   const std::vector<c_atable_ptr_t > _parts;
   const std::vector<size_t> _offsets;
   const std::vector<table_id_t> _table_id_offsets;
+  const std::vector<int> _nodes;
   /// Offset for each subtable
 
 };
@@ -0,0 +1,74 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/NumaPlacement.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#include "helper/HwlocHelper.h"
+#include "helper/parallel_sort.hpp"
+#include "storage/AbstractDictionary.h"
+#include "storage/HorizontalTable.h"
+#include "storage/Table.h"
+
+namespace hyrise {
+namespace storage {
+
+std::shared_ptr<HorizontalTable> placeOnNodes(const c_atable_ptr_t &table, const std::vector<unsigned> &nodes) {
+  if (nodes.empty())
+    throw std::runtime_error("Table has to be placed on at least one node");
+
+  const size_t columns = table->columnCount();
+  const size_t rows = table->size();
+  std::vector<ColumnMetadata> metadata;
+  std::vector<AbstractTable::SharedDictionaryPtr> dictionaries;
+  for (size_t column = 0; column < columns; ++column) {
+    metadata.push_back(table->metadataAt(column));
+    dictionaries.push_back(table->dictionaryAt(column));
+  }
+
+  std::vector<c_atable_ptr_t> parts(nodes.size());
+  std::vector<int> placed(nodes.size(), HorizontalTable::NO_NODE);
+  std::atomic<bool> shared(true);
+
+  // every partition is built by a thread bound to its node, so that the
+  // first touch of its pages happens there; thread 0 is the calling
+  // thread, which keeps its binding
+  run_threads(nodes.size() + 1, [&] (size_t thread) {
+    if (thread == 0)
+      return;
+    const size_t part = thread - 1;
+    if (bindCurrentThreadToNode(nodes[part]))
+      placed[part] = nodes[part];
+
+    const size_t first = rows * part / nodes.size();
+    const size_t last = rows * (part + 1) / nodes.size();
+    std::vector<AbstractTable::SharedDictionaryPtr> copies;
+    for (const auto &dictionary : dictionaries)
+      copies.push_back(dictionary ? dictionary->copy() : nullptr);
+    // partitions are bit compressed like the mains they are placed from
+    auto partition = std::make_shared<Table>(&metadata, &copies, last - first, true, true);
+    partition->resize(last - first);
+    for (size_t row = first; row < last; ++row) {
+      for (size_t column = 0; column < columns; ++column) {
+        if (table->dictionaryAt(column, row) != dictionaries[column])
+          shared = false;
+        partition->setValueId(column, row - first, table->getValueId(column, row));
+      }
+    }
+    parts[part] = partition;
+  });
+
+  if (!shared)
+    throw std::runtime_error("Rows of a table placed on numa nodes have to share their dictionaries, merge the table first");
+  return std::make_shared<HorizontalTable>(parts, placed);
+}
+
+std::shared_ptr<HorizontalTable> placeOnAllNodes(const c_atable_ptr_t &table) {
+  std::vector<unsigned> nodes(std::max(1u, getNumberOfNodes(getHWTopology())));
+  for (size_t node = 0; node < nodes.size(); ++node)
+    nodes[node] = node;
+  return placeOnNodes(table, nodes);
+}
+
+} } // namespace hyrise::storage
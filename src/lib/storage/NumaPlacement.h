@@ -0,0 +1,24 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace storage {
+
+class HorizontalTable;
+
+/// Splits table into one partition of consecutive rows per entry of
+/// nodes and allocates partition i and its dictionaries on nodes[i].
+/// Every partition gets a copy of the dictionaries, so that scans of a
+/// partition never read memory of another node. Throws if the rows of a
+/// column use different dictionaries, e.g. a store with delta rows.
+std::shared_ptr<HorizontalTable> placeOnNodes(const c_atable_ptr_t &table, const std::vector<unsigned> &nodes);
+
+/// placeOnNodes on every numa node of the machine
+std::shared_ptr<HorizontalTable> placeOnAllNodes(const c_atable_ptr_t &table);
+
+} } // namespace hyrise::storage
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <iostream>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 #include "helper/checked_cast.h"
 #include "storage/BaseDictionary.h"
@@ -26,29 +28,63 @@ public:
 private:
   shared_vector_type _values;
 
+  // The sorted values, either the content of _values or external
+  // memory kept alive by _mapping
+  const T *_data;
+  size_t _size;
+  std::shared_ptr<void> _mapping;
+
+  void sync() {
+    _data = _values->data();
+    _size = _values->size();
+  }
+
+  // Copies mapped values before the dictionary is modified
+  void materialize() {
+    if (_mapping) {
+      _values->assign(_data, _data + _size);
+      _mapping.reset();
+      sync();
+    }
+  }
+
 protected:
 
   // This constructor is only used for copying purposes
   explicit OrderPreservingDictionary(vector_type values) {
-      _values = std::make_shared<vector_type>();
-      std::copy(values.begin(), values.end(), values->begin());
+      _values = std::make_shared<vector_type>(values);
+      sync();
   }
 
 public:
 
   OrderPreservingDictionary() {
     _values = std::make_shared<vector_type>();
+    sync();
   }
   
   explicit OrderPreservingDictionary(size_t size) {
     _values = std::make_shared<vector_type>();
     _values->reserve(size);
+    sync();
+  }
+
+  /**
+   * Dictionary over size sorted values in external memory, e.g. a
+   * memory mapped file, that is kept alive by mapping. The values are
+   * only copied if the dictionary is modified.
+   */
+  OrderPreservingDictionary(const T *values, size_t size, std::shared_ptr<void> mapping) :
+      _values(std::make_shared<vector_type>()), _data(values), _size(size), _mapping(mapping) {
+    static_assert(std::is_arithmetic<T>::value, "Only fixed width values can be mapped");
   }
 
   virtual ~OrderPreservingDictionary() {}
 
   void shrink() {
     _values->shrink_to_fit();
+    if (!_mapping)
+      sync();
   }
 
   /**
@@ -59,11 +95,13 @@ public:
    */
   value_id_t addValue(T value) {
 #ifdef EXPENSIVE_ASSERTIONS
-    if ((_values->size() > 0) && (value <= _values->back()))
+    if ((_size > 0) && (value <= _data[_size - 1]))
       throw std::runtime_error("Can't insert value smaller or equal to last value");
 #endif
+    materialize();
     _values->push_back(value);
-    return _values->size() - 1;
+    sync();
+    return _size - 1;
   }
 
   /**
@@ -74,61 +112,68 @@ public:
    */
   T getValueForValueId(value_id_t value_id) {
 #ifdef EXPENSIVE_ASSERTIONS
-    if (value_id >= _values->size())
+    if (value_id >= _size)
       throw std::out_of_range("Trying to access value_id larger than available values");
 #endif
-    return (*_values)[value_id];
+    return _data[value_id];
   }
       
   value_id_t getValueIdForValue(const T &value) const {
-    auto binary_search = std::lower_bound(_values->begin(), _values->end(), value);
-    size_t index = binary_search - _values->begin();
+    auto binary_search = std::lower_bound(_data, _data + _size, value);
+    size_t index = binary_search - _data;
     return index;
   }
 
   value_id_t getValueIdForValueSmaller(T other) {
-    auto binary_search = std::lower_bound(_values->begin(), _values->end(), other);
-    size_t index = binary_search - _values->begin();
+    auto binary_search = std::lower_bound(_data, _data + _size, other);
+    size_t index = binary_search - _data;
     
     assert(index > 0);
     return index - 1;
   }
 
   value_id_t getValueIdForValueGreater(T other) {
-    auto binary_search = std::upper_bound(_values->begin(), _values->end(), other);
-    size_t index = binary_search - _values->begin();
+    auto binary_search = std::upper_bound(_data, _data + _size, other);
+    size_t index = binary_search - _data;
     
     return index;
   }
 
   const T getSmallestValue() {
-    assert(_values->size() > 0);
-    return (*_values)[0];
+    assert(_size > 0);
+    return _data[0];
   }
     
   const T getGreatestValue() {
-    assert(_values->size() > 0);
-    return (*_values)[_values->size() - 1];
+    assert(_size > 0);
+    return _data[_size - 1];
   }
 
   bool isValueIdValid(value_id_t value_id) {
-    return value_id < _values->size();
+    return value_id < _size;
   }
 
   bool valueExists(const T &value) const {
-    return binary_search(_values->begin(), _values->end(), value);
+    return std::binary_search(_data, _data + _size, value);
   }
 
   void reserve(size_t size) {
+    materialize();
     _values->reserve(size);
+    sync();
   }
   
   size_t size() {
-    return _values->size();
+    return _size;
+  }
+
+  /// Whether the values are read from external memory
+  bool isMapped() const {
+    return static_cast<bool>(_mapping);
   }
 
   std::shared_ptr<AbstractDictionary> copy() {
-    throw std::runtime_error("Dictionaries cannot be copied");
+    return std::shared_ptr<AbstractDictionary>(new OrderPreservingDictionary<T>(vector_type(_data, _data + _size)));
   }
 
   std::shared_ptr<AbstractDictionary> copy_empty() {
@@ -142,11 +187,11 @@ public:
   typedef DictionaryIterator<T> iterator;
 
   iterator begin() {
-    return iterator(std::make_shared<OrderPreservingDictionaryIterator<T>>(_values, 0));
+    return iterator(std::make_shared<OrderPreservingDictionaryIterator<T>>(_data, 0));
   }
 
   iterator end() {
-    return iterator(std::make_shared<OrderPreservingDictionaryIterator<T>>(_values, _values->size()));
+    return iterator(std::make_shared<OrderPreservingDictionaryIterator<T>>(_data, _size));
   }
 
 };
@@ -160,16 +205,13 @@ public:
 template <typename T>
 class OrderPreservingDictionaryIterator : public BaseIterator<T> {
 
-  typedef OrderPreservingDictionary<T> dictionary_type;
-  typedef typename dictionary_type::shared_vector_type vector_type;
-
 public:
-  const vector_type& _values;
+  const T *_values;
   size_t _index;
 
-  explicit OrderPreservingDictionaryIterator(const vector_type& values): _values(values), _index(0) {}
+  explicit OrderPreservingDictionaryIterator(const T *values): _values(values), _index(0) {}
 
-  OrderPreservingDictionaryIterator(const vector_type& values, size_t index): _values(values), _index(index) {}
+  OrderPreservingDictionaryIterator(const T *values, size_t index): _values(values), _index(index) {}
 
   virtual ~OrderPreservingDictionaryIterator() { }
 
@@ -179,12 +221,12 @@ public:
 
   bool equal(const std::shared_ptr<BaseIterator<T>>& other) const {
     return
-        _values.get() == std::dynamic_pointer_cast<OrderPreservingDictionaryIterator<T>>(other)->_values.get() &&
+        _values == std::dynamic_pointer_cast<OrderPreservingDictionaryIterator<T>>(other)->_values &&
         _index  == std::dynamic_pointer_cast<OrderPreservingDictionaryIterator<T>>(other)->_index;
   }
 
   T &dereference() const {
-    return (*_values)[_index];
+    return const_cast<T &>(_values[_index]);
   }
 
   value_id_t getValueId() const {
@@ -0,0 +1,128 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ParallelHeapMerger.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "taskscheduler/ParallelTasks.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+// Rows per range, ranges need to start at multiples of 64 rows
+const size_t MIN_RANGE_SIZE = 64 * 1024;
+}
+
+ParallelHeapMerger::ParallelHeapMerger(size_t threads) : _threads(threads) {}
+
+size_t ParallelHeapMerger::parts() const {
+  return _threads == 0 ? taskscheduler::parallelWorkers() : _threads;
+}
+
+void ParallelHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
+                                     atable_ptr_t merged_table,
+                                     const column_mapping_t &column_mapping,
+                                     const uint64_t newSize,
+                                     bool useValid,
+                                     const std::vector<bool>& valid) {
+  const std::vector<std::pair<size_t, size_t> > columns(column_mapping.begin(), column_mapping.end());
+  std::vector<value_id_mapping_t> mappingPerAttribute(input_tables[0]->columnCount());
+
+  // one dictionary merge per column
+  parallelFor(columns.size(), [&] (size_t i) {
+      mergeDictionary(input_tables, columns[i].first, merged_table, columns[i].second,
+                      mappingPerAttribute[columns[i].first], useValid, valid);
+    });
+
+  merged_table->resize(newSize);
+
+  std::vector<size_t> offsets(1, 0);
+  for (const auto& table : input_tables)
+    offsets.push_back(offsets.back() + table->size());
+
+  // all columns of a row range are written by the same thread, since
+  // columns of the same partition share blocks
+  const auto ranges = splitRows(offsets.back(), newSize, useValid, valid);
+  parallelFor(ranges.size(), [&] (size_t i) {
+      for (const auto& column : columns)
+        copyValues(input_tables, offsets, ranges[i], column.first, merged_table, column.second,
+                   mappingPerAttribute[column.first], useValid, valid);
+    });
+}
+
+std::vector<ParallelHeapMerger::RowRange> ParallelHeapMerger::splitRows(size_t inputSize,
+                                                                        uint64_t newSize,
+                                                                        bool useValid,
+                                                                        const std::vector<bool>& valid) const {
+  size_t rangeSize = std::max(MIN_RANGE_SIZE, newSize / (parts() * 4));
+  rangeSize = (rangeSize + 63) / 64 * 64;
+
+  std::vector<RowRange> ranges;
+  if (!useValid) {
+    for (size_t begin = 0; begin < inputSize; begin += rangeSize)
+      ranges.push_back({begin, std::min(begin + rangeSize, inputSize), begin});
+    return ranges;
+  }
+
+  // split where the number of valid rows reaches a multiple of the range size
+  RowRange current {0, 0, 0};
+  size_t written = 0;
+  for (size_t row = 0; row < inputSize; ++row) {
+    if (!valid[row])
+      continue;
+    if (written > 0 && written % rangeSize == 0) {
+      current.end = row;
+      ranges.push_back(current);
+      current = {row, row, written};
+    }
+    ++written;
+  }
+  current.end = inputSize;
+  ranges.push_back(current);
+  return ranges;
+}
+
+void ParallelHeapMerger::copyValues(const std::vector<c_atable_ptr_t > &input_tables,
+                                    const std::vector<size_t> &offsets,
+                                    const RowRange &range,
+                                    size_t source_column_index,
+                                    atable_ptr_t &merged_table,
+                                    size_t destination_column_index,
+                                    const value_id_mapping_t &value_id_mapping,
+                                    bool useValid,
+                                    const std::vector<bool>& valid) {
+  ValueId value_id;
+  size_t merged_table_row = range.destination;
+
+  // the input tables overlapping with the range
+  auto table = std::upper_bound(offsets.begin(), offsets.end(), range.begin) - offsets.begin() - 1;
+  for (size_t position = range.begin; position < range.end; ++table) {
+    const auto& input = input_tables[table];
+    const size_t stop = std::min(range.end, offsets[table + 1]);
+    // no dict columns have no mapping, their value ids are copied
+    const std::vector<value_id_t> *mapping = value_id_mapping.empty() ? nullptr : &value_id_mapping[table];
+    for (; position < stop; ++position) {
+      if (useValid && !valid[position])
+        continue;
+      value_id.valueId = input->getValueId(source_column_index, position - offsets[table]).valueId;
+      if (mapping != nullptr)
+        value_id.valueId = (*mapping)[value_id.valueId];
+      merged_table->setValueId(destination_column_index, merged_table_row++, value_id);
+    }
+  }
+}
+
+void ParallelHeapMerger::parallelFor(size_t count, const std::function<void(size_t)> &job) const {
+  std::atomic<size_t> next(0);
+  taskscheduler::runParallel(std::min(parts(), count), [&] (size_t) {
+    for (size_t i = next++; i < count; i = next++)
+      job(i);
+  });
+}
+
+AbstractMerger *ParallelHeapMerger::copy() {
+  return new ParallelHeapMerger(_threads);
+}
+
+} } // namespace hyrise::storage
@@ -0,0 +1,66 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <functional>
+
+#include <storage/SequentialHeapMerger.h>
+
+namespace hyrise {
+namespace storage {
+
+/*
+  Heap merger that runs on the workers of the shared scheduler. The
+  dictionaries of different columns are merged concurrently, afterwards
+  the value ids are translated and written to the merged table in row
+  ranges. Row ranges start at multiples of 64 rows, so that no two
+  workers write to the same block of a bit compressed vector. Stores
+  merge with the SequentialHeapMerger unless this merger is selected
+  with Store::setMerger().
+ */
+class ParallelHeapMerger : public SequentialHeapMerger {
+public:
+
+  /// Splits the work into `threads` parts, or one per worker of the
+  /// shared scheduler if it is 0
+  explicit ParallelHeapMerger(size_t threads = 0);
+
+  virtual void mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
+                           atable_ptr_t merged_table,
+                           const column_mapping_t &column_mapping,
+                           const uint64_t newSize,
+                           bool useValid = false,
+                           const std::vector<bool>& valid = std::vector<bool>());
+  virtual AbstractMerger *copy();
+
+private:
+
+  // Rows of the input tables, as positions in all input tables, that
+  // are written to the merged table starting at destination
+  struct RowRange {
+    size_t begin;
+    size_t end;
+    size_t destination;
+  };
+
+  std::vector<RowRange> splitRows(size_t inputSize, uint64_t newSize, bool useValid, const std::vector<bool>& valid) const;
+
+  void copyValues(const std::vector<c_atable_ptr_t > &input_tables,
+                  const std::vector<size_t> &offsets,
+                  const RowRange &range,
+                  size_t source_column_index,
+                  atable_ptr_t &merged_table,
+                  size_t destination_column_index,
+                  const value_id_mapping_t &value_id_mapping,
+                  bool useValid,
+                  const std::vector<bool>& valid);
+
+  /// Number of parts the work is split into
+  size_t parts() const;
+
+  /// Runs job(0) ... job(count - 1) in up to parts() scheduler tasks
+  void parallelFor(size_t count, const std::function<void(size_t)> &job) const;
+
+  size_t _threads;
+};
+
+} } // namespace hyrise::storage
@@ -17,7 +17,7 @@ namespace hyrise {
 namespace storage {
 
 template <typename T>
-T* copy_vec(T* orig) {
+T* copy_vec(const T* orig) {
   if (orig == nullptr) return nullptr;
   return new T(begin(*orig), end(*orig));
 }
@@ -29,10 +29,10 @@ void PointerCalculator::unnest() {
   if (auto p = std::dynamic_pointer_cast<const PointerCalculator>(table)) {
 
     // if our actual table is a PC, we have to unfold the positions
-    if (pos_list != nullptr && p->pos_list != nullptr) {
+    if (pos_list != nullptr && (p->pos_list != nullptr || p->_position_set)) {
       auto tmp_list = new pos_list_t(pos_list->size());
       std::transform(std::begin(*(pos_list)), std::end(*(pos_list)), std::begin(*tmp_list), [p](const pos_t& i) -> pos_t {
-	  return p->pos_list->at(i);
+	  return p->positionAt(i);
 	});
       table = p->table;
       std::swap(pos_list, tmp_list);
@@ -66,12 +66,16 @@ PointerCalculator::PointerCalculator(c_atable_ptr_t t, pos_list_t *pos, field_li
   updateFieldMapping();
 }
 
-PointerCalculator::PointerCalculator(const PointerCalculator& other) : table(other.table), pos_list(copy_vec(other.pos_list)), fields(copy_vec(other.fields)) {
+PointerCalculator::PointerCalculator(const PointerCalculator& other) : table(other.table), pos_list(copy_vec(other.getPositions())), fields(copy_vec(other.fields)) {
+  if (other._position_set) {
+    _position_set = make_unique<PositionSet>(*other._position_set);
+    _materialized = pos_list != nullptr;
+  }
   updateFieldMapping();
 }
 
 atable_ptr_t PointerCalculator::copy() const {
-  return create(table, fields, pos_list);
+  return create(*this);
 }
 
 PointerCalculator::PointerCalculator(c_atable_ptr_t t, pos_list_t pos) : table(t), pos_list(new pos_list_t(std::move(pos))) {
@@ -79,6 +83,20 @@ PointerCalculator::PointerCalculator(c_atable_ptr_t t, pos_list_t pos) : table(t
   updateFieldMapping();
 }
 
+PointerCalculator::PointerCalculator(c_atable_ptr_t t, PositionSet positions, field_list_t *f) : table(t), pos_list(nullptr), fields(f) {
+  // position lists and positions relative to other views are kept as
+  // plain lists
+  if (positions.kind() == PositionSet::LIST ||
+      std::dynamic_pointer_cast<const PointerCalculator>(table) ||
+      std::dynamic_pointer_cast<const TableRangeView>(table)) {
+    pos_list = new pos_list_t(positions.releaseList());
+  } else {
+    _position_set = make_unique<PositionSet>(std::move(positions));
+  }
+  unnest();
+  updateFieldMapping();
+}
+
 PointerCalculator::~PointerCalculator() {
   delete fields;
   delete pos_list;
@@ -128,7 +146,8 @@ void PointerCalculator::updateFieldMapping() {
 void PointerCalculator::setPositions(const pos_list_t pos) {
   if (pos_list != nullptr)
     delete pos_list;
-  pos_list = new std::vector<pos_t>(pos);
+  pos_list = new pos_list_t(pos);
+  _position_set.reset();
 }
 
 void PointerCalculator::setFields(const field_list_t f) {
@@ -170,8 +189,8 @@ const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryAt(const
     actual_column = column;
   }
 
-  if (pos_list && pos_list->size() > 0) {
-    actual_row = pos_list->at(row);
+  if ((pos_list || _position_set) && size() > 0) {
+    actual_row = positionAt(row);
   } else {
     actual_row = row;
   }
@@ -192,6 +211,10 @@ const AbstractTable::SharedDictionaryPtr& PointerCalculator::dictionaryByTableId
 }
 
 size_t PointerCalculator::size() const {
+  if (_position_set) {
+    return _position_set->size();
+  }
+
   if (pos_list) {
     return pos_list->size();
   }
@@ -208,13 +231,7 @@ size_t PointerCalculator::columnCount() const {
 }
 
 ValueId PointerCalculator::getValueId(const size_t column, const size_t row) const {
-  size_t actual_column, actual_row;
-
-  if (pos_list) {
-    actual_row = pos_list->at(row);
-  } else {
-    actual_row = row;
-  }
+  size_t actual_column;
 
   if (fields) {
     actual_column = fields->at(column);
@@ -222,7 +239,7 @@ ValueId PointerCalculator::getValueId(const size_t column, const size_t row) con
     actual_column = column;
   }
 
-  return table->getValueId(actual_column, actual_row);
+  return table->getValueId(actual_column, positionAt(row));
 }
 
 unsigned PointerCalculator::partitionCount() const {
@@ -245,13 +262,8 @@ void PointerCalculator::print(const size_t limit) const {
 
 size_t PointerCalculator::getTableRowForRow(const size_t row) const
 {
-  size_t actual_row;
   // resolve mapping of THIS pointer calculator
-  if (pos_list) {
-    actual_row = pos_list->at(row);
-  } else {
-    actual_row = row;
-  }
+  size_t actual_row = positionAt(row);
   // if underlying table is PointerCalculator, resolve recursively
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(table);
   if (p)
@@ -290,12 +302,45 @@ c_atable_ptr_t PointerCalculator::getActualTable() const {
   }
 }
 
+pos_t PointerCalculator::positionAt(const size_t row) const {
+  // ranges and bitmaps are accessed without materializing a list
+  if (_position_set) {
+    return _position_set->at(row);
+  }
+
+  if (pos_list) {
+    return pos_list->at(row);
+  }
+
+  return row;
+}
+
 const pos_list_t *PointerCalculator::getPositions() const {
+  if (_position_set && !_materialized.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(_materialize_mutex);
+    if (!_materialized.load(std::memory_order_relaxed)) {
+      pos_list = new pos_list_t(_position_set->materialize());
+      _materialized.store(true, std::memory_order_release);
+    }
+  }
   return pos_list;
 }
 
+PositionSet PointerCalculator::getPositionSet() const {
+  if (_position_set) {
+    return *_position_set;
+  }
+
+  if (pos_list) {
+    return PositionSet::fromSorted(*pos_list);
+  }
+
+  return PositionSet::range(0, table->size());
+}
+
 pos_list_t PointerCalculator::getActualTablePositions() const {
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(table);
+  const auto pos_list = getPositions();
 
   if (!p) {
     return *pos_list;
@@ -345,17 +390,8 @@ atable_ptr_t PointerCalculator::copy_structure(const field_list_t *fields, const
 }
 
 std::shared_ptr<PointerCalculator> PointerCalculator::intersect(const std::shared_ptr<const PointerCalculator>& other) const {
-  pos_list_t *result = new pos_list_t();
-  result->reserve(std::max(pos_list->size(), other->pos_list->size()));
-  assert(std::is_sorted(begin(*pos_list), end(*pos_list)) && std::is_sorted(begin(*other->pos_list), end(*other->pos_list)) && "Both lists have to be sorted");
-  
-  intersect_pos_list(
-    pos_list->begin(), pos_list->end(),
-    other->pos_list->begin(), other->pos_list->end(),
-    std::back_inserter(*result));
-
   assert((other->table == this->table) && "Should point to same table");
-  return create(table, result, fields);
+  return create(table, getPositionSet().intersect(other->getPositionSet()), copy_vec(fields));
 }
 
 
@@ -374,18 +410,12 @@ std::shared_ptr<const PointerCalculator> PointerCalculator::intersect_many(pc_ve
 
 std::shared_ptr<PointerCalculator> PointerCalculator::unite(const std::shared_ptr<const PointerCalculator>& other) const {
   assert((other->table == this->table) && "Should point to same table");
-  if (pos_list && other->pos_list) {
-    auto result = new pos_list_t();
-    result->reserve(pos_list->size() + other->pos_list->size());
-    assert(std::is_sorted(begin(*pos_list), end(*pos_list)) && std::is_sorted(begin(*other->pos_list), end(*other->pos_list)) && "Both lists have to be sorted");
-    std::set_union(pos_list->begin(), pos_list->end(),
-                   other->pos_list->begin(), other->pos_list->end(),
-                   std::back_inserter(*result));
-    return create(table, result, copy_vec(fields));
+  if ((pos_list || _position_set) && (other->pos_list || other->_position_set)) {
+    return create(table, getPositionSet().unite(other->getPositionSet()), copy_vec(fields));
   } else {
-    pos_list_t* positions = nullptr;
-    if (pos_list == nullptr) { positions = other->pos_list; }
-    if (other->pos_list == nullptr) { positions = pos_list; }
+    const pos_list_t* positions = nullptr;
+    if (pos_list == nullptr && !_position_set) { positions = other->getPositions(); }
+    if (other->pos_list == nullptr && !other->_position_set) { positions = getPositions(); }
     return create(table, copy_vec(positions), copy_vec(fields));
   }
 }
@@ -411,7 +441,7 @@ std::shared_ptr<PointerCalculator> PointerCalculator::concatenate_many(pc_vector
 
   c_atable_ptr_t table = nullptr;
   for (;it != it_end; ++it) {
-    const auto& pl = (*it)->pos_list;
+    const auto& pl = (*it)->getPositions();
     if (table == nullptr) {
       table = (*it)->table;
     }
@@ -436,14 +466,18 @@ void PointerCalculator::debugStructure(size_t level) const {
 
 void PointerCalculator::validate(tx::transaction_id_t tid, tx::transaction_id_t cid) {
   const auto& store = checked_pointer_cast<const Store>(table);
-  if (pos_list == nullptr) {
+  if (pos_list == nullptr && !_position_set) {
     pos_list = new pos_list_t(store->buildValidPositions(cid, tid));
   } else {
+    getPositions();
+    _position_set.reset();
     store->validatePositions(*pos_list, cid, tid);
   }
 }
 
 void PointerCalculator::remove(const pos_list_t& pl) {
+  getPositions();
+  _position_set.reset();
   std::unordered_set<pos_t> tmp(pl.begin(), pl.end());
   const auto& end = tmp.cend();
   auto res = std::remove_if(std::begin(*pos_list), std::end(*pos_list),[&tmp, &end](const pos_t& p){
@@ -1,14 +1,17 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "helper/types.h"
 #include "helper/SharedFactory.h"
 
 #include "storage/AbstractTable.h"
 #include "storage/MutableVerticalTable.h"
+#include "storage/PositionSet.h"
 
 namespace hyrise {
 namespace storage {
@@ -21,6 +24,11 @@ class PointerCalculator : public AbstractTable,
   */
   void unnest();
 
+  /**
+  * Position of the given row in the underlying table
+  */
+  pos_t positionAt(const size_t row) const;
+
 public:
 
   PointerCalculator(c_atable_ptr_t t, pos_list_t *pos = nullptr, field_list_t *f = nullptr);
@@ -28,6 +36,12 @@ public:
   
   PointerCalculator(c_atable_ptr_t t, pos_list_t pos);
 
+  /**
+  * Keeps ranges and bitmaps as they are; the position list is only
+  * materialized once it is requested through getPositions()
+  */
+  PointerCalculator(c_atable_ptr_t t, PositionSet positions, field_list_t *f = nullptr);
+
   virtual ~PointerCalculator();
 
   void setPositions(const pos_list_t pos);
@@ -44,6 +58,24 @@ public:
   static bool isSmaller( std::shared_ptr<const PointerCalculator> lx, std::shared_ptr<const PointerCalculator> rx );
 
   const pos_list_t *getPositions() const;
+
+  /// Positions as a set, all rows of the table if there is no position
+  /// list; the positions have to be sorted
+  PositionSet getPositionSet() const;
+
+  /// Calls fun for every position without materializing a position list
+  template <typename F>
+  void forEachPosition(F fun) const {
+    if (_position_set) {
+      _position_set->forEach(fun);
+    } else if (pos_list) {
+      for (const auto& pos : *pos_list)
+        fun(pos);
+    } else {
+      for (pos_t pos = 0, rows = table->size(); pos < rows; ++pos)
+        fun(pos);
+    }
+  }
   pos_list_t getActualTablePositions() const;
 
   size_t getTableRowForRow(const size_t row) const;
@@ -87,9 +119,14 @@ public:
   void updateFieldMapping();
  private:
   c_atable_ptr_t table;
-  pos_list_t *pos_list;
+  mutable pos_list_t *pos_list;
   field_list_t *fields;
 
+  // Compressed positions, pos_list is materialized from them on demand
+  std::unique_ptr<PositionSet> _position_set;
+  mutable std::atomic<bool> _materialized {false};
+  mutable std::mutex _materialize_mutex;
+
   // Vector mapping the renaed field names
   std::unique_ptr<std::vector<ColumnMetadata>> _renamed;
 
@@ -0,0 +1,349 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/PositionSet.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "helper/PositionsIntersect.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace hyrise {
+namespace storage {
+
+const size_t PositionSet::RANK_BLOCK;
+
+namespace {
+
+inline pos_t alignDown(pos_t pos) {
+  return pos & ~pos_t(63);
+}
+
+inline size_t wordsBetween(pos_t base, pos_t last) {
+  return (last - base + 63) / 64;
+}
+
+// out[i] &= in[i] for count words
+void andWords(uint64_t *out, const uint64_t *in, size_t count) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 4 <= count; i += 4) {
+    auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(out + i));
+    auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_and_si256(a, b));
+  }
+#elif defined(__SSE4_1__)
+  for (; i + 2 <= count; i += 2) {
+    auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(out + i));
+    auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_and_si128(a, b));
+  }
+#endif
+  for (; i < count; ++i)
+    out[i] &= in[i];
+}
+
+// out[i] |= in[i] for count words
+void orWords(uint64_t *out, const uint64_t *in, size_t count) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 4 <= count; i += 4) {
+    auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(out + i));
+    auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_or_si256(a, b));
+  }
+#elif defined(__SSE4_1__)
+  for (; i + 2 <= count; i += 2) {
+    auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(out + i));
+    auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_or_si128(a, b));
+  }
+#endif
+  for (; i < count; ++i)
+    out[i] |= in[i];
+}
+
+// Mask of the bits of word `index` of a bitmap starting at base that
+// belong to the positions [first, last)
+inline uint64_t rangeMask(pos_t base, size_t index, pos_t first, pos_t last) {
+  const pos_t wordFirst = base + index * 64;
+  if (last <= wordFirst || first >= wordFirst + 64)
+    return 0;
+  uint64_t mask = ~0ull;
+  if (first > wordFirst)
+    mask &= ~0ull << (first - wordFirst);
+  if (last < wordFirst + 64)
+    mask &= ~0ull >> (wordFirst + 64 - last);
+  return mask;
+}
+
+// Bitmaps are used if they are not larger than the list of positions
+inline bool prefersBitmap(size_t size, pos_t first, pos_t last) {
+  return size * 64 >= last - first;
+}
+
+}  // namespace
+
+PositionSet::PositionSet() : _kind(LIST), _size(0), _first(0), _last(0), _base(0) {}
+
+PositionSet PositionSet::range(pos_t first, pos_t last) {
+  PositionSet result;
+  if (first < last) {
+    result._kind = RANGE;
+    result._size = last - first;
+    result._first = first;
+    result._last = last;
+  }
+  return result;
+}
+
+PositionSet PositionSet::fromSorted(pos_list_t positions) {
+  if (positions.empty())
+    return PositionSet();
+
+  const pos_t first = positions.front(), last = positions.back() + 1;
+  if (positions.size() == last - first)
+    return range(first, last);
+
+  if (prefersBitmap(positions.size(), first, last)) {
+    PositionSet result;
+    result._kind = BITMAP;
+    result._size = positions.size();
+    result._first = first;
+    result._last = last;
+    result._base = alignDown(first);
+    result._words.assign(wordsBetween(result._base, last), 0);
+    for (const auto& pos : positions)
+      result._words[(pos - result._base) / 64] |= 1ull << ((pos - result._base) % 64);
+    result.buildRanks();
+    return result;
+  }
+
+  PositionSet result;
+  result._size = positions.size();
+  result._first = first;
+  result._last = last;
+  result._list = std::move(positions);
+  return result;
+}
+
+PositionSet PositionSet::fromBitmap(pos_t base, std::vector<uint64_t> words) {
+  if (base != alignDown(base))
+    throw std::runtime_error("PositionSet::fromBitmap needs a base that is a multiple of 64");
+  size_t begin = 0, end = words.size();
+  while (begin < end && words[begin] == 0)
+    ++begin;
+  while (end > begin && words[end - 1] == 0)
+    --end;
+  if (begin == end)
+    return PositionSet();
+
+  size_t size = 0;
+  for (size_t i = begin; i < end; ++i)
+    size += __builtin_popcountll(words[i]);
+
+  const pos_t first = base + begin * 64 + __builtin_ctzll(words[begin]);
+  const pos_t last = base + end * 64 - __builtin_clzll(words[end - 1]);
+  if (size == last - first)
+    return range(first, last);
+
+  PositionSet result;
+  result._kind = BITMAP;
+  result._size = size;
+  result._first = first;
+  result._last = last;
+  result._base = base + begin * 64;
+  if (begin > 0)
+    std::copy(words.begin() + begin, words.begin() + end, words.begin());
+  words.resize(end - begin);
+  result._words = std::move(words);
+
+  if (!prefersBitmap(size, first, last))
+    return fromSorted(result.materialize());
+  result.buildRanks();
+  return result;
+}
+
+void PositionSet::buildRanks() {
+  _ranks.resize((_words.size() + RANK_BLOCK - 1) / RANK_BLOCK);
+  size_t rank = 0;
+  for (size_t i = 0; i < _words.size(); ++i) {
+    if (i % RANK_BLOCK == 0)
+      _ranks[i / RANK_BLOCK] = rank;
+    rank += __builtin_popcountll(_words[i]);
+  }
+}
+
+size_t PositionSet::memorySize() const {
+  return _words.size() * sizeof(uint64_t) + _ranks.size() * sizeof(size_t) + _list.size() * sizeof(pos_t);
+}
+
+bool PositionSet::contains(pos_t pos) const {
+  switch (_kind) {
+    case RANGE:
+      return _first <= pos && pos < _last;
+    case BITMAP:
+      return _first <= pos && pos < _last && (_words[(pos - _base) / 64] >> ((pos - _base) % 64)) & 1;
+    case LIST:
+      return std::binary_search(_list.begin(), _list.end(), pos);
+  }
+  return false;
+}
+
+pos_t PositionSet::at(size_t index) const {
+  switch (_kind) {
+    case RANGE:
+      return _first + index;
+    case BITMAP: {
+      // last block in front of the position, then the word holding it
+      const size_t block = std::upper_bound(_ranks.begin(), _ranks.end(), index) - _ranks.begin() - 1;
+      size_t remaining = index - _ranks[block];
+      size_t i = block * RANK_BLOCK;
+      for (size_t count; remaining >= (count = __builtin_popcountll(_words[i])); ++i)
+        remaining -= count;
+      uint64_t word = _words[i];
+      for (; remaining > 0; --remaining)
+        word &= word - 1;
+      return _base + i * 64 + __builtin_ctzll(word);
+    }
+    case LIST:
+      return _list[index];
+  }
+  return 0;
+}
+
+void PositionSet::orInto(pos_t base, uint64_t *words, size_t count) const {
+  switch (_kind) {
+    case RANGE: {
+      const size_t firstWord = _first > base ? (_first - base) / 64 : 0;
+      for (size_t i = firstWord; i < count; ++i) {
+        const auto mask = rangeMask(base, i, _first, _last);
+        if (mask == 0 && base + i * 64 >= _last)
+          break;
+        words[i] |= mask;
+      }
+      break;
+    }
+    case BITMAP: {
+      // both bitmaps are aligned to 64 rows
+      const pos_t from = std::max(base, _base);
+      const pos_t to = std::min(base + count * 64, _base + _words.size() * 64);
+      if (from < to)
+        orWords(words + (from - base) / 64, _words.data() + (from - _base) / 64, (to - from) / 64);
+      break;
+    }
+    case LIST:
+      for (const auto& pos : _list) {
+        if (pos >= base && pos < base + count * 64)
+          words[(pos - base) / 64] |= 1ull << ((pos - base) % 64);
+      }
+      break;
+  }
+}
+
+void PositionSet::andInto(pos_t base, uint64_t *words, size_t count) const {
+  switch (_kind) {
+    case RANGE:
+      for (size_t i = 0; i < count; ++i)
+        words[i] &= rangeMask(base, i, _first, _last);
+      break;
+    case BITMAP: {
+      const pos_t from = std::max(base, _base);
+      const pos_t to = std::min(base + count * 64, _base + _words.size() * 64);
+      if (from >= to) {
+        std::fill(words, words + count, 0);
+        break;
+      }
+      std::fill(words, words + (from - base) / 64, 0);
+      andWords(words + (from - base) / 64, _words.data() + (from - _base) / 64, (to - from) / 64);
+      std::fill(words + (to - base) / 64, words + count, 0);
+      break;
+    }
+    case LIST:
+      throw std::runtime_error("PositionSet::andInto is not defined for position lists");
+  }
+}
+
+PositionSet PositionSet::intersect(const PositionSet &other) const {
+  if (empty() || other.empty())
+    return PositionSet();
+
+  const pos_t first = std::max(_first, other._first);
+  const pos_t last = std::min(_last, other._last);
+
+  if (_kind == LIST || other._kind == LIST) {
+    const auto& list = _kind == LIST ? *this : other;
+    const auto& set = _kind == LIST ? other : *this;
+    pos_list_t result;
+    if (set._kind == LIST) {
+      intersect_pos_list(list._list.begin(), list._list.end(),
+                         set._list.begin(), set._list.end(),
+                         std::back_inserter(result));
+    } else {
+      std::copy_if(list._list.begin(), list._list.end(), std::back_inserter(result),
+                   [&set] (const pos_t& pos) { return set.contains(pos); });
+    }
+    return fromSorted(std::move(result));
+  }
+
+  if (first >= last)
+    return PositionSet();
+  if (_kind == RANGE && other._kind == RANGE)
+    return range(first, last);
+
+  const pos_t base = alignDown(first);
+  std::vector<uint64_t> words(wordsBetween(base, last), 0);
+  orInto(base, words.data(), words.size());
+  other.andInto(base, words.data(), words.size());
+  return fromBitmap(base, std::move(words));
+}
+
+PositionSet PositionSet::unite(const PositionSet &other) const {
+  if (empty())
+    return other;
+  if (other.empty())
+    return *this;
+
+  const pos_t first = std::min(_first, other._first);
+  const pos_t last = std::max(_last, other._last);
+
+  if (_kind == RANGE && other._kind == RANGE && _first <= other._last && other._first <= _last)
+    return range(first, last);
+
+  if (_kind == LIST && other._kind == LIST) {
+    pos_list_t result;
+    result.reserve(_list.size() + other._list.size());
+    std::set_union(_list.begin(), _list.end(),
+                   other._list.begin(), other._list.end(),
+                   std::back_inserter(result));
+    return fromSorted(std::move(result));
+  }
+
+  const pos_t base = alignDown(first);
+  std::vector<uint64_t> words(wordsBetween(base, last), 0);
+  orInto(base, words.data(), words.size());
+  other.orInto(base, words.data(), words.size());
+  return fromBitmap(base, std::move(words));
+}
+
+pos_list_t PositionSet::materialize() const {
+  if (_kind == LIST)
+    return _list;
+  pos_list_t result;
+  result.reserve(_size);
+  forEach([&result] (pos_t pos) { result.push_back(pos); });
+  return result;
+}
+
+pos_list_t PositionSet::releaseList() {
+  pos_list_t result = _kind == LIST ? std::move(_list) : materialize();
+  *this = PositionSet();
+  return result;
+}
+
+} } // namespace hyrise::storage
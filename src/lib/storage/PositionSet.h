@@ -0,0 +1,110 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+  Sorted set of distinct row positions in one of three representations:
+  a range of consecutive rows, a bitmap over the rows between the first
+  and the last position, or a plain list. The representation is chosen
+  by density whenever a set is built, a bitmap is used as soon as it is
+  not larger than the list of 64 bit positions, i.e. if at least every
+  64th row of the span is part of the set.
+
+  Intersections and unions of bitmaps and ranges work on whole words
+  with the instruction set the library was compiled for, sets can be
+  iterated with forEach() without materializing a position list.
+ */
+class PositionSet {
+ public:
+  enum Kind { RANGE, BITMAP, LIST };
+
+  /// Empty set
+  PositionSet();
+
+  /// Rows [first, last)
+  static PositionSet range(pos_t first, pos_t last);
+
+  /// Set of the given sorted and distinct positions
+  static PositionSet fromSorted(pos_list_t positions);
+
+  /// Set of the rows base + i for every bit i set in words, base has to
+  /// be a multiple of 64
+  static PositionSet fromBitmap(pos_t base, std::vector<uint64_t> words);
+
+  Kind kind() const { return _kind; }
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  /// Smallest position of a non-empty set
+  pos_t front() const { return _first; }
+
+  /// Bytes used by the representation
+  size_t memorySize() const;
+
+  bool contains(pos_t pos) const;
+
+  /// Position number index in ascending order, index < size(). Bitmaps
+  /// find it through the counts of set bits of their blocks instead of
+  /// materializing a list
+  pos_t at(size_t index) const;
+
+  PositionSet intersect(const PositionSet &other) const;
+  PositionSet unite(const PositionSet &other) const;
+
+  /// Calls fun for all positions in ascending order
+  template <typename F>
+  void forEach(F fun) const {
+    switch (_kind) {
+      case RANGE:
+        for (pos_t pos = _first; pos < _last; ++pos)
+          fun(pos);
+        break;
+      case BITMAP:
+        for (size_t i = 0; i < _words.size(); ++i) {
+          for (uint64_t word = _words[i]; word != 0; word &= word - 1)
+            fun(_base + i * 64 + __builtin_ctzll(word));
+        }
+        break;
+      case LIST:
+        for (const auto& pos : _list)
+          fun(pos);
+        break;
+    }
+  }
+
+  pos_list_t materialize() const;
+
+  /// Moves the positions out of a set of kind LIST
+  pos_list_t releaseList();
+
+ private:
+  // sets the bits of all positions in [base, base + 64 * count) in words
+  void orInto(pos_t base, uint64_t *words, size_t count) const;
+  // clears the bits of all positions in [base, base + 64 * count) in
+  // words that are not part of this set, the set must not be a LIST
+  void andInto(pos_t base, uint64_t *words, size_t count) const;
+  // counts the set bits in front of every block of RANK_BLOCK words
+  void buildRanks();
+
+  static const size_t RANK_BLOCK = 8;
+
+  Kind _kind;
+  size_t _size;
+  // first and one behind the last position
+  pos_t _first;
+  pos_t _last;
+  // position of the first bit of the bitmap, a multiple of 64
+  pos_t _base;
+  std::vector<uint64_t> _words;
+  std::vector<size_t> _ranks;
+  pos_list_t _list;
+};
+
+} } // namespace hyrise::storage
@@ -103,9 +103,10 @@ void PrettyPrinter::special_print(const Store* store, std::ostream& outStream, c
     for (size_t column = 0; column < columns; ++column) {
       tp << generateValue(store, column, row);
     }
-    writeTid(tp, store->_tidVector[row]);
-    writeCid(tp, store->_cidBeginVector[row]);
-    writeCid(tp, store->_cidEndVector[row]);
+    const auto version = store->version(row);
+    writeTid(tp, version.tid);
+    writeCid(tp, version.begin);
+    writeCid(tp, version.end);
   }
   tp.printFooter();
 }
@@ -23,34 +23,8 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input
 
   std::vector<value_id_mapping_t> mappingPerAtrtibute(input_tables[0]->columnCount());
 
-  for (const auto & kv: column_mapping) {
-    const auto &source = kv.first;
-    const auto &destination = kv.second;
-    switch (merged_table->metadataAt(destination).getType()) {
-    case IntegerType:
-    case IntegerTypeDelta:
-    case IntegerTypeDeltaConcurrent:
-      mergeValues<hyrise_int_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-    break;
-    
-    case FloatType:
-    case FloatTypeDelta:
-    case FloatTypeDeltaConcurrent:
-      mergeValues<hyrise_float_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-      break;
-      
-    case StringType:
-    case StringTypeDelta:
-    case StringTypeDeltaConcurrent:
-      mergeValues<hyrise_string_t>(input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-      break;
-    case IntegerNoDictType:
-    case FloatNoDictType:
-      merged_table->setDictionaryAt(makeDictionary(merged_table->typeOfColumn(destination)), destination);
-    default:
-      break;
-    }
-  }
+  for (const auto & kv: column_mapping)
+    mergeDictionary(input_tables, kv.first, merged_table, kv.second, mappingPerAtrtibute[kv.first], useValid, valid);
 
   merged_table->resize(newSize);
 
@@ -63,6 +37,39 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input
   }
 }
 
+void SequentialHeapMerger::mergeDictionary(const std::vector<c_atable_ptr_t > &input_tables,
+                                           size_t source_column_index,
+                                           atable_ptr_t merged_table,
+                                           size_t destination_column_index,
+                                           value_id_mapping_t &mapping,
+                                           bool useValid,
+                                           const std::vector<bool>& valid) {
+  switch (merged_table->metadataAt(destination_column_index).getType()) {
+  case IntegerType:
+  case IntegerTypeDelta:
+  case IntegerTypeDeltaConcurrent:
+    mergeValues<hyrise_int_t>(input_tables, source_column_index, merged_table, destination_column_index, mapping, useValid, valid);
+  break;
+  
+  case FloatType:
+  case FloatTypeDelta:
+  case FloatTypeDeltaConcurrent:
+    mergeValues<hyrise_float_t>(input_tables, source_column_index, merged_table, destination_column_index, mapping, useValid, valid);
+    break;
+    
+  case StringType:
+  case StringTypeDelta:
+  case StringTypeDeltaConcurrent:
+    mergeValues<hyrise_string_t>(input_tables, source_column_index, merged_table, destination_column_index, mapping, useValid, valid);
+    break;
+  case IntegerNoDictType:
+  case FloatNoDictType:
+    merged_table->setDictionaryAt(makeDictionary(merged_table->typeOfColumn(destination_column_index)), destination_column_index);
+  default:
+    break;
+  }
+}
+
 template <typename T>
 void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
                                        size_t source_column_index,
@@ -19,10 +19,26 @@ public:
                            const std::vector<bool>& valid = std::vector<bool>());
   virtual AbstractMerger *copy();
 
-private:
+protected:
 
   typedef std::vector<std::vector<value_id_t> > value_id_mapping_t;
 
+  /*
+    Merges the dictionaries of one column into the dictionary of the
+    destination column and stores the translation of the value ids of
+    each input table in mapping, which stays empty for columns without
+    dictionary.
+   */
+  void mergeDictionary(const std::vector<c_atable_ptr_t > &input_tables,
+                       size_t source_column_index,
+                       atable_ptr_t merged_table,
+                       size_t destination_column_index,
+                       value_id_mapping_t &mapping,
+                       bool useValid,
+                       const std::vector<bool>& valid);
+
+private:
+
   template <typename T>
   void mergeValues(const std::vector<c_atable_ptr_t > &input_tables,
                    size_t source_column_index,
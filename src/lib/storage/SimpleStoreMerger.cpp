@@ -54,9 +54,8 @@ struct MergeDictFunctor {
     }
       
 
-    size_t dictSize = dict->size();
-    for(size_t i=0; i < dictSize; ++i)
-      data.insert(dict->getValueForValueId(i));
+    for(auto it = dict->begin(), dictEnd = dict->end(); it != dictEnd; ++it)
+      data.insert(*it);
 
     // Build mapping table for old dictionary
     auto start = data.cbegin();
@@ -65,8 +64,8 @@ struct MergeDictFunctor {
     
     std::vector<value_id_t> mapping;
 
-    for(size_t i=0; i < dictSize; ++i) {
-      auto val = dict->getValueForValueId(i);
+    for(auto it = dict->begin(), dictEnd = dict->end(); it != dictEnd; ++it) {
+      const auto& val = *it;
 
       // Skip until we are equal
       while(start != end && *start != val) {
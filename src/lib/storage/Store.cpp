@@ -1,6 +1,10 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <storage/Store.h>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <thread>
 
 #include <io/TransactionManager.h>
 #include <storage/storage_types.h>
@@ -10,19 +14,44 @@
 #include <helper/vector_helpers.h>
 #include <helper/locking.h>
 #include <helper/cas.h>
+#include <helper/checked_cast.h>
+#include <helper/Epochs.h>
 
 #include "storage/DictionaryFactory.h"
+#include "storage/FrontCodedDictionary.h"
+#include "storage/SequentialHeapMerger.h"
+#include "storage/TableRangeView.h"
 #include "storage/ConcurrentUnorderedDictionary.h"
 #include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/Table.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
 
 namespace hyrise { namespace storage {
 
+const size_t Store::VISIBILITY_BLOCK_SIZE;
+const size_t Store::MAIN_VERSION_STRIPES;
+const uint64_t Store::DIRTY;
+const uint64_t Store::ALL_VISIBLE_NEVER;
+
 TableMerger* createDefaultMerger() {
   return new TableMerger(new DefaultMergeStrategy, new SequentialHeapMerger, false);
 }
 
 Store::Store() :
-  merger(createDefaultMerger()) {
+  _delta_size(0),
+  _versioned_size(0),
+  _mainVersion(nullptr),
+  _generation(0),
+  _delta_offset(0),
+  merger(createDefaultMerger()),
+  _mainTid(tx::UNKNOWN),
+  _summaryVersion(0) {
+  resetMainVersions(0, tx::UNKNOWN);
   setUuid();
 }
 
@@ -37,97 +66,226 @@ auto create_concurrent_storage = [](std::size_t cols) { return std::make_shared<
 
 Store::Store(atable_ptr_t main_table) :
     _delta_size(0),
-    _main_table(main_table),
+    _versioned_size(0),
+    _mainVersion(new MainVersion{0, main_table, {nullptr}}),
+    _generation(0),
+    _delta_offset(main_table->size()),
     delta(main_table->copy_structure(create_concurrent_dict, create_concurrent_storage)),
     merger(createDefaultMerger()),
-    _cidBeginVector(main_table->size(), 0),
-    _cidEndVector(main_table->size(), tx::INF_CID),
-    _tidVector(main_table->size(), tx::UNKNOWN) {
+    _summaryVersion(0) {
+  resetMainVersions(main_table->size(), tx::UNKNOWN);
   setUuid();
 }
 
 Store::~Store() {
+  deleteVersions(_mainVersion.load());
   delete merger;
 }
 
+void Store::deleteVersions(MainVersion *version) {
+  while (version != nullptr) {
+    auto previous = version->previous.load();
+    delete version;
+    version = previous;
+  }
+}
+
+const Store::MainVersion *Store::pinnedVersion() const {
+  const MainVersion *version = _mainVersion.load(std::memory_order_acquire);
+  const MainVersion *previous = version->previous.load(std::memory_order_acquire);
+  if (previous == nullptr)
+    return version;
+  const auto epoch = Epochs::pinned();
+  while (version->epoch > epoch && previous != nullptr) {
+    version = previous;
+    previous = version->previous.load(std::memory_order_acquire);
+  }
+  return version;
+}
+
+void Store::setMainTable(atable_ptr_t main) {
+  deleteVersions(_mainVersion.exchange(new MainVersion{0, main, {nullptr}}));
+  _retired.clear();
+}
+
+void Store::reclaim() {
+  const auto oldest = Epochs::oldestPinned();
+  // versions before the newest one of the oldest pinned epoch are not read
+  MainVersion *version = _mainVersion.load();
+  while (version->epoch > oldest)
+    version = version->previous.load();
+  deleteVersions(version->previous.exchange(nullptr));
+  _retired.erase(std::remove_if(_retired.begin(), _retired.end(), [oldest] (const RetiredRows& retired) {
+        if (retired.epoch > oldest)
+          return false;
+        retired.vector->releaseRows(retired.rows);
+        return true;
+      }), _retired.end());
+}
+
 void Store::merge() {
   if (merger == nullptr) {
     throw std::runtime_error("No Merger set.");
   }
+  std::lock_guard<std::mutex> merging(_merge_mutex);
 
   // Create new delta and merge
   atable_ptr_t new_delta = delta->copy_structure(create_concurrent_dict, create_concurrent_storage);
 
-  // Prepare the merge
-  std::vector<c_atable_ptr_t> tmp {_main_table, delta};
+  // Prepare the merge, the newest main is merged even if the calling
+  // operation pinned an older one
+  const auto main = _mainVersion.load()->main;
+  const size_t first = main->size() - _delta_offset;
+  c_atable_ptr_t unmerged = delta;
+  if (first > 0)
+    unmerged = TableRangeView::create(delta, first, delta->size());
+  std::vector<c_atable_ptr_t> tmp {main, unmerged};
 
   // get valid positions
-  std::vector<bool> validPositions(_cidBeginVector.size());
+  std::vector<bool> validPositions(_delta_offset + _cidBeginVector.size());
   tx::transaction_cid_t last_commit_id = tx::TransactionManager::getInstance().getLastCommitId();
-  functional::forEachWithIndex(_cidBeginVector, [&](size_t i, bool v){
-    validPositions[i] = isVisibleForTransaction(i, last_commit_id, tx::MERGE_TID);
-  });
+  for (const auto& pos : buildValidPositions(last_commit_id, tx::MERGE_TID))
+    validPositions[pos] = true;
 
   auto tables = merger->merge(tmp, true, validPositions);
   assert(tables.size() == 1);
-  _main_table = tables.front();
-  // Fixup the cid and tid vectors
-  _cidBeginVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::UNKNOWN_CID);
-  _cidEndVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::INF_CID);
-  _tidVector = tbb::concurrent_vector<tx::transaction_id_t>(_main_table->size(), tx::START_TID);
-  
+  if (_frontCoding)
+    frontCode(tables.front());
+  // no reader runs concurrently, so no reader uses a replaced main
+  setMainTable(tables.front());
+  const auto mainSize = tables.front()->size();
+  // All rows of the new main are visible, only the delta keeps versions
+  resetMainVersions(mainSize, tx::START_TID);
+  _cidBeginVector.clear();
+  _cidEndVector.clear();
+  _tidVector.clear();
+  _blockSummaries.clear();
+
   // Replace the delta partition
   delta = new_delta;
+  _delta_offset = mainSize;
   _delta_size = new_delta->size();
+  _versioned_size = new_delta->size();
+  ++_generation;
+}
+
+uint64_t Store::generation() const {
+  return _generation.load();
+}
+
+void Store::setGeneration(uint64_t generation) {
+  _generation = generation;
+}
+
+std::unique_lock<std::mutex> Store::blockMerges() {
+  return std::unique_lock<std::mutex>(_merge_mutex);
+}
+
+void Store::mergeOnline() {
+  if (merger == nullptr) {
+    throw std::runtime_error("No Merger set.");
+  }
+  std::lock_guard<std::mutex> merging(_merge_mutex);
+
+  const auto main = _mainVersion.load()->main;
+  const size_t first = main->size() - _delta_offset;
+
+  // the delta rows whose MVCC data already exists, rows drawn by writers
+  // are added to the MVCC vectors after resizing the delta and the size
+  // of the vectors includes entries still being constructed
+  const size_t rows = std::min(delta->size(), _versioned_size.load());
+  // dead rows are merged along, only rows that a running transaction may
+  // still write stop the merge
+  size_t last = first;
+  while (last < rows && (_cidBeginVector[last] != tx::INF_CID || _cidEndVector[last] != tx::INF_CID))
+    ++last;
+  if (last == first)
+    return;
+
+  // All rows are kept, so that positions stay valid. The valid vector
+  // limits the merge to the dictionary entries used by these rows, the
+  // delta dictionary grows concurrently.
+  std::vector<c_atable_ptr_t> tmp {main, TableRangeView::create(delta, first, last)};
+  std::vector<bool> validPositions(main->size() + last - first, true);
+  auto tables = merger->merge(tmp, true, validPositions);
+  assert(tables.size() == 1);
+  if (_frontCoding)
+    frontCode(tables.front());
+
+  const auto epoch = Epochs::publish([&] (uint64_t epoch) {
+      _mainVersion.store(new MainVersion{epoch, tables.front(), {_mainVersion.load()}}, std::memory_order_release);
+    });
+
+  // operations of earlier epochs read the value ids of the merged rows
+  // from the delta until they end
+  for (size_t column = 0; column < delta->columnCount(); ++column) {
+    for (const auto& av : delta->getAttributeVectors(column)) {
+      auto vector = std::dynamic_pointer_cast<ConcurrentFixedLengthVector<value_id_t>>(av.attribute_vector);
+      const bool retired = std::any_of(_retired.begin(), _retired.end(), [&] (const RetiredRows& rows) {
+          return rows.epoch == epoch && rows.vector == vector;
+        });
+      if (vector != nullptr && !retired)
+        _retired.push_back({epoch, vector, last});
+    }
+  }
+  reclaim();
 }
 
 
 atable_ptr_t Store::getMainTable() const {
-  return _main_table;
+  if (_mainVersion.load() == nullptr)
+    return nullptr;
+  EpochGuard guard;
+  return pinnedVersion()->main;
 }
 
 atable_ptr_t Store::getDeltaTable() const {
   return delta;
 }
 
+c_atable_ptr_t Store::getUnmergedDelta() const {
+  const size_t first = mainTable()->size() - _delta_offset;
+  if (first == 0)
+    return delta;
+  return TableRangeView::create(delta, first, delta->size());
+}
+
 const ColumnMetadata& Store::metadataAt(const size_t column_index, const size_t row_index, const table_id_t table_id) const {
-  size_t offset = _main_table->size();
-  if (row_index < offset) {
-    return _main_table->metadataAt(column_index, row_index, table_id);
+  auto main = mainTable();
+  if (row_index < main->size()) {
+    return main->metadataAt(column_index, row_index, table_id);
   }
-  return delta->metadataAt(column_index, row_index - offset, table_id);
+  return delta->metadataAt(column_index, row_index - _delta_offset, table_id);
 }
 
 void Store::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_t column, const size_t row, const table_id_t table_id) {
-  size_t offset = _main_table->size();
-  if (row < offset) {
-    _main_table->setDictionaryAt(dict, column, row, table_id);
+  auto location = responsibleTable(row);
+  if (location.table_index == 0) {
+    location.table->setDictionaryAt(dict, column, row, table_id);
   }
-  delta->setDictionaryAt(dict, column, row - offset, table_id);
+  delta->setDictionaryAt(dict, column, row - _delta_offset, table_id);
 }
 
 const AbstractTable::SharedDictionaryPtr& Store::dictionaryAt(const size_t column, const size_t row, const table_id_t table_id) const {
-  size_t offset = _main_table->size();
-  if (row < offset) {
-    return _main_table->dictionaryAt(column, row);
-  }
-  return delta->dictionaryAt(column, row - offset);
+  auto location = responsibleTable(row);
+  return location.table->dictionaryAt(column, location.offset_in_table);
 }
 
 const AbstractTable::SharedDictionaryPtr& Store::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
   if (table_id == 0)
-    return _main_table->dictionaryByTableId(column, table_id);
+    return mainTable()->dictionaryByTableId(column, table_id);
   else
     return delta->dictionaryByTableId(column, table_id);
 }
 
 inline Store::table_offset_idx_t Store::responsibleTable(const size_t row) const {
-  size_t offset = _main_table->size();
-  if (row < offset) {
-    return {_main_table, row, 0};
+  auto main = const_cast<AbstractTable *>(mainTable());
+  if (row < main->size()) {
+    return {main, row, 0};
   }
-  assert( row - offset < delta->size() );
-  return {delta, row - offset, 1};
+  // rows merged online stay in the delta, so delta rows keep their offset
+  assert( row - _delta_offset < delta->size() );
+  return {delta.get(), row - _delta_offset, 1};
 }
 
 void Store::setValueId(const size_t column, const size_t row, ValueId vid) {
@@ -144,11 +302,11 @@ ValueId Store::getValueId(const size_t column, const size_t row) const {
 
 
 size_t Store::size() const {
-  return _main_table->size() + delta->size();
+  return _delta_offset + delta->size();
 }
 
 size_t Store::deltaOffset() const {
-  return _main_table->size();
+  return _delta_offset;
 }
 
 size_t Store::columnCount() const {
@@ -156,13 +314,13 @@ size_t Store::columnCount() const {
 }
 
 unsigned Store::partitionCount() const {
-  return _main_table->partitionCount();
+  return mainTable()->partitionCount();
 }
 
 size_t Store::partitionWidth(const size_t slice) const {
   // TODO we now require that all main tables have the same layout
   //return main_tables[0]->partitionWidth(slice);
-  return  _main_table->partitionWidth(slice);
+  return  mainTable()->partitionWidth(slice);
 }
 
 
@@ -170,6 +328,20 @@ void Store::print(const size_t limit) const {
   PrettyPrinter::print(this, std::cout, "Store", limit, 0);
 }
 
+void Store::setFrontCoding(bool frontCoding) {
+  _frontCoding = frontCoding;
+}
+
+void Store::frontCode(const atable_ptr_t& main) const {
+  for (size_t column = 0; column < main->columnCount(); ++column) {
+    if (main->typeOfColumn(column) != StringType)
+      continue;
+    auto dictionary = std::dynamic_pointer_cast<OrderPreservingDictionary<hyrise_string_t>>(main->dictionaryAt(column));
+    if (dictionary && !std::dynamic_pointer_cast<FrontCodedDictionary>(dictionary))
+      main->setDictionaryAt(FrontCodedDictionary::encode(*dictionary), column);
+  }
+}
+
 void Store::setMerger(TableMerger *_merger) {
   delete merger;
   merger = _merger;
@@ -181,9 +353,27 @@ void Store::setDelta(atable_ptr_t _delta) {
 
 atable_ptr_t Store::copy() const {
   std::shared_ptr<Store> new_store = std::make_shared<Store>();
+  // the delta rows merged into the main are copied from the main
+  EpochGuard guard;
 
-  new_store->_main_table = _main_table->copy();
+  new_store->setMainTable(getMainTable()->copy());
   new_store->delta = delta->copy();
+  new_store->_delta_size = new_store->delta->size();
+  new_store->_versioned_size = new_store->delta->size();
+  new_store->_delta_offset = _delta_offset;
+  new_store->_generation = generation();
+  new_store->_frontCoding = _frontCoding;
+  {
+    // all stripes are locked in order to copy a consistent state
+    std::vector<std::unique_lock<std::mutex> > locks;
+    for (auto& stripe : _mainVersions)
+      locks.emplace_back(stripe.mutex);
+    new_store->resetMainVersions(_delta_offset, _mainTid);
+    for (size_t stripe = 0; stripe < MAIN_VERSION_STRIPES; ++stripe)
+      new_store->_mainVersions[stripe].versions = _mainVersions[stripe].versions;
+    for (size_t word = 0; word < (_delta_offset + 63) / 64; ++word)
+      new_store->_mainModified[word].store(_mainModified[word].load());
+  }
 
   if (merger == nullptr) {
     new_store->merger = nullptr;
@@ -198,7 +388,7 @@ atable_ptr_t Store::copy() const {
 const attr_vectors_t Store::getAttributeVectors(size_t column) const {
   attr_vectors_t tables;
 
-  const auto& subtablesM = _main_table->getAttributeVectors(column);
+  const auto& subtablesM = mainTable()->getAttributeVectors(column);
   tables.insert(tables.end(), subtablesM.begin(), subtablesM.end());
 
   const auto& subtables = delta->getAttributeVectors(column);
@@ -209,27 +399,71 @@ const attr_vectors_t Store::getAttributeVectors(size_t column) const {
 void Store::debugStructure(size_t level) const {
   std::cout << std::string(level, '\t') << "Store " << this << std::endl;
   std::cout << std::string(level, '\t') << "(main) " << this << std::endl;
-  _main_table->debugStructure(level+1);
+  mainTable()->debugStructure(level+1);
   std::cout << std::string(level, '\t') << "(delta) " << this << std::endl;
   delta->debugStructure(level+1);
 }
 
+void Store::resetMainVersions(size_t rows, tx::transaction_id_t tid) {
+  const size_t words = (rows + 63) / 64;
+  _mainModified.reset(new std::atomic<uint64_t>[words]);
+  for (size_t word = 0; word < words; ++word)
+    _mainModified[word].store(0, std::memory_order_relaxed);
+  for (auto& stripe : _mainVersions)
+    stripe.versions.clear();
+  _mainTid = tid;
+}
+
+template <typename F>
+void Store::updateMainVersion(pos_t pos, F fun) {
+  auto& stripe = mainStripe(pos);
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+  auto entry = stripe.versions.find(pos);
+  RowVersion version = entry == stripe.versions.end() ? mainDefault() : entry->second;
+  fun(version);
+
+  // rows of other stripes share the word, so the bit is flipped atomically
+  const uint64_t bit = 1ull << (pos % 64);
+  if (version == mainDefault()) {
+    if (entry != stripe.versions.end())
+      stripe.versions.erase(entry);
+    _mainModified[pos / 64].fetch_and(~bit, std::memory_order_release);
+  } else {
+    stripe.versions[pos] = version;
+    _mainModified[pos / 64].fetch_or(bit, std::memory_order_release);
+  }
+}
+
+Store::RowVersion Store::version(pos_t pos) const {
+  if (pos >= _delta_offset) {
+    const auto row = pos - _delta_offset;
+    return {_cidBeginVector[row], _cidEndVector[row], _tidVector[row]};
+  }
+  if (!isMainModified(pos))
+    return mainDefault();
+  auto& stripe = mainStripe(pos);
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+  auto entry = stripe.versions.find(pos);
+  return entry == stripe.versions.end() ? mainDefault() : entry->second;
+}
+
 bool Store::isVisibleForTransaction(pos_t pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
-  if (_tidVector[pos] == tid) {
-    if (last_commit_id >= _cidBeginVector[pos]) {
+  const auto row = version(pos);
+  if (row.tid == tid) {
+    if (last_commit_id >= row.begin) {
       // row was inserted and committed by another transaction, then deleted by our transaction
       // if we have a lock for it but someone else committed a delete, something is wrong
-      assert(_cidEndVector[pos] == tx::INF_CID);
+      assert(row.end == tx::INF_CID);
       return false;
     } else {
       // we inserted this row - nobody should have deleted it yet
-      assert(_cidEndVector[pos] == tx::INF_CID);
+      assert(row.end == tx::INF_CID);
       return true;
     }
   } else {
-    if (last_commit_id >= _cidBeginVector[pos]) {
+    if (last_commit_id >= row.begin) {
       // we are looking at a row that was inserted and deleted before we started - we should see it unless it was already deleted again
-      if(last_commit_id >= _cidEndVector[pos]) {
+      if(last_commit_id >= row.end) {
         // the row was deleted and the delete was committed before we started our transaction
         return false;
       } else {
@@ -238,33 +472,186 @@ bool Store::isVisibleForTransaction(pos_t pos, tx::transaction_cid_t last_commit
       }
     } else {
       // we are looking at a row that was inserted after we started
-      assert(_cidEndVector[pos] > last_commit_id);
+      // rows of aborted inserts are dead and end before every snapshot
+      assert(row.end > last_commit_id || row.begin == tx::INF_CID);
       return false;
     }
   }
 }
 
+namespace {
+
+typedef tbb::concurrent_vector<tx::transaction_id_t> mvcc_vector_t;
+
+/*
+  Calls fun(begin, end, tids, count, first) for runs of consecutive rows
+  in [first, last) whose MVCC data is contiguous in memory. The segments
+  of a tbb::concurrent_vector double in size, segment k holds the
+  elements [2^k, 2^(k+1)).
+ */
+template <typename F>
+void forEachContiguousRun(const mvcc_vector_t& begins, const mvcc_vector_t& ends, const mvcc_vector_t& tids,
+                          size_t first, size_t last, F fun) {
+  for (size_t row = first; row < last;) {
+    const size_t next = row < 2 ? row + 1 : std::min(last, size_t(1) << (64 - __builtin_clzll(row)));
+    fun(&begins[row], &ends[row], &tids[row], next - row, row);
+    row = next;
+  }
+}
+
+// Appends first + i for all rows i < count visible for the transaction,
+// see Store::isVisibleForTransaction()
+void appendVisible(const tx::transaction_cid_t *begins, const tx::transaction_cid_t *ends, const tx::transaction_id_t *tids,
+                   size_t count, pos_t first, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid,
+                   pos_list_t& result) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  const auto lcid = _mm256_set1_epi64x(last_commit_id);
+  const auto own = _mm256_set1_epi64x(tid);
+  for (; i + 4 <= count; i += 4) {
+    const auto begin = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begins + i));
+    const auto end = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ends + i));
+    const auto rowTid = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tids + i));
+    const auto insertedLater = _mm256_cmpgt_epi64(begin, lcid);
+    const auto committed = _mm256_andnot_si256(insertedLater, _mm256_cmpgt_epi64(end, lcid));
+    const auto visible = _mm256_blendv_epi8(committed, insertedLater, _mm256_cmpeq_epi64(rowTid, own));
+    for (int mask = _mm256_movemask_pd(_mm256_castsi256_pd(visible)); mask != 0; mask &= mask - 1)
+      result.push_back(first + i + __builtin_ctz(mask));
+  }
+#elif defined(__SSE4_2__)
+  const auto lcid = _mm_set1_epi64x(last_commit_id);
+  const auto own = _mm_set1_epi64x(tid);
+  for (; i + 2 <= count; i += 2) {
+    const auto begin = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begins + i));
+    const auto end = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ends + i));
+    const auto rowTid = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tids + i));
+    const auto insertedLater = _mm_cmpgt_epi64(begin, lcid);
+    const auto committed = _mm_andnot_si128(insertedLater, _mm_cmpgt_epi64(end, lcid));
+    const auto visible = _mm_blendv_epi8(committed, insertedLater, _mm_cmpeq_epi64(rowTid, own));
+    for (int mask = _mm_movemask_pd(_mm_castsi128_pd(visible)); mask != 0; mask &= mask - 1)
+      result.push_back(first + i + __builtin_ctz(mask));
+  }
+#endif
+  for (; i < count; ++i) {
+    const bool visible = tids[i] == tid ? last_commit_id < begins[i]
+                                        : last_commit_id >= begins[i] && last_commit_id < ends[i];
+    if (visible)
+      result.push_back(first + i);
+  }
+}
+
+}  // namespace
+
+void Store::invalidateBlock(size_t delta_row) {
+  _blockSummaries[delta_row / VISIBILITY_BLOCK_SIZE].value.store(DIRTY | ++_summaryVersion);
+}
+
+uint64_t Store::blockSummary(size_t block) const {
+  auto& summary = _blockSummaries[block].value;
+  auto seen = summary.load();
+  if (!(seen & DIRTY))
+    return seen;
+
+  uint64_t maxBegin = 0;
+  bool allVisible = true;
+  forEachContiguousRun(_cidBeginVector, _cidEndVector, _tidVector,
+                       block * VISIBILITY_BLOCK_SIZE, (block + 1) * VISIBILITY_BLOCK_SIZE,
+                       [&] (const tx::transaction_cid_t *begins, const tx::transaction_cid_t *ends,
+                            const tx::transaction_id_t *tids, size_t count, size_t) {
+    for (size_t i = 0; i < count; ++i) {
+      allVisible &= begins[i] != tx::INF_CID && ends[i] == tx::INF_CID && tids[i] <= tx::START_TID;
+      maxBegin = std::max<uint64_t>(maxBegin, begins[i]);
+    }
+  });
+  const uint64_t result = allVisible ? maxBegin : ALL_VISIBLE_NEVER;
+  // a writer that modified the block meanwhile stored a new version
+  summary.compare_exchange_strong(seen, result);
+  return result;
+}
+
+bool Store::isBlockVisibleForTransaction(pos_t pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
+  if (pos < _delta_offset)
+    return tid != _mainTid && _mainModified[pos / 64].load(std::memory_order_acquire) == 0;
+
+  // rows of transactions with a lower tid are all treated as own rows
+  const auto block = (pos - _delta_offset) / VISIBILITY_BLOCK_SIZE;
+  if (tid <= tx::START_TID || block >= _blockSummaries.size())
+    return false;
+  const auto summary = _blockSummaries[block].value.load();
+  return !(summary & DIRTY) && summary <= static_cast<uint64_t>(last_commit_id);
+}
+
 // This method iterates of the pos list and validates each position
 void Store::validatePositions(pos_list_t& pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
   // Make sure we captured all rows
-  assert(_cidBeginVector.size() == size() && _cidEndVector.size() == size() && _tidVector.size() == size());
-
-  // Pos is nullptr, we should circumvent
+  assert(_cidBeginVector.size() == delta->size() && _cidEndVector.size() == delta->size() && _tidVector.size() == delta->size());
+
+  // Positions in blocks that are known to be visible pass without looking
+  // at their rows, delta blocks are not summarized here as the positions
+  // may only touch few of their rows
+  const size_t mainBlocks = (_delta_offset + 63) / 64;
+  size_t block = static_cast<size_t>(-1);
+  bool blockVisible = false;
   auto end = std::remove_if(std::begin(pos), std::end(pos), [&](const pos_t& v){
-
-    return !isVisibleForTransaction(v, last_commit_id, tid);
-
+    const size_t current = v < _delta_offset ? v / 64 : mainBlocks + (v - _delta_offset) / VISIBILITY_BLOCK_SIZE;
+    if (current != block) {
+      block = current;
+      blockVisible = isBlockVisibleForTransaction(v, last_commit_id, tid);
+    }
+    return !blockVisible && !isVisibleForTransaction(v, last_commit_id, tid);
   } );
   if (end != pos.end())
     pos.erase(end, pos.end());
 }
 
 pos_list_t Store::buildValidPositions(tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
+  const size_t rows = std::min({_cidBeginVector.size(), _cidEndVector.size(), _tidVector.size()});
   pos_list_t result;
-  functional::forEachWithIndex(_cidBeginVector, [&](size_t i, tx::transaction_cid_t v){
-    if(isVisibleForTransaction(i, last_commit_id, tid)) result.push_back(i);
+  result.reserve(_delta_offset + rows);
+  appendVisibleMainPositions(last_commit_id, tid, result);
+  for (size_t block = 0; block * VISIBILITY_BLOCK_SIZE < rows; ++block) {
+    const size_t first = block * VISIBILITY_BLOCK_SIZE;
+    const size_t last = std::min(rows, first + VISIBILITY_BLOCK_SIZE);
+    // the last block may still grow and is never summarized
+    if (tid > tx::START_TID && last - first == VISIBILITY_BLOCK_SIZE &&
+        blockSummary(block) <= static_cast<uint64_t>(last_commit_id)) {
+      const auto offset = result.size();
+      result.resize(offset + VISIBILITY_BLOCK_SIZE);
+      std::iota(result.begin() + offset, result.end(), _delta_offset + first);
+      continue;
+    }
+    appendVisibleDeltaPositions(first, last, last_commit_id, tid, result);
+  }
+  return result;
+}
+
+void Store::appendVisibleMainPositions(tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid, pos_list_t& result) const {
+  // unmodified main rows are visible for all but the main tid
+  const bool unmodifiedVisible = tid != _mainTid;
+  for (size_t word = 0; word * 64 < _delta_offset; ++word) {
+    const pos_t first = word * 64;
+    const pos_t last = std::min<pos_t>(_delta_offset, first + 64);
+    const uint64_t modified = _mainModified[word].load(std::memory_order_acquire);
+    if (modified == 0) {
+      if (unmodifiedVisible) {
+        for (pos_t pos = first; pos < last; ++pos)
+          result.push_back(pos);
+      }
+      continue;
+    }
+    for (pos_t pos = first; pos < last; ++pos) {
+      if ((modified >> (pos - first) & 1) ? isVisibleForTransaction(pos, last_commit_id, tid) : unmodifiedVisible)
+        result.push_back(pos);
+    }
+  }
+}
+
+void Store::appendVisibleDeltaPositions(size_t first, size_t last, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid, pos_list_t& result) const {
+  forEachContiguousRun(_cidBeginVector, _cidEndVector, _tidVector, first, last,
+                       [&] (const tx::transaction_cid_t *begins, const tx::transaction_cid_t *ends,
+                            const tx::transaction_id_t *tids, size_t count, size_t run) {
+    appendVisible(begins, ends, tids, count, _delta_offset + run, last_commit_id, tid, result);
   });
-  return std::move(result);
 }
 
 std::pair<size_t, size_t> Store::resizeDelta(size_t num) {
@@ -276,54 +663,187 @@ std::pair<size_t, size_t> Store::appendToDelta(size_t num_rows) {
   // By atomically drawing a range of rows unique to the calling thread...
   std::size_t prior_delta_size =_delta_size.fetch_add(num_rows);
   delta->resize(prior_delta_size + num_rows);  
-  auto main_size = _main_table->size();
-  auto new_size = main_size + prior_delta_size + num_rows;
+  auto new_size = prior_delta_size + num_rows;
   auto grow_and_fill = [=] (tbb::concurrent_vector<tx::transaction_id_t>& vector, tx::transaction_id_t value) {
-    vector.grow_to_at_least(new_size);
+    // new entries are constructed with the value, concurrent readers never see them zeroed
+    vector.grow_to_at_least(new_size, value);
     // ... we can fill the drawn range without interferring with other threads
-    std::fill(std::begin(vector) + main_size + prior_delta_size, std::begin(vector) + new_size, value);
+    std::fill(std::begin(vector) + prior_delta_size, std::begin(vector) + new_size, value);
   };
+  // summaries exist before the rows of their blocks
+  _blockSummaries.grow_to_at_least((new_size + VISIBILITY_BLOCK_SIZE - 1) / VISIBILITY_BLOCK_SIZE);
   grow_and_fill(_cidBeginVector, tx::INF_CID);
   grow_and_fill(_cidEndVector, tx::INF_CID);
   grow_and_fill(_tidVector, tx::START_TID);
+  for (size_t block = prior_delta_size / VISIBILITY_BLOCK_SIZE; block * VISIBILITY_BLOCK_SIZE < new_size; ++block)
+    invalidateBlock(block * VISIBILITY_BLOCK_SIZE);
+  // waits for the appenders that drew the rows before
+  for (auto expected = prior_delta_size; !_versioned_size.compare_exchange_weak(expected, new_size); expected = prior_delta_size)
+    std::this_thread::yield();
   return {prior_delta_size, prior_delta_size + num_rows};
 }
 
 void Store::copyRowToDelta(const c_atable_ptr_t& source, const size_t src_row, const size_t dst_row, tx::transaction_id_t tid) {
-  auto main_tables_size = _main_table->size();
-
   // Update the validity
-  _tidVector[main_tables_size + dst_row] = tid;
+  _tidVector[dst_row] = tid;
+  invalidateBlock(dst_row);
 
   delta->copyRowFrom(source, src_row, dst_row, true);
 }
 
+namespace {
+
+bool isNoDictType(DataType type) {
+  return type == IntegerNoDictType || type == FloatNoDictType;
+}
+
+// Writes the value ids of column of source to rows [first, first +
+// source->size()) of delta, encoding each distinct value id of source once
+template <typename T>
+void encodeColumn(const c_atable_ptr_t& source, size_t column, AbstractTable& delta, size_t first) {
+  static const value_id_t UNMAPPED = std::numeric_limits<value_id_t>::max();
+  const auto& sourceDictionary = checked_pointer_cast<BaseDictionary<T>>(source->dictionaryAt(column));
+  const auto& deltaDictionary = checked_pointer_cast<BaseDictionary<T>>(delta.dictionaryAt(column));
+  std::vector<value_id_t> mapping(sourceDictionary->size(), UNMAPPED);
+  for (size_t row = 0, rows = source->size(); row < rows; ++row) {
+    const value_id_t valueId = source->getValueId(column, row).valueId;
+    auto& mapped = mapping[valueId];
+    if (mapped == UNMAPPED)
+      mapped = deltaDictionary->getValueId(sourceDictionary->getValueForValueId(valueId), true);
+    delta.setValueId(column, first + row, ValueId(mapped, 0));
+  }
+}
+
+}  // namespace
+
+std::pair<size_t, size_t> Store::appendRowsToDelta(const c_atable_ptr_t& source, tx::transaction_id_t tid) {
+  const size_t rows = source->size();
+  const auto writeArea = appendToDelta(rows);
+  const size_t first = writeArea.first;
+
+  // plain tables have one dictionary per column
+  if (std::dynamic_pointer_cast<const Table>(source) == nullptr) {
+    for (size_t row = 0; row < rows; ++row)
+      copyRowToDelta(source, row, first + row, tid);
+    return writeArea;
+  }
+
+  for (size_t column = 0; column < source->columnCount(); ++column) {
+    const auto sourceType = source->typeOfColumn(column);
+    const auto deltaType = delta->typeOfColumn(column);
+    if (!types::isCompatible(sourceType, deltaType))
+      throw std::runtime_error("Column types of the rows and the delta do not match");
+    if (isNoDictType(sourceType) || isNoDictType(deltaType)) {
+      if (sourceType == deltaType) {
+        // value ids are the values
+        for (size_t row = 0; row < rows; ++row)
+          delta->setValueId(column, first + row, source->getValueId(column, row));
+      } else {
+        for (size_t row = 0; row < rows; ++row)
+          delta->copyValueFrom(source, column, row, column, first + row);
+      }
+      continue;
+    }
+    switch (sourceType) {
+      case IntegerType:
+      case IntegerTypeDelta:
+      case IntegerTypeDeltaConcurrent:
+        encodeColumn<hyrise_int_t>(source, column, *delta, first);
+        break;
+      case FloatType:
+      case FloatTypeDelta:
+      case FloatTypeDeltaConcurrent:
+        encodeColumn<hyrise_float_t>(source, column, *delta, first);
+        break;
+      default:
+        encodeColumn<hyrise_string_t>(source, column, *delta, first);
+        break;
+    }
+  }
+
+  std::fill(_tidVector.begin() + first, _tidVector.begin() + writeArea.second, tid);
+  for (size_t block = first / VISIBILITY_BLOCK_SIZE; block * VISIBILITY_BLOCK_SIZE < writeArea.second; ++block)
+    invalidateBlock(block * VISIBILITY_BLOCK_SIZE);
+  return writeArea;
+}
+
+void Store::setTid(size_t row, tx::transaction_id_t tid) {
+  if (row < _delta_offset) {
+    updateMainVersion(row, [tid] (RowVersion& version) { version.tid = tid; });
+  } else {
+    _tidVector[row - _delta_offset] = tid;
+    invalidateBlock(row - _delta_offset);
+  }
+}
+
 tx::TX_CODE Store::commitPositions(const pos_list_t& pos, const tx::transaction_cid_t cid, bool valid) {
   for(const auto& p : pos) {
+    if (p < _delta_offset) {
+      updateMainVersion(p, [cid, valid] (RowVersion& version) {
+        (valid ? version.begin : version.end) = cid;
+        version.tid = tx::START_TID;
+      });
+      continue;
+    }
+    const auto row = p - _delta_offset;
     if(valid) {
-      _cidBeginVector[p] = cid;
+      _cidBeginVector[row] = cid;
     } else {
-      _cidEndVector[p] = cid;
+      _cidEndVector[row] = cid;
     }
-    _tidVector[p] = tx::START_TID;
+    _tidVector[row] = tx::START_TID;
+    invalidateBlock(row);
   }
   return tx::TX_CODE::TX_OK;
 }
 
+void Store::abortPositions(const pos_list_t& pos) {
+  for(const auto& p : pos) {
+    assert(p >= _delta_offset);
+    const auto row = p - _delta_offset;
+    // the begin cid stays infinite, so no snapshot sees the row
+    _cidEndVector[row] = tx::UNKNOWN_CID;
+    _tidVector[row] = tx::START_TID;
+    invalidateBlock(row);
+  }
+}
+
+void Store::abortUncommitted() {
+  pos_list_t uncommitted;
+  for (size_t row = 0; row < _cidBeginVector.size(); ++row) {
+    if (_cidBeginVector[row] == tx::INF_CID && _cidEndVector[row] == tx::INF_CID)
+      uncommitted.push_back(_delta_offset + row);
+  }
+  abortPositions(uncommitted);
+}
+
 tx::TX_CODE Store::checkForConcurrentCommit(const pos_list_t& pos, const tx::transaction_id_t tid) const {
   for(const auto& p : pos) {
-    if (_tidVector[p] != tid)
+    if (version(p).tid != tid)
       return tx::TX_CODE::TX_FAIL_CONCURRENT_COMMIT;
   }
   return tx::TX_CODE::TX_OK;
 }
 
 tx::TX_CODE Store::markForDeletion(const pos_t pos, const tx::transaction_id_t tid) {
-  if(atomic_cas(&_tidVector[pos], tx::START_TID, tid)) {
+  if (pos < _delta_offset) {
+    bool locked = false;
+    updateMainVersion(pos, [tid, &locked] (RowVersion& version) {
+      if (version.tid == tx::START_TID)
+        version.tid = tid;
+      // rows we hold ourselves are left as they are, see below
+      locked = version.tid == tid;
+    });
+    return locked ? tx::TX_CODE::TX_OK : tx::TX_CODE::TX_FAIL_CONCURRENT_COMMIT;
+  }
+
+  const auto row = pos - _delta_offset;
+  if(atomic_cas(&_tidVector[row], tx::START_TID, tid)) {
+    invalidateBlock(row);
     return tx::TX_CODE::TX_OK;
   }
 
-  if(_tidVector[pos] == tid) {
+  if(_tidVector[row] == tid) {
     // It is a row that we inserted ourselves. So we leave it as it is.
     // No need for a CAS here since we already have it "locked"
     // WARNING:
@@ -337,8 +857,15 @@ tx::TX_CODE Store::markForDeletion(const pos_t pos, const tx::transaction_id_t t
 
 tx::TX_CODE Store::unmarkForDeletion(const pos_list_t& pos, const tx::transaction_id_t tid) {
   for(const auto& p : pos) {
-    if (_tidVector[p] == tid)
-      _tidVector[p] = tx::START_TID;
+    if (p < _delta_offset) {
+      updateMainVersion(p, [tid] (RowVersion& version) {
+        if (version.tid == tid)
+          version.tid = tx::START_TID;
+      });
+    } else if (_tidVector[p - _delta_offset] == tid) {
+      _tidVector[p - _delta_offset] = tx::START_TID;
+      invalidateBlock(p - _delta_offset);
+    }
   }
   return tx::TX_CODE::TX_OK;
 }
@@ -14,9 +14,16 @@
 #include <storage/AbstractMergeStrategy.h>
 #include <storage/SequentialHeapMerger.h>
 #include <storage/PrettyPrinter.h>
+#include <storage/ConcurrentFixedLengthVector.h>
 
 #include <helper/types.h>
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include "tbb/concurrent_vector.h"
 
 namespace hyrise {
@@ -27,6 +34,19 @@ namespace storage {
  * only entity capable of modifying the content of the table(s) after
  * initialization via the delta store. It can be merged into the main
  * tables using a to-be-set merger.
+ *
+ * Rows keep their position until the next merge(), the delta rows start
+ * at deltaOffset(). mergeOnline() merges committed delta rows into a new
+ * main table while reads and writes continue, the new main then covers
+ * these rows at the same positions and the rows keep their MVCC data in
+ * the delta until the next merge(). Readers pin an epoch, see Epochs, to
+ * read one main throughout an operation.
+ *
+ * The MVCC data of delta rows is kept per row. Rows of the main are
+ * visible for every transaction unless they were deleted or are locked
+ * for a delete, so only a bitmap of modified main rows and the versions
+ * of these rows are kept. merge() compacts the versions of all rows into
+ * the new main.
  */
 class Store : public AbstractTable {
 public:
@@ -36,10 +56,45 @@ public:
 
   atable_ptr_t getMainTable() const;
   void setDelta(atable_ptr_t _delta);
+  /// The delta table, row `i` of the delta is at position
+  /// deltaOffset() + i of the store. Rows merged by mergeOnline() still
+  /// count to the delta table, but their value ids are released.
   atable_ptr_t getDeltaTable() const;
+  /// The rows of the delta that are not part of the main table
+  c_atable_ptr_t getUnmergedDelta() const;
   size_t deltaOffset() const;
+
+  /// Merges main and delta into a new main table, dropping rows that are
+  /// invisible for new transactions. Positions change, so no transaction
+  /// may run concurrently.
   void merge();
 
+  /// Number of merge() calls that renumbered the rows, logged positions
+  /// refer to the rows of one generation
+  uint64_t generation() const;
+  /// Continues with generation after recovery
+  void setGeneration(uint64_t generation);
+
+  /// Holds off merge() and mergeOnline() while the lock is held, e.g. while
+  /// a checkpoint reads the store
+  std::unique_lock<std::mutex> blockMerges();
+
+  /// Merges the longest sequence of committed and dead rows at the
+  /// beginning of the unmerged delta into a new main table without blocking reads or
+  /// writes and publishes it in a new epoch. Operations that pinned an
+  /// earlier epoch keep reading the replaced main, which is freed along
+  /// with the value ids of the merged delta rows once no such operation
+  /// runs. Positions and the MVCC data do not change, deleted rows, the
+  /// MVCC data of merged rows and their delta dictionary entries are
+  /// reclaimed by the next merge(). Committed rows are never modified, so
+  /// they can be read while the merge runs.
+  void mergeOnline();
+
+  /// Mains created by later merges keep their sorted string columns in a
+  /// FrontCodedDictionary, which saves memory on values with common
+  /// prefixes but makes lookups and materialization slower. Off by default.
+  void setFrontCoding(bool frontCoding);
+
   /// Replaces the merger used for merging main tables with delta.
   /// @param _merger Pointer to a merger instance.
   void setMerger(TableMerger *_merger);
@@ -54,17 +109,45 @@ public:
 
   /// This method validates a list of positions to check if it is valid
   void validatePositions(pos_list_t& pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid ) const;
+  /// All positions visible for the transaction. Unmodified main rows
+  /// pass 64 at a time. Blocks of VISIBILITY_BLOCK_SIZE delta rows whose
+  /// rows are all committed and not deleted are summarized by their
+  /// largest begin cid and pass as a whole, the rows of other blocks are
+  /// checked with SIMD compares.
   pos_list_t buildValidPositions(tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const;
 
+  /// Delta rows per block of the visibility summaries
+  static const size_t VISIBILITY_BLOCK_SIZE = 1 << 16;
+
+  /// True if all rows of the block containing pos are known to be visible
+  /// for the transaction. Main rows form blocks of 64 rows of the bitmap
+  /// of modified rows, the summary of a delta block only shows this if it
+  /// was summarized since its last modification.
+  bool isBlockVisibleForTransaction(pos_t pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const;
+
   /// Copies a new row to the delta table, sets the validity and the
   /// tx id accordingly. May need to resize delta.
   void copyRowToDelta(const c_atable_ptr_t& source, size_t src_row, size_t dst_row, tx::transaction_id_t tid);
 
+  /// Appends all rows of source to the delta in a single write area and
+  /// returns it. Every distinct value of a column of source is looked up
+  /// in or added to the delta dictionary once per batch, the value ids
+  /// and tids are then written in tight loops. Sources whose columns do
+  /// not have a single dictionary are copied row by row.
+  std::pair<size_t, size_t> appendRowsToDelta(const c_atable_ptr_t& source, tx::transaction_id_t tid);
+
   tx::TX_CODE commitPositions(const pos_list_t& pos, const tx::transaction_cid_t cid, bool valid);
 
+  /// Marks delta rows inserted by a transaction that never commits as
+  /// dead. Dead rows are never visible and mergeOnline() passes over them.
+  void abortPositions(const pos_list_t& pos);
+  /// Marks all uncommitted delta rows as dead, only valid while no
+  /// transaction runs, e.g. at the end of a recovery
+  void abortUncommitted();
+
   // TID handling
-  inline tx::transaction_id_t tid(size_t row) const { return _tidVector[row]; }
-  inline void setTid(size_t row, tx::transaction_id_t tid) { _tidVector[row] = tid; }
+  inline tx::transaction_id_t tid(size_t row) const { return version(row).tid; }
+  void setTid(size_t row, tx::transaction_id_t tid);
   tx::TX_CODE checkForConcurrentCommit(const pos_list_t& pos, tx::transaction_id_t tid) const;
   tx::TX_CODE markForDeletion(pos_t pos,  tx::transaction_id_t tid);
   tx::TX_CODE unmarkForDeletion(const pos_list_t& pos, tx::transaction_id_t tid);
@@ -88,9 +171,52 @@ public:
   void debugStructure(size_t level=0) const override;
 
  private:
+  /*
+    Mains published by mergeOnline(), newest first. A version is read by
+    the operations that pinned an epoch from the one it was published in
+    on, see Epochs, so all reads of one operation use the same main and
+    value ids decoded with its dictionaries stay valid. Versions that no
+    pinned epoch reads any more are freed by reclaim().
+   */
+  struct MainVersion {
+    uint64_t epoch;
+    atable_ptr_t main;
+    std::atomic<MainVersion *> previous;
+  };
+  /// The main of the epoch pinned by the calling thread
+  const MainVersion *pinnedVersion() const;
+  /// The main of the pinned epoch without taking a reference for accesses
+  /// of single rows. Threads that pin no epoch read the newest main, which
+  /// may be freed by a concurrent mergeOnline().
+  inline const AbstractTable *mainTable() const { return pinnedVersion()->main.get(); }
+  /// Replaces all versions by main, no reader may run concurrently
+  void setMainTable(atable_ptr_t main);
+  /// Frees the versions of the main and the retired delta rows that no
+  /// pinned epoch reads, requires the merge mutex
+  void reclaim();
+  void deleteVersions(MainVersion *version);
+  /// Front codes the string dictionaries of a main that is not published yet
+  void frontCode(const atable_ptr_t& main) const;
+
   std::atomic<std::size_t> _delta_size;
-  //* Vector containing the main tables
-  atable_ptr_t _main_table;
+  //* Delta rows whose versions are constructed, appenders publish their
+  //* rows in the order in which they drew them
+  std::atomic<std::size_t> _versioned_size;
+  std::atomic<MainVersion *> _mainVersion;
+  //* Delta rows merged online, released once the epoch of the main
+  //* covering them is the oldest one read
+  struct RetiredRows {
+    uint64_t epoch;
+    std::shared_ptr<ConcurrentFixedLengthVector<value_id_t>> vector;
+    size_t rows;
+  };
+  std::vector<RetiredRows> _retired;
+  //* Serializes merges
+  std::mutex _merge_mutex;
+  //* Number of merges that renumbered the rows
+  std::atomic<uint64_t> _generation;
+  //* Position of the first row of the delta
+  size_t _delta_offset;
 
   //* Delta store
   atable_ptr_t delta;
@@ -98,16 +224,85 @@ public:
   //* Current merger
   TableMerger *merger;
 
-  typedef struct { const atable_ptr_t& table; size_t offset_in_table; size_t table_index; } table_offset_idx_t;
+  //* Whether merged mains get front coded string dictionaries
+  bool _frontCoding = false;
+
+  typedef struct { AbstractTable *table; size_t offset_in_table; size_t table_index; } table_offset_idx_t;
   table_offset_idx_t responsibleTable(size_t row) const;
  
   // TX Management
-  // Stores the CID of the transaction that created the row
+  struct RowVersion {
+    // CID of the transaction that created the row
+    tx::transaction_cid_t begin;
+    // CID of the transaction that deleted the row
+    tx::transaction_cid_t end;
+    // TID of the transaction holding the row to identify your own writes
+    tx::transaction_id_t tid;
+
+    bool operator==(const RowVersion& other) const {
+      return begin == other.begin && end == other.end && tid == other.tid;
+    }
+  };
+  RowVersion version(pos_t pos) const;
+
+  // Version of main rows that are not modified
+  inline RowVersion mainDefault() const { return {tx::UNKNOWN_CID, tx::INF_CID, _mainTid}; }
+  inline bool isMainModified(pos_t pos) const { return _mainModified[pos / 64].load(std::memory_order_acquire) >> (pos % 64) & 1; }
+  void resetMainVersions(size_t rows, tx::transaction_id_t tid);
+  // Calls fun with the version of a main row while holding the lock of
+  // its stripe and stores the modified version
+  template <typename F>
+  void updateMainVersion(pos_t pos, F fun);
+
+  // Versions of the modified main rows of one stripe, row i belongs to
+  // stripe i % MAIN_VERSION_STRIPES
+  struct MainVersionStripe {
+    std::mutex mutex;
+    std::unordered_map<pos_t, RowVersion> versions;
+  };
+  static const size_t MAIN_VERSION_STRIPES = 64;
+  inline MainVersionStripe &mainStripe(pos_t pos) const { return _mainVersions[pos % MAIN_VERSION_STRIPES]; }
+
+  // Bit i is set if main row i has an entry in _mainVersions
+  std::unique_ptr<std::atomic<uint64_t>[]> _mainModified;
+  // Deletes and locks of main rows only contend for the lock of their stripe
+  mutable std::array<MainVersionStripe, MAIN_VERSION_STRIPES> _mainVersions;
+  // TID of the main rows that are not modified
+  tx::transaction_id_t _mainTid;
+
+  // Versions of the delta rows, indexed by delta row
   tbb::concurrent_vector<tx::transaction_id_t> _cidBeginVector;
-  // Stores the CID of the transaction that deleted the row
   tbb::concurrent_vector<tx::transaction_id_t> _cidEndVector;
-  // Stores the TID for each record to identify your own writes
   tbb::concurrent_vector<tx::transaction_id_t> _tidVector;
+
+  /*
+    Visibility summary of a block of VISIBILITY_BLOCK_SIZE delta rows: the
+    largest begin cid if all rows are committed, not deleted and not
+    locked, ALL_VISIBLE_NEVER if some are not, or a DIRTY version if the
+    block was modified since it was last summarized. Writers store a new
+    version after modifying rows, summaries are only stored by a CAS from
+    the version seen before reading the rows, so a concurrent
+    modification is never hidden by a stale summary.
+   */
+  struct BlockSummary {
+    std::atomic<uint64_t> value;
+    BlockSummary() : value(DIRTY) {}
+    BlockSummary(const BlockSummary& other) : value(other.value.load()) {}
+  };
+  static const uint64_t DIRTY = 1ull << 63;
+  static const uint64_t ALL_VISIBLE_NEVER = DIRTY - 1;
+
+  void invalidateBlock(size_t delta_row);
+  // the summary of a full block, summarizes it if it is dirty
+  uint64_t blockSummary(size_t block) const;
+  void appendVisibleMainPositions(tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid, pos_list_t& result) const;
+  void appendVisibleDeltaPositions(size_t first, size_t last, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid, pos_list_t& result) const;
+
+  // Summaries of all delta blocks with at least one row
+  mutable tbb::concurrent_vector<BlockSummary> _blockSummaries;
+  // Source of the versions of dirty summaries
+  std::atomic<uint64_t> _summaryVersion;
+
   friend class PrettyPrinter;
 };
 
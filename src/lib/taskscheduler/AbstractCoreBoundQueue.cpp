@@ -20,7 +20,7 @@ namespace taskscheduler {
 log4cxx::LoggerPtr AbstractCoreBoundQueue::logger(log4cxx::Logger::getLogger("taskscheduler.AbstractCoreBoundQueue"));
 
 
-AbstractCoreBoundQueue::AbstractCoreBoundQueue(): _status(RUN){
+AbstractCoreBoundQueue::AbstractCoreBoundQueue(): _status(RUN), _node(Task::NO_PREFERRED_NODE){
   // TODO Auto-generated constructor stub
 
 }
@@ -46,6 +46,9 @@ void AbstractCoreBoundQueue::launchThread(int core) {
   core = (core % (NUM_PROCS - freeCores)) + freeCores;
 
   if (core < NUM_PROCS) {
+    // machines without numa nodes keep the queue on no node
+    if (getNumberOfNodes(getHWTopology()) > 0)
+      _node = getNodeForCore(core);
     _thread = new std::thread(&AbstractTaskQueue::executeTask, this);
     hwloc_cpuset_t cpuset;
     hwloc_obj_t obj;
@@ -22,6 +22,8 @@ protected:
   std::atomic<queue_status_t> _status;
   // specific core thread is bound to
   int _core;
+  // numa node of the core the thread is bound to
+  int _node;
   // mutex to protect the queue
   lock_t _queueMutex;
   // mutext to protect the thread status
@@ -60,6 +62,10 @@ public:
   int getCore() const{
     return _core;
   }
+
+  int getNode() const{
+    return _node;
+  }
 };
 
 } } // namespace hyrise::taskscheduler
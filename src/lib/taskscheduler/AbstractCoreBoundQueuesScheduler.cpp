@@ -50,6 +50,23 @@ void AbstractCoreBoundQueuesScheduler::schedule(std::shared_ptr<Task> task, int
   schedule(task);
 }
 
+bool AbstractCoreBoundQueuesScheduler::pushToNodeQueue(const std::shared_ptr<Task>& task) {
+  const int node = task->getPreferredNode();
+  if (node == Task::NO_PREFERRED_NODE)
+    return false;
+  std::lock_guard<lock_t> lk(_queuesMutex);
+  for (size_t i = 0; i < _queues; ++i) {
+    const size_t queue = (_nextQueue + i) % _queues;
+    if (_taskQueues[queue]->getNode() == node) {
+      _taskQueues[queue]->push(task);
+      LOG4CXX_DEBUG(_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " pushed to queue " << queue << " on node " << node);
+      _nextQueue = (queue + 1) % _queues;
+      return true;
+    }
+  }
+  return false;
+}
+
 /*
  * notify scheduler that a given task is ready
  */
@@ -49,6 +49,13 @@ class AbstractCoreBoundQueuesScheduler :
    */
   virtual void pushToQueue(std::shared_ptr<Task> task) = 0;
 
+  /**
+   * push task to the next queue on its preferred node (round robin over
+   * the queues of the node), returns false if the task prefers no node
+   * or no queue runs on it
+   */
+  bool pushToNodeQueue(const std::shared_ptr<Task>& task);
+
   /*
    * create a new task queue
    */
@@ -40,6 +40,7 @@ void CoreBoundQueue::executeTask() {
         _blocked = true;
         //LOG4CXX_DEBUG(logger, "Started executing task" << std::hex << &task << std::dec << " on core " << _core);
         // run task
+        task->setActualNode(_node);
         //std::cout << "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core<< std::endl;
         (*task)();
         LOG4CXX_DEBUG(logger, "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core);
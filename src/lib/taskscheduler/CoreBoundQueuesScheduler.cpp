@@ -62,6 +62,10 @@ void CoreBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task)
       // Tried to assign task to core which is not assigned to scheduler; assigned to other core, log warning
       LOG4CXX_WARN(this->_logger, "Tried to assign task " << std::hex << (void *)task.get() << std::dec << " to core " << std::to_string(core) << " which is not assigned to scheduler; assigned it to next available core");
 
+    // prefer the queues of the node of the task
+    if (pushToNodeQueue(task))
+      return;
+
     // lock queuesMutex to sync pushing to queue and incrementing next queue
     {
       std::lock_guard<lock_t> lk2(this->_queuesMutex);
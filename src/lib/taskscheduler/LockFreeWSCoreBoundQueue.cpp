@@ -0,0 +1,253 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "LockFreeWSCoreBoundQueue.h"
+#include "LockFreeWSCoreBoundQueuesScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <xmmintrin.h>
+#endif
+
+namespace hyrise {
+namespace taskscheduler {
+
+namespace {
+
+// the queue whose worker runs on the current thread
+thread_local LockFreeWSCoreBoundQueue *currentQueue = nullptr;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#endif
+}
+
+void futexWait(std::atomic<int> *address, int expected, long microseconds) {
+#ifdef __linux__
+  const struct timespec timeout = {microseconds / 1000000, (microseconds % 1000000) * 1000};
+  syscall(SYS_futex, reinterpret_cast<int *>(address), FUTEX_WAIT_PRIVATE, expected, &timeout, nullptr, 0);
+#else
+  if (address->load() == expected)
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min(microseconds, 100l)));
+#endif
+}
+
+void futexWake(std::atomic<int> *address) {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<int *>(address), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
+
+}
+
+LockFreeWSCoreBoundQueue::LockFreeWSCoreBoundQueue(int core, LockFreeWSCoreBoundQueuesScheduler *scheduler):
+    AbstractCoreBoundQueue(), _inbox(nullptr), _wakeups(0), _parked(false) {
+  _core = core;
+  _scheduler = scheduler;
+  launchThread(_core);
+}
+
+LockFreeWSCoreBoundQueue::~LockFreeWSCoreBoundQueue() {
+  if (_thread != nullptr) stopQueue();
+  emptyQueue();
+}
+
+void LockFreeWSCoreBoundQueue::executeTask() {
+  currentQueue = this;
+  size_t idleRounds = 0;
+
+  while (_status != TO_STOP) {
+    std::shared_ptr<Task> task = nextTask();
+    if (task) {
+      idleRounds = 0;
+      task->setActualNode(_node);
+      (*task)();
+      LOG4CXX_DEBUG(logger, "Executed task " << std::hex << &task << std::dec << " on core " << _core);
+      // notify done observers that task is done
+      task->notifyDoneObservers();
+      continue;
+    }
+
+    // queue is empty, stop if we were only asked to finish the remaining tasks
+    if (_status != RUN)
+      break;
+
+    ++idleRounds;
+    if (idleRounds <= SPIN_ROUNDS) {
+      cpuRelax();
+    } else if (idleRounds <= SPIN_ROUNDS + YIELD_ROUNDS) {
+      std::this_thread::yield();
+    } else {
+      park();
+      idleRounds = 0;
+    }
+  }
+  currentQueue = nullptr;
+}
+
+LockFreeWSCoreBoundQueue::TaskNode *LockFreeWSCoreBoundQueue::takeInbox() {
+  TaskNode *nodes = _inbox.exchange(nullptr);
+  // reverse, so that the oldest task comes first
+  TaskNode *reversed = nullptr;
+  while (nodes != nullptr) {
+    TaskNode *next = nodes->next;
+    nodes->next = reversed;
+    reversed = nodes;
+    nodes = next;
+  }
+  return reversed;
+}
+
+std::shared_ptr<Task> LockFreeWSCoreBoundQueue::adopt(TaskNode *nodes) {
+  if (nodes == nullptr)
+    return nullptr;
+  // the deque pops its most recent task first, push in reverse so the oldest task of the inbox is executed next
+  std::vector<TaskNode *> rest;
+  for (TaskNode *node = nodes->next; node != nullptr; node = node->next)
+    rest.push_back(node);
+  for (auto it = rest.rbegin(); it != rest.rend(); ++it)
+    _runQueue.push(*it);
+
+  std::shared_ptr<Task> task = std::move(nodes->task);
+  delete nodes;
+  return task;
+}
+
+std::shared_ptr<Task> LockFreeWSCoreBoundQueue::nextTask() {
+  if (TaskNode *node = _runQueue.pop()) {
+    std::shared_ptr<Task> task = std::move(node->task);
+    delete node;
+    return task;
+  }
+  if (std::shared_ptr<Task> task = adopt(takeInbox()))
+    return task;
+  return stealTasks();
+}
+
+std::shared_ptr<Task> LockFreeWSCoreBoundQueue::stealTasks() {
+  std::shared_ptr<Task> task = nullptr;
+  //check scheduler status
+  if (_scheduler->getSchedulerStatus() == LockFreeWSCoreBoundQueuesScheduler::RUN) {
+    auto *queues = _scheduler->getTaskQueues();
+    if (queues != nullptr) {
+      int number_of_queues = queues->size();
+      // we steal relative from the current queue to distribute stealing over queues
+      for (int i = 1; i < number_of_queues && !task; i++) {
+        task = static_cast<LockFreeWSCoreBoundQueue *>(queues->at((i + _core) % number_of_queues))->stealTask(this);
+      }
+    }
+  }
+  return task;
+}
+
+std::shared_ptr<Task> LockFreeWSCoreBoundQueue::stealTask(LockFreeWSCoreBoundQueue *thief) {
+  // dont steal tasks if thread is about to stop
+  if (_status != RUN)
+    return nullptr;
+
+  if (TaskNode *node = _runQueue.steal()) {
+    std::shared_ptr<Task> task = std::move(node->task);
+    delete node;
+    return task;
+  }
+  // the owner is busy and did not get to its inbox yet
+  if (_inbox.load(std::memory_order_relaxed) != nullptr)
+    return thief->adopt(takeInbox());
+  return nullptr;
+}
+
+bool LockFreeWSCoreBoundQueue::hasWork() const {
+  return !_runQueue.empty() || _inbox.load() != nullptr;
+}
+
+void LockFreeWSCoreBoundQueue::park() {
+  int wakeups = _wakeups.load();
+  _parked = true;
+  // recheck after announcing to sleep, pushes after this point see _parked and wake us up
+  if (_status == RUN && !hasWork())
+    futexWait(&_wakeups, wakeups, PARK_MICROSECONDS);
+  _parked = false;
+}
+
+void LockFreeWSCoreBoundQueue::wake() {
+  _wakeups.fetch_add(1);
+  futexWake(&_wakeups);
+}
+
+void LockFreeWSCoreBoundQueue::wakeIdlePeer() {
+  if (_scheduler->getSchedulerStatus() != LockFreeWSCoreBoundQueuesScheduler::RUN)
+    return;
+  auto *queues = _scheduler->getTaskQueues();
+  if (queues == nullptr)
+    return;
+  const int number_of_queues = queues->size();
+  for (int i = 1; i < number_of_queues; i++) {
+    auto *peer = static_cast<LockFreeWSCoreBoundQueue *>(queues->at((i + _core) % number_of_queues));
+    if (peer->_parked) {
+      peer->wake();
+      return;
+    }
+  }
+}
+
+void LockFreeWSCoreBoundQueue::push(std::shared_ptr<Task> task) {
+  TaskNode *node = new TaskNode {std::move(task), nullptr};
+  if (currentQueue == this) {
+    // the owner is busy with the task pushing this one, an idle peer
+    // may steal it meanwhile
+    _runQueue.push(node);
+    wakeIdlePeer();
+    return;
+  }
+
+  node->next = _inbox.load(std::memory_order_relaxed);
+  while (!_inbox.compare_exchange_weak(node->next, node)) {}
+  if (_parked)
+    wake();
+  else
+    wakeIdlePeer();
+}
+
+void LockFreeWSCoreBoundQueue::join() {
+  _status = RUN_UNTIL_DONE;
+  wake();
+  _thread->join();
+}
+
+std::vector<std::shared_ptr<Task> > LockFreeWSCoreBoundQueue::stopQueue() {
+  if (_status != STOPPED) {
+    // the thread either quits after executing its current task or after being woken up
+    _status = TO_STOP;
+    wake();
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+    _status = STOPPED;
+  }
+  return emptyQueue();
+}
+
+std::vector<std::shared_ptr<Task> > LockFreeWSCoreBoundQueue::emptyQueue() {
+  // only called once the worker thread is stopped, which makes this thread the owner of the deque
+  std::vector<std::shared_ptr<Task> > tmp;
+  while (TaskNode *node = _runQueue.steal()) {
+    tmp.push_back(std::move(node->task));
+    delete node;
+  }
+  for (TaskNode *node = takeInbox(); node != nullptr;) {
+    TaskNode *next = node->next;
+    tmp.push_back(std::move(node->task));
+    delete node;
+    node = next;
+  }
+  return tmp;
+}
+
+} } // namespace hyrise::taskscheduler
@@ -0,0 +1,97 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include "AbstractCoreBoundQueue.h"
+#include "WorkStealingDeque.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+class LockFreeWSCoreBoundQueuesScheduler;
+
+/*
+ * Work-stealing queue without locks on the task path. The worker thread
+ * pushes and pops on its own WorkStealingDeque, other threads hand tasks
+ * over through a lock-free inbox, and idle workers steal from the deques
+ * and inboxes of other queues. A worker without work spins, then yields,
+ * and finally parks on a futex until a task is pushed to its queue, a
+ * busy peer gets a task, or a timeout passes.
+ */
+class LockFreeWSCoreBoundQueue : public AbstractCoreBoundQueue {
+
+  struct TaskNode {
+    std::shared_ptr<Task> task;
+    TaskNode *next;
+  };
+
+  // idle rounds before the worker yields and before it parks
+  static const size_t SPIN_ROUNDS = 64;
+  static const size_t YIELD_ROUNDS = 64;
+  // longest time a parked worker sleeps before it looks for tasks to
+  // steal again, wake ups of idle peers may be missed
+  static const long PARK_MICROSECONDS = 1000;
+
+  WorkStealingDeque<TaskNode> _runQueue;
+  // tasks pushed by other threads, most recent first
+  std::atomic<TaskNode *> _inbox;
+  // futex word, incremented on every wake up
+  std::atomic<int> _wakeups;
+  std::atomic<bool> _parked;
+  LockFreeWSCoreBoundQueuesScheduler *_scheduler;
+
+  /*
+   * take all tasks from the inbox, oldest first
+   */
+  TaskNode *takeInbox();
+  /*
+   * get the next task to execute: own deque, own inbox, then stealing
+   */
+  std::shared_ptr<Task> nextTask();
+  std::shared_ptr<Task> stealTasks();
+  /*
+   * move the given inbox nodes to the own deque and return the first task
+   */
+  std::shared_ptr<Task> adopt(TaskNode *nodes);
+  bool hasWork() const;
+  void park();
+  void wake();
+  /*
+   * wake one parked worker of another queue, so that it steals the tasks
+   * of a busy owner
+   */
+  void wakeIdlePeer();
+
+public:
+  LockFreeWSCoreBoundQueue(int core, LockFreeWSCoreBoundQueuesScheduler *scheduler);
+  virtual ~LockFreeWSCoreBoundQueue();
+
+  /*
+   * Is executed by dedicated thread to work the queue
+   */
+  void executeTask();
+  /*
+   * push a new task to the queue, tasks are expected to have no unmet dependencies
+   */
+  void push(std::shared_ptr<Task> task);
+  /*
+   * wait until all tasks are done
+   */
+  void join();
+  /*
+   * stop queue and return remaining tasks; allows resizing the number of threads used by a task pool
+   */
+  std::vector<std::shared_ptr<Task> > stopQueue();
+
+  /**
+   * empty queue
+   */
+  std::vector<std::shared_ptr<Task> > emptyQueue();
+  /*
+   * steal a task from the top of the deque or, failing that, the whole
+   * inbox; remaining inbox tasks are pushed to the deque of the thief
+   */
+  std::shared_ptr<Task> stealTask(LockFreeWSCoreBoundQueue *thief);
+};
+
+} } // namespace hyrise::taskscheduler
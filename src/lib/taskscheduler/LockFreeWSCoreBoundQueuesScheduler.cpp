@@ -0,0 +1,62 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "LockFreeWSCoreBoundQueuesScheduler.h"
+#include "LockFreeWSCoreBoundQueue.h"
+#include "SharedScheduler.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+// register Scheduler at SharedScheduler
+namespace {
+bool registered  =
+    SharedScheduler::registerScheduler<LockFreeWSCoreBoundQueuesScheduler>("LockFreeWSCoreBoundQueuesScheduler");
+}
+
+LockFreeWSCoreBoundQueuesScheduler::LockFreeWSCoreBoundQueuesScheduler(const int queues) :
+    AbstractCoreBoundQueuesScheduler(), _nextQueueCounter(0) {
+  _status = START_UP;
+  std::lock_guard<lock_t> lk(_queuesMutex);
+  for (int i = 0; i < queues; ++i) {
+    _taskQueues.push_back(createTaskQueue(i));
+  }
+  _queues = queues;
+  _status = RUN;
+}
+
+LockFreeWSCoreBoundQueuesScheduler::~LockFreeWSCoreBoundQueuesScheduler() {
+  this->_status = AbstractCoreBoundQueuesScheduler::TO_STOP;
+  for (size_t i = 0; i < this->_queues; ++i) {
+    this->_taskQueues[i]->stopQueue();
+  }
+  for (size_t i = 0; i < this->_queues; ++i) {
+    delete this->_taskQueues[i];
+  }
+}
+
+const std::vector<AbstractCoreBoundQueue *> *LockFreeWSCoreBoundQueuesScheduler::getTaskQueues() {
+  // the set of queues is fixed while the scheduler runs, no need to lock
+  if (this->_status != AbstractCoreBoundQueuesScheduler::RUN)
+    return nullptr;
+  return &this->_taskQueues;
+}
+
+void LockFreeWSCoreBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task) {
+  int core = task->getPreferredCore();
+  if (core >= 0 && core < static_cast<int>(this->_queues)) {
+    // push task to queue that runs on given core
+    this->_taskQueues[core]->push(task);
+    LOG4CXX_DEBUG(this->_logger,  "Task " << std::hex << (void *)task.get() << std::dec << " pushed to queue " << core);
+  } else if (!this->pushToNodeQueue(task)) {
+    if (core != Task::NO_PREFERRED_CORE)
+      // Tried to assign task to core which is not assigned to scheduler; assigned to other core, log warning
+      LOG4CXX_WARN(this->_logger, "Tried to assign task " << std::hex << (void *)task.get() << std::dec << " to core " << std::to_string(core) << " which is not assigned to scheduler; assigned it to next available core");
+    // round robin on cores, tasks preferring a node were pushed to it
+    this->_taskQueues[_nextQueueCounter++ % this->_queues]->push(task);
+  }
+}
+
+LockFreeWSCoreBoundQueuesScheduler::task_queue_t *LockFreeWSCoreBoundQueuesScheduler::createTaskQueue(int core) {
+  return new LockFreeWSCoreBoundQueue(core, this);
+}
+
+} } // namespace hyrise::taskscheduler
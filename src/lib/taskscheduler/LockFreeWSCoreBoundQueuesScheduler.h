@@ -0,0 +1,37 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include "AbstractCoreBoundQueuesScheduler.h"
+#include "AbstractCoreBoundQueue.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Work-stealing scheduler like WSCoreBoundQueuesScheduler, but with the
+ * lock-free LockFreeWSCoreBoundQueue as queue of each core
+ */
+class LockFreeWSCoreBoundQueuesScheduler : public AbstractCoreBoundQueuesScheduler {
+
+  /**
+   * push ready task to the next queue
+   */
+  virtual void pushToQueue(std::shared_ptr<Task> task);
+
+  /*
+   * create a new task queue
+   */
+  virtual LockFreeWSCoreBoundQueuesScheduler::task_queue_t *createTaskQueue(int core);
+
+  // round robin counter for tasks without preferred core
+  std::atomic<size_t> _nextQueueCounter;
+
+public:
+  LockFreeWSCoreBoundQueuesScheduler(int queues = getNumberOfCoresOnSystem());
+  virtual ~LockFreeWSCoreBoundQueuesScheduler();
+
+  const std::vector<AbstractCoreBoundQueue *> *getTaskQueues();
+
+};
+
+} } // namespace hyrise::taskscheduler
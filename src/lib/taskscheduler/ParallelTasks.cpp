@@ -0,0 +1,112 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "taskscheduler/ParallelTasks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "helper/Epochs.h"
+#include "taskscheduler/SharedScheduler.h"
+
+namespace hyrise {
+namespace taskscheduler {
+
+namespace {
+
+// Part of runParallel, it is run once, either by a worker of the
+// scheduler or by the thread that waits for it
+class PartTask : public Task {
+  enum State { QUEUED, RUNNING, DONE };
+
+  const std::function<void()> _run;
+  std::atomic<int> _state;
+  std::mutex _mutex;
+  std::condition_variable _done;
+
+  bool claim() {
+    int queued = QUEUED;
+    return _state.compare_exchange_strong(queued, RUNNING);
+  }
+
+ public:
+  explicit PartTask(std::function<void()> run) : _run(std::move(run)), _state(QUEUED) {}
+
+  virtual void operator()() {
+    // the waiting thread may have run the part already, _run then
+    // refers to its finished call
+    if (!claim())
+      return;
+    _run();
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _state = DONE;
+    }
+    _done.notify_all();
+  }
+
+  /// Runs the part if no worker started it yet, otherwise waits until
+  /// the worker finished it
+  void join() {
+    if (claim()) {
+      _run();
+      return;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] () { return _state == DONE; });
+  }
+
+  const std::string vname() { return "PartTask"; }
+};
+
+}  // namespace
+
+size_t parallelWorkers() {
+  auto &sharedScheduler = SharedScheduler::getInstance();
+  if (!sharedScheduler.isInitialized())
+    return 1;
+  return std::max<size_t>(1, sharedScheduler.getScheduler()->getNumberOfWorker());
+}
+
+void runParallel(size_t count, const std::function<void(size_t)> &fun) {
+  std::vector<std::exception_ptr> errors(std::max<size_t>(1, count));
+  const auto epoch = Epochs::pinned();
+  auto guarded = [&fun, &errors, epoch] (size_t part) {
+    try {
+      EpochGuard pin(epoch);
+      fun(part);
+    } catch (...) {
+      errors[part] = std::current_exception();
+    }
+  };
+
+  std::vector<std::shared_ptr<PartTask> > tasks;
+  auto &sharedScheduler = SharedScheduler::getInstance();
+  if (count > 1 && sharedScheduler.isInitialized()) {
+    const auto scheduler = sharedScheduler.getScheduler();
+    try {
+      for (size_t part = 1; part < count; ++part) {
+        tasks.push_back(std::make_shared<PartTask>([&guarded, part] () { guarded(part); }));
+        scheduler->schedule(tasks.back());
+      }
+    } catch (...) {
+      // the parts that could not be scheduled are run by join() below
+    }
+  }
+
+  guarded(0);
+  // parts that were not scheduled run here as well
+  for (size_t part = tasks.size() + 1; part < count; ++part)
+    guarded(part);
+  for (const auto &task : tasks)
+    task->join();
+
+  for (const auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+} } // namespace hyrise::taskscheduler
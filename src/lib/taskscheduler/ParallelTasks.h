@@ -0,0 +1,23 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace hyrise {
+namespace taskscheduler {
+
+/// Number of workers of the shared scheduler, 1 if it is not initialized
+size_t parallelWorkers();
+
+/// Calls fun(part) for part in [0, count) on the workers of the shared
+/// scheduler. The calling thread runs part 0 and afterwards every part
+/// that no worker started yet, so it never waits for a queued task: parts
+/// only run in parallel on idle workers, and a plan operation that
+/// already occupies a worker does not oversubscribe the machine. Without
+/// a scheduler all parts run in the calling thread. The parts read the
+/// versions of the epoch pinned by the calling thread. After all parts
+/// finished, the first exception thrown by fun, if any, is rethrown.
+void runParallel(size_t count, const std::function<void(size_t)> &fun);
+
+} } // namespace hyrise::taskscheduler
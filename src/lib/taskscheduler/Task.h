@@ -77,7 +77,7 @@ protected:
   int _preferredCore;
   // indicates on which node the task should run
   int _preferredNode;
-  // indicates on which node the task should run
+  // indicates on which node the task was executed
   int _actualNode;
   // priority
   int _priority;
@@ -185,7 +185,7 @@ public:
     _actualNode = actualNode;
   }
 
-  int getPreferredNode() const {
+  virtual int getPreferredNode() const {
     return _preferredNode;
   }
 
@@ -59,6 +59,7 @@ void WSCoreBoundQueue::executeTask() {
     if (task) {
       //LOG4CXX_DEBUG(logger, "Started executing task" << std::hex << &task << std::dec << " on core " << _core);
       // run task
+      task->setActualNode(_node);
       //std::cout << "Running task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core<< std::endl;
       (*task)();
       //std::cout << "Executed task " << task->vname() << "; hex " << std::hex << &task << std::dec << " on core " << _core<< std::endl;
@@ -79,14 +80,21 @@ std::shared_ptr<Task> WSCoreBoundQueue::stealTasks() {
     if (queues != nullptr) {
       int number_of_queues = queues->size();
       if(number_of_queues > 1){
-        // steal from the next queue (we only check number_of_queues -1, as we do not have to check the queue taht wants to steal)
-        for (int i = 1; i < number_of_queues; i++) {
-          // we steal relative from the current queue to distribute stealing over queues
-          task = static_cast<WSCoreBoundQueue *>(queues->at((i + _core) % number_of_queues))->stealTask();
-          if (task != nullptr) {
-            //push(task);
-            //std::cout << "Queue " << _core << " stole Task " <<  task->vname() << "; hex " << std::hex << &task << std::dec << " from queue " << i << std::endl;
-            break;
+        // steal from the queues on the own node first, their tasks work on memory of this node;
+        // only if they have no tasks left, steal from the queues on other nodes
+        for (int sameNode = 1; sameNode >= 0 && task == nullptr; --sameNode) {
+          // steal from the next queue (we only check number_of_queues -1, as we do not have to check the queue taht wants to steal)
+          for (int i = 1; i < number_of_queues; i++) {
+            // we steal relative from the current queue to distribute stealing over queues
+            auto *queue = static_cast<WSCoreBoundQueue *>(queues->at((i + _core) % number_of_queues));
+            if ((queue->getNode() == _node) != (sameNode == 1))
+              continue;
+            task = queue->stealTask();
+            if (task != nullptr) {
+              //push(task);
+              //std::cout << "Queue " << _core << " stole Task " <<  task->vname() << "; hex " << std::hex << &task << std::dec << " from queue " << i << std::endl;
+              break;
+            }
           }
         }
       }
@@ -63,7 +63,9 @@ void WSCoreBoundQueuesScheduler::pushToQueue(std::shared_ptr<Task> task) {
       if (core < Task::NO_PREFERRED_CORE || core >= static_cast<int>(this->_queues))
         // Tried to assign task to core which is not assigned to scheduler; assigned to other core, log warning
         LOG4CXX_WARN(this->_logger, "Tried to assign task " << std::hex << (void *)task.get() << std::dec << " to core " << std::to_string(core) << " which is not assigned to scheduler; assigned it to next available core");
-      // push task to next queue
+      // push task to the next queue of its node, otherwise to the next queue
+      if (pushToNodeQueue(task))
+        return;
       {
         std::lock_guard<lock_t> lk2(this->_queuesMutex);
         this->_taskQueues[this->_nextQueue]->push(task);
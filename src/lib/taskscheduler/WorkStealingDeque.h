@@ -0,0 +1,134 @@
+// Copyright (c) 2013 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hyrise {
+namespace taskscheduler {
+
+/*
+ * Lock-free work-stealing deque after Chase and Lev ("Dynamic Circular
+ * Work-Stealing Deque", SPAA 2005), with the memory orderings of Le et
+ * al. ("Correct and Efficient Work-Stealing for Weak Memory Models",
+ * PPoPP 2013).
+ *
+ * Only the owning thread may call push() and pop(), which work on the
+ * bottom end; any thread may call steal(), which takes from the top end.
+ * The deque stores raw pointers and does not own them. Buffers replaced
+ * when growing are kept until the deque is destroyed, as thieves might
+ * still read from them.
+ */
+template <typename T>
+class WorkStealingDeque {
+  class Buffer {
+    const int64_t _mask;
+    std::unique_ptr<std::atomic<T *>[]> _slots;
+
+   public:
+    explicit Buffer(int64_t capacity) : _mask(capacity - 1), _slots(new std::atomic<T *>[capacity]) {}
+
+    int64_t capacity() const {
+      return _mask + 1;
+    }
+
+    T *get(int64_t index) const {
+      return _slots[index & _mask].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, T *item) {
+      _slots[index & _mask].store(item, std::memory_order_relaxed);
+    }
+  };
+
+  std::atomic<int64_t> _top;
+  // keeps the thief side and the owner side on different cache lines
+  char _padding[64 - sizeof(std::atomic<int64_t>)];
+  std::atomic<int64_t> _bottom;
+  std::atomic<Buffer *> _buffer;
+  // all buffers ever used, only touched by the owner
+  std::vector<std::unique_ptr<Buffer> > _buffers;
+
+  Buffer *grow(Buffer *old, int64_t top, int64_t bottom) {
+    _buffers.emplace_back(new Buffer(old->capacity() * 2));
+    Buffer *buffer = _buffers.back().get();
+    for (int64_t i = top; i < bottom; ++i) {
+      buffer->put(i, old->get(i));
+    }
+    _buffer.store(buffer, std::memory_order_release);
+    return buffer;
+  }
+
+ public:
+  /// capacity has to be a power of two
+  explicit WorkStealingDeque(int64_t capacity = 256) : _top(0), _bottom(0) {
+    _buffers.emplace_back(new Buffer(capacity));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+  /// Owner only
+  void push(T *item) {
+    int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    int64_t top = _top.load(std::memory_order_acquire);
+    Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+    if (bottom - top > buffer->capacity() - 1) {
+      buffer = grow(buffer, top, bottom);
+    }
+    buffer->put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /// Owner only, returns the most recently pushed item or nullptr
+  T *pop() {
+    int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+
+    T *item = nullptr;
+    if (top <= bottom) {
+      item = buffer->get(bottom);
+      if (top == bottom) {
+        // last item, race against thieves
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          item = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+      }
+    } else {
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /// Any thread, returns the least recently pushed item or nullptr if
+  /// the deque is empty or another thread won the race for the item
+  T *steal() {
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top < bottom) {
+      T *item = _buffer.load(std::memory_order_acquire)->get(top);
+      if (_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return item;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Any thread, only a snapshot while other threads modify the deque
+  bool empty() const {
+    int64_t bottom = _bottom.load(std::memory_order_acquire);
+    return bottom <= _top.load(std::memory_order_acquire);
+  }
+};
+
+} } // namespace hyrise::taskscheduler